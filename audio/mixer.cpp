@@ -240,6 +240,8 @@ MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize, uint outByte
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
+
+	SampleMix::selectFuncs();
 }
 
 MixerImpl::~MixerImpl() {
@@ -667,7 +669,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, getRateConverterQuality());
 }
 
 Channel::~Channel() {
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/rate.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+/** Divide by 256, rounding towards zero like the C division does. */
+static FORCEINLINE int16x4_t divideProduct(int32x4_t p) {
+	const int32x4_t bias = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 24));
+	return vshrn_n_s32(vaddq_s32(p, bias), 8);
+}
+
+/** Multiply eight samples by a volume and divide by 256. */
+static FORCEINLINE int16x8_t scaleSamples(int16x8_t in, int16_t vol) {
+	return vcombine_s16(
+		divideProduct(vmull_n_s16(vget_low_s16(in), vol)),
+		divideProduct(vmull_n_s16(vget_high_s16(in), vol)));
+}
+
+template<MixMode mixMode>
+static FORCEINLINE void mixFrames(int16 *out, int16x8_t left, int16x8_t right) {
+	int16x8x2_t dst = vld2q_s16(out);
+	if (mixMode == MIX_ADD) {
+		dst.val[0] = vaddq_s16(dst.val[0], left);
+		dst.val[1] = vaddq_s16(dst.val[1], right);
+	} else {
+		dst.val[0] = vqaddq_s16(dst.val[0], left);
+		dst.val[1] = vqaddq_s16(dst.val[1], right);
+	}
+	vst2q_s16(out, dst);
+}
+
+template<MixMode mixMode>
+static void mixStereoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo) {
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const int16x8x2_t samples = vld2q_s16(in);
+		const int16x8_t left = scaleSamples(samples.val[0], volL);
+		const int16x8_t right = scaleSamples(samples.val[1], volR);
+		if (reverseStereo)
+			mixFrames<mixMode>(out, right, left);
+		else
+			mixFrames<mixMode>(out, left, right);
+		in += 16;
+		out += 16;
+	}
+
+	if (i < frames)
+		SampleMix::mixStereoGeneric(out, in, frames - i, volL, volR, reverseStereo, mixMode);
+}
+
+template<MixMode mixMode>
+static void mixMonoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const int16x8_t samples = vld1q_s16(in);
+		mixFrames<mixMode>(out, scaleSamples(samples, volL), scaleSamples(samples, volR));
+		in += 8;
+		out += 16;
+	}
+
+	if (i < frames)
+		SampleMix::mixMonoGeneric(out, in, frames - i, volL, volR, false, mixMode);
+}
+
+void SampleMix::mixStereoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixStereoNEON<MIX_ADD>(out, in, frames, volL, volR, reverseStereo);
+	else
+		Audio::mixStereoNEON<MIX_CLAMPED_ADD>(out, in, frames, volL, volR, reverseStereo);
+}
+
+void SampleMix::mixMonoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixMonoNEON<MIX_ADD>(out, in, frames, volL, volR);
+	else
+		Audio::mixMonoNEON<MIX_CLAMPED_ADD>(out, in, frames, volL, volR);
+}
+
+void SampleMix::convolveNEON(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps) {
+	int32x4_t sumL = vdupq_n_s32(0);
+	int32x4_t sumR = vdupq_n_s32(0);
+
+	if (right) {
+		for (uint i = 0; i < taps; i += 8) {
+			const int16x8_t c = vld1q_s16(coefs + i);
+			const int16x8_t l = vld1q_s16(left + i);
+			const int16x8_t r = vld1q_s16(right + i);
+			sumL = vmlal_s16(sumL, vget_low_s16(l), vget_low_s16(c));
+			sumL = vmlal_s16(sumL, vget_high_s16(l), vget_high_s16(c));
+			sumR = vmlal_s16(sumR, vget_low_s16(r), vget_low_s16(c));
+			sumR = vmlal_s16(sumR, vget_high_s16(r), vget_high_s16(c));
+		}
+	} else {
+		for (uint i = 0; i < taps; i += 8) {
+			const int16x8_t c = vld1q_s16(coefs + i);
+			const int16x8_t l = vld1q_s16(left + i);
+			sumL = vmlal_s16(sumL, vget_low_s16(l), vget_low_s16(c));
+			sumL = vmlal_s16(sumL, vget_high_s16(l), vget_high_s16(c));
+		}
+		sumR = sumL;
+	}
+
+	// Reduce both sums at once, into the lanes L and R
+	const int32x2_t sum = vpadd_s32(vadd_s32(vget_low_s32(sumL), vget_high_s32(sumL)),
+		vadd_s32(vget_low_s32(sumR), vget_high_s32(sumR)));
+
+	// Round, shift and saturate to 16 bits
+	const int16x4_t frame = vqrshrn_n_s32(vcombine_s32(sum, sum), 14);
+	const int32 result = vget_lane_s32(vreinterpret_s32_s16(frame), 0);
+	memcpy(out, &result, sizeof(result));
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
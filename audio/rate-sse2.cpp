@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "audio/rate.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+/**
+ * Multiply eight samples by their volumes and divide by 256, rounding
+ * towards zero like the C division does.
+ */
+static FORCEINLINE __m128i scaleSamples(__m128i in, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(in, vol);
+	const __m128i hi = _mm_mulhi_epi16(in, vol);
+	const __m128i bias = _mm_set1_epi32(255);
+
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 8);
+
+	return _mm_packs_epi32(p0, p1);
+}
+
+template<MixMode mixMode>
+static FORCEINLINE void mixSamples(int16 *out, __m128i samples) {
+	const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+	if (mixMode == MIX_ADD)
+		_mm_storeu_si128((__m128i *)out, _mm_add_epi16(dst, samples));
+	else
+		_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, samples));
+}
+
+template<MixMode mixMode>
+static void mixStereoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo) {
+	// With reversed stereo, the input is swapped before scaling, so each
+	// lane keeps the volume of its output channel
+	const __m128i vol = reverseStereo ?
+		_mm_set_epi16(volL, volR, volL, volR, volL, volR, volL, volR) :
+		_mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	uint i = 0;
+	for (; i + 4 <= frames; i += 4) {
+		__m128i samples = _mm_loadu_si128((const __m128i *)in);
+		if (reverseStereo) {
+			samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+			samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+		mixSamples<mixMode>(out, scaleSamples(samples, vol));
+		in += 8;
+		out += 8;
+	}
+
+	if (i < frames)
+		SampleMix::mixStereoGeneric(out, in, frames - i, volL, volR, reverseStereo, mixMode);
+}
+
+template<MixMode mixMode>
+static void mixMonoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	uint i = 0;
+	for (; i + 8 <= frames; i += 8) {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)in);
+		mixSamples<mixMode>(out, scaleSamples(_mm_unpacklo_epi16(samples, samples), vol));
+		mixSamples<mixMode>(out + 8, scaleSamples(_mm_unpackhi_epi16(samples, samples), vol));
+		in += 8;
+		out += 16;
+	}
+
+	if (i < frames)
+		SampleMix::mixMonoGeneric(out, in, frames - i, volL, volR, false, mixMode);
+}
+
+void SampleMix::mixStereoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixStereoSSE2<MIX_ADD>(out, in, frames, volL, volR, reverseStereo);
+	else
+		Audio::mixStereoSSE2<MIX_CLAMPED_ADD>(out, in, frames, volL, volR, reverseStereo);
+}
+
+void SampleMix::mixMonoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixMonoSSE2<MIX_ADD>(out, in, frames, volL, volR);
+	else
+		Audio::mixMonoSSE2<MIX_CLAMPED_ADD>(out, in, frames, volL, volR);
+}
+
+void SampleMix::convolveSSE2(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps) {
+	__m128i sumL = _mm_setzero_si128();
+	__m128i sumR = _mm_setzero_si128();
+
+	if (right) {
+		for (uint i = 0; i < taps; i += 8) {
+			const __m128i c = _mm_loadu_si128((const __m128i *)(coefs + i));
+			sumL = _mm_add_epi32(sumL, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(left + i)), c));
+			sumR = _mm_add_epi32(sumR, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(right + i)), c));
+		}
+	} else {
+		for (uint i = 0; i < taps; i += 8) {
+			const __m128i c = _mm_loadu_si128((const __m128i *)(coefs + i));
+			sumL = _mm_add_epi32(sumL, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(left + i)), c));
+		}
+		sumR = sumL;
+	}
+
+	// Reduce both sums at once: L0+L2 R0+R2 L1+L3 R1+R3, then fold again
+	__m128i sum = _mm_add_epi32(_mm_unpacklo_epi32(sumL, sumR), _mm_unpackhi_epi32(sumL, sumR));
+	sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+
+	// Round, and let the saturating pack do the clipping
+	sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1 << 13)), 14);
+	const int32 frame = _mm_cvtsi128_si32(_mm_packs_epi32(sum, sum));
+	memcpy(out, &frame, sizeof(frame));
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
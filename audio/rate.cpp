@@ -34,8 +34,11 @@
 #include "audio/mixer.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/system.h"
 #include "common/util.h"
 
+#include <math.h>
+
 namespace Audio {
 
 /**
@@ -93,6 +96,17 @@ private:
 	template<st_volume_t volL, st_volume_t volR, typename st_sample_t, MixMode mixMode>
 	FORCEINLINE void writeFrame(st_sample_t *&outBuffer, int16 inL, int16 inR, st_volume_t volL_val, st_volume_t volR_val);
 
+	/** Check whether SampleMix can produce the output for these parameters. */
+	template<st_volume_t volL, st_volume_t volR, typename st_sample_t>
+	static bool useSampleMix(st_volume_t volL_val, st_volume_t volR_val) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		return false;
+#else
+		return outStereo && volL != 0 && volR != 0 && sizeof(st_sample_t) == sizeof(int16) &&
+			volL_val <= Audio::Mixer::kMaxMixerVolume && volR_val <= Audio::Mixer::kMaxMixerVolume;
+#endif
+	}
+
 	template<st_volume_t volL, st_volume_t volR, typename st_sample_t, MixMode mixMode>
 	int commonConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL_val, st_volume_t volR_val, int outputSamples);
 
@@ -236,7 +250,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::commonConvert(AudioS
 
 		_bufferSize -= count * (inStereo ? 2 : 1);
 
-		if (volL | volR) {
+		if (outputSamples == 1 && useSampleMix<volL, volR, st_sample_t>(volL_val, volR_val)) {
+			// Straight copy into a 16-bit stereo buffer, the most common case
+			if (inStereo)
+				SampleMix::mixStereo((int16 *)outBuffer, _bufferPos, count, volL_val, volR_val, reverseStereo, mixMode);
+			else
+				SampleMix::mixMono((int16 *)outBuffer, _bufferPos, count, volL_val, volR_val, reverseStereo, mixMode);
+			_bufferPos += count * (inStereo ? 2 : 1);
+			outBuffer += count * 2;
+		} else if (volL | volR) {
 			// Mix the data into the output buffer
 			for (int i = 0; i < count; ++i) {
 				// This code is eliminated if muted
@@ -391,6 +413,71 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 	const st_sample_t *outStart = outBuffer;
 	const st_sample_t *outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
+	if (useSampleMix<volL, volR, st_sample_t>(volL_val, volR_val)) {
+		// Interpolate a block of frames, then scale and mix it in one go
+		int16 block[512];
+		bool endOfInput = false;
+
+		while (outBuffer < outEnd && !endOfInput) {
+			const int blockFrames = MIN<int>((outEnd - outBuffer) / 2, ARRAYSIZE(block) / 2);
+			int frames = 0;
+
+			while (frames < blockFrames) {
+				// Read enough input samples so that _outPosFrac < 0
+				while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+					// Check if we have to refill the buffer
+					if (_bufferSize == 0) {
+						_bufferPos = _buffer;
+						_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+						if (_bufferSize <= 0) {
+							endOfInput = true;
+							break;
+						}
+					}
+
+					_bufferSize -= (inStereo ? 2 : 1);
+
+					_inLastL = _inCurL;
+					_inCurL = *_bufferPos++;
+					if (inStereo) {
+						_inLastR = _inCurR;
+						_inCurR = *_bufferPos++;
+					}
+
+					_outPosFrac -= FRAC_ONE_LOW;
+				}
+
+				if (endOfInput)
+					break;
+
+				// Local copies, since the compiler has to assume that writing
+				// to the block may change the int16 members
+				const int lastL = _inLastL, deltaL = _inCurL - _inLastL;
+				const int lastR = _inLastR, deltaR = _inCurR - _inLastR;
+				frac_t outPosFrac = _outPosFrac;
+
+				while (outPosFrac < (frac_t)FRAC_ONE_LOW && frames < blockFrames) {
+					int16 *frame = block + 2 * frames++;
+					frame[0] = (int16)(lastL + ((deltaL * outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+					frame[1] = (inStereo ?
+						(int16)(lastR + ((deltaR * outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
+						frame[0]);
+
+					// Increment output position
+					outPosFrac += outPos_inc;
+				}
+
+				_outPosFrac = outPosFrac;
+			}
+
+			SampleMix::mixStereo((int16 *)outBuffer, block, frames, volL_val, volR_val, reverseStereo, mixMode);
+			outBuffer += frames * 2;
+		}
+
+		return (outBuffer - outStart) / 2;
+	}
+
 	while (outBuffer < outEnd) {
 		// Read enough input samples so that _outPosFrac < 0
 		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
@@ -569,23 +656,413 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+/**
+ * Parameters of the polyphase windowed sinc filters. Each filter is stored
+ * as a table of (1 << phaseBits) phases of taps Q14 coefficients. Phase p
+ * produces the output sample located p / (1 << phaseBits) of a frame after
+ * input frame taps / 2 - 1 of the filter window.
+ */
+struct SincFilterParams {
+	uint taps;
+	uint phaseBits;
+	double cutoff;	///< Pass band edge, relative to the input Nyquist frequency
+	double beta;	///< Kaiser window shape
+};
+
+static const SincFilterParams sincBalanced = { 16, 7, 0.90, 6.0 };
+static const SincFilterParams sincBest = { 32, 9, 0.94, 8.5 };
+
+enum {
+	kSincMaxTaps = 32
+};
+
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+static void makeSincTable(int16 *table, const SincFilterParams &params, double cutoff) {
+	const uint phases = 1 << params.phaseBits;
+	const double half = params.taps / 2;
+	const double i0Beta = besselI0(params.beta);
+
+	for (uint p = 0; p < phases; p++) {
+		const double frac = (double)p / phases;
+		double coefs[kSincMaxTaps];
+		double sum = 0.0;
+
+		for (uint k = 0; k < params.taps; k++) {
+			// Distance of tap k from the output sample, in input frames
+			const double x = (double)k - (half - 1) - frac;
+			const double t = x / half;
+			const double window = (t > -1.0 && t < 1.0) ? besselI0(params.beta * sqrt(1.0 - t * t)) / i0Beta : 0.0;
+			const double sinc = (x == 0.0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			coefs[k] = sinc * window;
+			sum += coefs[k];
+		}
+
+		// Normalize each phase to unity gain, putting the rounding error on
+		// the center tap so that a constant input gives a constant output
+		int16 *phase = table + p * params.taps;
+		int total = 0;
+		for (uint k = 0; k < params.taps; k++) {
+			phase[k] = (int16)floor(coefs[k] / sum * 16384.0 + 0.5);
+			total += phase[k];
+		}
+		phase[params.taps / 2 - (frac < 0.5 ? 1 : 0)] += 16384 - total;
+	}
+}
+
+/**
+ * Rate converter using a polyphase windowed sinc filter. Compared to the
+ * linear interpolation of RateConverter_Impl it does not alias when
+ * upsampling 11 or 22 kHz samples to 44.1 or 48 kHz, at a higher CPU cost.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+private:
+	st_rate_t _inRate, _outRate;
+
+	const SincFilterParams &_params;
+
+	/** Coefficients for the current rates, rebuilt when the ratio changes */
+	Common::Array<int16> _table;
+	double _tableCutoff;
+
+	int16 _buffer[512];
+	const int16 *_bufferPos;
+	int _bufferSize;
+
+	/** Fractional position of the output stream in input stream unit */
+	frac_t _outPosFrac;
+
+	/**
+	 * The last taps input frames per channel. Every frame is written twice,
+	 * so that the window starting at _historyPos is always contiguous.
+	 */
+	int16 _historyL[2 * kSincMaxTaps];
+	int16 _historyR[2 * kSincMaxTaps];
+	uint _historyPos;
+
+	/**
+	 * Number of silent frames still to feed once the input has ended, so
+	 * that the filter response to its last frames is not cut off.
+	 */
+	uint _flushFrames;
+
+	void updateTable();
+	uint filterBlock(AudioStream &input, int16 *block, uint frames);
+
+	template<typename st_sample_t, MixMode mixMode>
+	void writeFrames(st_sample_t *outBuffer, const int16 *block, uint frames, st_volume_t volL, st_volume_t volR);
+
+public:
+	SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, const SincFilterParams &params);
+
+	int convert(AudioStream &input, byte *outBuffer, uint outBytesPerSample, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r, MixMode mixMode) override;
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; updateTable(); }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; updateTable(); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override { return _bufferSize != 0 || _flushFrames != 0; }
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter<inStereo, outStereo, reverseStereo>::SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, const SincFilterParams &params) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_params(params),
+	_tableCutoff(0.0),
+	_bufferPos(nullptr),
+	_bufferSize(0),
+	_outPosFrac(FRAC_ONE_LOW),
+	_historyPos(0),
+	_flushFrames(0) {
+
+	memset(_historyL, 0, sizeof(_historyL));
+	memset(_historyR, 0, sizeof(_historyR));
+
+	updateTable();
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::updateTable() {
+	// When downsampling, the pass band has to shrink with the output rate.
+	// Quantize the cutoff so that small rate changes, e.g. from pitch
+	// effects, do not recompute the table every time.
+	double cutoff = _params.cutoff;
+	if (_inRate > _outRate)
+		cutoff = ((uint)(_params.cutoff * _outRate / _inRate * 1024.0) | 1) / 1024.0;
+
+	if (cutoff != _tableCutoff) {
+		_table.resize(_params.taps << _params.phaseBits);
+		makeSincTable(_table.data(), _params, cutoff);
+		_tableCutoff = cutoff;
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+uint SincRateConverter<inStereo, outStereo, reverseStereo>::filterBlock(AudioStream &input, int16 *block, uint frames) {
+	const uint taps = _params.taps;
+	const uint phaseShift = FRAC_BITS_LOW - _params.phaseBits;
+	const int16 *const table = _table.data();
+	const SampleMix::ConvolveFunc convolve = SampleMix::convolve;
+
+	// How much to increment _outPosFrac by
+	const frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	// Work on local copies of the state, the convolution calls would
+	// otherwise force the compiler to reload it for every frame
+	frac_t outPosFrac = _outPosFrac;
+	uint historyPos = _historyPos;
+	const int16 *bufferPos = _bufferPos;
+	int bufferSize = _bufferSize;
+	uint flushFrames = _flushFrames;
+	bool endOfInput = false;
+
+	uint i = 0;
+	for (; i < frames; i++) {
+		// Feed input frames into the history until it reaches the output position
+		while ((frac_t)FRAC_ONE_LOW <= outPosFrac) {
+			// Check if we have to refill the buffer
+			if (bufferSize == 0) {
+				bufferPos = _buffer;
+				bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+				if (bufferSize > 0) {
+					flushFrames = taps;
+				} else {
+					bufferSize = 0;
+
+					// Once the stream has ended, feed silence until its last
+					// frame has left the filter window
+					if (flushFrames == 0 || !input.endOfData()) {
+						endOfInput = true;
+						break;
+					}
+					flushFrames--;
+				}
+			}
+
+			int16 sampleL = 0, sampleR = 0;
+			if (bufferSize != 0) {
+				bufferSize -= (inStereo ? 2 : 1);
+				sampleL = *bufferPos++;
+				if (inStereo)
+					sampleR = *bufferPos++;
+			}
+
+			_historyL[historyPos] = _historyL[historyPos + taps] = sampleL;
+			if (inStereo)
+				_historyR[historyPos] = _historyR[historyPos + taps] = sampleR;
+			if (++historyPos == taps)
+				historyPos = 0;
+
+			outPosFrac -= FRAC_ONE_LOW;
+		}
+
+		if (endOfInput)
+			break;
+
+		const int16 *coefs = table + (outPosFrac >> phaseShift) * taps;
+		convolve(block + 2 * i, _historyL + historyPos, inStereo ? _historyR + historyPos : nullptr, coefs, taps);
+
+		// Increment output position
+		outPosFrac += outPos_inc;
+	}
+
+	_outPosFrac = outPosFrac;
+	_historyPos = historyPos;
+	_bufferPos = bufferPos;
+	_bufferSize = bufferSize;
+	_flushFrames = flushFrames;
+
+	return i;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+template<typename st_sample_t, MixMode mixMode>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::writeFrames(st_sample_t *outBuffer, const int16 *block, uint frames, st_volume_t volL, st_volume_t volR) {
+	for (uint i = 0; i < frames; i++) {
+		const st_sample_t outL = (block[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		const st_sample_t outR = (block[1] * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+		block += 2;
+
+		if (outStereo) {
+			processSample<mixMode>(outBuffer[reverseStereo    ], outL);
+			processSample<mixMode>(outBuffer[reverseStereo ^ 1], outR);
+			outBuffer += 2;
+		} else {
+			processSample<mixMode>(outBuffer[0], (outL + outR) / 2);
+			outBuffer++;
+		}
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, byte *outBuffer, uint outBytesPerSample, st_size_t numSamples, st_volume_t volL, st_volume_t volR, MixMode mixMode) {
+	assert(input.isStereo() == inStereo);
+
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	const bool useSampleMix = false;
+#else
+	const bool useSampleMix = outStereo && outBytesPerSample == sizeof(int16) &&
+		volL <= Audio::Mixer::kMaxMixerVolume && volR <= Audio::Mixer::kMaxMixerVolume;
+#endif
+
+	int16 block[512];
+	st_size_t done = 0;
+
+	while (done < numSamples) {
+		const uint wanted = MIN<st_size_t>(numSamples - done, ARRAYSIZE(block) / 2);
+		const uint frames = filterBlock(input, block, wanted);
+
+		if (useSampleMix) {
+			SampleMix::mixStereo((int16 *)outBuffer + done * 2, block, frames, volL, volR, reverseStereo, mixMode);
+		} else if (outBytesPerSample == sizeof(int32)) {
+			int32 *out = (int32 *)outBuffer + done * (outStereo ? 2 : 1);
+			if (mixMode == MIX_ADD)
+				writeFrames<int32, MIX_ADD>(out, block, frames, volL, volR);
+			else
+				writeFrames<int32, MIX_CLAMPED_ADD>(out, block, frames, volL, volR);
+		} else {
+			int16 *out = (int16 *)outBuffer + done * (outStereo ? 2 : 1);
+			if (mixMode == MIX_ADD)
+				writeFrames<int16, MIX_ADD>(out, block, frames, volL, volR);
+			else
+				writeFrames<int16, MIX_CLAMPED_ADD>(out, block, frames, volL, volR);
+		}
+
+		done += frames;
+		if (frames < wanted)
+			break;
+	}
+
+	return done;
+}
+
+template<MixMode mixMode>
+static void mixStereoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo) {
+	for (uint i = 0; i < frames; i++) {
+		processSample<mixMode>(out[reverseStereo    ], (int16)((in[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume));
+		processSample<mixMode>(out[reverseStereo ^ 1], (int16)((in[1] * (int)volR) / Audio::Mixer::kMaxMixerVolume));
+		in += 2;
+		out += 2;
+	}
+}
+
+template<MixMode mixMode>
+static void mixMonoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR) {
+	for (uint i = 0; i < frames; i++) {
+		processSample<mixMode>(out[0], (int16)((in[0] * (int)volL) / Audio::Mixer::kMaxMixerVolume));
+		processSample<mixMode>(out[1], (int16)((in[0] * (int)volR) / Audio::Mixer::kMaxMixerVolume));
+		in++;
+		out += 2;
+	}
+}
+
+void SampleMix::mixStereoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixStereoGeneric<MIX_ADD>(out, in, frames, volL, volR, reverseStereo);
+	else
+		Audio::mixStereoGeneric<MIX_CLAMPED_ADD>(out, in, frames, volL, volR, reverseStereo);
+}
+
+void SampleMix::mixMonoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode) {
+	if (mixMode == MIX_ADD)
+		Audio::mixMonoGeneric<MIX_ADD>(out, in, frames, volL, volR);
+	else
+		Audio::mixMonoGeneric<MIX_CLAMPED_ADD>(out, in, frames, volL, volR);
+}
+
+static inline int16 convolveChannel(const int16 *samples, const int16 *coefs, uint taps) {
+	int32 sum = 0;
+	for (uint i = 0; i < taps; i++)
+		sum += samples[i] * coefs[i];
+	return (int16)CLIP<int32>((sum + (1 << 13)) >> 14, -32768, 32767);
+}
+
+void SampleMix::convolveGeneric(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps) {
+	out[0] = convolveChannel(left, coefs, taps);
+	out[1] = right ? convolveChannel(right, coefs, taps) : out[0];
+}
+
+// Start with the generic functions, so that converters work before the
+// mixer has selected the ones matching the running CPU.
+SampleMix::MixFunc SampleMix::mixStereo = SampleMix::mixStereoGeneric;
+SampleMix::MixFunc SampleMix::mixMono = SampleMix::mixMonoGeneric;
+SampleMix::ConvolveFunc SampleMix::convolve = SampleMix::convolveGeneric;
+
+void SampleMix::selectFuncs() {
+	// The SIMD versions divide by the volume range with a shift
+	static_assert(Audio::Mixer::kMaxMixerVolume == 256, "SampleMix assumes a volume range of 256");
+
+	mixStereo = mixStereoGeneric;
+	mixMono = mixMonoGeneric;
+	convolve = convolveGeneric;
+
+	// The test suites create converters without an OSystem
+	if (!g_system)
+		return;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		mixStereo = mixStereoNEON;
+		mixMono = mixMonoNEON;
+		convolve = convolveNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		mixStereo = mixStereoSSE2;
+		mixMono = mixMonoSSE2;
+		convolve = convolveSSE2;
+	}
+#endif
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateConverter *makeConverter(st_rate_t inRate, st_rate_t outRate, RateConverterQuality quality) {
+	if (quality == kRateQualityFast || inRate == outRate)
+		return new RateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+	else
+		return new SincRateConverter<inStereo, outStereo, reverseStereo>(inRate, outRate, quality == kRateQualityBest ? sincBest : sincBalanced);
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality) {
 	assert(inRate != 0 && outRate != 0);
 
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return makeConverter<true, true, true>(inRate, outRate, quality);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return makeConverter<true, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return makeConverter<true, false, false>(inRate, outRate, quality);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return makeConverter<false, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return makeConverter<false, false, false>(inRate, outRate, quality);
 	}
 }
 
+RateConverterQuality getRateConverterQuality() {
+	const Common::String &quality = ConfMan.get("resampler_quality");
+	if (quality == "best")
+		return kRateQualityBest;
+	else if (quality == "balanced")
+		return kRateQualityBalanced;
+	else
+		return kRateQualityFast;
+}
+
 } // End of namespace Audio
@@ -44,6 +44,16 @@ enum MixMode {
 	MIX_CLAMPED_ADD
 };
 
+/**
+ * Trade-off between CPU usage and sound quality when converting rates,
+ * as selected by the "resampler_quality" config key.
+ */
+enum RateConverterQuality {
+	kRateQualityFast,		///< Sample repetition or linear interpolation.
+	kRateQualityBalanced,	///< 16 tap polyphase windowed sinc filter.
+	kRateQualityBest		///< 32 tap polyphase windowed sinc filter.
+};
+
 // This assumes that 'a' and 'b' are 24-bit samples at most
 template <MixMode Mode, typename T>
 static inline void processSample(T& a, int b) {
@@ -84,6 +94,67 @@ static inline void clampedAdd(T& a, int b) {
 	processSample<MIX_CLAMPED_ADD>(a, b);
 }
 
+/**
+ * Inner loops of the rate converters for 16-bit stereo output, which is
+ * what nearly all backends mix into. They compute
+ * out = mix(out, (in * vol) / Mixer::kMaxMixerVolume) with the same rounding
+ * as the scalar converter code, for volumes up to Mixer::kMaxMixerVolume.
+ *
+ * The generic versions are plain C. selectFuncs() replaces them with SIMD
+ * versions where the running CPU supports them.
+ */
+class SampleMix {
+public:
+	/**
+	 * @param out				Stereo output buffer to mix into.
+	 * @param in				Input samples.
+	 * @param frames			Number of output frames to produce.
+	 * @param volL				Volume for left channel.
+	 * @param volR				Volume for right channel.
+	 * @param reverseStereo		Swap the input channels.
+	 * @param mixMode			Sample mix mode for out.
+	 */
+	typedef void (*MixFunc)(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+
+	/** Mix interleaved stereo input frames into the output. */
+	static MixFunc mixStereo;
+	/** Mix mono input samples into both output channels. reverseStereo is ignored. */
+	static MixFunc mixMono;
+
+	/**
+	 * Compute one output frame of the sinc rate converter: the dot products
+	 * of @p taps samples of each channel with Q14 filter coefficients,
+	 * rounded and clipped to 16 bits.
+	 *
+	 * @param out				Output frame, two samples.
+	 * @param left				Samples of the left channel.
+	 * @param right				Samples of the right channel, or nullptr for
+	 *							mono input, which is then written to both
+	 *							output samples.
+	 * @param coefs				Filter coefficients.
+	 * @param taps				Length of the filter, a multiple of 8.
+	 */
+	typedef void (*ConvolveFunc)(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps);
+	static ConvolveFunc convolve;
+
+	/**
+	 * Pick the fastest implementation for the running CPU. Called when the
+	 * mixer is created, before the audio thread runs, as the converters
+	 * read the functions without locking.
+	 */
+	static void selectFuncs();
+
+	static void mixStereoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void mixMonoGeneric(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void convolveGeneric(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps);
+	static void mixStereoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void mixMonoSSE2(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void convolveSSE2(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps);
+	static void mixStereoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void mixMonoNEON(int16 *out, const int16 *in, uint frames, st_volume_t volL, st_volume_t volR, bool reverseStereo, MixMode mixMode);
+	static void convolveNEON(int16 *out, const int16 *left, const int16 *right, const int16 *coefs, uint taps);
+};
+
 /**
  * Helper class that handles resampling an AudioStream between an input and output
  * sample rate. Its regular use case is upsampling from the native stream rate
@@ -124,7 +195,16 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * Create a rate converter.
+ *
+ * @param quality	Algorithm used when the rates differ. Use
+ *					getRateConverterQuality() to follow the user's choice.
+ */
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality = kRateQualityFast);
+
+/** Return the quality selected by the "resampler_quality" config key. */
+RateConverterQuality getRateConverterQuality();
 
 /** @} */
 } // End of namespace Audio
@@ -172,6 +172,16 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file referred
+	 * by this node, without opening it. The time is only meant to be compared
+	 * with previously retrieved values, its unit is backend specific.
+	 *
+	 * @return true if the information is available, false if the node is not
+	 *         a file or the backend does not support this
+	 */
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -212,6 +222,14 @@ public:
 	* @return true if the directory is created successfully
 	*/
 	virtual bool createDirectory() = 0;
+
+	/**
+	 * Deletes the file referred by this node.
+	 *
+	 * @return true if the file was deleted, false if the node is not a file
+	 *         or the backend does not support this
+	 */
+	virtual bool removeFile();
 };
 
 
@@ -73,6 +73,10 @@ bool ChRootFilesystemNode::isWritable() const {
 	return _realNode->isWritable();
 }
 
+bool ChRootFilesystemNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	return _realNode->getFileInfo(size, modificationTime);
+}
+
 AbstractFSNode *ChRootFilesystemNode::getChild(const Common::String &n) const {
 	return new ChRootFilesystemNode(_root, (POSIXFilesystemNode *)_realNode->getChild(n), _drive);
 }
@@ -108,6 +112,10 @@ bool ChRootFilesystemNode::createDirectory() {
 	return _realNode->createDirectory();
 }
 
+bool ChRootFilesystemNode::removeFile() {
+	return _realNode->removeFile();
+}
+
 Common::String ChRootFilesystemNode::addPathComponent(const Common::String &path, const Common::String &component) {
 	const char sep = '/';
 	if (path.lastChar() == sep && component.firstChar() == sep) {
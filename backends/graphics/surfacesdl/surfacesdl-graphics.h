@@ -34,6 +34,8 @@
 
 #include "backends/platform/sdl/sdl-sys.h"
 
+class ScalerPool;
+
 #ifndef RELEASE_BUILD
 // Define this to allow for focus rectangle debugging
 #define USE_SDL_DEBUG_FOCUSRECT
@@ -335,6 +337,8 @@ protected:
 	const PluginList &_scalerPlugins;
 	ScalerPluginObject *_scalerPlugin;
 	Scaler *_scaler, *_mouseScaler;
+	/** Optional worker pool for scaling large dirty rects in parallel */
+	ScalerPool *_scalerPool;
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
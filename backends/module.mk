@@ -218,6 +218,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mixer/null/null-mixer.o \
 	mutex/sdl/sdl-mutex.o \
+	thread/sdl/sdl-thread.o \
 	timer/sdl/sdl-timer.o
 
 ifndef USE_SDL3
@@ -357,6 +358,7 @@ MODULE_OBJS += \
 	graphics/android/android-graphics.o \
 	mixer/android/android-mixer.o \
 	mutex/pthread/pthread-mutex.o \
+	thread/pthread/pthread-thread.o \
 	networking/basic/android/jni.o \
 	networking/basic/android/socket.o \
 	networking/basic/android/url.o
@@ -460,6 +462,7 @@ ifdef IPHONE
 MODULE_OBJS += \
 	midi/coremidi.o \
 	mutex/pthread/pthread-mutex.o \
+	thread/pthread/pthread-thread.o \
 	graphics/ios/ios-graphics.o \
 	graphics/ios/renderbuffer.o
 
@@ -70,6 +70,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/mixer/mixer.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/thread/pthread/pthread-thread.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 
@@ -773,6 +774,18 @@ Common::MutexInternal *OSystem_Android::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Android::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::ConditionVariableInternal *OSystem_Android::createConditionVariable() {
+	return createPthreadConditionVariableInternal();
+}
+
+uint OSystem_Android::getCPUCount() {
+	return getPthreadCPUCount();
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
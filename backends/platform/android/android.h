@@ -245,6 +245,9 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) override;
+	Common::ConditionVariableInternal *createConditionVariable() override;
+	uint getCPUCount() override;
 
 	void quit() override;
 
@@ -53,15 +53,24 @@ typedef void (*sighandler_t)(int);
 #include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
 
+// The tests use real threads, so that the code running on worker threads
+// is exercised as it is with the other backends
+#if defined(POSIX) && defined(NULL_DRIVER_USE_FOR_TEST)
+#define NULL_DRIVER_USE_PTHREADS
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/thread/pthread/pthread-thread.h"
+#endif
+
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mixer/null/null-mixer.h"
-#include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
 
+#include "backends/graphics/null/null-graphics.h"
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -84,9 +93,16 @@ public:
 
 	virtual void initBackend();
 
+	virtual bool hasFeature(Feature f);
+
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
+#ifdef NULL_DRIVER_USE_PTHREADS
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name);
+	virtual Common::ConditionVariableInternal *createConditionVariable();
+	virtual uint getCPUCount();
+#endif
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
@@ -144,6 +160,9 @@ void OSystem_NULL::initBackend() {
 	_startTime = GetTickCount();
 #endif
 
+	// Also for the tests, as the codecs query the screen format
+	_graphicsManager = new NullGraphicsManager();
+
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #ifdef POSIX
 	last_handler = signal(SIGINT, intHandler);
@@ -152,7 +171,6 @@ void OSystem_NULL::initBackend() {
 	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
-	_graphicsManager = new NullGraphicsManager();
 	_mixerManager = new NullMixerManager();
 	// Setup and start mixer
 	_mixerManager->init();
@@ -161,6 +179,23 @@ void OSystem_NULL::initBackend() {
 #endif
 }
 
+bool OSystem_NULL::hasFeature(Feature f) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (f == kFeatureCpuSSE2)
+		return __builtin_cpu_supports("sse2");
+	if (f == kFeatureCpuSSE41)
+		return __builtin_cpu_supports("sse4.1");
+	if (f == kFeatureCpuAVX2)
+		return __builtin_cpu_supports("avx2");
+#endif
+#if defined(__aarch64__)
+	if (f == kFeatureCpuNEON)
+		return true;
+#endif
+
+	return ModularGraphicsBackend::hasFeature(f);
+}
+
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 #ifndef NULL_DRIVER_USE_FOR_TEST
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
@@ -189,9 +224,27 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#ifdef NULL_DRIVER_USE_PTHREADS
+	return createPthreadMutexInternal();
+#else
 	return new NullMutexInternal();
+#endif
+}
+
+#ifdef NULL_DRIVER_USE_PTHREADS
+Common::ThreadInternal *OSystem_NULL::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createPthreadThreadInternal(proc, param, name);
+}
+
+Common::ConditionVariableInternal *OSystem_NULL::createConditionVariable() {
+	return createPthreadConditionVariableInternal();
 }
 
+uint OSystem_NULL::getCPUCount() {
+	return getPthreadCPUCount();
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
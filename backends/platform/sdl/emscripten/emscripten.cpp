@@ -211,6 +211,19 @@ Common::MutexInternal *OSystem_Emscripten::createMutex() {
 	return new NullMutexInternal();
 }
 
+// The build does not enable pthreads, so fall back to the synchronous paths
+Common::ThreadInternal *OSystem_Emscripten::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return nullptr;
+}
+
+Common::ConditionVariableInternal *OSystem_Emscripten::createConditionVariable() {
+	return nullptr;
+}
+
+uint OSystem_Emscripten::getCPUCount() {
+	return 1;
+}
+
 void OSystem_Emscripten::addSysArchivesToSearchSet(Common::SearchSet &s, int priority) {
 	// Add the global DATA_PATH (and some sub-folders) to the directory search list 
 	// Note: gui-icons folder is added in GuiManager::initIconsSet 
@@ -53,6 +53,9 @@ public:
 	GraphicsManagerType getDefaultGraphicsManager() const override;
 #endif
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) override;
+	Common::ConditionVariableInternal *createConditionVariable() override;
+	uint getCPUCount() override;
 	void exportFile(const Common::Path &filename);
 	void delayMillis(uint msecs) override;
 	void init() override;
@@ -283,6 +283,31 @@ Common::Path OSystem_POSIX::getDefaultDLCsPath() {
 	return Common::Path(prefix).join(dlcsPath);
 }
 
+Common::Path OSystem_POSIX::getDefaultVideoCachePath() {
+	Common::String videoCachePath;
+
+	// On POSIX systems we follow the XDG Base Directory Specification for
+	// where to store files. The version we based our code upon can be found
+	// over here: https://specifications.freedesktop.org/basedir-spec/basedir-spec-0.8.html
+	const char *prefix = getenv("XDG_CACHE_HOME");
+	if (prefix == nullptr || !*prefix) {
+		prefix = getenv("HOME");
+		if (prefix == nullptr) {
+			return Common::Path();
+		}
+
+		videoCachePath = ".cache/";
+	}
+
+	videoCachePath += "scummvm/video";
+
+	if (!Posix::assureDirectoryExists(videoCachePath, prefix)) {
+		return Common::Path();
+	}
+
+	return Common::Path(prefix).join(videoCachePath);
+}
+
 Common::Path OSystem_POSIX::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	const Common::Path path = OSystem_SDL::getScreenshotsPath();
@@ -46,6 +46,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/thread/sdl/sdl-thread.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -399,6 +400,7 @@ void OSystem_SDL::initBackend() {
 
 	ConfMan.registerDefault("iconspath", this->getDefaultIconsPath());
 	ConfMan.registerDefault("dlcspath", this->getDefaultDLCsPath());
+	ConfMan.registerDefault("videocachepath", this->getDefaultVideoCachePath());
 
 	_inited = true;
 
@@ -876,6 +878,18 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(void (*proc)(void *param), void *param, const char *name) {
+	return createSdlThreadInternal(proc, param, name);
+}
+
+Common::ConditionVariableInternal *OSystem_SDL::createConditionVariable() {
+	return createSdlConditionVariableInternal();
+}
+
+uint OSystem_SDL::getCPUCount() {
+	return getSdlCPUCount();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
@@ -962,6 +976,11 @@ Common::Path OSystem_SDL::getDefaultDLCsPath() {
 	return path;
 }
 
+// Not specified in base class
+Common::Path OSystem_SDL::getDefaultVideoCachePath() {
+	return ConfMan.getPath("videocachepath");
+}
+
 //Not specified in base class
 Common::Path OSystem_SDL::getScreenshotsPath() {
 	return ConfMan.getPath("screenshotpath");
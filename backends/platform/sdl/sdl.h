@@ -89,6 +89,9 @@ public:
 	void setWindowCaption(const Common::U32String &caption) override;
 	void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) override;
+	Common::ConditionVariableInternal *createConditionVariable() override;
+	uint getCPUCount() override;
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
@@ -100,6 +103,7 @@ public:
 	// Default paths
 	virtual Common::Path getDefaultIconsPath();
 	virtual Common::Path getDefaultDLCsPath();
+	virtual Common::Path getDefaultVideoCachePath();
 	virtual Common::Path getScreenshotsPath();
 
 #if defined(USE_OPENGL_GAME) || defined(USE_OPENGL_SHADERS)
@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "backends/thread/pthread/pthread-thread.h"
+#include "common/textconsole.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * pthreads thread implementation
+ */
+class PthreadThreadInternal final : public Common::ThreadInternal {
+public:
+	PthreadThreadInternal(Common::ThreadProc proc, void *param) : _running(false), _proc(proc), _param(param) {}
+	~PthreadThreadInternal() override { join(); }
+
+	bool start() {
+		if (pthread_create(&_thread, nullptr, threadProc, this) != 0) {
+			warning("pthread_create() failed");
+			return false;
+		}
+		_running = true;
+		return true;
+	}
+
+	void join() override {
+		if (_running) {
+			if (pthread_join(_thread, nullptr) != 0)
+				warning("pthread_join() failed");
+			_running = false;
+		}
+	}
+
+private:
+	static void *threadProc(void *data) {
+		PthreadThreadInternal *thread = (PthreadThreadInternal *)data;
+		thread->_proc(thread->_param);
+		return nullptr;
+	}
+
+	pthread_t _thread;
+	bool _running;
+	Common::ThreadProc _proc;
+	void *_param;
+};
+
+/**
+ * pthreads condition variable implementation, with its own mutex
+ */
+class PthreadConditionVariableInternal final : public Common::ConditionVariableInternal {
+public:
+	PthreadConditionVariableInternal();
+	~PthreadConditionVariableInternal() override;
+
+	bool lock() override;
+	bool unlock() override;
+
+	void wait() override;
+	void notifyOne() override;
+	void notifyAll() override;
+
+private:
+	pthread_mutex_t _mutex;
+	pthread_cond_t _cond;
+};
+
+PthreadConditionVariableInternal::PthreadConditionVariableInternal() {
+	// Not recursive: pthread_cond_wait() only releases a single lock level
+	if (pthread_mutex_init(&_mutex, nullptr) != 0)
+		warning("pthread_mutex_init() failed");
+	if (pthread_cond_init(&_cond, nullptr) != 0)
+		warning("pthread_cond_init() failed");
+}
+
+PthreadConditionVariableInternal::~PthreadConditionVariableInternal() {
+	if (pthread_cond_destroy(&_cond) != 0)
+		warning("pthread_cond_destroy() failed");
+	if (pthread_mutex_destroy(&_mutex) != 0)
+		warning("pthread_mutex_destroy() failed");
+}
+
+bool PthreadConditionVariableInternal::lock() {
+	if (pthread_mutex_lock(&_mutex) != 0) {
+		warning("pthread_mutex_lock() failed");
+		return false;
+	} else {
+		return true;
+	}
+}
+
+bool PthreadConditionVariableInternal::unlock() {
+	if (pthread_mutex_unlock(&_mutex) != 0) {
+		warning("pthread_mutex_unlock() failed");
+		return false;
+	} else {
+		return true;
+	}
+}
+
+void PthreadConditionVariableInternal::wait() {
+	if (pthread_cond_wait(&_cond, &_mutex) != 0)
+		warning("pthread_cond_wait() failed");
+}
+
+void PthreadConditionVariableInternal::notifyOne() {
+	pthread_cond_signal(&_cond);
+}
+
+void PthreadConditionVariableInternal::notifyAll() {
+	pthread_cond_broadcast(&_cond);
+}
+
+Common::ThreadInternal *createPthreadThreadInternal(Common::ThreadProc proc, void *param, const char *name) {
+	PthreadThreadInternal *thread = new PthreadThreadInternal(proc, param);
+	if (!thread->start()) {
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::ConditionVariableInternal *createPthreadConditionVariableInternal() {
+	return new PthreadConditionVariableInternal();
+}
+
+uint getPthreadCPUCount() {
+#ifdef _SC_NPROCESSORS_ONLN
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 1 ? (uint)count : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/thread/sdl/sdl-thread.h"
+#include "backends/platform/sdl/sdl-sys.h"
+#include "common/textconsole.h"
+
+/**
+ * SDL thread
+ */
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *param) : _thread(nullptr), _proc(proc), _param(param) {}
+	~SdlThreadInternal() override { join(); }
+
+	bool start(const char *name) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_thread = SDL_CreateThread(threadProc, name, this);
+#else
+		_thread = SDL_CreateThread(threadProc, this);
+#endif
+		if (!_thread)
+			warning("Could not create thread '%s': %s", name, SDL_GetError());
+		return _thread != nullptr;
+	}
+
+	void join() override {
+		if (_thread) {
+			SDL_WaitThread(_thread, nullptr);
+			_thread = nullptr;
+		}
+	}
+
+private:
+	static int SDLCALL threadProc(void *data) {
+		SdlThreadInternal *thread = (SdlThreadInternal *)data;
+		thread->_proc(thread->_param);
+		return 0;
+	}
+
+	SDL_Thread *_thread;
+	Common::ThreadProc _proc;
+	void *_param;
+};
+
+/**
+ * SDL condition variable, with its own mutex
+ */
+class SdlConditionVariableInternal final : public Common::ConditionVariableInternal {
+public:
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SdlConditionVariableInternal() : _mutex(SDL_CreateMutex()), _cond(SDL_CreateCondition()) {}
+	~SdlConditionVariableInternal() override {
+		SDL_DestroyCondition(_cond);
+		SDL_DestroyMutex(_mutex);
+	}
+
+	bool lock() override { SDL_LockMutex(_mutex); return true; }
+	bool unlock() override { SDL_UnlockMutex(_mutex); return true; }
+
+	void wait() override { SDL_WaitCondition(_cond, _mutex); }
+	void notifyOne() override { SDL_SignalCondition(_cond); }
+	void notifyAll() override { SDL_BroadcastCondition(_cond); }
+#else
+	SdlConditionVariableInternal() : _mutex(SDL_CreateMutex()), _cond(SDL_CreateCond()) {}
+	~SdlConditionVariableInternal() override {
+		SDL_DestroyCond(_cond);
+		SDL_DestroyMutex(_mutex);
+	}
+
+	bool lock() override { return (SDL_mutexP(_mutex) == 0); }
+	bool unlock() override { return (SDL_mutexV(_mutex) == 0); }
+
+	void wait() override { SDL_CondWait(_cond, _mutex); }
+	void notifyOne() override { SDL_CondSignal(_cond); }
+	void notifyAll() override { SDL_CondBroadcast(_cond); }
+#endif
+
+	bool isValid() const { return _mutex && _cond; }
+
+private:
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Mutex *_mutex;
+	SDL_Condition *_cond;
+#else
+	SDL_mutex *_mutex;
+	SDL_cond *_cond;
+#endif
+};
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *param, const char *name) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, param);
+	if (!thread->start(name)) {
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::ConditionVariableInternal *createSdlConditionVariableInternal() {
+	SdlConditionVariableInternal *cond = new SdlConditionVariableInternal();
+	if (!cond->isValid()) {
+		warning("Could not create condition variable: %s", SDL_GetError());
+		delete cond;
+		return nullptr;
+	}
+	return cond;
+}
+
+uint getSdlCPUCount() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	const int count = SDL_GetNumLogicalCPUCores();
+#elif SDL_VERSION_ATLEAST(2, 0, 0)
+	const int count = SDL_GetCPUCount();
+#else
+	const int count = 1;
+#endif
+	return count > 1 ? count : 1;
+}
+
+#endif
@@ -315,15 +315,18 @@ void registerDefaults() {
 	ConfMan.registerDefault("stretch_mode", "default");
 	ConfMan.registerDefault("scaler", "default");
 	ConfMan.registerDefault("scale_factor", -1);
+	ConfMan.registerDefault("scaler_threads", 0);
 	ConfMan.registerDefault("shader", Common::Path("default", Common::Path::kNoSeparator));
 	ConfMan.registerDefault("show_fps", false);
 	ConfMan.registerDefault("dirtyrects", true);
+	ConfMan.registerDefault("tinygl_threads", 0);
 	ConfMan.registerDefault("vsync", true);
 
 	// Sound & Music
 	ConfMan.registerDefault("music_volume", 192);
 	ConfMan.registerDefault("sfx_volume", 192);
 	ConfMan.registerDefault("speech_volume", 192);
+	ConfMan.registerDefault("resampler_quality", "fast");
 
 	ConfMan.registerDefault("music_mute", false);
 	ConfMan.registerDefault("sfx_mute", false);
@@ -387,6 +390,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 	ConfMan.registerDefault("disable_sdl_audio", false);
+	ConfMan.registerDefault("detection_cache", true);
 
 #ifdef ENABLE_EVENTRECORDER
 	ConfMan.registerDefault("disable_display", false);
@@ -1640,17 +1644,17 @@ static void dumpAllDetectionEntries() {
 }
 
 /** Display all games in the given directory, or current directory if empty */
-static DetectedGames getGameList(const Common::FSNode &dir) {
+static DetectedGames getGameList(const Common::FSNode &dir, DetectionSession &session) {
 	Common::FSList files;
 
 	// Collect all files from directory
-	if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+	if (!session.getChildren(dir, files)) {
 		printf("Path %s does not exist or is not a directory.\n", dir.getPath().toString(Common::Path::kNativeSeparator).c_str());
 		return DetectedGames();
 	}
 
 	// detect Games
-	DetectionResults detectionResults = EngineMan.detectGames(files);
+	DetectionResults detectionResults = EngineMan.detectGames(files, 0, false, &session);
 
 	if (detectionResults.foundUnknownGames()) {
 		Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
@@ -1660,14 +1664,14 @@ static DetectedGames getGameList(const Common::FSNode &dir) {
 	return detectionResults.listRecognizedGames();
 }
 
-static DetectedGames recListGames(const Common::FSNode &dir, const Common::String &engineId, const Common::String &gameId, bool recursive) {
-	DetectedGames list = getGameList(dir);
+static DetectedGames recListGames(const Common::FSNode &dir, const Common::String &engineId, const Common::String &gameId, bool recursive, DetectionSession &session) {
+	DetectedGames list = getGameList(dir, session);
 
 	if (recursive) {
 		Common::FSList files;
-		dir.getChildren(files, Common::FSNode::kListDirectoriesOnly);
+		session.getChildren(dir, files, Common::FSNode::kListDirectoriesOnly);
 		for (const auto &file : files) {
-			DetectedGames rec = recListGames(file, engineId, gameId, recursive);
+			DetectedGames rec = recListGames(file, engineId, gameId, recursive, session);
 			for (auto &game : rec) {
 				if ((game.engineId == engineId && game.gameId == gameId)
 				    || gameId.empty())
@@ -1684,7 +1688,9 @@ static Common::String detectGames(const Common::Path &path, const Common::String
 	bool noPath = path.empty();
 	//Current directory
 	Common::FSNode dir(path);
-	DetectedGames candidates = recListGames(dir, engineId, gameId, recursive);
+	DetectionSession session;
+	DetectedGames candidates = recListGames(dir, engineId, gameId, recursive, session);
+	ADCacheMan.saveFileCache(true);
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().toString(Common::Path::kNativeSeparator).c_str());
@@ -1709,9 +1715,9 @@ static Common::String detectGames(const Common::Path &path, const Common::String
 	return buildQualifiedGameName(candidates[0].engineId, candidates[0].gameId);
 }
 
-static int recAddGames(const Common::FSNode &dir, const Common::String &engineId, const Common::String &gameId, bool recursive) {
+static int recAddGames(const Common::FSNode &dir, const Common::String &engineId, const Common::String &gameId, bool recursive, DetectionSession &session) {
 	int count = 0;
-	DetectedGames list = getGameList(dir);
+	DetectedGames list = getGameList(dir, session);
 	for (const auto &v : list) {
 		if ((v.engineId != engineId || v.gameId != gameId)
 		    && !gameId.empty()) {
@@ -1739,9 +1745,9 @@ static int recAddGames(const Common::FSNode &dir, const Common::String &engineId
 
 	if (recursive) {
 		Common::FSList files;
-		if (dir.getChildren(files, Common::FSNode::kListDirectoriesOnly)) {
+		if (session.getChildren(dir, files, Common::FSNode::kListDirectoriesOnly)) {
 			for (const auto &file : files) {
-				count += recAddGames(file, engineId, gameId, recursive);
+				count += recAddGames(file, engineId, gameId, recursive, session);
 			}
 		}
 	}
@@ -1825,7 +1831,9 @@ static void calcMD5Mac(Common::Path &filePath, int32 length) {
 static bool addGames(const Common::Path &path, const Common::String &engineId, const Common::String &gameId, bool recursive) {
 	//Current directory
 	Common::FSNode dir(path);
-	int added = recAddGames(dir, engineId, gameId, recursive);
+	DetectionSession session;
+	int added = recAddGames(dir, engineId, gameId, recursive, session);
+	ADCacheMan.saveFileCache(true);
 	printf("Added %d games\n", added);
 	if (added == 0 && !recursive) {
 		printf("Consider using --recursive to search inside subdirectories\n");
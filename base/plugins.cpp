@@ -679,7 +679,7 @@ QualifiedGameList EngineManager::findGameInLoadedPlugins(const Common::String &g
 	return results;
 }
 
-DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32 skipADFlags, bool skipIncomplete) {
+DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32 skipADFlags, bool skipIncomplete, DetectionSession *session) {
 	DetectedGames candidates;
 
 	// MetaEngines are always loaded into memory, so, get them and
@@ -688,6 +688,7 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Clear md5 cache before each detection starts, just in case.
 	ADCacheMan.clear();
+	ADCacheMan.setSession(session);
 
 	// Iterate over all known games and for each check if it might be
 	// the game in the presented directory.
@@ -706,6 +707,8 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
+	ADCacheMan.setSession(nullptr);
+	ADCacheMan.saveFileCache();
 
 	return DetectionResults(candidates);
 }
@@ -252,6 +252,16 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Get the size and the last modification time of the file referred by
+	 * this node, without opening it. The time is only meant to be compared
+	 * with previously retrieved values, its unit depends on the backend.
+	 *
+	 * @return True if the information is available, false if the node is not
+	 *         a file or the backend does not support this.
+	 */
+	bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -293,6 +303,14 @@ public:
 	 * @return True if the directory was created, false otherwise.
 	 */
 	bool createDirectory() const;
+
+	/**
+	 * Delete the file referred by this node.
+	 *
+	 * @return True if the file was deleted, false if the node is not a
+	 *         file, or the backend does not support this.
+	 */
+	bool removeFile() const;
 };
 
 /**
@@ -40,6 +40,8 @@ MODULE_OBJS := \
 	encodings/singlebyte.o \
 	system.o \
 	textconsole.o \
+	thread.o \
+	threadpool.o \
 	text-to-speech.o \
 	tokenizer.o \
 	translation.o \
@@ -22,6 +22,7 @@
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/system.h"
+#include "common/thread.h"
 
 namespace Common {
 
@@ -56,6 +57,11 @@ StackLock::StackLock(const Mutex &mutex, const char *mutexName)
 	lock();
 }
 
+StackLock::StackLock(const ConditionVariable &cond, const char *mutexName)
+	: _mutex(cond._cond), _mutexName(mutexName) {
+	lock();
+}
+
 StackLock::~StackLock() {
 	unlock();
 }
@@ -35,6 +35,7 @@ namespace Common {
  * @{
  */
 
+class ConditionVariable;
 class Mutex;
 
 class MutexInternal {
@@ -57,6 +58,7 @@ class StackLock {
 public:
 	explicit StackLock(MutexInternal *mutex, const char *mutexName = nullptr);
 	explicit StackLock(const Mutex &mutex, const char *mutexName = nullptr);
+	explicit StackLock(const ConditionVariable &cond, const char *mutexName = nullptr);
 	~StackLock();
 };
 
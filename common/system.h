@@ -57,6 +57,8 @@ class Store;
 namespace Common {
 class EventManager;
 class MutexInternal;
+class ThreadInternal;
+class ConditionVariableInternal;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
@@ -1659,6 +1661,11 @@ public:
 	 *
 	 * Hence, backends that do not use threads to implement the timers can simply
 	 * use dummy implementations for these methods.
+	 *
+	 * Threads have since been reintroduced as an optional feature, so that work
+	 * such as scaling or decoding can be spread over several cores where the
+	 * platform allows it. The default implementations report no thread support,
+	 * and all users must keep working when that is the case.
 	 */
 
 	/**
@@ -1668,6 +1675,36 @@ public:
 	 */
 	virtual Common::MutexInternal *createMutex() = 0;
 
+	/**
+	 * Start a new thread running @p proc with @p param.
+	 *
+	 * Thread support is optional. Backends that do not provide it return
+	 * nullptr, and callers are expected to run the work synchronously
+	 * instead (see Common::Thread and Common::ThreadPool).
+	 *
+	 * @param proc   Procedure to run on the new thread.
+	 * @param param  Parameter passed to the procedure.
+	 * @param name   Name of the thread, for debugging purposes.
+	 *
+	 * @return The newly created thread, or nullptr if threads are not supported.
+	 */
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param, const char *name) { return nullptr; }
+
+	/**
+	 * Create a new condition variable together with its mutex.
+	 *
+	 * Backends that implement createThread() must implement this as well.
+	 *
+	 * @return The newly created condition variable, or nullptr if threads are not supported.
+	 */
+	virtual Common::ConditionVariableInternal *createConditionVariable() { return nullptr; }
+
+	/**
+	 * Return the number of logical CPU cores available to the application.
+	 * Used to size thread pools. Backends without thread support return 1.
+	 */
+	virtual uint getCPUCount() { return 1; }
+
 	/** @} */
 
 
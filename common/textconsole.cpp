@@ -50,6 +50,12 @@ void setErrorHandler(ErrorHandler handler) {
 	s_errorHandler = handler;
 }
 
+static thread_local LogRedirect *s_threadLogRedirect = nullptr;
+
+void setThreadLogRedirect(LogRedirect *redirect) {
+	s_threadLogRedirect = redirect;
+}
+
 
 } // End of namespace Common
 
@@ -65,6 +71,11 @@ void warning(const char *s, ...) {
 	output = Common::String::vformat(s, va);
 	va_end(va);
 
+	if (Common::s_threadLogRedirect) {
+		Common::s_threadLogRedirect->redirectWarning(output.c_str());
+		return;
+	}
+
 	if (Common::s_logWatcher)
    		(*Common::s_logWatcher)(LogMessageType::kWarning, 0, 0, output.c_str());
 
@@ -91,6 +102,10 @@ void NORETURN_PRE error(const char *s, ...) {
 	vsnprintf(buf_input, STRINGBUFLEN, s, va);
 	va_end(va);
 
+	// Should this return, fall back to handling the error on this thread
+	if (Common::s_threadLogRedirect)
+		Common::s_threadLogRedirect->redirectError(buf_input);
+
 
 	// Next, give the active engine (if any) a chance to augment the message
 	if (Common::s_errorOutputFormatter) {
@@ -72,6 +72,31 @@ typedef bool (*ErrorHandler)(const char *msg);
  */
 void setErrorHandler(ErrorHandler handler);
 
+/**
+ * Receives the warnings and the error of a worker thread instead of the text
+ * console, so that the thread owning the work can output them itself.
+ */
+class LogRedirect {
+public:
+	virtual ~LogRedirect() {}
+
+	/** Called by warning() with the message, before it is decorated. */
+	virtual void redirectWarning(const char *msg) = 0;
+
+	/**
+	 * Called by error() with the message, before it is decorated. This
+	 * should hand the message over and block the thread until the owning
+	 * thread calls error() with it. If it returns, error() goes on as usual.
+	 */
+	virtual void redirectError(const char *msg) = 0;
+};
+
+/**
+ * Redirect the warnings and errors of the calling thread, or stop doing so
+ * if @p redirect is nullptr. Other threads are not affected.
+ */
+void setThreadLogRedirect(LogRedirect *redirect);
+
 /** @} */
 
 } // End of namespace Common
@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/thread.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Thread::Thread(ThreadProc proc, void *param, const char *name) {
+	assert(g_system);
+	_thread = g_system->createThread(proc, param, name);
+	if (!_thread)
+		proc(param);
+}
+
+Thread::~Thread() {
+	join();
+}
+
+void Thread::join() {
+	if (_thread) {
+		_thread->join();
+		delete _thread;
+		_thread = nullptr;
+	}
+}
+
+
+#pragma mark -
+
+
+namespace {
+
+/**
+ * Condition variable used when the backend has no thread support.
+ * Only the mutex part is functional.
+ */
+class SyncConditionVariableInternal final : public ConditionVariableInternal {
+public:
+	SyncConditionVariableInternal() : _mutex(g_system->createMutex()) {}
+	~SyncConditionVariableInternal() override { delete _mutex; }
+
+	bool lock() override { return _mutex->lock(); }
+	bool unlock() override { return _mutex->unlock(); }
+
+	void wait() override { error("ConditionVariable::wait() called without thread support"); }
+	void notifyOne() override {}
+	void notifyAll() override {}
+
+private:
+	MutexInternal *_mutex;
+};
+
+} // End of anonymous namespace
+
+ConditionVariable::ConditionVariable() {
+	assert(g_system);
+	_cond = g_system->createConditionVariable();
+	if (!_cond)
+		_cond = new SyncConditionVariableInternal();
+}
+
+ConditionVariable::~ConditionVariable() {
+	delete _cond;
+}
+
+bool ConditionVariable::lock() {
+	return _cond->lock();
+}
+
+bool ConditionVariable::unlock() {
+	return _cond->unlock();
+}
+
+void ConditionVariable::wait() {
+	_cond->wait();
+}
+
+void ConditionVariable::notifyOne() {
+	_cond->notifyOne();
+}
+
+void ConditionVariable::notifyAll() {
+	_cond->notifyAll();
+}
+
+} // End of namespace Common
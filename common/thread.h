@@ -0,0 +1,120 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_thread Threads
+ * @ingroup common
+ *
+ * @brief API for running code on backend provided threads.
+ *
+ * Threads are optional: backends that cannot create them return nullptr
+ * from OSystem::createThread(), in which case Thread runs its procedure
+ * synchronously and ThreadPool executes tasks on the calling thread.
+ * Code using these classes must therefore not rely on two pieces of work
+ * actually running concurrently.
+ * @{
+ */
+
+/** Entry point of a thread. */
+typedef void (*ThreadProc)(void *param);
+
+class ThreadInternal {
+public:
+	virtual ~ThreadInternal() {}
+
+	/** Wait until the thread procedure has returned. */
+	virtual void join() = 0;
+};
+
+/**
+ * A condition variable bundled with the mutex protecting it.
+ *
+ * wait() must only be called while the mutex is locked. It atomically
+ * releases the mutex, blocks until notified and locks it again before
+ * returning. Spurious wake-ups are possible, so callers must re-check their
+ * condition in a loop.
+ */
+class ConditionVariableInternal : public MutexInternal {
+public:
+	virtual void wait() = 0;
+	virtual void notifyOne() = 0;
+	virtual void notifyAll() = 0;
+};
+
+/**
+ * Wrapper class around OSystem::createThread().
+ *
+ * The thread is started by the constructor and joined by join() or the
+ * destructor. If the backend has no thread support, the procedure is run
+ * to completion inside the constructor.
+ */
+class Thread : NonCopyable {
+	ThreadInternal *_thread;
+
+public:
+	Thread(ThreadProc proc, void *param, const char *name = "ScummVM");
+	~Thread();
+
+	/** Wait for the thread to finish. Does nothing if it already has. */
+	void join();
+
+	/** Return true if the procedure really runs on a separate thread. */
+	bool isAsync() const { return _thread != nullptr; }
+};
+
+/**
+ * Wrapper class around OSystem::createConditionVariable().
+ *
+ * On backends without thread support this degrades to a plain mutex, and
+ * wait() is an error since nobody could ever notify the waiter.
+ */
+class ConditionVariable : NonCopyable {
+	friend class StackLock;
+
+	ConditionVariableInternal *_cond;
+
+public:
+	ConditionVariable();
+	~ConditionVariable();
+
+	bool lock();
+	bool unlock();
+
+	void wait();
+	void notifyOne();
+	void notifyAll();
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
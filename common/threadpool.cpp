@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/threadpool.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+void FutureStateBase::wait() {
+	_pool->waitFor(this);
+}
+
+ThreadPool::ThreadPool(uint numThreads, const char *name) : _pending(0), _quit(false) {
+	assert(g_system);
+
+	if (numThreads == 0) {
+		numThreads = g_system->getCPUCount();
+
+		// A single core gains nothing from a worker thread
+		if (numThreads <= 1)
+			return;
+	}
+
+	for (uint i = 0; i < numThreads; i++) {
+		ThreadInternal *thread = g_system->createThread(workerProc, this, name);
+		if (!thread)
+			break;
+
+		_threads.push_back(thread);
+	}
+
+	if (!_threads.empty() && _threads.size() < numThreads)
+		warning("ThreadPool: Only %u of %u worker threads could be created", _threads.size(), numThreads);
+}
+
+ThreadPool::~ThreadPool() {
+	wait();
+
+	_cond.lock();
+	_quit = true;
+	_cond.notifyAll();
+	_cond.unlock();
+
+	for (uint i = 0; i < _threads.size(); i++) {
+		_threads[i]->join();
+		delete _threads[i];
+	}
+}
+
+void ThreadPool::push(Task *task) {
+	if (_threads.empty()) {
+		task->run();
+		task->complete();
+		delete task;
+		return;
+	}
+
+	StackLock lock(_cond);
+	_queue.push(task);
+	_pending++;
+	_cond.notifyOne();
+}
+
+void ThreadPool::runTask() {
+	// Called and returns with the lock held
+	Task *task = _queue.pop();
+
+	_cond.unlock();
+	task->run();
+	_cond.lock();
+
+	task->complete();
+	delete task;
+	_pending--;
+	_cond.notifyAll();
+}
+
+void ThreadPool::wait() {
+	StackLock lock(_cond);
+	while (_pending) {
+		if (!_queue.empty())
+			runTask();
+		else
+			_cond.wait();
+	}
+}
+
+void ThreadPool::waitFor(const FutureStateBase *state) {
+	StackLock lock(_cond);
+	while (!state->_ready) {
+		if (!_queue.empty())
+			runTask();
+		else
+			_cond.wait();
+	}
+}
+
+void ThreadPool::workerProc(void *param) {
+	ThreadPool *pool = (ThreadPool *)param;
+
+	StackLock lock(pool->_cond);
+	for (;;) {
+		if (!pool->_queue.empty())
+			pool->runTask();
+		else if (pool->_quit)
+			break;
+		else
+			pool->_cond.wait();
+	}
+}
+
+} // End of namespace Common
@@ -0,0 +1,275 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/ptr.h"
+#include "common/queue.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief Fixed size pool of worker threads.
+ * @{
+ */
+
+class ThreadPool;
+
+/**
+ * State shared between a Future and the pool task computing its value.
+ * It is only ever touched by the pool under its lock, except for the
+ * value itself which the task writes before the state becomes ready.
+ */
+class FutureStateBase : NonCopyable {
+	friend class ThreadPool;
+
+protected:
+	ThreadPool *_pool;
+	bool _ready;
+
+	explicit FutureStateBase(ThreadPool *pool) : _pool(pool), _ready(false) {}
+
+public:
+	/** Block until the task has finished, helping the pool meanwhile. */
+	void wait();
+};
+
+template<typename T>
+class FutureState : public FutureStateBase {
+public:
+	explicit FutureState(ThreadPool *pool) : FutureStateBase(pool), _value() {}
+	~FutureState() { wait(); }
+
+	T _value;
+};
+
+template<>
+class FutureState<void> : public FutureStateBase {
+public:
+	explicit FutureState(ThreadPool *pool) : FutureStateBase(pool) {}
+	~FutureState() { wait(); }
+};
+
+/**
+ * Result of a task submitted with ThreadPool::async().
+ *
+ * Futures are cheap to copy. Destroying the last copy waits for the task,
+ * so a discarded Future never leaves a task writing to freed memory.
+ * Since the reference count is not atomic, a Future and its copies must
+ * stay on a single thread, and must not outlive the pool that created them.
+ */
+template<typename T>
+class Future {
+	SharedPtr<FutureState<T> > _state;
+
+public:
+	Future() {}
+	explicit Future(const SharedPtr<FutureState<T> > &state) : _state(state) {}
+
+	/** Return true if the future is attached to a task. */
+	bool isValid() const { return (bool)_state; }
+
+	/** Block until the task has finished. */
+	void wait() const {
+		if (_state)
+			_state->wait();
+	}
+
+	/** Block until the task has finished and return its result. */
+	const T &get() const {
+		assert(_state);
+		_state->wait();
+		return _state->_value;
+	}
+};
+
+template<>
+class Future<void> {
+	SharedPtr<FutureState<void> > _state;
+
+public:
+	Future() {}
+	explicit Future(const SharedPtr<FutureState<void> > &state) : _state(state) {}
+
+	bool isValid() const { return (bool)_state; }
+
+	void wait() const {
+		if (_state)
+			_state->wait();
+	}
+
+	void get() const { wait(); }
+};
+
+/**
+ * A fixed number of worker threads executing tasks from a shared queue.
+ *
+ * Tasks are any copyable callables, typically lambdas. Threads blocking
+ * in wait(), Future::wait() or parallelFor() run queued tasks themselves
+ * while they wait, so tasks may safely submit and wait for other tasks.
+ *
+ * When the backend has no thread support, or the pool is created with a
+ * single thread on a single core machine, every task runs synchronously
+ * inside submit() and async(), and the pool behaves like a plain loop.
+ */
+class ThreadPool : NonCopyable {
+	friend class FutureStateBase;
+
+public:
+	/**
+	 * Create a new pool.
+	 *
+	 * @param numThreads  Number of worker threads, or 0 to use one per CPU core.
+	 * @param name        Name given to the worker threads.
+	 */
+	explicit ThreadPool(uint numThreads = 0, const char *name = "ScummVM worker");
+
+	/** Wait for all pending tasks, then stop the worker threads. */
+	~ThreadPool();
+
+	/** Return the number of worker threads, 0 if tasks run synchronously. */
+	uint getThreadCount() const { return _threads.size(); }
+
+	/** Return true if tasks really run on separate threads. */
+	bool isAsync() const { return !_threads.empty(); }
+
+	/** Queue @p func for execution. */
+	template<typename F>
+	void submit(const F &func) {
+		push(new FuncTask<F>(func));
+	}
+
+	/**
+	 * Queue @p func for execution and return a Future holding its result.
+	 * The result type must be default constructible and copy assignable.
+	 */
+	template<typename F>
+	auto async(const F &func) -> Future<decltype(func())> {
+		typedef decltype(func()) R;
+
+		SharedPtr<FutureState<R> > state(new FutureState<R>(this));
+		push(new AsyncTask<F, R>(func, state.get()));
+		return Future<R>(state);
+	}
+
+	/** Block until every task submitted so far has finished. */
+	void wait();
+
+	/**
+	 * Call @p func(i) for every i in [begin, end), splitting the range into
+	 * contiguous chunks spread over the pool. The calling thread processes
+	 * the first chunk and returns once all chunks are done.
+	 */
+	template<typename F>
+	void parallelFor(int begin, int end, const F &func) {
+		if (begin >= end)
+			return;
+
+		const int count = end - begin;
+		const int chunks = isAsync() ? MIN<int>(count, (getThreadCount() + 1) * 4) : 1;
+
+		Array<Future<void> > futures;
+		futures.reserve(chunks - 1);
+		for (int c = 1; c < chunks; c++) {
+			const int first = begin + (int)((int64)count * c / chunks);
+			const int last = begin + (int)((int64)count * (c + 1) / chunks);
+			futures.push_back(async([&func, first, last]() {
+				for (int i = first; i < last; i++)
+					func(i);
+			}));
+		}
+
+		const int last = begin + count / chunks;
+		for (int i = begin; i < last; i++)
+			func(i);
+
+		for (uint i = 0; i < futures.size(); i++)
+			futures[i].wait();
+	}
+
+private:
+	class Task {
+	public:
+		virtual ~Task() {}
+
+		/** Called on the executing thread without the pool lock. */
+		virtual void run() = 0;
+		/** Called once run() returned, with the pool lock held. */
+		virtual void complete() {}
+	};
+
+	template<typename F>
+	class FuncTask : public Task {
+		F _func;
+
+	public:
+		explicit FuncTask(const F &func) : _func(func) {}
+		void run() override { _func(); }
+	};
+
+	template<typename F, typename R>
+	class AsyncTask : public Task {
+		F _func;
+		FutureState<R> *_state;
+
+	public:
+		AsyncTask(const F &func, FutureState<R> *state) : _func(func), _state(state) {}
+		void run() override { _state->_value = _func(); }
+		void complete() override { _state->_ready = true; }
+	};
+
+	template<typename F>
+	class AsyncTask<F, void> : public Task {
+		F _func;
+		FutureState<void> *_state;
+
+	public:
+		AsyncTask(const F &func, FutureState<void> *state) : _func(func), _state(state) {}
+		void run() override { _func(); }
+		void complete() override { _state->_ready = true; }
+	};
+
+	void push(Task *task);
+	void runTask();
+	void waitFor(const FutureStateBase *state);
+
+	static void workerProc(void *param);
+
+	ConditionVariable _cond;
+	Array<ThreadInternal *> _threads;
+	Queue<Task *> _queue;
+	uint _pending;
+	bool _quit;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
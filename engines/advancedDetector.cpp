@@ -30,6 +30,7 @@
 #include "common/punycode.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 #include "common/compression/clickteam.h"
@@ -464,7 +465,7 @@ void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, cons
 				continue;
 
 			Common::FSList files;
-			if (!file.getChildren(files, Common::FSNode::kListAll))
+			if (!ADCacheMan.getChildren(file, files))
 				continue;
 
 			composeFileHashMap(allFiles, files, depth - 1, tstr);
@@ -490,6 +491,181 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+DetectionSession::DetectionSession() {
+}
+
+DetectionSession::~DetectionSession() {
+}
+
+bool DetectionSession::getChildren(const Common::FSNode &dir, Common::FSList &list, Common::FSNode::ListMode mode) {
+	const Common::String key = dir.getPath().toString(Common::Path::kNativeSeparator);
+
+	if (!_listings.contains(key)) {
+		Common::FSList children;
+		if (!dir.getChildren(children, Common::FSNode::kListAll))
+			return false;
+		_listings.setVal(key, children);
+	}
+
+	for (const auto &child : _listings.getVal(key)) {
+		if (mode == Common::FSNode::kListAll || (mode == Common::FSNode::kListDirectoriesOnly) == child.isDirectory())
+			list.push_back(child);
+	}
+	return true;
+}
+
+bool DetectionSession::getFileProperties(const Common::String &key, FileProperties &fileProps) const {
+	PropertiesMap::const_iterator it = _fileProps.find(key);
+	if (it == _fileProps.end())
+		return false;
+
+	fileProps = it->_value;
+	return true;
+}
+
+void DetectionSession::setFileProperties(const Common::String &key, const FileProperties &fileProps) {
+	_fileProps.setVal(key, fileProps);
+}
+
+enum {
+	/** Maximum number of threads used to hash files during detection */
+	kDetectionThreads = 8,
+	/** Maximum number of files kept open at once while hashing them */
+	kDetectionOpenFiles = 64
+};
+
+Common::ThreadPool *DetectionSession::getThreadPool() {
+	if (!_threadPool)
+		_threadPool.reset(new Common::ThreadPool(kDetectionThreads, "ScummVM detection"));
+	return _threadPool.get();
+}
+
+static const char *const kDetectionCacheHeader = "# ScummVM detection cache v1";
+
+Common::Path AdvancedDetectorCacheManager::getFileCachePath() const {
+	if (!g_system || !ConfMan.getBool("detection_cache"))
+		return Common::Path();
+
+	// Keep the cache next to the configuration file
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::Path();
+
+	return configFile.getParent().appendComponent("detection.cache");
+}
+
+/**
+ * Read the tab terminated field starting at @p pos of a detection cache
+ * line, and move @p pos past it. Returns false if there is none.
+ */
+static bool nextCacheField(const Common::String &line, uint &pos, Common::String &field) {
+	const size_t end = line.find('\t', pos);
+	if (end == Common::String::npos || end == pos)
+		return false;
+
+	field = line.substr(pos, end - pos);
+	pos = end + 1;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::loadFileCache() {
+	fileCacheLoaded = true;
+
+	const Common::Path path = getFileCachePath();
+	if (path.empty())
+		return;
+
+	const Common::FSNode node(path);
+	Common::File file;
+	if (!node.exists() || !file.open(node))
+		return;
+
+	if (file.readLine() != kDetectionCacheHeader) {
+		warning("Ignoring detection cache '%s' with unknown format", path.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	// Each line holds: file size, modification time, size, MD5 and key,
+	// separated by tabs. The key goes last as it contains the file path.
+	while (!file.eos() && !file.err()) {
+		const Common::String line = file.readLine();
+
+		uint pos = 0;
+		Common::String fileSize, modTime, size, md5;
+		if (!nextCacheField(line, pos, fileSize) || !nextCacheField(line, pos, modTime) ||
+		    !nextCacheField(line, pos, size) || !nextCacheField(line, pos, md5) || pos >= line.size())
+			continue;
+
+		FileCacheEntry entry;
+		entry.fileSize = (int64)fileSize.asUint64();
+		entry.modTime = (int64)modTime.asUint64();
+		entry.size = (int64)size.asUint64();
+		entry.md5 = md5;
+
+		fileCacheMap.setVal(line.substr(pos), entry);
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %d entries from the detection cache", fileCacheMap.size());
+}
+
+bool AdvancedDetectorCacheManager::getFileProperties(const Common::String &key, int64 fileSize, int64 modTime, FileProperties &fileProps) {
+	if (!fileCacheLoaded)
+		loadFileCache();
+
+	const FileCacheMap::const_iterator it = fileCacheMap.find(key);
+	if (it == fileCacheMap.end() || it->_value.fileSize != fileSize || it->_value.modTime != modTime)
+		return false;
+
+	fileProps.size = it->_value.size;
+	fileProps.md5 = it->_value.md5;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::setFileProperties(const Common::String &key, int64 fileSize, int64 modTime, const FileProperties &fileProps) {
+	if (!fileCacheLoaded)
+		loadFileCache();
+
+	FileCacheEntry &entry = fileCacheMap[key];
+	entry.fileSize = fileSize;
+	entry.modTime = modTime;
+	entry.size = fileProps.size;
+	entry.md5 = fileProps.md5;
+	fileCacheDirty = true;
+}
+
+void AdvancedDetectorCacheManager::saveFileCache(bool force) {
+	if (!fileCacheDirty)
+		return;
+
+	// Rewriting the whole file for every directory scanned would be quadratic
+	const uint32 now = g_system->getMillis();
+	if (!force && fileCacheSaveTime != 0 && now - fileCacheSaveTime < 10000)
+		return;
+
+	fileCacheDirty = false;
+	fileCacheSaveTime = now;
+
+	const Common::Path path = getFileCachePath();
+	if (path.empty())
+		return;
+
+	Common::ScopedPtr<Common::SeekableWriteStream> stream(Common::FSNode(path).createWriteStream());
+	if (!stream) {
+		warning("Could not write detection cache '%s'", path.toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	stream->writeString(Common::String(kDetectionCacheHeader) + "\n");
+	for (const auto &entry : fileCacheMap) {
+		stream->writeString(Common::String::format("%lld\t%lld\t%lld\t%s\t%s\n",
+			(long long)entry._value.fileSize, (long long)entry._value.modTime, (long long)entry._value.size,
+			entry._value.md5.c_str(), entry._key.c_str()));
+	}
+	stream->finalize();
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -551,26 +727,209 @@ Common::String md5PropToGameFile(MD5Properties flags) {
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps);
 
 bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
-	Common::String hashname = md5PropToCachePrefix(md5prop);
-		hashname += ':';
-		hashname += fname.toString('/');
-		hashname += ':';
-		hashname += Common::String::format("%d", _md5Bytes);
-
-	if (ADCacheMan.containsMD5(hashname)) {
-		fileProps.md5 = ADCacheMan.getMD5(hashname);
-		fileProps.size = ADCacheMan.getSize(hashname);
-		return true;
+	Common::Array<FilePropertiesRequest> requests;
+	requests.push_back(FilePropertiesRequest(md5prop, fname));
+
+	getFileProperties(allFiles, requests);
+
+	fileProps = requests[0].props;
+	return requests[0].found;
+}
+
+/** State of a request while it goes through the caches. */
+struct FilePropertiesLookup {
+	Common::String hashname;	///< Key in the per directory cache
+	Common::String pathKey;		///< Key in the session and persistent caches, empty if not applicable
+	bool hasFileInfo;			///< Whether fileSize and modTime are valid
+	int64 fileSize;
+	int64 modTime;
+	uint task;					///< Index of the FileHashTask reading the file
+
+	FilePropertiesLookup() : hasFileInfo(false), fileSize(0), modTime(0), task(0) {}
+};
+
+/**
+ * A file hashed on a worker thread. FSNode and String objects must not be
+ * shared between threads, so the file is opened beforehand and the worker
+ * only gets this plain struct and a stream of its own.
+ */
+struct FileHashTask {
+	uint request;		///< First request for the file, used to open it
+	bool wantHead;
+	bool wantTail;
+	bool opened;
+	Common::SeekableReadStream *stream;
+	int64 size;
+	uint8 head[16];
+	uint8 tail[16];
+
+	FileHashTask() : request(0), wantHead(false), wantTail(false), opened(false), stream(nullptr), size(0) {}
+};
+
+static void hashFile(FileHashTask &task, uint md5Bytes) {
+	task.size = task.stream->size();
+
+	if (task.wantHead)
+		Common::computeStreamMD5(*task.stream, task.head, md5Bytes);
+
+	if (task.wantTail) {
+		task.stream->seek(task.size > md5Bytes ? task.size - md5Bytes : 0);
+		Common::computeStreamMD5(*task.stream, task.tail, md5Bytes);
 	}
+}
 
-	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
+static Common::String md5DigestToString(const uint8 digest[16]) {
+	Common::String md5;
+	for (int i = 0; i < 16; i++)
+		md5 += Common::String::format("%02x", (int)digest[i]);
+	return md5;
+}
+
+void AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles, Common::Array<FilePropertiesRequest> &requests) const {
+	Common::Array<FilePropertiesLookup> lookups;
+	lookups.resize(requests.size());
+	Common::Array<uint> pending;
+	Common::Array<FileHashTask> tasks;
+	Common::HashMap<Common::String, uint> taskMap;
+
+	for (uint i = 0; i < requests.size(); i++) {
+		FilePropertiesRequest &request = requests[i];
+		FilePropertiesLookup &lookup = lookups[i];
+
+		lookup.hashname = md5PropToCachePrefix(request.md5prop);
+		lookup.hashname += ':';
+		lookup.hashname += request.fname.toString('/');
+		lookup.hashname += ':';
+		lookup.hashname += Common::String::format("%d", _md5Bytes);
+
+		if (ADCacheMan.containsMD5(lookup.hashname)) {
+			request.props.md5 = ADCacheMan.getMD5(lookup.hashname);
+			request.props.size = ADCacheMan.getSize(lookup.hashname);
+			request.found = true;
+			continue;
+		}
+
+		// Archive members and Mac forks are read through other files and
+		// archives, which are shared between requests: handle them here.
+		if ((request.md5prop & (kMD5MacResFork | kMD5MacDataFork | kMD5Archive)) || !allFiles.contains(request.fname)) {
+			request.found = getFilePropertiesIntern(_md5Bytes, allFiles, request.md5prop, request.fname, request.props);
+			if (request.found) {
+				ADCacheMan.setMD5(lookup.hashname, request.props.md5);
+				ADCacheMan.setSize(lookup.hashname, request.props.size);
+			}
+			continue;
+		}
 
-	if (res) {
-		ADCacheMan.setMD5(hashname, fileProps.md5);
-		ADCacheMan.setSize(hashname, fileProps.size);
+		// Plain files are identified by their actual path, so that results
+		// can be shared between engines and between scanned directories
+		const Common::FSNode &node = allFiles[request.fname];
+		const Common::String nodePath = node.getPath().toString(Common::Path::kNativeSeparator);
+		lookup.pathKey = md5PropToCachePrefix(request.md5prop);
+		lookup.pathKey += Common::String::format(":%d:", _md5Bytes);
+		lookup.pathKey += nodePath;
+
+		DetectionSession *session = ADCacheMan.getSession();
+		if (session && session->getFileProperties(lookup.pathKey, request.props)) {
+			request.found = true;
+			ADCacheMan.setMD5(lookup.hashname, request.props.md5);
+			ADCacheMan.setSize(lookup.hashname, request.props.size);
+			continue;
+		}
+
+		// Then check the persistent cache, which avoids reading them again
+		// if they did not change since the last detection
+		lookup.hasFileInfo = node.getFileInfo(lookup.fileSize, lookup.modTime);
+		if (lookup.hasFileInfo && ADCacheMan.getFileProperties(lookup.pathKey, lookup.fileSize, lookup.modTime, request.props)) {
+			request.props.md5prop = (MD5Properties)(request.md5prop & kMD5Tail);
+			request.found = true;
+			ADCacheMan.setMD5(lookup.hashname, request.props.md5);
+			ADCacheMan.setSize(lookup.hashname, request.props.size);
+			if (session)
+				session->setFileProperties(lookup.pathKey, request.props);
+			continue;
+		}
+
+		// Read every file only once, even if it is requested several times
+		// or both its head and tail are needed
+		Common::HashMap<Common::String, uint>::const_iterator task = taskMap.find(nodePath);
+		if (task == taskMap.end()) {
+			lookup.task = tasks.size();
+			taskMap.setVal(nodePath, lookup.task);
+			tasks.push_back(FileHashTask());
+			tasks.back().request = i;
+		} else {
+			lookup.task = task->_value;
+		}
+
+		if (request.md5prop & kMD5Tail)
+			tasks[lookup.task].wantTail = true;
+		else
+			tasks[lookup.task].wantHead = true;
+
+		pending.push_back(i);
 	}
 
-	return res;
+	// Reading the files is the slow part, especially from network shares,
+	// so spread them over several threads. A session keeps its pool for
+	// the whole scan instead of starting threads for every engine.
+	DetectionSession *session = ADCacheMan.getSession();
+	Common::ScopedPtr<Common::ThreadPool> ownPool;
+	Common::ThreadPool *pool = nullptr;
+	if (tasks.size() > 1) {
+		if (session) {
+			pool = session->getThreadPool();
+		} else {
+			ownPool.reset(new Common::ThreadPool(MIN<uint>(tasks.size(), kDetectionThreads), "ScummVM detection"));
+			pool = ownPool.get();
+		}
+	}
+
+	const uint md5Bytes = _md5Bytes;
+	for (uint first = 0; first < tasks.size(); first += kDetectionOpenFiles) {
+		const uint last = MIN<uint>(first + kDetectionOpenFiles, tasks.size());
+
+		for (uint t = first; t < last; t++) {
+			const Common::FSNode &node = allFiles[requests[tasks[t].request].fname];
+			if (node.exists() && !node.isDirectory())
+				tasks[t].stream = node.createReadStream();
+			tasks[t].opened = (tasks[t].stream != nullptr);
+		}
+
+		auto hash = [&tasks, md5Bytes](int t) {
+			if (tasks[t].stream)
+				hashFile(tasks[t], md5Bytes);
+		};
+		if (pool)
+			pool->parallelFor(first, last, hash);
+		else
+			hash(first);
+
+		for (uint t = first; t < last; t++) {
+			delete tasks[t].stream;
+			tasks[t].stream = nullptr;
+		}
+	}
+
+	for (uint i = 0; i < pending.size(); i++) {
+		FilePropertiesRequest &request = requests[pending[i]];
+		const FilePropertiesLookup &lookup = lookups[pending[i]];
+		const FileHashTask &task = tasks[lookup.task];
+
+		if (!task.opened)
+			continue;
+
+		request.props.size = task.size;
+		request.props.md5 = md5DigestToString((request.md5prop & kMD5Tail) ? task.tail : task.head);
+		request.props.md5prop = (MD5Properties)(request.md5prop & kMD5Tail);
+		request.found = true;
+
+		ADCacheMan.setMD5(lookup.hashname, request.props.md5);
+		ADCacheMan.setSize(lookup.hashname, request.props.size);
+		if (session)
+			session->setFileProperties(lookup.pathKey, request.props);
+		if (lookup.hasFileInfo)
+			ADCacheMan.setFileProperties(lookup.pathKey, lookup.fileSize, lookup.modTime, request.props);
+	}
 }
 
 bool AdvancedMetaEngineBase::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
@@ -734,6 +1093,8 @@ ADDetectedGames AdvancedMetaEngineDetectionBase::detectGame(const Common::FSNode
 
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
+	Common::Array<FilePropertiesRequest> requests;
+	Common::StringArray requestKeys;
 	for (descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
 		g = (const ADGameDescription *)descPtr;
 
@@ -747,17 +1108,23 @@ ADDetectedGames AdvancedMetaEngineDetectionBase::detectGame(const Common::FSNode
 			if (filesProps.contains(key))
 				continue;
 
-			FileProperties tmp;
-			if (getFileProperties(allFiles, md5prop, Common::Path(fname), tmp)) {
-				debugC(3, kDebugGlobalDetection, "> '%s': '%s' %ld", key.c_str(), tmp.md5.c_str(), long(tmp.size));
-			}
-
 			// Both positive and negative results are cached to avoid
 			// repeatedly checking for files.
-			filesProps[key] = tmp;
+			filesProps[key] = FileProperties();
+			requests.push_back(FilePropertiesRequest(md5prop, Common::Path(fname)));
+			requestKeys.push_back(key);
 		}
 	}
 
+	getFileProperties(allFiles, requests);
+
+	for (uint r = 0; r < requests.size(); r++) {
+		if (requests[r].found)
+			debugC(3, kDebugGlobalDetection, "> '%s': '%s' %ld", requestKeys[r].c_str(), requests[r].props.md5.c_str(), long(requests[r].props.size));
+
+		filesProps[requestKeys[r]] = requests[r].props;
+	}
+
 	int maxFilesMatched = 0;
 	int maxCandidateFiles = 0;
 	bool gotAnyMatchesWithAllFiles = false;
@@ -26,12 +26,14 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/ptr.h"
 
 #include "common/gui_options.h" // Keep it here, so detection tables can refer to them
 
 namespace Common {
 class Error;
 class FSList;
+class ThreadPool;
 }
 /**
  * @defgroup engines_advdetector Advanced Detector
@@ -598,6 +600,22 @@ protected:
 	/** Get the properties (size and MD5) of this file. */
 	bool getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const;
 
+	/** A file whose properties are requested from getFileProperties(). */
+	struct FilePropertiesRequest {
+		MD5Properties md5prop;
+		Common::Path fname;
+		FileProperties props; /*!< Result, valid if found is true. */
+		bool found;
+
+		FilePropertiesRequest(MD5Properties prop, const Common::Path &name) : md5prop(prop), fname(name), found(false) {}
+	};
+
+	/**
+	 * Get the properties of several files at once. Files which are not in
+	 * the detection caches are hashed in parallel where possible.
+	 */
+	void getFileProperties(const FileMap &allFiles, Common::Array<FilePropertiesRequest> &requests) const;
+
 	/** Convert an AD game description into the shared game description format. */
 	virtual DetectedGame toDetectedGame(const ADDetectedGame &adGame, ADDetectedGameExtraInfo *extraInfo = nullptr) const;
 
@@ -743,11 +761,74 @@ private:
 	using AdvancedMetaEngineBase::createInstance;
 };
 
+/**
+ * State shared by all engines while detecting games, owned by the caller.
+ *
+ * Every engine lists the directories it looks into and gets the properties
+ * of the files it knows about, so without a session the same directories
+ * are listed, and the same files hashed, once per engine and per scanned
+ * directory. A session remembers both, keyed by native path, until it is
+ * destroyed.
+ *
+ * Create one for a whole scan, like a mass add, and pass it to each call
+ * to EngineManager::detectGames(). It assumes the files do not change while
+ * it exists.
+ */
+class DetectionSession : Common::NonCopyable {
+public:
+	DetectionSession();
+	~DetectionSession();
+
+	/**
+	 * List the contents of @p dir, like FSNode::getChildren() with hidden
+	 * files. Only the first listing of a directory goes to the file system.
+	 */
+	bool getChildren(const Common::FSNode &dir, Common::FSList &list, Common::FSNode::ListMode mode = Common::FSNode::kListAll);
+
+	/** Look up properties computed earlier in this session. */
+	bool getFileProperties(const Common::String &key, FileProperties &fileProps) const;
+
+	/** Remember the properties of a file. */
+	void setFileProperties(const Common::String &key, const FileProperties &fileProps);
+
+	/**
+	 * Get the pool hashing files, which is created on first use and then
+	 * kept for the whole scan.
+	 */
+	Common::ThreadPool *getThreadPool();
+
+private:
+	typedef Common::HashMap<Common::String, Common::FSList> ListingMap;
+	typedef Common::HashMap<Common::String, FileProperties> PropertiesMap;
+	ListingMap _listings;
+	PropertiesMap _fileProps;
+	Common::ScopedPtr<Common::ThreadPool> _threadPool;
+};
+
 /**
  * Singleton Cache Storage for Computed MD5s and Open Archives
  */
 class AdvancedDetectorCacheManager : public Common::Singleton<AdvancedDetectorCacheManager> {
 public:
+	/**
+	 * Use @p session, which may be nullptr, for the following detections.
+	 * The caller has to reset it before the session is destroyed.
+	 */
+	void setSession(DetectionSession *session) {
+		detectionSession = session;
+	}
+
+	DetectionSession *getSession() const {
+		return detectionSession;
+	}
+
+	/** List the contents of @p dir, through the current session if any. */
+	bool getChildren(const Common::FSNode &dir, Common::FSList &list) const {
+		if (detectionSession)
+			return detectionSession->getChildren(dir, list);
+		return dir.getChildren(list, Common::FSNode::kListAll);
+	}
+
 	void setMD5(const Common::String &fname, const Common::String &md5) {
 		md5HashMap.setVal(fname, md5);
 	}
@@ -785,7 +866,28 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Look up the properties of a file on disk in the persistent cache. The
+	 * entry is only used if the size and modification time of the file are
+	 * still the ones it was computed for.
+	 *
+	 * @param key          Path of the file and the kind of MD5 computed.
+	 * @param fileSize     Current size of the file on disk.
+	 * @param modTime      Current modification time of the file.
+	 */
+	bool getFileProperties(const Common::String &key, int64 fileSize, int64 modTime, FileProperties &fileProps);
+
+	/** Store the properties of a file on disk in the persistent cache. */
+	void setFileProperties(const Common::String &key, int64 fileSize, int64 modTime, const FileProperties &fileProps);
+
+	/**
+	 * Write the persistent cache to disk if it has changed. Unless @p force
+	 * is set, this is throttled so that repeated detections, like during
+	 * mass add, do not rewrite the file for every directory.
+	 */
+	void saveFileCache(bool force = false);
+
+	AdvancedDetectorCacheManager() : detectionSession(nullptr), fileCacheLoaded(false), fileCacheDirty(false), fileCacheSaveTime(0) {
 		clear();
 	}
 
@@ -811,6 +913,24 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+	DetectionSession *detectionSession;
+
+	struct FileCacheEntry {
+		int64 fileSize;
+		int64 modTime;
+		int64 size;
+		Common::String md5;
+	};
+
+	/** Persistent cache, keyed by the native path of the file. Not affected by clear(). */
+	typedef Common::HashMap<Common::String, FileCacheEntry> FileCacheMap;
+	FileCacheMap fileCacheMap;
+	bool fileCacheLoaded;
+	bool fileCacheDirty;
+	uint32 fileCacheSaveTime;
+
+	Common::Path getFileCachePath() const;
+	void loadFileCache();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
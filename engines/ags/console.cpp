@@ -25,6 +25,7 @@
 #include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_common.h"
+#include "ags/engine/script/script.h"
 #include "graphics/palette.h"
 #include "image/png.h"
 
@@ -34,6 +35,7 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_script_bench", WRAP_METHOD(AGSConsole, Cmd_scriptBench));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
 
@@ -185,6 +187,32 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_scriptBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [times]\n", argv[0]);
+		debugPrintf("Runs " REP_EXEC_NAME " of the game and the script modules, and prints how long it took\n");
+		return true;
+	}
+
+	if (!_G(gameinst)) {
+		debugPrintf("The game scripts are not loaded\n");
+		return true;
+	}
+
+	const int times = (argc == 2) ? atoi(argv[1]) : 1000;
+	const uint32 start = g_system->getMillis();
+	int ran = 0;
+	for (; ran < times && !_G(abort_engine); ++ran)
+		AGS3::RunScriptFunctionAuto(AGS3::kScInstGame, REP_EXEC_NAME);
+	const uint32 elapsed = g_system->getMillis() - start;
+
+	debugPrintf("Ran " REP_EXEC_NAME " %d times in %u ms", ran, elapsed);
+	if (ran > 0)
+		debugPrintf(", %u us each", (uint)((uint64)elapsed * 1000 / ran));
+	debugPrintf("\n");
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
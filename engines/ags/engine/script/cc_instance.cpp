@@ -158,6 +158,24 @@ struct ScriptCommands {
 };
 static ScriptCommands *g_commands;
 
+// Operations which the executor runs besides the plain instructions,
+// made when the byte-code is pre-decoded
+enum ScriptDecodedOpCode {
+	// LITTOREG with the argument fixed up in advance, Args[1] is its index in the values
+	kScDecLitToRegValue = CC_NUM_SCCMDS,
+	// LITTOREG and WRITELIT with a fixup which is applied when run
+	kScDecLitToRegFixup,
+	kScDecWriteLitFixup,
+	// Fused pairs of instructions
+	kScDecLitToRegPushReg,      // LITTOREG reg, lit; PUSHREG reg
+	kScDecLoadSpOffsMemRead,    // LOADSPOFFS off; MEMREAD reg
+	kScDecLoadSpOffsMemWrite,   // LOADSPOFFS off; MEMWRITE reg
+	kScDecLitToMarMemRead,      // LITTOREG mar, value; MEMREAD reg
+	kScDecLitToMarMemWrite      // LITTOREG mar, value; MEMWRITE reg
+};
+
+static bool DecodeOperation(const ccInstance &inst, const int32_t at_pc, ScriptDecodedOp &op, std::vector<RuntimeScriptValue> *values);
+
 void script_commands_init() {
 	g_commands = new ScriptCommands();
 }
@@ -560,7 +578,10 @@ int ccInstance::Run(int32_t curpc) {
 	thisbase[0] = 0;
 	funcstart[0] = pc;
 	ccInstance *codeInst = runningInst;
-	ScriptOperation codeOp;
+	if (!codeInst->decoded_code)
+		codeInst->DecodeCode();
+	ScriptDecodedOp *const ops = &codeInst->decoded_code->Ops[0];
+	const RuntimeScriptValue *const values = codeInst->decoded_code->Values.data();
 	FunctionCallStack func_callstack;
 #if DEBUG_CC_EXEC
 	const bool dump_opcodes = (ccGetOption(SCOPT_DEBUGRUN) != 0) ||
@@ -583,56 +604,42 @@ int ccInstance::Run(int32_t curpc) {
 		//
 		/* Read operation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		CC_ERROR_IF_RETCODE((codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS),
-							"invalid instruction %d found in code stream", codeOp.Instruction.Code);
-
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-
-		CC_ERROR_IF_RETCODE(pc + codeOp.ArgCount >= codeInst->codesize,
-							"unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-
-
-		// Read arguments; use switch as it proved to be faster than the loop
-
-		switch (codeOp.ArgCount) {
-		case 3:
-			codeOp.Args[2].SetInt32(static_cast<int32_t>(codeInst->code[pc + 3]));
-			/* fall-through */
-		case 2:
-			codeOp.Args[1].SetInt32(static_cast<int32_t>(codeInst->code[pc + 2]));
-			/* fall-through */
-		case 1:
-			codeOp.Args[0].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1]));
-			break;
-		default:
-			break;
+		// The operations were decoded when the script was loaded, except
+		// where the code was not expected to be run
+		if (ops[pc].Code < 0 && !DecodeOperation(*codeInst, pc, ops[pc], nullptr)) {
+			cc_error("invalid instruction %d found in code stream", static_cast<int32_t>(codeInst->code[pc] & INSTANCE_ID_REMOVEMASK));
+			return -1;
 		}
+		const ScriptDecodedOp &op = ops[pc];
 		//---------------------------------------------------------------------
 		/* End read operation */
 		//=====================================================================
 
 #if (DEBUG_CC_EXEC)
 		if (dump_opcodes) {
+			// Dump the instruction as it is in the byte-code
+			ScriptOperation codeOp;
+			codeOp.Instruction.Code = static_cast<int32_t>(codeInst->code[pc] & INSTANCE_ID_REMOVEMASK);
+			codeOp.Instruction.InstanceId = op.InstanceId;
+			codeOp.ArgCount = op.Length - 1;
+			for (int i = 0; i < codeOp.ArgCount; ++i)
+				codeOp.Args[i].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1 + i]));
 			DumpInstruction(codeOp);
 		}
 #endif
 
 		/* Perform operation */
 		//=====================================================================
-		switch (codeOp.Instruction.Code) {
+		switch (op.Code) {
 		case SCMD_LINENUM:
-			line_number = codeOp.Arg1i();
+			line_number = op.Args[0];
 			_G(currentline) = line_number;
 			if (_G(new_line_hook))
 				_G(new_line_hook)(this, _G(currentline));
 			break;
 		case SCMD_ADD: {
-			const auto arg_reg = codeOp.Arg1i();
-			const auto arg_lit = codeOp.Arg2i();
+			const auto arg_reg = op.Args[0];
+			const auto arg_lit = op.Args[1];
 			auto &reg1 = registers[arg_reg];
 			// If the register is SREG_SP, we are allocating new variable on the stack
 			if (arg_reg == SREG_SP) {
@@ -656,8 +663,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_SUB: {
-			const auto arg_reg = codeOp.Arg1i();
-			const auto arg_lit = codeOp.Arg2i();
+			const auto arg_reg = op.Args[0];
+			const auto arg_lit = op.Args[1];
 			auto &reg1 = registers[arg_reg];
 			if (reg1.Type == kScValStackPtr) {
 				// If this is SREG_SP, this is stack pop, which frees local variables;
@@ -679,22 +686,25 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_REGTOREG: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
-			auto &reg2 = registers[codeOp.Arg2i()];
+			const auto &reg1 = registers[op.Args[0]];
+			auto &reg2 = registers[op.Args[1]];
 			reg2 = reg1;
 			break;
 		}
-		case SCMD_WRITELIT: {
+		case SCMD_WRITELIT:
+		case kScDecWriteLitFixup: {
 			// Take the data address from reg[MAR] and copy there arg1 bytes from arg2 address
 			//
 			// NOTE: since it reads directly from arg2 (which originally was
 			// long, or rather int32 due x32 build), written value may normally
 			// be only up to 4 bytes large;
 			// I guess that's an obsolete way to do WRITE, WRITEW and WRITEB
-			const auto arg_size = codeOp.Arg1i();
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
-			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
+			const auto arg_size = op.Args[0];
+			RuntimeScriptValue arg_value(op.Args[1]);
+			if (op.Code == kScDecWriteLitFixup) {
+				FixupArgument(arg_value, codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+				ASSERT_CC_ERROR();
+			}
 			switch (arg_size) {
 			case sizeof(char):
 				registers[SREG_MAR].WriteByte(arg_value.IValue);
@@ -728,40 +738,50 @@ int ccInstance::Run(int32_t curpc) {
 			continue; // continue so that the PC doesn't get overwritten
 		}
 		case SCMD_LITTOREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+			auto &reg1 = registers[op.Args[0]];
+			reg1.SetInt32(op.Args[1]);
+			break;
+		}
+		case kScDecLitToRegValue: {
+			auto &reg1 = registers[op.Args[0]];
+			reg1 = values[op.Args[1]];
+			break;
+		}
+		case kScDecLitToRegFixup: {
+			auto &reg1 = registers[op.Args[0]];
+			RuntimeScriptValue arg_value;
+			FixupArgument(arg_value, codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
 			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
 			reg1 = arg_value;
 			break;
 		}
 		case SCMD_MEMREAD: {
 			// Take the data address from reg[MAR] and copy int32_t to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			reg1 = registers[SREG_MAR].ReadValue();
 			break;
 		}
 		case SCMD_MEMWRITE: {
 			// Take the data address from reg[MAR] and copy there int32_t from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			registers[SREG_MAR].WriteValue(reg1);
 			break;
 		}
 		case SCMD_LOADSPOFFS: {
-			const auto arg_off = codeOp.Arg1i();
+			const auto arg_off = op.Args[0];
 			registers[SREG_MAR] = GetStackPtrOffsetRw(arg_off);
 			ASSERT_CC_ERROR();
 			break;
 		}
 		case SCMD_MULREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue * reg2.IValue);
 			break;
 		}
 		case SCMD_DIVREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
@@ -770,88 +790,88 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_ADDREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue += reg2.IValue;
 			break;
 		}
 		case SCMD_SUBREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue -= reg2.IValue;
 			break;
 		}
 		case SCMD_BITAND: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue & reg2.IValue);
 			break;
 		}
 		case SCMD_BITOR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue | reg2.IValue);
 			break;
 		}
 		case SCMD_ISEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1 == reg2);
 			break;
 		}
 		case SCMD_NOTEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1 != reg2);
 			break;
 		}
 		case SCMD_GREATER: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue > reg2.IValue);
 			break;
 		}
 		case SCMD_LESSTHAN: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue < reg2.IValue);
 			break;
 		}
 		case SCMD_GTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue >= reg2.IValue);
 			break;
 		}
 		case SCMD_LTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue <= reg2.IValue);
 			break;
 		}
 		case SCMD_AND: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue && reg2.IValue);
 			break;
 		}
 		case SCMD_OR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32AsBool(reg1.IValue || reg2.IValue);
 			break;
 		}
 		case SCMD_XORREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue ^ reg2.IValue);
 			break;
 		}
 		case SCMD_MODREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
@@ -860,7 +880,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NOTREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			reg1 = !(reg1);
 			break;
 		}
@@ -875,9 +895,9 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			ASSERT_STACK_SPACE_VALS(1);
-			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp.ArgCount + 1));
+			PushValueToStack(RuntimeScriptValue().SetInt32(pc + op.Length));
 
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			if (thisbase[curnest] == 0)
 				pc = reg1.IValue;
 			else {
@@ -897,55 +917,55 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_MEMREADB: {
 			// Take the data address from reg[MAR] and copy byte to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			reg1.SetUInt8(registers[SREG_MAR].ReadByte());
 			break;
 		}
 		case SCMD_MEMREADW: {
 			// Take the data address from reg[MAR] and copy int16_t to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			reg1.SetInt16(registers[SREG_MAR].ReadInt16());
 			break;
 		}
 		case SCMD_MEMWRITEB: {
 			// Take the data address from reg[MAR] and copy there byte from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			registers[SREG_MAR].WriteByte(reg1.IValue);
 			break;
 		}
 		case SCMD_MEMWRITEW: {
 			// Take the data address from reg[MAR] and copy there int16_t from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			registers[SREG_MAR].WriteInt16(reg1.IValue);
 			break;
 		}
 		case SCMD_JZ: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			if (registers[SREG_AX].IsNull())
 				pc += arg_lit;
 			break;
 		}
 		case SCMD_JNZ: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			if (!registers[SREG_AX].IsNull())
 				pc += arg_lit;
 			break;
 		}
 		case SCMD_PUSHREG: {
 			// Push reg[arg1] value to the stack
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			ASSERT_STACK_SPACE_VALS(1);
 			PushValueToStack(reg1);
 			break;
 		}
 		case SCMD_POPREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			ASSERT_STACK_SIZE(1);
 			reg1 = PopValueFromStack();
 			break;
 		}
 		case SCMD_JMP: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			pc += arg_lit;
 
 			// Make sure it's not stuck in a While loop
@@ -970,14 +990,14 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_MUL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[op.Args[0]];
+			const auto arg_lit = op.Args[1];
 			reg1.IValue *= arg_lit;
 			break;
 		}
 		case SCMD_CHECKBOUNDS: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			const auto &reg1 = registers[op.Args[0]];
+			const auto arg_lit = op.Args[1];
 			if ((reg1.IValue < 0) ||
 				(reg1.IValue >= arg_lit)) {
 				cc_error("!Array index out of bounds (index: %d, bounds: 0..%d)", reg1.IValue, arg_lit - 1);
@@ -986,7 +1006,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_DYNAMICBOUNDS: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			// TODO: test reg[MAR] type here;
 			// That might be dynamic object, but also a non-managed dynamic array, "allocated"
 			// on global or local memspace (buffer)
@@ -1009,7 +1029,7 @@ int ccInstance::Run(int32_t curpc) {
 			// 64 bit: Handles are always 32 bit values. They are not C pointer.
 
 		case SCMD_MEMREADPTR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			// FIXME: make pool return a ready RuntimeScriptValue with these set?
 			// or another struct, which may be assigned to RSV
@@ -1021,7 +1041,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_MEMWRITEPTR: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			void *address;
 			switch (reg1.Type) {
@@ -1060,7 +1080,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_MEMINITPTR: {
 			void *address;
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 
 			switch (reg1.Type) {
 			case kScValStaticArray:
@@ -1119,7 +1139,7 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			break;
 		case SCMD_CHECKNULLREG: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			if (reg1.IsNull()) {
 				cc_error("!Null string referenced");
 				return -1;
@@ -1127,7 +1147,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NUMFUNCARGS: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			num_args_to_func = arg_lit;
 			break;
 		}
@@ -1135,7 +1155,7 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			// Call to a function in another script
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 
 			// If there are nested CALLAS calls, the stack might
 			// contain 2 calls worth of parameters, so only
@@ -1158,7 +1178,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = op.InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			uintptr_t callAddr = reg1.PtrU8 - reinterpret_cast<uint8_t *>(&runningInst->code[0]);
@@ -1186,7 +1206,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_CALLEXT: {
 			// Call to a real 'C' code function
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 
 			was_just_callas = -1;
 			if (num_args_to_func < 0) {
@@ -1253,12 +1273,12 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_PUSHREAL: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			PushToFuncCallStack(func_callstack, reg1);
 			break;
 		}
 		case SCMD_SUBREALSTACK: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			PopFromFuncCallStack(func_callstack, arg_lit);
 			if (was_just_callas >= 0) {
 				ASSERT_STACK_SIZE(arg_lit);
@@ -1269,7 +1289,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_CALLOBJ: {
 			// set the OP register
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[op.Args[0]];
 			if (reg1.IsNull()) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1299,26 +1319,26 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_SHIFTLEFT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue << reg2.IValue);
 			break;
 		}
 		case SCMD_SHIFTRIGHT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetInt32(reg1.IValue >> reg2.IValue);
 			break;
 		}
 		case SCMD_THISBASE: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = op.Args[0];
 			thisbase[curnest] = arg_lit;
 			break;
 		}
 		case SCMD_NEWARRAY: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_elsize = codeOp.Arg2i();
-			const auto arg_managed = codeOp.Arg3().GetAsBool();
+			auto &reg1 = registers[op.Args[0]];
+			const auto arg_elsize = op.Args[1];
+			const auto arg_managed = (op.Args[2] != 0);
 			int numElements = reg1.IValue;
 			if (numElements < 1) {
 				cc_error("invalid size for dynamic array; requested: %d, range: 1..%d", numElements, INT32_MAX);
@@ -1329,8 +1349,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NEWUSEROBJECT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_size = codeOp.Arg2i();
+			auto &reg1 = registers[op.Args[0]];
+			const auto arg_size = op.Args[1];
 			if (arg_size < 0) {
 				cc_error("Invalid size for user object; requested: %d (or %d), range: 0..%d", arg_size, arg_size, INT_MAX);
 				return -1;
@@ -1340,26 +1360,26 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_FADD: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[op.Args[0]];
+			const auto arg_lit = op.Args[1];
 			reg1.SetFloat(reg1.FValue + arg_lit); // arg2 was used as int here originally
 			break;
 		}
 		case SCMD_FSUB: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[op.Args[0]];
+			const auto arg_lit = op.Args[1];
 			reg1.SetFloat(reg1.FValue - arg_lit); // arg2 was used as int here originally
 			break;
 		}
 		case SCMD_FMULREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloat(reg1.FValue * reg2.FValue);
 			break;
 		}
 		case SCMD_FDIVREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			if (reg2.FValue == 0.0) {
 				cc_error("!Floating point divide by zero");
 				return -1;
@@ -1368,43 +1388,43 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_FADDREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloat(reg1.FValue + reg2.FValue);
 			break;
 		}
 		case SCMD_FSUBREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloat(reg1.FValue - reg2.FValue);
 			break;
 		}
 		case SCMD_FGREATER: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloatAsBool(reg1.FValue > reg2.FValue);
 			break;
 		}
 		case SCMD_FLESSTHAN: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloatAsBool(reg1.FValue < reg2.FValue);
 			break;
 		}
 		case SCMD_FGTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloatAsBool(reg1.FValue >= reg2.FValue);
 			break;
 		}
 		case SCMD_FLTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			reg1.SetFloatAsBool(reg1.FValue <= reg2.FValue);
 			break;
 		}
 		case SCMD_ZEROMEMORY: {
-			const auto arg_size = codeOp.Arg1i();
+			const auto arg_size = op.Args[0];
 			// Check if we are zeroing at stack tail
 			if (registers[SREG_MAR] == registers[SREG_SP]) {
 				// creating a local variable -- check the stack to ensure no mem overrun
@@ -1421,15 +1441,15 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_CREATESTRING: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[op.Args[0]];
 			const char *ptr = reinterpret_cast<const char *>(reg1.GetDirectPtr());
 			DynObjectRef ref = ScriptString::Create(ptr);
 			reg1.SetScriptObject(ref.Obj, &_GP(myScriptStringImpl));
 			break;
 		}
 		case SCMD_STRINGSEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1441,8 +1461,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_STRINGSNOTEQ: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[op.Args[0]];
+			const auto &reg2 = registers[op.Args[1]];
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1457,14 +1477,47 @@ int ccInstance::Run(int32_t curpc) {
 			if (loopIterationCheckDisabled == 0)
 				loopIterationCheckDisabled++;
 			break;
+		case kScDecLitToRegPushReg: {
+			auto &reg1 = registers[op.Args[0]];
+			reg1.SetInt32(op.Args[1]);
+			ASSERT_STACK_SPACE_VALS(1);
+			PushValueToStack(reg1);
+			break;
+		}
+		case kScDecLoadSpOffsMemRead: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(op.Args[0]);
+			ASSERT_CC_ERROR();
+			auto &reg1 = registers[op.Args[1]];
+			reg1 = registers[SREG_MAR].ReadValue();
+			break;
+		}
+		case kScDecLoadSpOffsMemWrite: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(op.Args[0]);
+			ASSERT_CC_ERROR();
+			const auto &reg1 = registers[op.Args[1]];
+			registers[SREG_MAR].WriteValue(reg1);
+			break;
+		}
+		case kScDecLitToMarMemRead: {
+			registers[SREG_MAR] = values[op.Args[0]];
+			auto &reg1 = registers[op.Args[1]];
+			reg1 = registers[SREG_MAR].ReadValue();
+			break;
+		}
+		case kScDecLitToMarMemWrite: {
+			registers[SREG_MAR] = values[op.Args[0]];
+			const auto &reg1 = registers[op.Args[1]];
+			registers[SREG_MAR].WriteValue(reg1);
+			break;
+		}
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			cc_error("instruction %d is not implemented", op.Code);
 			return -1;
 		}
 		/* End perform operation */
 		//=====================================================================
 
-		pc += codeOp.ArgCount + 1;
+		pc += op.Length;
 	}
 	return 0;
 }
@@ -1651,6 +1704,7 @@ bool ccInstance::_Create(PScript scri, const ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		decoded_code = joined->decoded_code;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1740,6 +1794,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	decoded_code.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1950,9 +2005,121 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+
+	// The code does not change anymore now
+	DecodeCode();
 	return true;
 }
 
+// Decodes the instruction at the given position in the byte-code;
+// arguments which can be fixed up in advance are added to `values`,
+// unless that is null. Returns false if there is no valid instruction.
+static bool DecodeOperation(const ccInstance &inst, const int32_t at_pc, ScriptDecodedOp &op, std::vector<RuntimeScriptValue> *values) {
+	const int32_t instr = static_cast<int32_t>(inst.code[at_pc]);
+	const int32_t instr_code = instr & INSTANCE_ID_REMOVEMASK;
+	if (instr_code < 0 || instr_code >= CC_NUM_SCCMDS)
+		return false;
+	const int arg_count = (*g_commands)[instr_code].ArgCount;
+	if (at_pc + arg_count >= inst.codesize)
+		return false;
+
+	op.InstanceId = static_cast<uint8_t>((instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK);
+	op.Length = static_cast<uint8_t>(arg_count + 1);
+	for (int i = 0; i < arg_count; ++i)
+		op.Args[i] = static_cast<int32_t>(inst.code[at_pc + 1 + i]);
+	op.Code = static_cast<int16_t>(instr_code);
+
+	// These are the only instructions with a fixed up argument
+	if (instr_code == SCMD_LITTOREG || instr_code == SCMD_WRITELIT) {
+		const int fixup = inst.code_fixups[at_pc + 2];
+		switch (fixup) {
+		case FIXUP_NOFIXUP:
+		case FIXUP_FUNCTION:
+			// a plain integer
+			break;
+		case FIXUP_GLOBALDATA:
+		case FIXUP_STRING:
+			if (values && instr_code == SCMD_LITTOREG) {
+				RuntimeScriptValue value;
+				FixupArgument(value, fixup, inst.code[at_pc + 2], nullptr, inst.strings);
+				op.Code = kScDecLitToRegValue;
+				op.Args[1] = static_cast<int32_t>(values->size());
+				values->push_back(value);
+				break;
+			}
+			// fall-through
+		default:
+			// the stack and imports can only be looked up when run
+			op.Code = (instr_code == SCMD_LITTOREG) ? kScDecLitToRegFixup : kScDecWriteLitFixup;
+			break;
+		}
+	}
+	return true;
+}
+
+#if (!DEBUG_CC_EXEC)
+// Replaces the first operation with one doing both, if they are a common pair
+static void FuseOperations(ScriptDecodedOp &first, const ScriptDecodedOp &second) {
+	int16_t fused;
+	switch (first.Code) {
+	case SCMD_LITTOREG:
+		if (second.Code != SCMD_PUSHREG || second.Args[0] != first.Args[0])
+			return;
+		fused = kScDecLitToRegPushReg;
+		break;
+	case SCMD_LOADSPOFFS:
+		if (second.Code == SCMD_MEMREAD)
+			fused = kScDecLoadSpOffsMemRead;
+		else if (second.Code == SCMD_MEMWRITE)
+			fused = kScDecLoadSpOffsMemWrite;
+		else
+			return;
+		first.Args[1] = second.Args[0];
+		break;
+	case kScDecLitToRegValue:
+		if (first.Args[0] != SREG_MAR)
+			return;
+		if (second.Code == SCMD_MEMREAD)
+			fused = kScDecLitToMarMemRead;
+		else if (second.Code == SCMD_MEMWRITE)
+			fused = kScDecLitToMarMemWrite;
+		else
+			return;
+		first.Args[0] = first.Args[1];
+		first.Args[1] = second.Args[0];
+		break;
+	default:
+		return;
+	}
+	first.Code = fused;
+	first.Length += second.Length;
+}
+#endif
+
+void ccInstance::DecodeCode() {
+	decoded_code.reset(new ScriptDecodedCode());
+	std::vector<ScriptDecodedOp> &ops = decoded_code->Ops;
+	ops.resize(codesize);
+
+	// Anything after an invalid instruction is left to the executor, which
+	// only reports it when it gets there
+	int32_t at_pc = 0;
+	while (at_pc < codesize && DecodeOperation(*this, at_pc, ops[at_pc], &decoded_code->Values))
+		at_pc += ops[at_pc].Length;
+
+#if (!DEBUG_CC_EXEC)
+	// The second instruction of a fused pair keeps its own operation,
+	// for the jumps which land on it. Not done when debugging, so that
+	// every instruction can be dumped.
+	for (int32_t first_pc = 0; first_pc < at_pc;) {
+		const int32_t next_pc = first_pc + ops[first_pc].Length;
+		if (next_pc < at_pc)
+			FuseOperations(ops[first_pc], ops[next_pc]);
+		first_pc = next_pc;
+	}
+#endif
+}
+
 void ccInstance::PushValueToStack(const RuntimeScriptValue &rval) {
 	// Write value to the stack tail and advance stack ptr
 	registers[SREG_SP].WriteValue(rval);
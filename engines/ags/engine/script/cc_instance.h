@@ -24,6 +24,7 @@
 
 #include "common/std/memory.h"
 #include "common/std/map.h"
+#include "common/std/vector.h"
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/script/cc_internal.h"
 #include "ags/shared/script/cc_script.h"  // ccScript
@@ -83,6 +84,24 @@ struct ScriptOperation {
 	inline int Arg3i() const { return Args[2].IValue; }
 };
 
+// Operation pre-decoded from the byte-code, which is what the executor runs;
+// see ccInstance::DecodeCode()
+struct ScriptDecodedOp {
+	int16_t Code = -1;      // instruction code or a fused operation, -1 if not decoded
+	uint8_t InstanceId = 0;
+	uint8_t Length = 0;     // number of code elements the operation takes
+	int32_t Args[MAX_SCMD_ARGS] = {};
+};
+
+// Pre-decoded byte-code, shared between the instance and its forks
+struct ScriptDecodedCode {
+	// An operation for each position in the byte-code, so that it is found by
+	// the program counter; only positions which start an instruction are decoded
+	std::vector<ScriptDecodedOp> Ops;
+	// Arguments which were fixed up to something else than an integer
+	std::vector<RuntimeScriptValue> Values;
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -154,6 +173,7 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	std::shared_ptr<ScriptDecodedCode> decoded_code;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -208,6 +228,9 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Pre-decode the byte-code for the executor, applying the fixups which
+	// do not depend on the running state and fusing common pairs of instructions
+	void    DecodeCode();
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
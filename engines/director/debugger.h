@@ -73,6 +73,10 @@ public:
 	~Debugger();
 	void debugLogFile(Common::String logs, bool prompt);
 	void stepHook();
+	/** Whether stepHook() has anything to do, so that it can be skipped for every instruction otherwise. */
+	bool isStepHookActive() const { return _step || _finish || _bpCheckFunc || _bpCheckMoviePath; }
+	bool isVarReadHookActive() const { return _bpCheckVarRead; }
+	bool isVarWriteHookActive() const { return _bpCheckVarWrite; }
 	void frameHook();
 	void movieHook();
 	void eventHook(LEvent eventId);
@@ -481,12 +481,14 @@ void Lingo::initBuiltIns(const BuiltinProto protos[]) {
 			break;
 		}
 	}
+	invalidateBuiltinHandles();
 }
 
 void Lingo::cleanupBuiltIns() {
 	_builtinCmds.clear();
 	_builtinFuncs.clear();
 	_builtinConsts.clear();
+	invalidateBuiltinHandles();
 }
 
 void Lingo::cleanupBuiltIns(const BuiltinProto protos[]) {
@@ -508,6 +510,34 @@ void Lingo::cleanupBuiltIns(const BuiltinProto protos[]) {
 			break;
 		}
 	}
+	invalidateBuiltinHandles();
+}
+
+const Symbol *Lingo::getBuiltinHandle(const Common::String &name, bool allowRetVal) {
+	BuiltinHandleHash &handles = allowRetVal ? _builtinFuncHandles : _builtinCmdHandles;
+	BuiltinHandleHash::const_iterator it = handles.find(name);
+	if (it == handles.end())
+		return nullptr;
+
+	// A handler of the same name in the calling script or in another
+	// movie could override the builtin
+	if (it->_value.context != _state->context || it->_value.movie != _vm->getCurrentMovie())
+		return nullptr;
+
+	return it->_value.sym;
+}
+
+void Lingo::setBuiltinHandle(const Common::String &name, bool allowRetVal, const Symbol *sym) {
+	BuiltinHandle &handle = (allowRetVal ? _builtinFuncHandles : _builtinCmdHandles)[name];
+	handle.sym = sym;
+	handle.context = _state->context;
+	handle.movie = _vm->getCurrentMovie();
+}
+
+void Lingo::invalidateBuiltinHandles() {
+	// Whenever handlers are defined, or builtins added or removed
+	_builtinFuncHandles.clear();
+	_builtinCmdHandles.clear();
 }
 
 void Lingo::printArgs(const char *funcname, int nargs, const char *prefix) {
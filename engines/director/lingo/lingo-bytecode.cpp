@@ -1707,6 +1707,7 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 					_assemblyArchive->functionHandlers[it._key] = it._value;
 				}
 			}
+			g_lingo->invalidateBuiltinHandles();
 		}
 	}
 
@@ -103,7 +103,8 @@ static const struct FuncDescr {
 	{ LC::c_le,				"c_le",				"" },
 	{ LC::c_lineToOf,		"c_lineToOf",		"" },	// D3
 	{ LC::c_lineToOfRef,	"c_lineToOfRef",	"" },	// D3
-	{ LC::c_localpush,		"c_localpush",		"s" },
+	{ LC::c_localassign,	"c_localassign",	"i" },
+	{ LC::c_localpush,		"c_localpush",		"i" },
 	{ LC::c_localrefpush,	"c_localrefpush",	"s" },
 	{ LC::c_lt,				"c_lt",				"" },
 	{ LC::c_mod,			"c_mod",			"" },
@@ -279,6 +280,12 @@ void Lingo::pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRet
 		}
 	}
 
+	// The compiled code reaches the arguments and then the locals by their
+	// index in these slots. They point into localVars, whose entries stay
+	// in place while the hash grows, so that both see the same values.
+	uint argCount = funcSym.argNames ? funcSym.argNames->size() : 0;
+	fp->localSlots.resize(argCount + (funcSym.varNames ? funcSym.varNames->size() : 0));
+
 	if (funcSym.argNames) {
 		if (funcSym.argNames->size() > fp->paramList.size()) {
 			debugC(1, kDebugLingoExec, "%d arg names defined for %d args! Ignoring the last %d names", funcSym.argNames->size(), fp->paramList.size(), funcSym.argNames->size() - fp->paramList.size());
@@ -295,16 +302,18 @@ void Lingo::pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRet
 			} else {
 				warning("Argument %s already defined", name.c_str());
 			}
+			fp->localSlots[i] = &localvars->getVal(name);
 		}
 	}
 	if (funcSym.varNames) {
-		for (auto &it : *funcSym.varNames) {
-			Common::String name = it;
+		for (uint i = 0; i < funcSym.varNames->size(); i++) {
+			Common::String name = (*funcSym.varNames)[i];
 			if (!localvars->contains(name)) {
 				(*localvars)[name] = Datum();
 			} else {
 				warning("Variable %s already defined", name.c_str());
 			}
+			fp->localSlots[argCount + i] = &localvars->getVal(name);
 		}
 	}
 	_state->localVars = localvars;
@@ -551,27 +560,25 @@ void LC::c_proprefpush() {
 }
 
 void LC::c_varpush() {
-	LC::c_varrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetch(name, VARREF));
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetch(name, GLOBALREF));
 }
 
 void LC::c_localpush() {
-	LC::c_localrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	int slot = g_lingo->readInt();
+	if (g_debugger->isVarReadHookActive())
+		g_debugger->varReadHook(g_lingo->localSlotName(slot));
+	g_lingo->push(g_lingo->localSlot(slot));
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetch(name, PROPREF));
 }
 
 void LC::c_stackpeek() {
@@ -594,6 +601,13 @@ void LC::c_assign() {
 	g_lingo->varAssign(d1, d2);
 }
 
+void LC::c_localassign() {
+	int slot = g_lingo->readInt();
+	g_lingo->localSlot(slot) = g_lingo->pop();
+	if (g_debugger->isVarWriteHookActive())
+		g_debugger->varWriteHook(g_lingo->localSlotName(slot));
+}
+
 void LC::c_theentitypush() {
 	Datum id = g_lingo->pop();
 
@@ -1709,10 +1723,18 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 		}
 	}
 
+	// Builtin found by an earlier call from here, saving the search of the handlers
+	const Symbol *builtin = g_lingo->getBuiltinHandle(name, allowRetVal);
+	if (builtin) {
+		call(*builtin, nargs, allowRetVal);
+		return;
+	}
+
 	// Handler
 	funcSym = g_lingo->getHandler(name);
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
+	bool listHandler = g_lingo->_builtinListHandlers.contains(name);
+	if (listHandler && nargs >= 1) {
 		// Lingo builtin functions in the "List" category have very strange override mechanics.
 		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
 		// Otherwise, it will fall back to whatever handler is defined globally.
@@ -1725,14 +1747,12 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 
 	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
 		// Builtin
-		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
-		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
+		SymbolHash &builtins = allowRetVal ? g_lingo->_builtinFuncs : g_lingo->_builtinCmds;
+		SymbolHash::const_iterator it = builtins.find(name);
+		if (it != builtins.end()) {
+			funcSym = it->_value;
+			if (!listHandler)
+				g_lingo->setBuiltinHandle(name, allowRetVal, &it->_value);
 		}
 	}
 
@@ -91,6 +91,7 @@ void c_proparraypush();
 void c_stackpeek();
 void c_stackdrop();
 void c_assign();
+void c_localassign();
 bool verify(const Symbol &s);
 
 void c_swap();
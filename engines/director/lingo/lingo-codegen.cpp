@@ -256,6 +256,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 				_assemblyArchive->functionHandlers[it._key] = it._value;
 			}
 		}
+		g_lingo->invalidateBuiltinHandles();
 	}
 
 	delete _methodVars;
@@ -342,10 +343,20 @@ int LingoCompiler::codeFunc(const Common::String &s, int numpar) {
 
 void LingoCompiler::codeVarSet(const Common::String &name) {
 	registerMethodVar(name);
+	if (codeLocalSet(name))
+		return;
 	codeVarRef(name);
 	code1(LC::c_assign);
 }
 
+bool LingoCompiler::codeLocalSet(const Common::String &name) {
+	if (!_methodSlots.contains(name))
+		return false;
+	code1(LC::c_localassign);
+	codeInt(_methodSlots[name]);
+	return true;
+}
+
 void LingoCompiler::codeVarRef(const Common::String &name) {
 	VarType type;
 	if (_methodVars->contains(name)) {
@@ -391,7 +402,8 @@ void LingoCompiler::codeVarGet(const Common::String &name) {
 	case kVarLocal:
 	case kVarArgument:
 		code1(LC::c_localpush);
-		break;
+		codeInt(_methodSlots[name]);
+		return;
 	case kVarProperty:
 	case kVarInstance:
 		code1(LC::c_proppush);
@@ -406,6 +418,10 @@ void LingoCompiler::registerMethodVar(const Common::String &name, VarType type)
 			type = kVarLocal;
 		}
 		(*_methodVars)[name] = type;
+		if (type == kVarLocal) {
+			_methodSlots[name] = _methodSlotNames.size();
+			_methodSlotNames.push_back(name);
+		}
 		if (type == kVarProperty || type == kVarInstance) {
 			if (!_assemblyContext->hasProp(name))
 				_assemblyContext->setProp(name, Datum(), true);
@@ -484,11 +500,21 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	VarTypeHash *mainMethodVars = _methodVars;
 	_methodVars = new VarTypeHash;
 
+	// Arguments take the first slots in their order, as a repeated name
+	// still takes up a slot; the locals follow as they are registered
+	Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
 	if (_inFactory) {
-		registerMethodVar("me", kVarArgument);
+		argNames->push_back("me");
 	}
 	for (uint i = 0; i < node->args->size(); i++) {
-		registerMethodVar(*(*node->args)[i], kVarArgument);
+		argNames->push_back(Common::String((*node->args)[i]->c_str()));
+	}
+	_methodSlotNames = *argNames;
+	_methodSlots.clear();
+	for (uint i = 0; i < argNames->size(); i++) {
+		registerMethodVar((*argNames)[i], kVarArgument);
+		if (!_methodSlots.contains((*argNames)[i]))
+			_methodSlots[(*argNames)[i]] = i;
 	}
 	for (auto &i : *mainMethodVars) {
 		if (i._value == kVarGlobal)
@@ -504,18 +530,7 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	if (debugChannelSet(1, kDebugCompile))
 		debug("define handler \"%s\" (len: %d)", node->name->c_str(), _currentAssembly->size() - 1);
 
-	Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
-	if (_inFactory) {
-		argNames->push_back("me");
-	}
-	for (uint i = 0; i < node->args->size(); i++) {
-		argNames->push_back(Common::String((*node->args)[i]->c_str()));
-	}
-	Common::Array<Common::String> *varNames = new Common::Array<Common::String>;
-	for (auto &it : *_methodVars) {
-		if (it._value == kVarLocal)
-			varNames->push_back(Common::String(it._key));
-	}
+	Common::Array<Common::String> *varNames = new Common::Array<Common::String>(_methodSlotNames.begin() + argNames->size(), _methodSlotNames.size() - argNames->size());
 
 	if (debugChannelSet(1, kDebugCompile)) {
 		debug("Function vars");
@@ -537,6 +552,8 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	_currentAssembly = mainAssembly;
 	delete _methodVars;
 	_methodVars = mainMethodVars;
+	_methodSlotNames.clear();
+	_methodSlots.clear();
 	return true;
 }
 
@@ -625,6 +642,8 @@ bool LingoCompiler::visitPutIntoNode(PutIntoNode *node) {
 		registerMethodVar(*static_cast<VarNode *>(node->var)->name);
 	}
 	COMPILE(node->val);
+	if (node->var->type == kVarNode && codeLocalSet(*static_cast<VarNode *>(node->var)->name))
+		return true;
 	COMPILE_REF(node->var);
 	code1(LC::c_assign);
 	return true;
@@ -825,6 +844,8 @@ bool LingoCompiler::visitSetNode(SetNode *node) {
 		registerMethodVar(*static_cast<VarNode *>(node->var)->name);
 	}
 	COMPILE(node->val);
+	if (node->var->type == kVarNode && codeLocalSet(*static_cast<VarNode *>(node->var)->name))
+		return true;
 	COMPILE_REF(node->var);
 	code1(LC::c_assign);
 	return true;
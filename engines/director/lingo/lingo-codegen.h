@@ -46,6 +46,7 @@ public:
 	int codeInt(int val);
 	int codeString(const char *s);
 	void codeVarSet(const Common::String &name);
+	bool codeLocalSet(const Common::String &name);
 	void codeVarRef(const Common::String &name);
 	void codeVarGet(const Common::String &name);
 	int getTheFieldID(int entity, const Common::String &field, bool silent = false);
@@ -69,6 +70,9 @@ public:
 	bool _refMode;
 
 	Common::HashMap<Common::String, VarType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> *_methodVars;
+	// Arguments and then locals of the handler being compiled, by slot index
+	Common::Array<Common::String> _methodSlotNames;
+	Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _methodSlots;
 
 	bool _hadError;
 
@@ -591,6 +591,7 @@ ScriptContext::ScriptContext(const ScriptContext &sc) : Object<ScriptContext>(sc
 		_functionHandlers[it._key] = it._value;
 		_functionHandlers[it._key].ctx = this;
 	}
+	g_lingo->invalidateBuiltinHandles();
 	for (auto &it : sc._eventHandlers) {
 		_eventHandlers[it._key] = it._value;
 		_eventHandlers[it._key].ctx = this;
@@ -646,6 +647,7 @@ Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Commo
 	}
 
 	_functionHandlers[name] = sym;
+	g_lingo->invalidateBuiltinHandles();
 	if (g_lingo->_eventHandlerTypeIds.contains(name)) {
 		_eventHandlers[g_lingo->_eventHandlerTypeIds[name]] = sym;
 	}
@@ -375,6 +375,7 @@ void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uin
 			it._value.ctx = scriptContexts[type][id];
 			scriptContexts[type][id]->_functionHandlers[it._key] = it._value;
 			functionHandlers[it._key] = it._value;
+			g_lingo->invalidateBuiltinHandles();
 			if (g_lingo->_eventHandlerTypeIds.contains(it._key)) {
 				scriptContexts[type][id]->_eventHandlers[g_lingo->_eventHandlerTypeIds[it._key]] = it._value;
 			}
@@ -631,6 +632,11 @@ bool Lingo::execute(int targetFrame) {
 	uint localCounter = 0;
 	uint lastUpdate = 0;
 
+	// Checking the debug channels takes longer than most instructions, so
+	// they are only checked again whenever the events are processed
+	bool traceExec = debugChannelSet(4, kDebugLingoExec);
+	bool fewFramesOnly = debugChannelSet(-1, kDebugFewFramesOnly);
+
 	while (!_abort && !_freezeState && !_playDone && _state->script && (*_state->script)[_state->pc] != STOP) {
 		if (targetFrame != -1 && (int)_state->callstack.size() == targetFrame)
 			break;
@@ -648,7 +654,7 @@ bool Lingo::execute(int targetFrame) {
 			}
 		}
 
-		if (_globalCounter > 1000 && debugChannelSet(-1, kDebugFewFramesOnly)) {
+		if (fewFramesOnly && _globalCounter > 1000) {
 			warning("Lingo::execute(): Stopping due to debug few frames only");
 			_vm->getCurrentMovie()->getScore()->_playState = kPlayStopped;
 			break;
@@ -668,26 +674,30 @@ bool Lingo::execute(int targetFrame) {
 				// On Emscripten, updateScreen() may skip the swap, so force a yield here; a no-op elsewhere.
 				g_system->delayMillis(0);
 			}
+
+			traceExec = debugChannelSet(4, kDebugLingoExec);
+			fewFramesOnly = debugChannelSet(-1, kDebugFewFramesOnly);
 		}
 
 		uint current = _state->pc;
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack before: ", current);
+		if (traceExec) {
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack before: ", current);
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars before");
-			printAllVars();
-			if (_state->me.type == OBJECT)
-				debug("me: %s", _state->me.asString(true).c_str());
-		}
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars before");
+				printAllVars();
+				if (_state->me.type == OBJECT)
+					debug("me: %s", _state->me.asString(true).c_str());
+			}
 
-		if (debugChannelSet(4, kDebugLingoExec)) {
 			Common::String instr = decodeInstruction(_state->script, _state->pc);
 			debugC(4, kDebugLingoExec, "[%5d]: %s", current, instr.c_str());
 		}
 
-		g_debugger->stepHook();
+		if (g_debugger->isStepHookActive())
+			g_debugger->stepHook();
 
 		if (_state->script == nullptr) {
 			debugC(1, kDebugLingoExec, "Lingo::execute(): PANIC: No script to execute (1)");
@@ -697,12 +707,14 @@ bool Lingo::execute(int targetFrame) {
 		_state->pc++;
 		(*((*_state->script)[_state->pc - 1]))();
 
-		if (debugChannelSet(5, kDebugLingoExec))
-			printStack("Stack after: ", current);
+		if (traceExec) {
+			if (debugChannelSet(5, kDebugLingoExec))
+				printStack("Stack after: ", current);
 
-		if (debugChannelSet(9, kDebugLingoExec)) {
-			debug("Vars after");
-			printAllVars();
+			if (debugChannelSet(9, kDebugLingoExec)) {
+				debug("Vars after");
+				printAllVars();
+			}
 		}
 
 		_globalCounter++;
@@ -1738,11 +1750,14 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
-				g_debugger->varWriteHook(name);
-				return;
+			const Common::String &name = *var.u.s;
+			if (_state->localVars) {
+				DatumHash::iterator it = _state->localVars->find(name);
+				if (it != _state->localVars->end()) {
+					it->_value = value;
+					g_debugger->varWriteHook(name);
+					return;
+				}
 			}
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
@@ -1763,9 +1778,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
-			if (_state->localVars && _state->localVars->contains(name)) {
-				(*_state->localVars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_state->localVars && (it = _state->localVars->find(name)) != _state->localVars->end()) {
+				it->_value = value;
 				g_debugger->varWriteHook(name);
 			} else {
 				warning("varAssign: local variable %s not defined", name.c_str());
@@ -1774,7 +1790,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
 				_state->me.u.obj->setProp(name, value);
 				g_debugger->varWriteHook(name);
@@ -1854,59 +1870,10 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 
 	switch (var.type) {
 	case VARREF:
-		{
-			Datum d;
-			Common::String name = *var.u.s;
-			g_debugger->varReadHook(name);
-
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
-			}
-			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
-				return _state->me.u.obj->getProp(name);
-			}
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
-			}
-
-			if (!silent)
-				debugC(1, kDebugLingoExec, "varFetch: variable %s not found", name.c_str());
-			return result;
-		}
-		break;
 	case GLOBALREF:
-		{
-			Common::String name = *var.u.s;
-			g_debugger->varReadHook(name);
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
-			}
-			debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
-			return result;
-		}
-		break;
 	case LOCALREF:
-		{
-			Common::String name = *var.u.s;
-			g_debugger->varReadHook(name);
-			if (_state->localVars && _state->localVars->contains(name)) {
-				return (*_state->localVars)[name];
-			}
-			debugC(1, kDebugLingoExec, "varFetch: local variable %s not defined", name.c_str());
-			return result;
-		}
-		break;
 	case PROPREF:
-		{
-			Common::String name = *var.u.s;
-			g_debugger->varReadHook(name);
-			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
-				return _state->me.u.obj->getProp(name);
-			}
-			warning("varFetch: property %s not defined", name.c_str());
-			return result;
-		}
-		break;
+		return varFetch(*var.u.s, var.type, silent);
 	case FIELDREF:
 	case CASTREF:
 	case CHUNKREF:
@@ -1923,6 +1890,53 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	return result;
 }
 
+Datum Lingo::varFetch(const Common::String &name, DatumType type, bool silent) {
+	g_debugger->varReadHook(name);
+
+	// Every table is searched only once, as this is done for every variable
+	// read by a script
+	if ((type == VARREF || type == LOCALREF) && _state->localVars) {
+		DatumHash::const_iterator it = _state->localVars->find(name);
+		if (it != _state->localVars->end())
+			return it->_value;
+	}
+	if ((type == VARREF || type == PROPREF) && _state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
+		return _state->me.u.obj->getProp(name);
+	}
+	if (type == VARREF || type == GLOBALREF) {
+		DatumHash::const_iterator it = _globalvars.find(name);
+		if (it != _globalvars.end())
+			return it->_value;
+	}
+
+	switch (type) {
+	case VARREF:
+		if (!silent)
+			debugC(1, kDebugLingoExec, "varFetch: variable %s not found", name.c_str());
+		break;
+	case GLOBALREF:
+		debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
+		break;
+	case LOCALREF:
+		debugC(1, kDebugLingoExec, "varFetch: local variable %s not defined", name.c_str());
+		break;
+	case PROPREF:
+		warning("varFetch: property %s not defined", name.c_str());
+		break;
+	default:
+		break;
+	}
+	return Datum();
+}
+
+const Common::String &Lingo::localSlotName(int slot) {
+	const Symbol &sym = _state->callstack.back()->sp;
+	int argCount = sym.argNames ? sym.argNames->size() : 0;
+	if (slot < argCount)
+		return (*sym.argNames)[slot];
+	return (*sym.varNames)[slot - argCount];
+}
+
 Common::U32String Lingo::evalChunkRef(const Datum &var) {
 	Common::U32String result;
 
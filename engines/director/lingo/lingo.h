@@ -48,6 +48,7 @@ class DirectorEngine;
 class Frame;
 class Window;
 class LingoCompiler;
+class Movie;
 struct Breakpoint;
 
 typedef void (*inst)(void);
@@ -248,6 +249,13 @@ typedef Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::Ig
 typedef Common::HashMap<Common::String, ObjectType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> OpenXLibsHash;
 typedef Common::HashMap<Common::String, AbstractObject *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> OpenXLibsStateHash;
 
+struct BuiltinHandle {	/* builtin a call resolved to, when no handler overrode it */
+	const Symbol	*sym;
+	ScriptContext	*context;			/* context the call was made from */
+	Movie			*movie;				/* movie whose handlers were searched */
+};
+typedef Common::HashMap<Common::String, BuiltinHandle, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> BuiltinHandleHash;
+
 typedef Common::HashMap<Common::String, const TheEntity *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityHash;
 typedef Common::HashMap<Common::String, const TheEntityField *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TheEntityFieldHash;
 
@@ -263,6 +271,7 @@ struct CFrame {	/* proc/func call stack frame */
 	Datum			defaultRetVal;		/* default return value */
 	int				paramCount;			/* original number of arguments submitted */
 	Common::Array<Datum> paramList;		/* original argument list */
+	Common::Array<Datum *> localSlots;	/* arguments and then locals in localVars, by slot index */
 	Window			*retWindow = nullptr;	/* window to restore on return */
 };
 
@@ -397,6 +406,9 @@ public:
 	void initBuiltIns(const BuiltinProto protos[]);
 	void cleanupBuiltIns();
 	void cleanupBuiltIns(const BuiltinProto protos[]);
+	const Symbol *getBuiltinHandle(const Common::String &name, bool allowRetVal);
+	void setBuiltinHandle(const Common::String &name, bool allowRetVal, const Symbol *sym);
+	void invalidateBuiltinHandles();
 	void initFuncs();
 	void cleanupFuncs();
 	void initBytecode();
@@ -435,6 +447,11 @@ public:
 	void cleanLocalVars();
 	void varAssign(const Datum &var, const Datum &value);
 	Datum varFetch(const Datum &var, bool silent = false);
+	/** Fetch the variable of a VARREF, GLOBALREF, LOCALREF or PROPREF by its name. */
+	Datum varFetch(const Common::String &name, DatumType type, bool silent = false);
+	/** The argument or local of the current handler the compiler gave this slot. */
+	Datum &localSlot(int slot) { return *_state->callstack.back()->localSlots[slot]; }
+	const Common::String &localSlotName(int slot);
 	Common::U32String evalChunkRef(const Datum &var);
 	Datum findVarV4(int varType, const Datum &id);
 	CastMemberID resolveCastMember(const Datum &memberID, const Datum &castLib, CastType type);
@@ -541,6 +558,8 @@ public:
 	SymbolHash _builtinConsts;
 	SymbolHash _builtinListHandlers;
 	SymbolHash _methods;
+	BuiltinHandleHash _builtinFuncHandles;
+	BuiltinHandleHash _builtinCmdHandles;
 	XLibOpenerFuncHash _xlibOpeners;
 	XLibCloserFuncHash _xlibClosers;
 	XLibTypeHash _xlibTypes;
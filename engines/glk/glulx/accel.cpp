@@ -70,9 +70,27 @@ acceleration_func Glulx::accel_find_func(uint index) {
 	case 13:
 		return &Glulx::func_13_op__pr;
 	}
+
+	/* Not one of the built-in functions; it may have been registered separately. */
+	if (accel_registered.contains(index))
+		return accel_registered[index];
+
 	return nullptr;
 }
 
+void Glulx::accel_register_func(uint index, acceleration_func func) {
+	/* Index 0 always means no acceleration, and 1 through 13 are built in. */
+	if (index <= 13) {
+		nonfatal_warning_i("Attempt to register a reserved acceleration function index.", index);
+		return;
+	}
+
+	if (func)
+		accel_registered[index] = func;
+	else
+		accel_registered.erase(index);
+}
+
 acceleration_func Glulx::accel_get_func(uint addr) {
 	int bucknum;
 	accelentry_t *ptr;
@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/glulx/debugger.h"
+#include "glk/glulx/glulx.h"
+#include "common/algorithm.h"
+
+namespace Glk {
+namespace Glulx {
+
+struct CallCountEntry {
+	uint _addr;
+	callcount_t _count;
+
+	CallCountEntry(uint addr, const callcount_t &count) : _addr(addr), _count(count) {}
+
+	bool operator<(const CallCountEntry &rhs) const {
+		return _count.calls > rhs._count.calls;
+	}
+};
+
+Debugger::Debugger(Glulx *vm) : Glk::Debugger(), _vm(vm) {
+	registerCmd("callcounts", WRAP_METHOD(Debugger, cmdCallCounts));
+}
+
+bool Debugger::cmdCallCounts(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		_vm->profile_set_call_counts(true);
+		debugPrintf("Call counting is on\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		_vm->profile_set_call_counts(false);
+		debugPrintf("Call counting is off\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		_vm->profile_reset_call_counts();
+		debugPrintf("Call counts have been reset\n");
+		return true;
+	} else if (argc > 2) {
+		debugPrintf("Format: callcounts [on | off | reset | <number of functions to list>]\n");
+		return true;
+	}
+
+	int limit = (argc == 2) ? strToInt(argv[1]) : 20;
+	const Common::HashMap<uint, callcount_t> &counts = _vm->profile_get_call_counts();
+
+	Common::Array<CallCountEntry> entries;
+	for (Common::HashMap<uint, callcount_t>::const_iterator it = counts.begin(); it != counts.end(); ++it)
+		entries.push_back(CallCountEntry(it->_key, it->_value));
+	Common::sort(entries.begin(), entries.end());
+
+	debugPrintf("Call counting is %s, %u functions called\n",
+		_vm->profile_call_counts_active() ? "on" : "off", entries.size());
+
+	for (int idx = 0; idx < (int)entries.size() && idx < limit; ++idx) {
+		const CallCountEntry &entry = entries[idx];
+
+		// Addresses above 0xE0000000 stand for string decoding and Glk calls
+		if (entry._addr >= 0xF0000000)
+			debugPrintf("glk %04x      %10u\n", entry._addr - 0xF0000000, entry._count.calls);
+		else if (entry._addr >= 0xE0000000)
+			debugPrintf("string (%u)    %10u\n", entry._addr - 0xE0000000, entry._count.calls);
+		else
+			debugPrintf("func %08x %10u (%u accelerated)\n", entry._addr, entry._count.calls, entry._count.accelcalls);
+	}
+
+	return true;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
@@ -28,17 +28,20 @@ void Glulx::execute_loop() {
 	bool done_executing = false;
 	int ix;
 	uint opcode;
-	const operandlist_t *oplist;
+	const decodedop_t *dop;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
 	uint *arglist;
 	uint arglistfix[3];
+	uint quitcheck = 0;
 #ifdef FLOAT_SUPPORT
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
 
-	while (!done_executing && !g_vm->shouldQuit()) {
+	/* Asking the engine whether to quit is slow compared to executing an
+	   opcode, so it's only done once every 1024 instructions. */
+	while (!done_executing && ((++quitcheck & 0x3FF) != 0 || !g_vm->shouldQuit())) {
 
 		profile_tick();
 		debugger_tick();
@@ -48,44 +51,17 @@ void Glulx::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			}
-		}
-
-		/* Now we have an opcode number. */
-
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
-
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
+		/* Fetch the decoded form of the instruction. For code in ROM this
+		   usually comes straight out of the decode cache. */
+		dop = &decodecache[DECODE_CACHE_INDEX(pc)];
+		if (dop->pc != pc)
+			dop = fetch_instruction(pc);
+		opcode = dop->opcode;
 
-		/* Based on the oplist structure, load the actual operand values
+		/* Based on the decoded operand modes, load the actual operand values
 		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+		pc = dop->nextpc;
+		load_operands(inst, dop);
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
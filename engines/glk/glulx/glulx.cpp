@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/glulx/debugger.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
 
@@ -42,6 +43,10 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		accelentries(nullptr),
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
+		// operand
+		decodecache(nullptr),
+		// profile
+		call_counts_active(false),
 		// serial
 		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
 		// string
@@ -51,6 +56,10 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 	glkopInit();
 }
 
+void Glulx::createDebugger() {
+	setDebugger(new Debugger(this));
+}
+
 void Glulx::runGame() {
 	if (!is_gamefile_valid())
 		return;
@@ -25,6 +25,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -104,6 +105,12 @@ private:
 	uint cpv__start;        ///< array of common prop defaults
 	accelentry_t **accelentries;
 
+	/**
+	 * Acceleration functions registered with accel_register_func, keyed by function index.
+	 * These are consulted for any index the built-in table does not recognize.
+	 */
+	Common::HashMap<uint, acceleration_func> accel_registered;
+
 	/**@}*/
 
 	/**
@@ -145,6 +152,27 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Cache of decoded instructions, indexed by a hash of their address. Only instructions
+	 * lying wholly in ROM are kept, since that part of memory can't be written by the game.
+	 */
+	decodedop_t *decodecache;
+
+	/**
+	 * Holds the decoded form of an instruction in RAM, which has to be decoded every time
+	 */
+	decodedop_t decodescratch;
+
+	/**@}*/
+
+	/**
+	 * \defgroup profile fields
+	 * @{
+	 */
+
+	bool call_counts_active;
+	Common::HashMap<uint, callcount_t> call_counts;
+
 	/**@}*/
 
 	/**
@@ -392,6 +420,11 @@ protected:
 	void dumpcache(cacheblock_t *cablist, int count, int indent);
 
 	/**@}*/
+
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
 public:
 	/**
 	 * Constructor
@@ -543,13 +576,30 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
+	 * Decode the instruction at the given address: its opcode, and the addressing mode and
+	 * constant part of each operand. Everything except the pc field of dop is filled in.
+	 */
+	void decode_instruction(uint addr, decodedop_t *dop);
+
+	/**
+	 * Return the decoded form of the instruction at the given address. Instructions in ROM are
+	 * served from the decode cache; anything else is decoded into a scratch entry each time.
+	 */
+	const decodedop_t *fetch_instruction(uint addr);
+
+	/**
+	 * Discard everything in the decode cache. This must be called whenever code memory may
+	 * have been changed behind the interpreter's back.
+	 */
+	void flush_decode_cache();
+
+	/**
+	 * Fetch the operand values of a decoded instruction, and put them in args. Stack operands
+	 * are popped in order, just as if the instruction was being parsed from memory.
 	 *
 	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
 	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	void load_operands(oparg_t *opargs, const decodedop_t *dop);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -817,8 +867,36 @@ public:
 
 	void setup_profile(strid_t stream, char *filename);
 	int init_profile();
+
+	/**
+	 * Turn counting of function calls on or off. Counts already gathered are kept.
+	 */
 	void profile_set_call_counts(int flag);
 
+	/**
+	 * Returns true if function calls are currently being counted
+	 */
+	bool profile_call_counts_active() const {
+		return call_counts_active;
+	}
+
+	/**
+	 * Discard all the call counts gathered so far
+	 */
+	void profile_reset_call_counts();
+
+	/**
+	 * Record a call to a function, which may have been handled by an accelerated function
+	 */
+	void profile_count_call(uint addr, bool accel);
+
+	/**
+	 * Return the call counts gathered so far, keyed by function address
+	 */
+	const Common::HashMap<uint, callcount_t> &profile_get_call_counts() const {
+		return call_counts;
+	}
+
 #ifdef VM_PROFILING
 	uint profile_opcount;
 	#define profile_tick() (profile_opcount++)
@@ -830,7 +908,10 @@ public:
 #else /* VM_PROFILING */
 	void profile_tick() {}
 	void profile_profiling_active() {}
-	void profile_in(uint addr, uint stackuse, int accel) {}
+	void profile_in(uint addr, uint stackuse, int accel) {
+		if (call_counts_active)
+			profile_count_call(addr, accel);
+	}
 	void profile_out(uint stackuse)  {}
 	void profile_fail(const char *reason) {}
 	void profile_quit() {}
@@ -871,6 +952,13 @@ public:
 
 	acceleration_func accel_find_func(uint index);
 	acceleration_func accel_get_func(uint addr);
+
+	/**
+	 * Register an additional acceleration function under the given index, so that games can
+	 * request it with the accelfunc opcode. The built-in functions (1 through 13) can't be replaced.
+	 */
+	void accel_register_func(uint index, acceleration_func func);
+
 	void accel_set_func(uint index, uint addr);
 	void accel_set_param(uint index, uint val);
 
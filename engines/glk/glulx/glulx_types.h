@@ -351,6 +351,50 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How a decoded operand gets its value when the instruction is executed. Load operands
+ * which come from memory, the stack or the locals have to be fetched afresh every time;
+ * constants and store destinations are fully resolved when the instruction is decoded.
+ */
+enum decodedarg {
+	decodedarg_Static = 0,      ///< the decoded oparg is used as is
+	decodedarg_Pop = 1,         ///< pop the value off the stack
+	decodedarg_Mem1 = 2,        ///< read 1, 2 or 4 bytes from the main memory address in value
+	decodedarg_Mem2 = 3,
+	decodedarg_Mem4 = 4,
+	decodedarg_Local1 = 5,      ///< read 1, 2 or 4 bytes from the locals segment offset in value
+	decodedarg_Local2 = 6,
+	decodedarg_Local4 = 7
+};
+
+/**
+ * An instruction whose opcode and operand modes have already been decoded.
+ */
+struct decodedop_struct {
+	uint pc;                        ///< Address of the instruction, or 0 for an empty cache slot
+	uint nextpc;                    ///< Address of the following instruction
+	uint opcode;
+	int numops;
+	byte kinds[MAX_OPERANDS];       ///< decodedarg values for each operand
+	oparg_t args[MAX_OPERANDS];     ///< resolved operands, or the address to load them from
+};
+typedef decodedop_struct decodedop_t;
+
+/**
+ * Number of entries in the decoded instruction cache. Must be a power of two.
+ */
+#define DECODE_CACHE_SIZE (4096)
+#define DECODE_CACHE_INDEX(addr) (((addr) ^ ((addr) >> 12)) & (DECODE_CACHE_SIZE - 1))
+
+/**
+ * Call counts gathered for a single function while call counting is turned on.
+ */
+struct callcount_struct {
+	uint calls;         ///< Number of times the function was entered
+	uint accelcalls;    ///< How many of those calls were handled by an accelerated function
+};
+typedef callcount_struct callcount_t;
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
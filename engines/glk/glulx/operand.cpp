@@ -279,22 +279,61 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+void Glulx::decode_instruction(uint addr, decodedop_t *dop) {
 	int ix;
-	oparg_t *curarg;
-	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	uint opcode;
+	const operandlist_t *oplist;
+	int numops;
+	int argsize;
+	uint modeaddr;
 	int modeval = 0;
 
-	pc += (numops + 1) / 2;
+	/* Fetch the opcode number. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	numops = oplist->num_ops;
+	argsize = oplist->arg_size;
+
+	dop->opcode = opcode;
+	dop->numops = numops;
+	modeaddr = addr;
+	addr += (numops + 1) / 2;
+
+	for (ix = 0; ix < numops; ix++) {
 		int mode;
+		byte kind;
+		uint desttype = 0;
 		uint value;
-		uint addr;
-
-		curarg->desttype = 0;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -304,203 +343,134 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			modeaddr++;
 		}
 
-		if (oplist->formlist[ix] == modeform_Load) {
+		/* Pull the constant part of the operand, if there is one, out of
+		   the instruction. This is an address for memory and locals modes. */
+		switch (mode) {
+		case 0: /* constant zero / discard value */
+		case 8: /* stack */
+			value = 0;
+			break;
+
+		case 1: /* one-byte constant */
+			/* Sign-extend from 8 bits to 32 */
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			break;
+
+		case 2: /* two-byte constant */
+			/* Sign-extend the first byte from 8 bits to 32; the subsequent
+			   byte must not be sign-extended. */
+			value = (int)(signed char)(Mem1(addr));
+			addr++;
+			value = (value << 8) | (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 3: /* four-byte constant */
+		case 7: /* main memory, four-byte address */
+		case 11: /* locals, four-byte address */
+			/* Bytes must not be sign-extended. */
+			value = Mem4(addr);
+			addr += 4;
+			break;
+
+		case 15: /* main memory RAM, four-byte address */
+			value = Mem4(addr) + ramstart;
+			addr += 4;
+			break;
+
+		case 6: /* main memory, two-byte address */
+		case 10: /* locals, two-byte address */
+			value = (uint)Mem2(addr);
+			addr += 2;
+			break;
+
+		case 14: /* main memory RAM, two-byte address */
+			value = (uint)Mem2(addr) + ramstart;
+			addr += 2;
+			break;
+
+		case 5: /* main memory, one-byte address */
+		case 9: /* locals, one-byte address */
+			value = (uint)(Mem1(addr));
+			addr++;
+			break;
+
+		case 13: /* main memory RAM, one-byte address */
+			value = (uint)(Mem1(addr)) + ramstart;
+			addr++;
+			break;
+
+		default:
+			value = 0;
+			break;
+		}
 
+		if (oplist->formlist[ix] == modeform_Load) {
 			switch (mode) {
-
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
-				break;
-
-			case 0: /* constant zero */
-				value = 0;
-				break;
-
-			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
-			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				kind = decodedarg_Static;
 				break;
 
-			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+			case 8:
+				kind = decodedarg_Pop;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				kind = (argsize == 4) ? decodedarg_Mem4 : (argsize == 2) ? decodedarg_Mem2 : decodedarg_Mem1;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+			case 9:
+			case 10:
+			case 11:
+				/* It's illegal for the address to not be four-byte aligned, but
+				   we don't check this explicitly. A "strict mode" interpreter
+				   probably should. It's also illegal for it to be less than zero
+				   or greater than the size of the locals segment. */
+				kind = (argsize == 4) ? decodedarg_Local4 : (argsize == 2) ? decodedarg_Local2 : decodedarg_Local1;
 				break;
 
 			default:
-				value = 0;
+				kind = decodedarg_Static;
 				fatal_error("Unknown addressing mode in load operand.");
 			}
 
-			curarg->value = value;
-
 		} else { /* modeform_Store */
-			switch (mode) {
+			kind = decodedarg_Static;
 
+			switch (mode) {
 			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
+				desttype = 0;
 				break;
 
 			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
+				desttype = 3;
 				break;
 
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				desttype = 1;
 				break;
 
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
+			case 9:
+			case 10:
+			case 11:
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
 				   stack position. */
-				curarg->value = addr;
+				desttype = 2;
 				break;
 
 			case 1:
@@ -513,6 +483,94 @@ WrLocalsAddr:
 				fatal_error("Unknown addressing mode in store operand.");
 			}
 		}
+
+		dop->kinds[ix] = kind;
+		dop->args[ix].desttype = desttype;
+		dop->args[ix].value = value;
+	}
+
+	dop->nextpc = addr;
+}
+
+const decodedop_t *Glulx::fetch_instruction(uint addr) {
+	decodedop_t *dop;
+
+	if (addr < ramstart) {
+		dop = &decodecache[DECODE_CACHE_INDEX(addr)];
+		if (dop->pc != addr) {
+			decode_instruction(addr, dop);
+			/* An instruction which runs over into RAM could change under us,
+			   so leave the slot marked as empty. */
+			dop->pc = (dop->nextpc <= ramstart) ? addr : 0;
+		}
+		return dop;
+	}
+
+	decode_instruction(addr, &decodescratch);
+	return &decodescratch;
+}
+
+void Glulx::flush_decode_cache() {
+	int ix;
+
+	if (!decodecache)
+		return;
+
+	for (ix = 0; ix < DECODE_CACHE_SIZE; ix++)
+		decodecache[ix].pc = 0;
+}
+
+void Glulx::load_operands(oparg_t *args, const decodedop_t *dop) {
+	int ix;
+	oparg_t *curarg;
+	const oparg_t *decarg;
+
+	for (ix = 0, curarg = args, decarg = dop->args; ix < dop->numops; ix++, curarg++, decarg++) {
+		switch (dop->kinds[ix]) {
+		case decodedarg_Static:
+			*curarg = *decarg;
+			break;
+
+		case decodedarg_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->desttype = 0;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case decodedarg_Mem1:
+			curarg->desttype = 0;
+			curarg->value = Mem1(decarg->value);
+			break;
+
+		case decodedarg_Mem2:
+			curarg->desttype = 0;
+			curarg->value = Mem2(decarg->value);
+			break;
+
+		case decodedarg_Mem4:
+			curarg->desttype = 0;
+			curarg->value = Mem4(decarg->value);
+			break;
+
+		case decodedarg_Local1:
+			curarg->desttype = 0;
+			curarg->value = Stk1(decarg->value + localsbase);
+			break;
+
+		case decodedarg_Local2:
+			curarg->desttype = 0;
+			curarg->value = Stk2(decarg->value + localsbase);
+			break;
+
+		case decodedarg_Local4:
+		default:
+			curarg->desttype = 0;
+			curarg->value = Stk4(decarg->value + localsbase);
+			break;
+		}
 	}
 }
 
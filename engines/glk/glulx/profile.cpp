@@ -0,0 +1,44 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/glulx/glulx.h"
+
+namespace Glk {
+namespace Glulx {
+
+void Glulx::profile_set_call_counts(int flag) {
+	call_counts_active = (flag != 0);
+}
+
+void Glulx::profile_reset_call_counts() {
+	call_counts.clear();
+}
+
+void Glulx::profile_count_call(uint addr, bool accel) {
+	callcount_t &entry = call_counts[addr];
+
+	entry.calls++;
+	if (accel)
+		entry.accelcalls++;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
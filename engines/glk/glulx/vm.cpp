@@ -87,6 +87,15 @@ void Glulx::setup_vm() {
 	}
 	stringtable = 0;
 
+	decodecache = (decodedop_t *)glulx_malloc(DECODE_CACHE_SIZE * sizeof(decodedop_t));
+	if (!decodecache) {
+		glulx_free(stack);
+		glulx_free(memmap);
+		stack = nullptr;
+		memmap = nullptr;
+		fatal_error("Unable to allocate the instruction decode cache.");
+	}
+
 	// Initialize various other things in the terp.
 	init_operands();
 	init_serial();
@@ -114,6 +123,10 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decodecache) {
+		glulx_free(decodecache);
+		decodecache = nullptr;
+	}
 
 	final_serial();
 }
@@ -155,6 +168,9 @@ void Glulx::vm_restart() {
 		memmap[lx] = 0;
 	}
 
+	/* The code has just been reloaded, so nothing decoded earlier can be trusted. */
+	flush_decode_cache();
+
 	/* Reset all the registers */
 	stackptr = 0;
 	frameptr = 0;
@@ -179,6 +179,7 @@ MODULE_OBJS := \
 	comprehend/game_tr2.o \
 	comprehend/pics.o \
 	glulx/accel.o \
+	glulx/debugger.o \
 	glulx/exec.o \
 	glulx/float.o \
 	glulx/funcs.o \
@@ -187,6 +188,7 @@ MODULE_OBJS := \
 	glulx/glulx.o \
 	glulx/heap.o \
 	glulx/operand.o \
+	glulx/profile.o \
 	glulx/search.o \
 	glulx/serial.o \
 	glulx/string.o \
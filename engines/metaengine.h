@@ -33,6 +33,7 @@
 
 #include "base/plugins.h"
 
+class DetectionSession;
 class Engine;
 class OSystem;
 
@@ -603,9 +604,10 @@ public:
 	 * Given a list of FSNodes in a given directory, detect a set of games contained within.
 	 * @ param skipADFlags		Ignore results which are flagged with the ADGF flags specified here (for mass add)
 	 * @ param skipIncomplete	Ignore incomplete file/md5/size matches (for mass add)
+	 * @ param session			Share directory listings and file hashes with other calls using the same session
 	 * Returns an empty list if none are found.
 	 */
-	DetectionResults detectGames(const Common::FSList &fslist, uint32 skipADFlags = 0, bool skipIncomplete = false);
+	DetectionResults detectGames(const Common::FSList &fslist, uint32 skipADFlags = 0, bool skipIncomplete = false, DetectionSession *session = nullptr);
 
 	/** Find a plugin by its engine ID. */
 	const Plugin *findDetectionPlugin(const Common::String &engineId) const;
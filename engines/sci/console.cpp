@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -85,6 +86,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	// Variables
 	registerVar("sleeptime_factor",	&g_debug_sleeptime_factor);
 	registerVar("gc_interval",		&engine->_gamestate->scriptGCInterval);
+	registerVar("gc_full_interval",	&engine->_gamestate->scriptGCFullInterval);
 	registerVar("simulated_key",		&g_debug_simulated_key);
 	registerVar("track_mouse_clicks",	&g_debug_track_mouse_clicks);
 	registerCmd("speed_throttle",   WRAP_METHOD(Console, cmdSpeedThrottle));
@@ -117,6 +119,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -144,6 +147,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("pl",                 WRAP_METHOD(Console, cmdPlaneList));	// alias
 	registerCmd("visible_plane_list", WRAP_METHOD(Console, cmdVisiblePlaneList));
 	registerCmd("vpl",                WRAP_METHOD(Console, cmdVisiblePlaneList));	// alias
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	registerCmd("plane_items",        WRAP_METHOD(Console, cmdPlaneItemList));
 	registerCmd("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
 	registerCmd("visible_plane_items", WRAP_METHOD(Console, cmdVisiblePlaneItemList));
@@ -319,6 +323,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("---------\n");
 	debugPrintf("sleeptime_factor: Factor to multiply with wait times in kWait()\n");
 	debugPrintf("gc_interval: Number of kernel calls in between garbage collections\n");
+	debugPrintf("gc_full_interval: Number of minor garbage collections in between full ones, 0 to make every collection a full one\n");
 	debugPrintf("simulated_key: Add a key with the specified scan code to the event list\n");
 	debugPrintf("track_mouse_clicks: Toggles mouse click tracking to the console\n");
 	debugPrintf("speed_throttle: Displays or changes kGameIsRestarting maximum delay\n");
@@ -357,6 +362,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows resource cache statistics, or changes its size\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -382,6 +388,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" window_list / wl - Shows a list of all the windows (ports) in the draw list (SCI0 - SCI1.1)\n");
 	debugPrintf(" plane_list / pl - Shows a list of all the planes in the draw list (SCI2+)\n");
 	debugPrintf(" visible_plane_list / vpl - Shows a list of all the planes in the visible draw list (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows cel pixel cache statistics, or changes its size (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
@@ -1191,6 +1198,40 @@ bool Console::cmdResourceInfo(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 2) {
+		debugPrintf("Shows resource cache statistics.\n");
+		debugPrintf("Usage: %s [<size in KiB> | reset]\n", argv[0]);
+		debugPrintf("A size changes the budget for unlocked resources, \"reset\" clears the counters\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetCacheStats();
+		} else {
+			const int size = atoi(argv[1]);
+			if (size <= 0) {
+				debugPrintf("Invalid cache size: %s\n", argv[1]);
+				return true;
+			}
+			resMan->setCacheBudget(size * 1024);
+		}
+	}
+
+	const ResourceManager::CacheStats &stats = resMan->getCacheStats();
+	const uint32 lookups = stats.hits + stats.misses;
+
+	debugPrintf("Cached: %d of %d KiB, locked: %d KiB\n", resMan->getCacheMemory() / 1024, resMan->getCacheBudget() / 1024, resMan->getLockedMemory() / 1024);
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate)\n", stats.hits, stats.misses, lookups ? (uint32)((uint64)stats.hits * 100 / lookups) : 0);
+	debugPrintf("Evictions: %u\n", stats.evictions);
+	debugPrintf("Prefetched: %u, used: %u, queued: %u\n", stats.prefetches, stats.prefetchHits, resMan->getPrefetchQueueSize());
+
+	return true;
+}
+
 bool Console::cmdResourceTypes(int argc, const char **argv) {
 	debugPrintf("The %d valid resource types are:\n", kResourceTypeInvalid);
 	for (int i = 0; i < kResourceTypeInvalid; i++) {
@@ -2188,6 +2229,47 @@ bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	CelPixelCache *cache = CelObj::_pixelCache;
+	if (!cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc > 2) {
+		debugPrintf("Shows cel pixel cache statistics.\n");
+		debugPrintf("Usage: %s [<size in KiB> | reset]\n", argv[0]);
+		debugPrintf("A size changes the budget of the cache (0 disables it), \"reset\" clears the counters\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			cache->resetStats();
+		} else {
+			const int size = atoi(argv[1]);
+			if (size < 0) {
+				debugPrintf("Invalid cache size: %s\n", argv[1]);
+				return true;
+			}
+			cache->setBudget(size * 1024);
+		}
+	}
+
+	const CelPixelCache::Stats &stats = cache->getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	const uint32 scaledLookups = stats.scaledHits + stats.scaledMisses;
+
+	debugPrintf("Cached: %u cels, %u of %u KiB\n", cache->getNumEntries(), cache->getSize() / 1024, cache->getBudget() / 1024);
+	debugPrintf("Decompressed cels: %u hits, %u misses (%u%% hit rate)\n", stats.hits, stats.misses, lookups ? (uint32)((uint64)stats.hits * 100 / lookups) : 0);
+	debugPrintf("Scaled cels: %u hits, %u misses (%u%% hit rate)\n", stats.scaledHits, stats.scaledMisses, scaledLookups ? (uint32)((uint64)stats.scaledHits * 100 / scaledLookups) : 0);
+	debugPrintf("Evictions: %u\n", stats.evictions);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
 
 bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	if (argc != 2) {
@@ -3043,6 +3125,8 @@ bool Console::cmdVMVars(int argc, const char **argv) {
 			debugPrintf("Or pass a decimal or hexadecimal value directly (e.g. 12, 1Ah)\n");
 			return true;
 		}
+		if (varType == VAR_GLOBAL || varType == VAR_LOCAL)
+			s->_segMan->markGCDirty(make_reg(s->variablesSegment[varType], 0));
 	}
 	return true;
 }
@@ -3062,12 +3146,14 @@ bool Console::cmdLocalVars(int argc, const char **argv) {
 
 	// search segment table for script locals
 	Common::Array<reg_t> *locals = nullptr;
+	SegmentObj *localsSegment = nullptr;
 	for (uint i = 0; i < _engine->_gamestate->_segMan->_heap.size(); i++) {
 		SegmentObj *segmentObj = _engine->_gamestate->_segMan->_heap[i];
 		if (segmentObj != nullptr && segmentObj->getType() == SEG_TYPE_LOCALS) {
 			LocalVariables *localVariables = (LocalVariables *)segmentObj;
 			if (localVariables->script_id == scriptNumber) {
 				locals = &localVariables->_locals;
+				localsSegment = segmentObj;
 				break;
 			}
 		}
@@ -3107,6 +3193,7 @@ bool Console::cmdLocalVars(int argc, const char **argv) {
 			debugPrintf("Check the \"addresses\" command on how to use addresses\n");
 			debugPrintf("Or pass a decimal or hexadecimal value directly (e.g. 12, 1Ah)\n");
 		}
+		localsSegment->markGCDirty(NULL_REG);
 	}
 
 	return true;
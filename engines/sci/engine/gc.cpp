@@ -83,7 +83,7 @@ static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_
 	return normal_map;
 }
 
-static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
+static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap, bool fullCollection) {
 	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
 	while (!wm._worklist.empty()) {
 		reg_t reg = wm._worklist.back();
@@ -91,14 +91,20 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 		if (reg.getSegment() != stackSegment) { // No need to repeat this one
 			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.getSegment() < heap.size() && heap[reg.getSegment()]) {
-				// Valid heap object? Find its outgoing references!
-				wm.pushArray(heap[reg.getSegment()]->listAllOutgoingReferences(reg));
+				SegmentObj *mobj = heap[reg.getSegment()];
+
+				// Valid heap object? Find its outgoing references! A minor
+				// collection only follows those of young objects: older
+				// ones can only point to young objects if they were written
+				// since the last collection, and were then remembered.
+				if (fullCollection || mobj->isGCYoung(reg))
+					wm.pushArray(mobj->listAllOutgoingReferences(reg));
 			}
 		}
 	}
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
+AddrSet *findAllActiveReferences(EngineState *s, bool fullCollection) {
 	assert(!s->_executionStack.empty());
 
 	WorklistManager wm;
@@ -144,8 +150,19 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 	for (uint i = 1; i < heapSize; i++) {
 		if (heap[i]) {
-			// Init: Explicitly loaded scripts
+			// Init: Everything written since the last collection
+			if (!fullCollection) {
+				Common::Array<reg_t> remembered;
+				heap[i]->listGCRemembered(i, remembered);
+				wm.pushArray(remembered);
+			}
+
+			// Init: Explicitly loaded scripts, whose objects a minor
+			// collection only scans if they were written
 			if (heap[i]->getType() == SEG_TYPE_SCRIPT) {
+				if (!fullCollection)
+					continue;
+
 				Script *script = (Script *)heap[i];
 
 				if (script->getLockers()) { // Explicitly loaded?
@@ -170,7 +187,7 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
 
-	processWorkList(s->_segMan, wm, heap);
+	processWorkList(s->_segMan, wm, heap, fullCollection);
 
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
@@ -178,11 +195,16 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
+void run_gc(EngineState *s, bool fullCollection) {
 	SegManager *segMan = s->_segMan;
 
+	if (fullCollection || s->gcFullCountDown-- <= 0) {
+		fullCollection = true;
+		s->gcFullCountDown = s->scriptGCFullInterval;
+	}
+
 	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
+	debugC(kDebugLevelGC, "[GC] Running %s collection...", fullCollection ? "full" : "minor");
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -191,7 +213,7 @@ void run_gc(EngineState *s) {
 #endif
 
 	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
+	AddrSet *activeRefs = findAllActiveReferences(s, fullCollection);
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -206,8 +228,9 @@ void run_gc(EngineState *s) {
 #endif
 
 			// Get a list of all deallocatable objects in this segment,
-			// then free any which are not referenced from somewhere.
-			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
+			// then free any which are not referenced from somewhere. A
+			// minor collection leaves older garbage to the next full one.
+			const Common::Array<reg_t> tmp = fullCollection ? mobj->listAllDeallocatable(seg) : mobj->listGCYoung(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
@@ -225,6 +248,12 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	// Everything left is old now
+	for (uint seg = 1; seg < heap.size(); seg++) {
+		if (heap[seg])
+			heap[seg]->resetGCGeneration();
+	}
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -44,15 +44,27 @@ typedef Common::HashMap<reg_t, bool, reg_t_Hash> AddrSet;
 /**
  * Finds all used references and normalises them to their memory addresses
  * @param s The state to gather all information from
+ * @param fullCollection Whether to search the whole heap, or only what was
+ *        allocated or written since the last collection
  * @return A hash map containing entries for all used references
  */
-AddrSet *findAllActiveReferences(EngineState *s);
+AddrSet *findAllActiveReferences(EngineState *s, bool fullCollection = true);
 
 /**
- * Runs garbage collection on the current system state
+ * Runs garbage collection on the current system state.
+ *
+ * A minor collection only frees objects allocated since the last
+ * collection. It marks from the registers and stacks, and from everything
+ * the write barrier (SegManager::markGCDirty()) remembered since then,
+ * only following references out of young objects. Its cost grows with the
+ * work done since the last collection instead of the size of the heap.
+ * Older garbage is left for the next full collection, which happens at
+ * least every scriptGCFullInterval collections.
+ *
  * @param s The state in which we should gc
+ * @param fullCollection Whether the whole heap should be collected
  */
-void run_gc(EngineState *s);
+void run_gc(EngineState *s, bool fullCollection = true);
 
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
@@ -109,36 +109,36 @@ struct DefaultSyncer : Common::BinaryFunction<Common::Serializer, T, void> {
 	}
 };
 
-// Syncer for entries in a segment obj table
+// Sync an entry in a segment obj table. The data of loaded entries is
+// allocated from the arena of the table.
 template<typename T>
-struct SegmentObjTableEntrySyncer : Common::BinaryFunction<Common::Serializer, typename T::Entry &, void> {
-	void operator()(Common::Serializer &s, typename T::Entry &entry, int index) const {
-		s.syncAsSint32LE(entry.next_free);
+void syncTableEntry(Common::Serializer &s, T &table, int index) {
+	typename T::Entry &entry = table._table[index];
+	s.syncAsSint32LE(entry.next_free);
 
-		bool hasData = false;
-		if (s.getVersion() >= 37) {
-			if (s.isSaving()) {
-				hasData = entry.data != nullptr;
-			}
-			s.syncAsByte(hasData);
-		} else {
-			hasData = (entry.next_free == index);
+	bool hasData = false;
+	if (s.getVersion() >= 37) {
+		if (s.isSaving()) {
+			hasData = entry.data != nullptr;
 		}
+		s.syncAsByte(hasData);
+	} else {
+		hasData = (entry.next_free == index);
+	}
 
-		if (hasData) {
-			if (s.isLoading()) {
-				entry.data = new typename T::value_type;
-			}
-			syncWithSerializer(s, *entry.data);
-		} else if (s.isLoading()) {
-			if (s.getVersion() < 37) {
-				typename T::value_type dummy{};
-				syncWithSerializer(s, dummy);
-			}
-			entry.data = nullptr;
+	if (hasData) {
+		if (s.isLoading()) {
+			entry.data = table.allocData();
+		}
+		syncWithSerializer(s, *entry.data);
+	} else if (s.isLoading()) {
+		if (s.getVersion() < 37) {
+			typename T::value_type dummy{};
+			syncWithSerializer(s, dummy);
 		}
+		entry.data = nullptr;
 	}
-};
+}
 
 /**
  * Sync a Common::Array using a Common::Serializer.
@@ -496,7 +496,14 @@ void sync_Table(Common::Serializer &s, T &obj) {
 	s.syncAsSint32LE(obj.first_free);
 	s.syncAsSint32LE(obj.entries_used);
 
-	syncArray<typename T::Entry, SegmentObjTableEntrySyncer<T> >(s, obj._table);
+	uint len = obj._table.size();
+	s.syncAsUint32LE(len);
+
+	if (s.isLoading())
+		obj._table.resize(len);
+
+	for (uint i = 0; i < len; ++i)
+		syncTableEntry(s, obj, i);
 }
 
 void CloneTable::saveLoadWithSerializer(Common::Serializer &s) {
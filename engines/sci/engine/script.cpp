@@ -1221,6 +1221,17 @@ Common::Array<reg_t> Script::listAllOutgoingReferences(reg_t addr) const {
 	return tmp;
 }
 
+void Script::listGCRemembered(SegmentId segId, Common::Array<reg_t> &refs) const {
+	if (!_gcDirty)
+		return;
+
+	// Writes are only tracked per script, so report the variables of all
+	// objects in it
+	const ObjMap::const_iterator end = _objects.end();
+	for (ObjMap::const_iterator it = _objects.begin(); it != end; ++it)
+		refs.push_back(listAllOutgoingReferences(it->_value.getPos()));
+}
+
 Common::Array<reg_t> Script::listObjectReferences() const {
 	Common::Array<reg_t> tmp;
 
@@ -144,6 +144,7 @@ public:
 	void freeAtAddress(SegManager *segMan, reg_t sub_addr) override;
 	Common::Array<reg_t> listAllDeallocatable(SegmentId segId) const override;
 	Common::Array<reg_t> listAllOutgoingReferences(reg_t object) const override;
+	void listGCRemembered(SegmentId segId, Common::Array<reg_t> &refs) const override;
 
 	/**
 	 * Return a list of all references to objects in this script
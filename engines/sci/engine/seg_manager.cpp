@@ -25,6 +25,8 @@
 #include "sci/engine/script.h"
 #ifdef ENABLE_SCI32
 #include "sci/engine/guest_additions.h"
+#include "sci/engine/kernel.h"
+#include "sci/engine/selector.h"
 #endif
 
 namespace Sci {
@@ -552,6 +554,7 @@ List *SegManager::lookupList(reg_t addr) {
 		return nullptr;
 	}
 
+	lt.markGCDirty(addr);
 	return &(lt[addr.getOffset()]);
 }
 
@@ -576,9 +579,16 @@ Node *SegManager::lookupNode(reg_t addr, bool stopOnDiscarded) {
 		return nullptr;
 	}
 
+	nt.markGCDirty(addr);
 	return &(nt[addr.getOffset()]);
 }
 
+void SegManager::markGCDirty(reg_t addr) {
+	SegmentObj *mobj = getSegmentObj(addr.getSegment());
+	if (mobj)
+		mobj->markGCDirty(addr);
+}
+
 SegmentRef SegManager::dereference(reg_t pointer) {
 	SegmentRef ret;
 
@@ -589,7 +599,13 @@ SegmentRef SegManager::dereference(reg_t pointer) {
 	}
 
 	SegmentObj *mobj = _heap[pointer.getSegment()];
-	return mobj->dereference(pointer);
+	ret = mobj->dereference(pointer);
+
+	// Callers may store references in reg_t based memory
+	if (ret.isValid() && !ret.isRaw)
+		mobj->markGCDirty(pointer);
+
+	return ret;
 }
 
 static void *derefPtr(SegManager *segMan, reg_t pointer, int entries, bool wantRaw) {
@@ -968,6 +984,7 @@ SciArray *SegManager::lookupArray(reg_t addr) {
 	if (!arrayTable.isValidEntry(addr.getOffset()))
 		error("Attempt to use non-array %04x:%04x as array", PRINT_REG(addr));
 
+	arrayTable.markGCDirty(addr);
 	return &(arrayTable[addr.getOffset()]);
 }
 
@@ -1105,10 +1122,40 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
+	prefetchScriptResources(scr);
 
 	return segmentId;
 }
 
+void SegManager::prefetchScriptResources(const Script *scr) {
+	// The selectors are not known yet while the kernel looks them up
+	if (!_resMan->isPrefetchEnabled() || SELECTOR(view) <= 0)
+		return;
+
+	// Queue the views and pictures the objects of the script start out with
+	static const struct {
+		Selector SelectorCache::*selector;
+		ResourceType type;
+	} references[] = {
+		{ &SelectorCache::view, kResourceTypeView },
+		{ &SelectorCache::picture, kResourceTypePic }
+	};
+
+	const SelectorCache &selectors = g_sci->getKernel()->_selectorCache;
+	for (ObjMap::const_iterator it = scr->getObjectMap().begin(); it != scr->getObjectMap().end(); ++it) {
+		for (int i = 0; i < ARRAYSIZE(references); ++i) {
+			const Selector selector = selectors.*references[i].selector;
+			const int index = selector > 0 ? it->_value.locateVarSelector(this, selector) : -1;
+			if (index < 0)
+				continue;
+
+			const reg_t value = it->_value.getVariable(index);
+			if (value.isNumber() && value.getOffset() != 0xffff)
+				_resMan->prefetchResource(ResourceId(references[i].type, value.getOffset()));
+		}
+	}
+}
+
 void SegManager::uninstantiateScript(int script_nr) {
 	SegmentId segmentId = getScriptSegment(script_nr);
 	Script *scr = getScriptIfLoaded(segmentId);
@@ -206,14 +206,14 @@ public:
 	reg_t newNode(reg_t value, reg_t key);
 
 	/**
-	 * Resolves a list pointer to a list.
+	 * Resolves a list pointer to a list, which may then be written to.
 	 * @param addr The address to resolve
 	 * @return The list referenced, or NULL on error
 	 */
 	List *lookupList(reg_t addr);
 
 	/**
-	 * Resolves an address into a list node.
+	 * Resolves an address into a list node, which may then be written to.
 	 * @param addr The address to resolve
 	 * @return The list node referenced, or NULL on error
 	 */
@@ -389,6 +389,16 @@ public:
 	 */
 	Object *getObject(reg_t pos) const;
 
+	/**
+	 * Write barrier of the garbage collector, to call after storing a
+	 * reference in the variables of an object or in local variables.
+	 * Minor collections only look for references to new objects in what
+	 * was written since the last collection. lookupList(), lookupNode(),
+	 * lookupArray() and dereference() call this themselves.
+	 * @param addr	The object, or any address in the local variables
+	 */
+	void markGCDirty(reg_t addr);
+
 	/**
 	 * Checks whether a heap address contains an object
 	 * @parm obj The address to check
@@ -490,6 +500,12 @@ private:
 	void deallocate(SegmentId seg);
 	void createClassTable();
 
+	/**
+	 * Queues the resources referenced by the objects of a newly
+	 * instantiated script for prefetching.
+	 */
+	void prefetchScriptResources(const Script *scr);
+
 	SegmentId findFreeSegment() const;
 
 	/**
@@ -22,6 +22,7 @@
 #ifndef SCI_ENGINE_SEGMENT_H
 #define SCI_ENGINE_SEGMENT_H
 
+#include "common/memorypool.h"
 #include "common/serializer.h"
 #include "common/str.h"
 #include "sci/engine/object.h"
@@ -82,11 +83,17 @@ enum SegmentType {
 struct SegmentObj : public Common::Serializable {
 	SegmentType _type;
 
+	/**
+	 * Set when references may have been stored in this segment since the
+	 * last garbage collection. Table segments track this per entry instead.
+	 */
+	bool _gcDirty;
+
 public:
 	static SegmentObj *createSegmentObj(SegmentType type);
 
 public:
-	SegmentObj(SegmentType type) : _type(type) {}
+	SegmentObj(SegmentType type) : _type(type), _gcDirty(false) {}
 	~SegmentObj() override {}
 
 	inline SegmentType getType() const { return _type; }
@@ -142,6 +149,46 @@ public:
 	virtual Common::Array<reg_t> listAllOutgoingReferences(reg_t object) const {
 		return Common::Array<reg_t>();
 	}
+
+	/**
+	 * Write barrier of the garbage collector: remembers that a reference
+	 * may have been stored at the specified address since the last
+	 * collection.
+	 * @param addr		address (within the current segment) written to
+	 */
+	virtual void markGCDirty(reg_t addr) { _gcDirty = true; }
+
+	/**
+	 * Reports the references held by everything written to since the last
+	 * collection, which minor collections use instead of scanning the whole
+	 * heap.
+	 * @param segId		the id of this segment
+	 * @param refs		array to add the references to
+	 */
+	virtual void listGCRemembered(SegmentId segId, Common::Array<reg_t> &refs) const {
+		if (_gcDirty)
+			refs.push_back(listAllOutgoingReferences(make_reg(segId, 0)));
+	}
+
+	/**
+	 * Checks whether the specified address was allocated since the last
+	 * collection. Minor collections only free such addresses.
+	 */
+	virtual bool isGCYoung(reg_t addr) const { return false; }
+
+	/**
+	 * Iterates over the addresses allocated since the last collection.
+	 * @return the young subset of listAllDeallocatable()
+	 */
+	virtual Common::Array<reg_t> listGCYoung(SegmentId segId) const {
+		return Common::Array<reg_t>();
+	}
+
+	/**
+	 * Called after every collection, which leaves all remaining addresses
+	 * old and unwritten.
+	 */
+	virtual void resetGCGeneration() { _gcDirty = false; }
 };
 
 struct LocalVariables : public SegmentObj {
@@ -182,6 +229,9 @@ public:
 	}
 	Common::Array<reg_t> listAllOutgoingReferences(reg_t object) const override;
 
+	// The stack is part of the root set of every collection
+	void markGCDirty(reg_t addr) override {}
+
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
 };
 
@@ -236,6 +286,8 @@ struct SegmentObjTable : public SegmentObj {
 	struct Entry {
 		T *data;
 		int next_free; /* Only used for free entries */
+		bool gcYoung; /* Allocated since the last garbage collection */
+		bool gcDirty; /* Written since the last garbage collection */
 	};
 	enum { HEAPENTRY_INVALID = -1 };
 
@@ -245,6 +297,19 @@ struct SegmentObjTable : public SegmentObj {
 	typedef Common::Array<Entry> ArrayType;
 	ArrayType _table;
 
+	/**
+	 * Arena for the entry data. Entries are carved out of pages owned by the
+	 * table instead of being separate heap allocations.
+	 */
+	Common::ObjectPool<T, 0> _arena;
+
+	/**
+	 * The entries with gcYoung and gcDirty set, which keep their flags when
+	 * they are freed until the next garbage collection.
+	 */
+	Common::Array<int> _gcYoungEntries;
+	Common::Array<int> _gcDirtyEntries;
+
 public:
 	SegmentObjTable(SegmentType type) : SegmentObj(type) {
 	}
@@ -257,6 +322,14 @@ public:
 		}
 	}
 
+	/**
+	 * Allocates the data of an entry from the arena of this table.
+	 * Must be released again through freeEntry().
+	 */
+	T *allocData() {
+		return new (_arena) T;
+	}
+
 	int allocEntry() {
 		entries_used++;
 		if (first_free != HEAPENTRY_INVALID) {
@@ -265,17 +338,26 @@ public:
 
 			_table[oldff].next_free = oldff;
 			assert(_table[oldff].data == nullptr);
-			_table[oldff].data = new T;
+			_table[oldff].data = allocData();
+			markGCYoung(oldff);
 			return oldff;
 		} else {
 			uint newIdx = _table.size();
 			_table.push_back(Entry());
-			_table.back().data = new T;
+			_table.back().data = allocData();
 			_table[newIdx].next_free = newIdx;	// Tag as 'valid'
+			markGCYoung(newIdx);
 			return newIdx;
 		}
 	}
 
+	void markGCYoung(int idx) {
+		if (!_table[idx].gcYoung) {
+			_table[idx].gcYoung = true;
+			_gcYoungEntries.push_back(idx);
+		}
+	}
+
 	bool isValidOffset(uint32 offset) const override {
 		return isValidEntry(offset);
 	}
@@ -289,7 +371,8 @@ public:
 			::error("Table::freeEntry: Attempt to release invalid table index %d", idx);
 
 		_table[idx].next_free = first_free;
-		delete _table[idx].data;
+		if (_table[idx].data)
+			_arena.deleteChunk(_table[idx].data);
 		_table[idx].data = nullptr;
 		first_free = idx;
 		entries_used--;
@@ -303,6 +386,48 @@ public:
 		return tmp;
 	}
 
+	void markGCDirty(reg_t addr) override {
+		const int idx = addr.getOffset();
+		if (!isValidEntry(idx))
+			return;
+
+		// Young entries are scanned anyway if they are reachable
+		Entry &entry = _table[idx];
+		if (!entry.gcYoung && !entry.gcDirty) {
+			entry.gcDirty = true;
+			_gcDirtyEntries.push_back(idx);
+		}
+	}
+
+	void listGCRemembered(SegmentId segId, Common::Array<reg_t> &refs) const override {
+		for (uint i = 0; i < _gcDirtyEntries.size(); i++)
+			if (isValidEntry(_gcDirtyEntries[i]))
+				refs.push_back(listAllOutgoingReferences(make_reg(segId, _gcDirtyEntries[i])));
+	}
+
+	bool isGCYoung(reg_t addr) const override {
+		const int idx = addr.getOffset();
+		return isValidEntry(idx) && _table[idx].gcYoung;
+	}
+
+	Common::Array<reg_t> listGCYoung(SegmentId segId) const override {
+		Common::Array<reg_t> tmp;
+		for (uint i = 0; i < _gcYoungEntries.size(); i++)
+			if (isValidEntry(_gcYoungEntries[i]))
+				tmp.push_back(make_reg(segId, _gcYoungEntries[i]));
+		return tmp;
+	}
+
+	void resetGCGeneration() override {
+		for (uint i = 0; i < _gcYoungEntries.size(); i++)
+			_table[_gcYoungEntries[i]].gcYoung = false;
+		for (uint i = 0; i < _gcDirtyEntries.size(); i++)
+			_table[_gcDirtyEntries[i]].gcDirty = false;
+		_gcYoungEntries.clear();
+		_gcDirtyEntries.clear();
+		SegmentObj::resetGCGeneration();
+	}
+
 	uint size() const { return _table.size(); }
 
 	T &at(uint index) { return *_table[index].data; }
@@ -52,6 +52,7 @@ void Kernel::mapSelectors() {
 	FIND_SELECTOR(y);
 	FIND_SELECTOR(x);
 	FIND_SELECTOR(view);
+	FIND_SELECTOR(picture);
 	FIND_SELECTOR(loop);
 	FIND_SELECTOR(cel);
 	FIND_SELECTOR(underBits);
@@ -178,7 +179,6 @@ void Kernel::mapSelectors() {
 
 #ifdef ENABLE_SCI32
 	FIND_SELECTOR(data);
-	FIND_SELECTOR(picture);
 	FIND_SELECTOR(bitmap);
 	FIND_SELECTOR(plane);
 	FIND_SELECTOR(top);
@@ -285,6 +285,7 @@ void writeSelector(SegManager *segMan, reg_t object, Selector selectorId, reg_t
 	}
 
 	*address.getPointer(segMan) = value;
+	segMan->markGCDirty(address.obj);
 #ifdef ENABLE_SCI32
 	updateInfoFlagViewVisible(segMan->getObject(object), address.varindex);
 #endif
@@ -40,6 +40,7 @@ struct SelectorCache {
 	Selector y;
 	Selector x;
 	Selector view, loop, cel; ///< Description of a specific image
+	Selector picture; ///< The picture of a room or, in SCI32, of a plane
 	Selector underBits; ///< Used by the graphics subroutines to store backupped BG pic data
 	Selector nsTop, nsLeft, nsBottom, nsRight; ///< View boundaries ('now seen')
 	Selector lsTop, lsLeft, lsBottom, lsRight; ///< Used by Animate() subfunctions and scroll list controls
@@ -145,7 +146,6 @@ struct SelectorCache {
 
 #ifdef ENABLE_SCI32
 	Selector data; // Used by Array()/String()
-	Selector picture; // Used to hold the picture ID for SCI32 pictures
 	Selector bitmap; // Used to hold the text bitmap for SCI32 texts
 
 	Selector plane;
@@ -104,6 +104,7 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcFullCountDown = 0;
 
 	_eventCounter = 0;
 	_paletteSetIntensityCounter = 0;
@@ -119,6 +120,7 @@ void EngineState::reset(bool isRestoring) {
 
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
+	scriptGCFullInterval = GC_FULL_INTERVAL;
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -172,6 +172,7 @@ struct EngineState : public Common::Serializable {
 
 	int scriptStepCounter; // Counts the number of steps executed
 	int scriptGCInterval; // Number of steps in between gcs
+	int scriptGCFullInterval; // Number of minor gcs in between full ones
 
 	uint16 currentRoomNumber() const;
 	void setRoomNumber(uint16 roomNumber);
@@ -188,6 +189,7 @@ struct EngineState : public Common::Serializable {
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	int gcFullCountDown; /**< Number of minor gcs until next full gc */
 
 	MessageState *_msgState;
 	void initMessageState();
@@ -193,6 +193,11 @@ enum {
 	GC_INTERVAL = 0x8000
 };
 
+/** Number of minor gcs in between full ones */
+enum {
+	GC_FULL_INTERVAL = 8
+};
+
 enum SciOpcodes {
 	op_bnot     = 0x00,	// 000
 	op_add      = 0x01,	// 001
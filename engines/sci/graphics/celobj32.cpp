@@ -38,6 +38,7 @@ namespace Sci {
 #pragma mark CelScaler
 
 CelScaler *CelObj::_scaler = nullptr;
+CelPixelCache *CelObj::_pixelCache = nullptr;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
@@ -81,6 +82,131 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 	return _scaleTables[_activeIndex];
 }
 
+#pragma mark -
+#pragma mark CelPixelCache
+
+CelPixelCache::CelPixelCache(const uint32 budget) :
+	_first(nullptr),
+	_last(nullptr),
+	_budget(budget),
+	_size(0) {
+	resetStats();
+}
+
+CelPixelCache::~CelPixelCache() {
+	while (_first) {
+		removeEntry(_first);
+	}
+}
+
+CelPixelCache::Key CelPixelCache::makeKey(const CelInfo32 &celInfo, const int16 width, const int16 height, const bool scaled) {
+	Key key;
+	key.type = celInfo.type;
+	key.resourceId = celInfo.resourceId;
+	key.loopNo = celInfo.loopNo;
+	key.celNo = celInfo.celNo;
+	key.width = width;
+	key.height = height;
+	key.scaled = scaled;
+	return key;
+}
+
+Common::SharedPtr<Buffer> CelPixelCache::find(const CelInfo32 &celInfo, const int16 width, const int16 height, const bool scaled) {
+	EntryMap::iterator it = _entries.find(makeKey(celInfo, width, height, scaled));
+	if (it == _entries.end()) {
+		if (scaled) {
+			++_stats.scaledMisses;
+		} else {
+			++_stats.misses;
+		}
+		return Common::SharedPtr<Buffer>();
+	}
+
+	if (scaled) {
+		++_stats.scaledHits;
+	} else {
+		++_stats.hits;
+	}
+
+	Entry *entry = it->_value;
+	if (entry != _first) {
+		unlinkEntry(entry);
+		pushFront(entry);
+	}
+	return entry->pixels;
+}
+
+void CelPixelCache::insert(const CelInfo32 &celInfo, const bool scaled, const Common::SharedPtr<Buffer> &pixels) {
+	const uint32 size = pixels->h * pixels->pitch;
+	if (size > _budget) {
+		return;
+	}
+
+	const Key key = makeKey(celInfo, pixels->w, pixels->h, scaled);
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		removeEntry(it->_value);
+	}
+
+	Entry *entry = new Entry();
+	entry->key = key;
+	entry->pixels = pixels;
+	pushFront(entry);
+	_entries.setVal(key, entry);
+	_size += size;
+
+	shrink();
+}
+
+void CelPixelCache::setBudget(const uint32 budget) {
+	_budget = budget;
+	shrink();
+}
+
+void CelPixelCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void CelPixelCache::unlinkEntry(Entry *entry) {
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	} else {
+		_first = entry->next;
+	}
+
+	if (entry->next) {
+		entry->next->prev = entry->prev;
+	} else {
+		_last = entry->prev;
+	}
+}
+
+void CelPixelCache::pushFront(Entry *entry) {
+	entry->prev = nullptr;
+	entry->next = _first;
+	if (_first) {
+		_first->prev = entry;
+	} else {
+		_last = entry;
+	}
+	_first = entry;
+}
+
+void CelPixelCache::removeEntry(Entry *entry) {
+	unlinkEntry(entry);
+	_entries.erase(entry->key);
+	_size -= entry->pixels->h * entry->pixels->pitch;
+	// Pixels still referenced by a reader are freed once it is done with them
+	delete entry;
+}
+
+void CelPixelCache::shrink() {
+	while (_size > _budget) {
+		removeEntry(_last);
+		++_stats.evictions;
+	}
+}
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
@@ -91,11 +217,19 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
 	_cache = new CelCache(100);
+
+	int pixelCacheSize = kCelPixelCacheSize;
+	if (ConfMan.hasKey("cel_cache_size")) {
+		pixelCacheSize = MAX(0, ConfMan.getInt("cel_cache_size"));
+	}
+	_pixelCache = new CelPixelCache(pixelCacheSize * 1024);
 }
 
 void CelObj::deinit() {
 	delete _scaler;
 	_scaler = nullptr;
+	delete _pixelCache;
+	_pixelCache = nullptr;
 	delete _cache;
 	_cache = nullptr;
 }
@@ -240,14 +374,29 @@ struct SCALER_Scale {
 				scaledPosition.y,
 				scaledPosition.x + (celObj._width * scaleX).toInt(),
 				scaledPosition.y + (celObj._height * scaleY).toInt());
-			_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
-			_sourceBuffer->create(
-				scaledImageRect.width(), scaledImageRect.height(),
-				Graphics::PixelFormat::createFormatCLUT8());
-			Copier copier(_reader, *_sourceBuffer);
-			Graphics::larryScale(
-				celObj._width, celObj._height, celObj._skipColor, copier,
-				scaledImageRect.width(), scaledImageRect.height(), copier);
+
+			// The result only depends on the cel and the scaled size, so it
+			// can be reused as long as the cel keeps being drawn at this size
+			CelPixelCache *cache = CelObj::_pixelCache;
+			const bool useCache = cache && cache->getBudget() && CelPixelCache::isCacheable(celObj._info);
+			if (useCache) {
+				_sourceBuffer = cache->find(celObj._info, scaledImageRect.width(), scaledImageRect.height(), true);
+			}
+
+			if (!_sourceBuffer) {
+				_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_sourceBuffer->create(
+					scaledImageRect.width(), scaledImageRect.height(),
+					Graphics::PixelFormat::createFormatCLUT8());
+				Copier copier(_reader, *_sourceBuffer);
+				Graphics::larryScale(
+					celObj._width, celObj._height, celObj._skipColor, copier,
+					scaledImageRect.width(), scaledImageRect.height(), copier);
+
+				if (useCache) {
+					cache->insert(celObj._info, true, _sourceBuffer);
+				}
+			}
 
 			// Set _valuesX and _valuesY to reference the scaled image without additional scaling
 			for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -370,7 +519,10 @@ private:
 	int16 _y;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
-	const int16 _maxWidth;
+	int16 _maxWidth;
+	// If _pixels is set, it contains the whole decompressed cel from the
+	// pixel cache and rows are read from it directly.
+	Common::SharedPtr<Buffer> _pixels;
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
@@ -378,17 +530,42 @@ public:
 	_y(-1),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
-	_maxWidth(maxWidth) {
+	_maxWidth(maxWidth),
+	_pixels() {
 		assert(maxWidth <= celObj._width);
 
 		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
+
+		CelPixelCache *cache = CelObj::_pixelCache;
+		if (cache && cache->getBudget() && CelPixelCache::isCacheable(celObj._info)) {
+			_pixels = cache->find(celObj._info, celObj._width, _sourceHeight, false);
+			if (!_pixels) {
+				// Cached cels are always decompressed in full, since the
+				// next draw may need a different part of them
+				_maxWidth = celObj._width;
+				_pixels = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_pixels->create(celObj._width, _sourceHeight, Graphics::PixelFormat::createFormatCLUT8());
+				for (int16 y = 0; y < _sourceHeight; ++y) {
+					memcpy(_pixels->getBasePtr(0, y), decompressRow(y), celObj._width);
+				}
+				cache->insert(celObj._info, false, _pixels);
+			}
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_pixels) {
+			return static_cast<const byte *>(_pixels->getBasePtr(0, y));
+		}
+
+		return decompressRow(y);
+	}
+
+	inline const byte *decompressRow(const int16 y) {
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
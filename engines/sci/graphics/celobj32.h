@@ -22,6 +22,8 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -148,6 +150,119 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+enum {
+	/**
+	 * The default size of the cel pixel cache, in KiB.
+	 */
+	kCelPixelCacheSize = 8192
+};
+
+/**
+ * A cache of decompressed cel pixels, and of cels scaled with LarryScale,
+ * limited by the total size of the cached pixels. CelCache only saves
+ * reading the cel headers again; without this cache, compressed cels are
+ * decompressed every time they are drawn.
+ *
+ * Remapping is applied while drawing and depends on the pixels of the target,
+ * so it is not cached.
+ */
+class CelPixelCache {
+public:
+	struct Stats {
+		uint32 hits;         ///< Draws of decompressed cels which were cached
+		uint32 misses;       ///< Cels which had to be decompressed
+		uint32 scaledHits;   ///< LarryScale results which were cached
+		uint32 scaledMisses; ///< Cels which had to be scaled
+		uint32 evictions;    ///< Entries dropped to stay within the budget
+	};
+
+	CelPixelCache(const uint32 budget);
+	~CelPixelCache();
+
+	/**
+	 * Returns true if the pixels of the given cel never change, which is the
+	 * case for cels loaded from view and pic resources.
+	 */
+	static bool isCacheable(const CelInfo32 &celInfo) {
+		return celInfo.type == kCelTypeView || celInfo.type == kCelTypePic;
+	}
+
+	/**
+	 * Retrieves the cached pixels of a cel at the given size. `scaled`
+	 * selects LarryScale results instead of decompressed source pixels.
+	 * Returns a null pointer if the pixels are not cached.
+	 */
+	Common::SharedPtr<Buffer> find(const CelInfo32 &celInfo, const int16 width, const int16 height, const bool scaled);
+
+	/**
+	 * Adds the pixels of a cel to the cache, evicting the least recently used
+	 * entries if the cache grows over its budget.
+	 */
+	void insert(const CelInfo32 &celInfo, const bool scaled, const Common::SharedPtr<Buffer> &pixels);
+
+	/**
+	 * Changes the maximum number of bytes to cache. 0 disables the cache.
+	 */
+	void setBudget(const uint32 budget);
+	uint32 getBudget() const { return _budget; }
+	uint32 getSize() const { return _size; }
+	uint getNumEntries() const { return _entries.size(); }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	struct Key {
+		CelType type;
+		GuiResourceId resourceId;
+		int16 loopNo;
+		int16 celNo;
+		int16 width;
+		int16 height;
+		bool scaled;
+
+		bool operator==(const Key &other) const {
+			return type == other.type && resourceId == other.resourceId &&
+				loopNo == other.loopNo && celNo == other.celNo &&
+				width == other.width && height == other.height && scaled == other.scaled;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return ((uint)key.type << 28) ^ ((uint)(uint16)key.resourceId << 12) ^ ((uint)(uint16)key.loopNo << 8) ^ (uint16)key.celNo ^
+				((uint)(uint16)key.width << 16) ^ (uint16)key.height ^ (key.scaled ? 0x80000000 : 0);
+		}
+	};
+
+	/**
+	 * A cache entry, linked into a list from the most to the least recently
+	 * used entry.
+	 */
+	struct Entry {
+		Key key;
+		Common::SharedPtr<Buffer> pixels;
+		Entry *prev;
+		Entry *next;
+	};
+
+	typedef Common::HashMap<Key, Entry *, KeyHash> EntryMap;
+
+	static Key makeKey(const CelInfo32 &celInfo, const int16 width, const int16 height, const bool scaled);
+
+	void unlinkEntry(Entry *entry);
+	void pushFront(Entry *entry);
+	void removeEntry(Entry *entry);
+	void shrink();
+
+	EntryMap _entries;
+	Entry *_first;
+	Entry *_last;
+	uint32 _budget;
+	uint32 _size;
+	Stats _stats;
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -262,6 +377,11 @@ protected:
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * The cache of decompressed and scaled cel pixels.
+	 */
+	static CelPixelCache *_pixelCache;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
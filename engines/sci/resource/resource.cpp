@@ -30,6 +30,7 @@
 #ifdef ENABLE_SCI32
 #include "common/compression/installshield_cab.h"
 #include "common/memstream.h"
+#include "common/system.h"
 #endif
 
 #include "sci/engine/workarounds.h"
@@ -207,6 +208,9 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_lruPrev = nullptr;
+	_lruNext = nullptr;
+	_prefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -225,6 +229,7 @@ void Resource::unalloc() {
 	delete[] _header;
 	_header = nullptr;
 	_status = kResStatusNoMalloc;
+	_prefetched = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -1008,7 +1013,13 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
-	_LRU.clear();
+	_lruFirst = nullptr;
+	_lruLast = nullptr;
+	resetCacheStats();
+	_prefetchEnabled = false;
+	_prefetchQueue.clear();
+	for (int i = 0; i < kResourceTypeInvalid; ++i)
+		_prefetchLoadTime[i] = kPrefetchInitialLoadTime;
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1082,6 +1093,15 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Users on slow storage can trade memory for fewer reloads of evicted
+	// resources, and have the resources of new rooms loaded while idle
+	if (!_detectionMode) {
+		if (ConfMan.hasKey("resource_cache_size") && ConfMan.getInt("resource_cache_size") > 0)
+			_maxMemoryLRU = ConfMan.getInt("resource_cache_size") * 1024;
+		if (ConfMan.hasKey("resource_prefetch"))
+			_prefetchEnabled = ConfMan.getBool("resource_prefetch");
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1128,7 +1148,16 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	if (res->_lruPrev)
+		res->_lruPrev->_lruNext = res->_lruNext;
+	else
+		_lruFirst = res->_lruNext;
+	if (res->_lruNext)
+		res->_lruNext->_lruPrev = res->_lruPrev;
+	else
+		_lruLast = res->_lruPrev;
+	res->_lruPrev = nullptr;
+	res->_lruNext = nullptr;
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1138,7 +1167,13 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+	res->_lruPrev = nullptr;
+	res->_lruNext = _lruFirst;
+	if (_lruFirst)
+		_lruFirst->_lruPrev = res;
+	else
+		_lruLast = res;
+	_lruFirst = res;
 	_memoryLRU += res->size();
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1150,10 +1185,11 @@ void ResourceManager::addToLRU(Resource *res) {
 
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(_lruLast);
+		Resource *goner = _lruLast;
 		removeFromLRU(goner);
 		goner->unalloc();
+		_cacheStats.evictions++;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
@@ -1196,9 +1232,18 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		_cacheStats.misses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else {
+		_cacheStats.hits++;
+		if (retval->_prefetched) {
+			_cacheStats.prefetchHits++;
+			retval->_prefetched = false;
+		}
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -1248,6 +1293,64 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+void ResourceManager::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
+void ResourceManager::setCacheBudget(int bytes) {
+	_maxMemoryLRU = bytes;
+	freeOldResources();
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	if (!_prefetchEnabled)
+		return;
+
+	Resource *res = testResource(id);
+	if (res && res->_status == kResStatusNoMalloc)
+		_prefetchQueue.push_back(id);
+}
+
+bool ResourceManager::processPrefetchQueue(uint32 deadline) {
+	// Prefetching must not push out resources which are still in use
+	if (_prefetchQueue.empty() || _memoryLRU >= _maxMemoryLRU)
+		return false;
+
+	// Loading cannot be interrupted, so only start on a resource which
+	// is expected to be done before the engine has to wake up again
+	const uint32 time = g_system->getMillis();
+	Common::List<ResourceId>::iterator it;
+	for (it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (time + _prefetchLoadTime[it->getType()] < deadline)
+			break;
+	}
+	if (it == _prefetchQueue.end())
+		return false;
+
+	Resource *res = testResource(*it);
+	_prefetchQueue.erase(it);
+
+	// The resource may have been requested in the meantime
+	if (!res || res->_status != kResStatusNoMalloc)
+		return true;
+
+	loadResource(res);
+
+	// Follow the slowest recent load of each type, decaying slowly
+	uint32 &estimate = _prefetchLoadTime[res->getType()];
+	const uint32 loadTime = g_system->getMillis() - time;
+	estimate = MAX(loadTime, (estimate * 3 + loadTime) / 4);
+
+	if (res->_status == kResStatusAllocated) {
+		res->_prefetched = true;
+		addToLRU(res);
+		_cacheStats.prefetches++;
+		freeOldResources();
+	}
+
+	return true;
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
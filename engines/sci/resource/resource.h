@@ -51,7 +51,10 @@ enum {
 	kResourceHeaderSize = 2, ///< patch type + header size
 
 	/** The maximum allowed size for a compressed or decompressed resource */
-	SCI_MAX_RESOURCE_SIZE = 0x0400000
+	SCI_MAX_RESOURCE_SIZE = 0x0400000,
+
+	/** The time in ms a resource is expected to take to prefetch, before one is measured */
+	kPrefetchInitialLoadTime = 10
 };
 
 /** Resource status types */
@@ -309,6 +312,9 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	Resource *_lruPrev; /**< More recently used neighbour while enqueued */
+	Resource *_lruNext; /**< Less recently used neighbour while enqueued */
+	bool _prefetched; /**< Loaded ahead of time and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -487,6 +493,44 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/** Statistics of the resource cache, shown by the debugger. */
+	struct CacheStats {
+		uint32 hits;         ///< Lookups of resources which were still in memory
+		uint32 misses;       ///< Lookups which had to load the resource
+		uint32 evictions;    ///< Resources freed to stay within the budget
+		uint32 prefetches;   ///< Resources loaded ahead of time
+		uint32 prefetchHits; ///< Prefetched resources which were used afterwards
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
+	/**
+	 * Sets the maximum number of bytes of unlocked resources to keep in
+	 * memory, freeing the least recently used ones over this budget.
+	 */
+	void setCacheBudget(int bytes);
+	int getCacheBudget() const { return _maxMemoryLRU; }
+	int getCacheMemory() const { return _memoryLRU; }
+	int getLockedMemory() const { return _memoryLocked; }
+	uint getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+
+	/**
+	 * Queues a resource to be loaded into the cache the next time the
+	 * engine is idle. Does nothing unless prefetching is enabled.
+	 */
+	void prefetchResource(ResourceId id);
+
+	bool isPrefetchEnabled() const { return _prefetchEnabled; }
+
+	/**
+	 * Loads the next resource of the prefetch queue which is expected to
+	 * be loaded before the deadline, if the cache has room left for it.
+	 * @param deadline the time in milliseconds by which loading has to be done
+	 * @return true if a queued resource was processed
+	 */
+	bool processPrefetchQueue(uint32 deadline);
+
 protected:
 	bool _detectionMode;
 
@@ -501,7 +545,12 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Resource *_lruFirst; ///< Most recently used resource under LRU control
+	Resource *_lruLast;  ///< Least recently used resource under LRU control
+	CacheStats _cacheStats;
+	bool _prefetchEnabled;
+	Common::List<ResourceId> _prefetchQueue;
+	uint32 _prefetchLoadTime[kResourceTypeInvalid]; ///< Expected load time in ms of a prefetched resource, per type
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -969,7 +969,9 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		uint32 time = _system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			_system->delayMillis(10);
+			// Spend the idle time loading prefetched resources, if any
+			if (!_resMan->processPrefetchQueue(wakeUpTime - 10))
+				_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				_system->delayMillis(wakeUpTime - time);
@@ -94,6 +94,10 @@ public:
 	AVIVideoTrack *getTransparencyTrack() {
 		return static_cast<AVIVideoTrack *>(_transparencyTrack.track);
 	}
+
+protected:
+	// AVISurface reads the tracks directly
+	bool supportsDecodeAhead() const override { return false; }
 };
 
 class AVISurface {
@@ -38,6 +38,10 @@ public:
 	void setMute(bool mute);
 	virtual bool forceSeekToFrame(uint frame) { return false; }
 	virtual bool endOfFrames() const { return false; }
+
+protected:
+	// The dirty rects and forced seeks read the tracks directly
+	bool supportsDecodeAhead() const override { return false; }
 };
 
 class NightlongSmackerDecoder : public NightlongVideoDecoder {
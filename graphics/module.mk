@@ -56,6 +56,7 @@ MODULE_OBJS := \
 	riscoscursor.o \
 	renderer.o \
 	scalerplugin.o \
+	scalerpool.o \
 	scaler/downscaler.o \
 	scaler/thumbnail_intern.o \
 	screen.o \
@@ -167,7 +168,17 @@ MODULE_OBJS += \
 	tinygl/zmath.o \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
-	tinygl/zdirtyrect.o
+	tinygl/zdirtyrect.o \
+	tinygl/ztiles.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/zspan-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/zspan-sse2.o
+endif
 endif
 
 ifdef USE_ASPECT
@@ -191,6 +202,19 @@ MODULE_OBJS += \
 	scaler/Normal2xARM.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/scale2x-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/scale2x-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/scale2x-avx2.o
+endif
+
 ifdef USE_HQ_SCALERS
 MODULE_OBJS += \
 	scaler/hq.o
@@ -201,6 +225,19 @@ MODULE_OBJS += \
 	scaler/hq3x_i386.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/hq-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/hq-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/hq-avx2.o
+endif
+
 endif
 
 ifdef USE_EDGE_SCALERS
@@ -217,15 +254,18 @@ endif
 
 ifdef SCUMMVM_NEON
 MODULE_OBJS += \
-	blit/blit-neon.o
+	blit/blit-neon.o \
+	yuv_to_rgb-neon.o
 endif
 ifdef SCUMMVM_SSE2
 MODULE_OBJS += \
-	blit/blit-sse2.o
+	blit/blit-sse2.o \
+	yuv_to_rgb-sse2.o
 endif
 ifdef SCUMMVM_AVX2
 MODULE_OBJS += \
-	blit/blit-avx2.o
+	blit/blit-avx2.o \
+	yuv_to_rgb-avx2.o
 endif
 
 # Include common rules
@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/endian.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+/**
+ * AVX2 version of diffYUV() for eight pixels. Returns all bits set in
+ * every lane where the two YUV values differ noticeably.
+ */
+static FORCEINLINE __m256i diffYUV_AVX2(__m256i yuv1, __m256i yuv2) {
+	const __m256i diffY = _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(_mm256_and_si256(yuv1, _mm256_set1_epi32(0x00FF0000)), _mm256_and_si256(yuv2, _mm256_set1_epi32(0x00FF0000)))), _mm256_set1_epi32(0x00300000));
+	const __m256i diffU = _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(_mm256_and_si256(yuv1, _mm256_set1_epi32(0x0000FF00)), _mm256_and_si256(yuv2, _mm256_set1_epi32(0x0000FF00)))), _mm256_set1_epi32(0x00000700));
+	const __m256i diffV = _mm256_cmpgt_epi32(_mm256_abs_epi32(_mm256_sub_epi32(_mm256_and_si256(yuv1, _mm256_set1_epi32(0x000000FF)), _mm256_and_si256(yuv2, _mm256_set1_epi32(0x000000FF)))), _mm256_set1_epi32(0x00000006));
+	return _mm256_or_si256(diffY, _mm256_or_si256(diffU, diffV));
+}
+
+static FORCEINLINE __m256i patternBit(__m256i yuv5, const uint32 *neighbour, int bit) {
+	return _mm256_and_si256(diffYUV_AVX2(yuv5, _mm256_loadu_si256((const __m256i *)neighbour)), _mm256_set1_epi32(bit));
+}
+
+void HQScaler::computePatternsAVX2(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width) {
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m256i yuv5 = _mm256_loadu_si256((const __m256i *)(yuv1 + x));
+
+		__m256i pattern = patternBit(yuv5, yuv0 + x - 1, 0x0001);
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv0 + x,     0x0002));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv0 + x + 1, 0x0004));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv1 + x - 1, 0x0008));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv1 + x + 1, 0x0010));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv2 + x - 1, 0x0020));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv2 + x,     0x0040));
+		pattern = _mm256_or_si256(pattern, patternBit(yuv5, yuv2 + x + 1, 0x0080));
+
+		// Narrow the eight 32-bit patterns down to bytes. The pack
+		// instructions work within each 128-bit lane, so each lane
+		// ends up holding four of the patterns in its lowest bytes.
+		pattern = _mm256_packs_epi32(pattern, pattern);
+		pattern = _mm256_packus_epi16(pattern, pattern);
+		WRITE_UINT32(patterns + x, _mm_cvtsi128_si32(_mm256_castsi256_si128(pattern)));
+		WRITE_UINT32(patterns + x + 4, _mm_cvtsi128_si32(_mm256_extracti128_si256(pattern, 1)));
+	}
+
+	computePatternsGeneric(yuv0 + x, yuv1 + x, yuv2 + x, patterns + x, width - x);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "common/endian.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+/**
+ * NEON version of diffYUV() for four pixels. Returns all bits set in
+ * every lane where the two YUV values differ noticeably.
+ */
+static FORCEINLINE uint32x4_t diffYUV_NEON(uint32x4_t yuv1, uint32x4_t yuv2) {
+	const uint32x4_t diffY = vcgtq_u32(vabdq_u32(vandq_u32(yuv1, vdupq_n_u32(0x00FF0000)), vandq_u32(yuv2, vdupq_n_u32(0x00FF0000))), vdupq_n_u32(0x00300000));
+	const uint32x4_t diffU = vcgtq_u32(vabdq_u32(vandq_u32(yuv1, vdupq_n_u32(0x0000FF00)), vandq_u32(yuv2, vdupq_n_u32(0x0000FF00))), vdupq_n_u32(0x00000700));
+	const uint32x4_t diffV = vcgtq_u32(vabdq_u32(vandq_u32(yuv1, vdupq_n_u32(0x000000FF)), vandq_u32(yuv2, vdupq_n_u32(0x000000FF))), vdupq_n_u32(0x00000006));
+	return vorrq_u32(diffY, vorrq_u32(diffU, diffV));
+}
+
+static FORCEINLINE uint32x4_t patternBit(uint32x4_t yuv5, const uint32 *neighbour, uint32 bit) {
+	return vandq_u32(diffYUV_NEON(yuv5, vld1q_u32(neighbour)), vdupq_n_u32(bit));
+}
+
+void HQScaler::computePatternsNEON(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width) {
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		const uint32x4_t yuv5 = vld1q_u32(yuv1 + x);
+
+		uint32x4_t pattern = patternBit(yuv5, yuv0 + x - 1, 0x0001);
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv0 + x,     0x0002));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv0 + x + 1, 0x0004));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv1 + x - 1, 0x0008));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv1 + x + 1, 0x0010));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv2 + x - 1, 0x0020));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv2 + x,     0x0040));
+		pattern = vorrq_u32(pattern, patternBit(yuv5, yuv2 + x + 1, 0x0080));
+
+		// Narrow the four 32-bit patterns down to four bytes
+		const uint16x4_t narrow16 = vmovn_u32(pattern);
+		const uint8x8_t narrow8 = vmovn_u16(vcombine_u16(narrow16, narrow16));
+		WRITE_UINT32(patterns + x, vget_lane_u32(vreinterpret_u32_u8(narrow8), 0));
+	}
+
+	computePatternsGeneric(yuv0 + x, yuv1 + x, yuv2 + x, patterns + x, width - x);
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/endian.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+static FORCEINLINE __m128i absDiffChannel(__m128i a, __m128i b, __m128i mask) {
+	const __m128i diff = _mm_sub_epi32(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+	const __m128i sign = _mm_srai_epi32(diff, 31);
+	return _mm_sub_epi32(_mm_xor_si128(diff, sign), sign);
+}
+
+/**
+ * SSE2 version of diffYUV() for four pixels. Returns all bits set in
+ * every lane where the two YUV values differ noticeably.
+ */
+static FORCEINLINE __m128i diffYUV_SSE2(__m128i yuv1, __m128i yuv2) {
+	const __m128i diffY = _mm_cmpgt_epi32(absDiffChannel(yuv1, yuv2, _mm_set1_epi32(0x00FF0000)), _mm_set1_epi32(0x00300000));
+	const __m128i diffU = _mm_cmpgt_epi32(absDiffChannel(yuv1, yuv2, _mm_set1_epi32(0x0000FF00)), _mm_set1_epi32(0x00000700));
+	const __m128i diffV = _mm_cmpgt_epi32(absDiffChannel(yuv1, yuv2, _mm_set1_epi32(0x000000FF)), _mm_set1_epi32(0x00000006));
+	return _mm_or_si128(diffY, _mm_or_si128(diffU, diffV));
+}
+
+static FORCEINLINE __m128i patternBit(__m128i yuv5, const uint32 *neighbour, int bit) {
+	return _mm_and_si128(diffYUV_SSE2(yuv5, _mm_loadu_si128((const __m128i *)neighbour)), _mm_set1_epi32(bit));
+}
+
+void HQScaler::computePatternsSSE2(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width) {
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		const __m128i yuv5 = _mm_loadu_si128((const __m128i *)(yuv1 + x));
+
+		__m128i pattern = patternBit(yuv5, yuv0 + x - 1, 0x0001);
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv0 + x,     0x0002));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv0 + x + 1, 0x0004));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv1 + x - 1, 0x0008));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv1 + x + 1, 0x0010));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv2 + x - 1, 0x0020));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv2 + x,     0x0040));
+		pattern = _mm_or_si128(pattern, patternBit(yuv5, yuv2 + x + 1, 0x0080));
+
+		// Narrow the four 32-bit patterns down to four bytes
+		pattern = _mm_packs_epi32(pattern, pattern);
+		pattern = _mm_packus_epi16(pattern, pattern);
+		WRITE_UINT32(patterns + x, _mm_cvtsi128_si32(pattern));
+	}
+
+	computePatternsGeneric(yuv0 + x, yuv1 + x, yuv2 + x, patterns + x, width - x);
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
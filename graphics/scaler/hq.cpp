@@ -18,6 +18,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "common/system.h"
+
 #include "graphics/scaler/hq.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
@@ -199,7 +201,7 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, const uint8 *patterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -238,18 +240,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
-
-			switch (pattern) {
+			switch (*patterns++) {
 			case 0:
 			case 1:
 			case 4:
@@ -2116,7 +2107,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, const uint8 *patterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -2156,18 +2147,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
-
-			switch (pattern) {
+			switch (*patterns++) {
 			case 0:
 			case 1:
 			case 4:
@@ -4947,13 +4927,88 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	}
 }
 
+/**
+ * Convert a row of pixels to YUV for the pattern computation.
+ */
+template<typename ColorMask>
+static inline void HQ_convertRowToYUV(const typename ColorMask::PixelType *src, uint32 *dst, int count, const uint32 *RGBtoYUV) {
+	for (int i = 0; i < count; i++) {
+		if (sizeof(typename ColorMask::PixelType) == 2)
+			dst[i] = RGBtoYUV[src[i]];
+		else
+			dst[i] = ConvertYUV<ColorMask>(src[i], RGBtoYUV);
+	}
+}
+
+void HQScaler::computePatternsGeneric(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width) {
+	for (int x = 0; x < width; x++) {
+		const uint32 yuv5 = yuv1[x];
+
+		int pattern = 0;
+		if (yuv5 != yuv0[x - 1] && diffYUV(yuv5, yuv0[x - 1])) pattern |= 0x0001;
+		if (yuv5 != yuv0[x]     && diffYUV(yuv5, yuv0[x]))     pattern |= 0x0002;
+		if (yuv5 != yuv0[x + 1] && diffYUV(yuv5, yuv0[x + 1])) pattern |= 0x0004;
+		if (yuv5 != yuv1[x - 1] && diffYUV(yuv5, yuv1[x - 1])) pattern |= 0x0008;
+		if (yuv5 != yuv1[x + 1] && diffYUV(yuv5, yuv1[x + 1])) pattern |= 0x0010;
+		if (yuv5 != yuv2[x - 1] && diffYUV(yuv5, yuv2[x - 1])) pattern |= 0x0020;
+		if (yuv5 != yuv2[x]     && diffYUV(yuv5, yuv2[x]))     pattern |= 0x0040;
+		if (yuv5 != yuv2[x + 1] && diffYUV(yuv5, yuv2[x + 1])) pattern |= 0x0080;
+
+		patterns[x] = pattern;
+	}
+}
+
+/**
+ * Compute the neighbourhood pattern of every pixel in the rect up front,
+ * so that the pattern detection can use the SIMD row functions while the
+ * per-pixel interpolation switch stays scalar.
+ */
+template<typename ColorMask>
+const uint8 *HQScaler::computePatterns(const uint8 *srcPtr, uint32 srcPitch, int width, int height) {
+	typedef typename ColorMask::PixelType Pixel;
+
+	// Each YUV row also covers the pixel to the left and to the right
+	const int rowSize = width + 2;
+	_yuvBuffer.resize(rowSize * 3);
+	_patternBuffer.resize(width * height);
+
+	uint32 *rows[3] = { &_yuvBuffer[0], &_yuvBuffer[rowSize], &_yuvBuffer[rowSize * 2] };
+	HQ_convertRowToYUV<ColorMask>((const Pixel *)(srcPtr - srcPitch) - 1, rows[0], rowSize, _RGBtoYUV);
+	HQ_convertRowToYUV<ColorMask>((const Pixel *)srcPtr - 1, rows[1], rowSize, _RGBtoYUV);
+
+	uint8 *patterns = _patternBuffer.data();
+	for (int y = 0; y < height; y++) {
+		HQ_convertRowToYUV<ColorMask>((const Pixel *)(srcPtr + (y + 1) * srcPitch) - 1, rows[2], rowSize, _RGBtoYUV);
+
+		_patternFunc(rows[0] + 1, rows[1] + 1, rows[2] + 1, patterns, width);
+		patterns += width;
+
+		uint32 *tmp = rows[0];
+		rows[0] = rows[1];
+		rows[1] = rows[2];
+		rows[2] = tmp;
+	}
+
+	return _patternBuffer.data();
+}
+
 HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 #ifdef USE_NASM
 	_hqx_params(nullptr),
 #endif
-	_RGBtoYUV(nullptr) {
+	_RGBtoYUV(nullptr), _patternFunc(computePatternsGeneric) {
 	_factor = 2;
 
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) _patternFunc = computePatternsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) _patternFunc = computePatternsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) _patternFunc = computePatternsAVX2;
+#endif
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4987,19 +5042,23 @@ void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<565> >(srcPtr, srcPitch, width, height));
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<555> >(srcPtr, srcPitch, width, height));
 }
 
 void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<565> >(srcPtr, srcPitch, width, height));
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<555> >(srcPtr, srcPitch, width, height));
 }
 #endif
 
@@ -5007,15 +5066,18 @@ void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV,
+					computePatterns<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, width, height));
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV,
+					computePatterns<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, width, height));
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<888> >(srcPtr, srcPitch, width, height));
 	}
 }
 
@@ -5023,15 +5085,18 @@ void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV,
+					computePatterns<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, width, height));
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV,
+					computePatterns<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, width, height));
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV,
+				computePatterns<Graphics::ColorMasks<888> >(srcPtr, srcPitch, width, height));
 	}
 }
 
@@ -21,6 +21,7 @@
 #ifndef GRAPHICS_SCALER_HQ_H
 #define GRAPHICS_SCALER_HQ_H
 
+#include "common/array.h"
 #include "graphics/scalerplugin.h"
 
 #ifdef USE_NASM
@@ -33,6 +34,30 @@ public:
 	~HQScaler();
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+
+	/**
+	 * Compute the HQ neighbourhood pattern of one row of pixels.
+	 *
+	 * @param yuv0     YUV values of the previous row.
+	 * @param yuv1     YUV values of the current row.
+	 * @param yuv2     YUV values of the next row.
+	 * @param patterns Receives one pattern byte per pixel.
+	 * @param width    The number of pixels in the row. The YUV rows must
+	 *                 be readable from index -1 up to and including width.
+	 */
+	typedef void (*PatternFunc)(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width);
+
+	static void computePatternsGeneric(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width);
+#ifdef SCUMMVM_NEON
+	static void computePatternsNEON(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void computePatternsSSE2(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void computePatternsAVX2(const uint32 *yuv0, const uint32 *yuv1, const uint32 *yuv2, uint8 *patterns, int width);
+#endif
+
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
@@ -43,7 +68,13 @@ protected:
 	inline void HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 
+	template<typename ColorMask>
+	const uint8 *computePatterns(const uint8 *srcPtr, uint32 srcPitch, int width, int height);
+
 	uint32 *_RGBtoYUV;
+	PatternFunc _patternFunc;
+	Common::Array<uint32> _yuvBuffer;
+	Common::Array<uint8> _patternBuffer;
 #ifdef USE_NASM
 	hqx_parameters *_hqx_params;
 #endif
@@ -0,0 +1,162 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/scale2x.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+template<typename Pixel>
+struct Scale2xNEON;
+
+template<>
+struct Scale2xNEON<scale2x_uint8> {
+	typedef uint8x16_t Vec;
+	static FORCEINLINE Vec load(const scale2x_uint8 *p) { return vld1q_u8(p); }
+	static FORCEINLINE Vec cmpeq(Vec a, Vec b) { return vceqq_u8(a, b); }
+	static FORCEINLINE Vec orr(Vec a, Vec b) { return vorrq_u8(a, b); }
+	static FORCEINLINE Vec bic(Vec a, Vec b) { return vbicq_u8(a, b); }
+	static FORCEINLINE Vec select(Vec mask, Vec a, Vec b) { return vbslq_u8(mask, a, b); }
+	static FORCEINLINE void store(scale2x_uint8 *p, Vec a, Vec b) {
+		uint8x16x2_t v = {{ a, b }};
+		vst2q_u8(p, v);
+	}
+};
+
+template<>
+struct Scale2xNEON<scale2x_uint16> {
+	typedef uint16x8_t Vec;
+	static FORCEINLINE Vec load(const scale2x_uint16 *p) { return vld1q_u16(p); }
+	static FORCEINLINE Vec cmpeq(Vec a, Vec b) { return vceqq_u16(a, b); }
+	static FORCEINLINE Vec orr(Vec a, Vec b) { return vorrq_u16(a, b); }
+	static FORCEINLINE Vec bic(Vec a, Vec b) { return vbicq_u16(a, b); }
+	static FORCEINLINE Vec select(Vec mask, Vec a, Vec b) { return vbslq_u16(mask, a, b); }
+	static FORCEINLINE void store(scale2x_uint16 *p, Vec a, Vec b) {
+		uint16x8x2_t v = {{ a, b }};
+		vst2q_u16(p, v);
+	}
+};
+
+template<>
+struct Scale2xNEON<scale2x_uint32> {
+	typedef uint32x4_t Vec;
+	static FORCEINLINE Vec load(const scale2x_uint32 *p) { return vld1q_u32(p); }
+	static FORCEINLINE Vec cmpeq(Vec a, Vec b) { return vceqq_u32(a, b); }
+	static FORCEINLINE Vec orr(Vec a, Vec b) { return vorrq_u32(a, b); }
+	static FORCEINLINE Vec bic(Vec a, Vec b) { return vbicq_u32(a, b); }
+	static FORCEINLINE Vec select(Vec mask, Vec a, Vec b) { return vbslq_u32(mask, a, b); }
+	static FORCEINLINE void store(scale2x_uint32 *p, Vec a, Vec b) {
+		uint32x4x2_t v = {{ a, b }};
+		vst2q_u32(p, v);
+	}
+};
+
+/**
+ * Scale both destination rows at once, 16 bytes of source pixels per
+ * iteration. The remaining pixels are left for the C implementation.
+ * @return The number of source pixels processed.
+ */
+template<typename Pixel>
+static inline unsigned scale2x_neon(Pixel *dst0, Pixel *dst1, const Pixel *src0, const Pixel *src1, const Pixel *src2, unsigned count) {
+	typedef Scale2xNEON<Pixel> Ops;
+	typedef typename Ops::Vec Vec;
+
+	const unsigned step = 16 / sizeof(Pixel);
+	unsigned done = 0;
+
+	for (; done + step <= count; done += step) {
+		const Vec b = Ops::load(src0 + done);
+		const Vec d = Ops::load(src1 + done - 1);
+		const Vec e = Ops::load(src1 + done);
+		const Vec f = Ops::load(src1 + done + 1);
+		const Vec h = Ops::load(src2 + done);
+
+		// Pixels where B == H or D == F are copied unchanged
+		const Vec same = Ops::orr(Ops::cmpeq(b, h), Ops::cmpeq(d, f));
+
+		const Vec e0 = Ops::select(Ops::bic(Ops::cmpeq(d, b), same), b, e);
+		const Vec e1 = Ops::select(Ops::bic(Ops::cmpeq(f, b), same), b, e);
+		const Vec e2 = Ops::select(Ops::bic(Ops::cmpeq(d, h), same), h, e);
+		const Vec e3 = Ops::select(Ops::bic(Ops::cmpeq(f, h), same), h, e);
+
+		// vst2 interleaves the two vectors, which is exactly the 2x layout
+		Ops::store(dst0 + 2 * done, e0, e1);
+		Ops::store(dst1 + 2 * done, e2, e3);
+	}
+
+	return done;
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 8 bits.
+ * This function operates like scale2x_8_def() but uses NEON.
+ */
+void scale2x_8_neon(scale2x_uint8* dst0, scale2x_uint8* dst1, const scale2x_uint8* src0, const scale2x_uint8* src1, const scale2x_uint8* src2, unsigned count) {
+	const unsigned done = scale2x_neon(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_8_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 16 bits.
+ * This function operates like scale2x_16_def() but uses NEON.
+ */
+void scale2x_16_neon(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count) {
+	const unsigned done = scale2x_neon(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_16_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 32 bits.
+ * This function operates like scale2x_32_def() but uses NEON.
+ */
+void scale2x_32_neon(scale2x_uint32* dst0, scale2x_uint32* dst1, const scale2x_uint32* src0, const scale2x_uint32* src1, const scale2x_uint32* src2, unsigned count) {
+	const unsigned done = scale2x_neon(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_32_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/scale2x.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+template<typename Pixel>
+static FORCEINLINE __m128i scale2x_sse2_cmpeq(__m128i a, __m128i b) {
+	if (sizeof(Pixel) == 1)
+		return _mm_cmpeq_epi8(a, b);
+	else if (sizeof(Pixel) == 2)
+		return _mm_cmpeq_epi16(a, b);
+	else
+		return _mm_cmpeq_epi32(a, b);
+}
+
+template<typename Pixel>
+static FORCEINLINE void scale2x_sse2_store(Pixel *dst, __m128i a, __m128i b) {
+	__m128i lo, hi;
+	if (sizeof(Pixel) == 1) {
+		lo = _mm_unpacklo_epi8(a, b);
+		hi = _mm_unpackhi_epi8(a, b);
+	} else if (sizeof(Pixel) == 2) {
+		lo = _mm_unpacklo_epi16(a, b);
+		hi = _mm_unpackhi_epi16(a, b);
+	} else {
+		lo = _mm_unpacklo_epi32(a, b);
+		hi = _mm_unpackhi_epi32(a, b);
+	}
+	_mm_storeu_si128((__m128i *)dst, lo);
+	_mm_storeu_si128((__m128i *)(dst + 16 / sizeof(Pixel)), hi);
+}
+
+static FORCEINLINE __m128i scale2x_sse2_select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Scale both destination rows at once, 16 bytes of source pixels per
+ * iteration. The remaining pixels are left for the C implementation.
+ * @return The number of source pixels processed.
+ */
+template<typename Pixel>
+static inline unsigned scale2x_sse2(Pixel *dst0, Pixel *dst1, const Pixel *src0, const Pixel *src1, const Pixel *src2, unsigned count) {
+	const unsigned step = 16 / sizeof(Pixel);
+	unsigned done = 0;
+
+	for (; done + step <= count; done += step) {
+		const __m128i b = _mm_loadu_si128((const __m128i *)(src0 + done));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(src1 + done - 1));
+		const __m128i e = _mm_loadu_si128((const __m128i *)(src1 + done));
+		const __m128i f = _mm_loadu_si128((const __m128i *)(src1 + done + 1));
+		const __m128i h = _mm_loadu_si128((const __m128i *)(src2 + done));
+
+		// Pixels where B == H or D == F are copied unchanged
+		const __m128i same = _mm_or_si128(scale2x_sse2_cmpeq<Pixel>(b, h), scale2x_sse2_cmpeq<Pixel>(d, f));
+
+		const __m128i e0 = scale2x_sse2_select(_mm_andnot_si128(same, scale2x_sse2_cmpeq<Pixel>(d, b)), b, e);
+		const __m128i e1 = scale2x_sse2_select(_mm_andnot_si128(same, scale2x_sse2_cmpeq<Pixel>(f, b)), b, e);
+		const __m128i e2 = scale2x_sse2_select(_mm_andnot_si128(same, scale2x_sse2_cmpeq<Pixel>(d, h)), h, e);
+		const __m128i e3 = scale2x_sse2_select(_mm_andnot_si128(same, scale2x_sse2_cmpeq<Pixel>(f, h)), h, e);
+
+		scale2x_sse2_store<Pixel>(dst0 + 2 * done, e0, e1);
+		scale2x_sse2_store<Pixel>(dst1 + 2 * done, e2, e3);
+	}
+
+	return done;
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 8 bits.
+ * This function operates like scale2x_8_def() but uses SSE2.
+ */
+void scale2x_8_sse2(scale2x_uint8* dst0, scale2x_uint8* dst1, const scale2x_uint8* src0, const scale2x_uint8* src1, const scale2x_uint8* src2, unsigned count) {
+	const unsigned done = scale2x_sse2(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_8_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 16 bits.
+ * This function operates like scale2x_16_def() but uses SSE2.
+ */
+void scale2x_16_sse2(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count) {
+	const unsigned done = scale2x_sse2(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_16_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+/**
+ * Scale by a factor of 2 a row of pixels of 32 bits.
+ * This function operates like scale2x_32_def() but uses SSE2.
+ */
+void scale2x_32_sse2(scale2x_uint32* dst0, scale2x_uint32* dst1, const scale2x_uint32* src0, const scale2x_uint32* src1, const scale2x_uint32* src2, unsigned count) {
+	const unsigned done = scale2x_sse2(dst0, dst1, src0, src1, src2, count);
+	if (done < count)
+		scale2x_32_def(dst0 + 2 * done, dst1 + 2 * done, src0 + done, src1 + done, src2 + done, count - done);
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -35,6 +35,7 @@
  */
 
 #include "common/scummsys.h"
+#include "common/system.h"
 
 #include "graphics/scaler/scale2x.h"
 #include "graphics/scaler/scale3x.h"
@@ -43,30 +44,77 @@
 #define DST(bits, num)	(scale2x_uint ## bits *)dst ## num
 #define SRC(bits, num)	(const scale2x_uint ## bits *)src ## num
 
+typedef void (*Scale2xFunc8)(scale2x_uint8* dst0, scale2x_uint8* dst1, const scale2x_uint8* src0, const scale2x_uint8* src1, const scale2x_uint8* src2, unsigned count);
+typedef void (*Scale2xFunc16)(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count);
+typedef void (*Scale2xFunc32)(scale2x_uint32* dst0, scale2x_uint32* dst1, const scale2x_uint32* src0, const scale2x_uint32* src1, const scale2x_uint32* src2, unsigned count);
+
+static Scale2xFunc8 scale2x_8_func = nullptr;
+static Scale2xFunc16 scale2x_16_func = nullptr;
+static Scale2xFunc32 scale2x_32_func = nullptr;
+
 /**
- * Apply the Scale2x effect on a group of rows. Used internally.
+ * Select the Scale2x row implementation. The SIMD versions are picked at
+ * runtime if the CPU supports them, otherwise the compile-time default is used.
+ *
+ * This is called when an AdvMameScaler is created, on the thread that sets up
+ * the graphics mode, so the pointers are settled before any scaling work is
+ * split across threads.
  */
-static inline void stage_scale2x(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, unsigned pixel, unsigned pixel_per_row) {
-	switch (pixel) {
+static void scale2x_select() {
 #if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
-	case 1: scale2x_8_mmx( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_mmx(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_mmx(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+	scale2x_8_func = scale2x_8_mmx;
+	scale2x_16_func = scale2x_16_mmx;
+	scale2x_32_func = scale2x_32_mmx;
 #elif defined(USE_ARM_SCALER_ASM)
-	case 1: scale2x_8_arm( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_arm(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_arm(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+	scale2x_8_func = scale2x_8_arm;
+	scale2x_16_func = scale2x_16_arm;
+	scale2x_32_func = scale2x_32_arm;
 #else
-	case 1: scale2x_8_def( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
-	case 2: scale2x_16_def(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
-	case 4: scale2x_32_def(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
+	scale2x_8_func = scale2x_8_def;
+	scale2x_16_func = scale2x_16_def;
+	scale2x_32_func = scale2x_32_def;
+#endif
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		scale2x_8_func = scale2x_8_neon;
+		scale2x_16_func = scale2x_16_neon;
+		scale2x_32_func = scale2x_32_neon;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		scale2x_8_func = scale2x_8_sse2;
+		scale2x_16_func = scale2x_16_sse2;
+		scale2x_32_func = scale2x_32_sse2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		scale2x_8_func = scale2x_8_avx2;
+		scale2x_16_func = scale2x_16_avx2;
+		scale2x_32_func = scale2x_32_avx2;
+	}
 #endif
+}
+
+/**
+ * Apply the Scale2x effect on a group of rows. Used internally.
+ */
+static inline void stage_scale2x(void* dst0, void* dst1, const void* src0, const void* src1, const void* src2, unsigned pixel, unsigned pixel_per_row) {
+	switch (pixel) {
+	case 1: scale2x_8_func( DST( 8,0), DST( 8,1), SRC( 8,0), SRC( 8,1), SRC( 8,2), pixel_per_row); break;
+	case 2: scale2x_16_func(DST(16,0), DST(16,1), SRC(16,0), SRC(16,1), SRC(16,2), pixel_per_row); break;
+	case 4: scale2x_32_func(DST(32,0), DST(32,1), SRC(32,0), SRC(32,1), SRC(32,2), pixel_per_row); break;
 	default: break;
 	}
 }
 
 /**
  * Apply the Scale3x effect on a group of rows. Used internally.
+ *
+ * There are no SIMD versions of the Scale3x rows; each output pixel depends on
+ * a different set of comparisons, which does not pay off the way Scale2x does.
  */
 static inline void stage_scale3x(void* dst0, void* dst1, void* dst2, const void* src0, const void* src1, const void* src2, unsigned pixel, unsigned pixel_per_row) {
 	switch (pixel) {
@@ -166,8 +214,9 @@ static void scale3x(void* void_dst, unsigned dst_slice, const void* void_src, un
  * The destination bitmap must be manually allocated before calling the function,
  * note that the resulting size is exactly 4x4 times the size of the source bitmap.
  * \note This function requires also a small buffer bitmap used internally to store
- * intermediate results. This bitmap must have at least a horizontal size in bytes of 2*width*pixel,
- * and a vertical size of 6 rows. The memory of this buffer must not be allocated
+ * intermediate results. This bitmap must have at least a horizontal size in bytes of 2*(width+2)*pixel,
+ * and a vertical size of 6 rows. The intermediate rows include one source pixel on either
+ * side, which the second pass reads, so the source must be padded by two pixels. The memory of this buffer must not be allocated
  * in video memory because it's also read and not only written. Generally
  * a heap (malloc) or a stack (alloca) buffer is the best choices.
  * @param void_dst Pointer at the first pixel of the destination bitmap.
@@ -198,13 +247,13 @@ static void scale4x_buf(void* void_dst, unsigned dst_slice, void* void_mid, unsi
 	mid[4] = mid[3] + mid_slice;
 	mid[5] = mid[4] + mid_slice;
 
-	stage_scale2x(SCMID(0), SCMID(1), SCSRC(0), SCSRC(1), SCSRC(2), pixel, width);
-	stage_scale2x(SCMID(2), SCMID(3), SCSRC(1), SCSRC(2), SCSRC(3), pixel, width);
+	stage_scale2x(SCMID(0), SCMID(1), SCSRC(0) - pixel, SCSRC(1) - pixel, SCSRC(2) - pixel, pixel, width + 2);
+	stage_scale2x(SCMID(2), SCMID(3), SCSRC(1) - pixel, SCSRC(2) - pixel, SCSRC(3) - pixel, pixel, width + 2);
 	while (count) {
 		unsigned char* tmp;
 
-		stage_scale2x(SCMID(4), SCMID(5), SCSRC(2), SCSRC(3), SCSRC(4), pixel, width);
-		stage_scale4x(SCDST(0), SCDST(1), SCDST(2), SCDST(3), SCMID(1), SCMID(2), SCMID(3), SCMID(4), pixel, width);
+		stage_scale2x(SCMID(4), SCMID(5), SCSRC(2) - pixel, SCSRC(3) - pixel, SCSRC(4) - pixel, pixel, width + 2);
+		stage_scale4x(SCDST(0), SCDST(1), SCDST(2), SCDST(3), SCMID(1) + 2 * pixel, SCMID(2) + 2 * pixel, SCMID(3) + 2 * pixel, SCMID(4) + 2 * pixel, pixel, width);
 
 		dst = SCDST(4);
 		src = SCSRC(1);
@@ -246,7 +295,7 @@ static void scale4x(void* void_dst, unsigned dst_slice, const void* void_src, un
 	unsigned mid_slice;
 	void* mid;
 
-	mid_slice = 2 * pixel * width; /* required space for 1 row buffer */
+	mid_slice = 2 * pixel * (width + 2); /* required space for 1 row buffer */
 
 	mid_slice = (mid_slice + 0x7) & ~0x7; /* align to 8 bytes */
 
@@ -338,6 +387,8 @@ int scale_precondition(unsigned scale, unsigned pixel, unsigned width, unsigned
  */
 void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height)
 {
+	assert(scale2x_8_func);
+
 	switch (scale) {
 	case 2:
 		scale2x(void_dst, dst_slice, void_src, src_slice, pixel, width, height);
@@ -353,6 +404,11 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+AdvMameScaler::AdvMameScaler(const Graphics::PixelFormat &format) : Scaler(format) {
+	_factor = 2;
+	scale2x_select();
+}
+
 void AdvMameScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
 	if (_factor != 4)
@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphics/scalerpool.h"
+
+ScalerPool::ScalerPool(uint numThreads) : _pool(MAX<uint>(numThreads, 2) - 1, "ScummVM scaler") {
+}
+
+ScalerPool::~ScalerPool() {
+	_pool.wait();
+	clearScalers();
+}
+
+void ScalerPool::clearScalers() {
+	for (auto &scaler : _scalers)
+		delete scaler;
+	_scalers.clear();
+}
+
+void ScalerPool::setScaler(const ScalerPluginObject *plugin, const Graphics::PixelFormat &format) {
+	clearScalers();
+
+	// The scalers are all created here, on the calling thread, so that any
+	// one-time setup in their constructors never runs concurrently
+	for (uint i = 0; i < _pool.getThreadCount(); i++)
+		_scalers.push_back(plugin->createInstance(format));
+}
+
+void ScalerPool::scale(Scaler *mainScaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+                       uint32 dstPitch, int width, int height, int x, int y) {
+	const uint numBands = MIN<uint>(_scalers.size() + 1, height / kMinBandHeight);
+	if (numBands < 2) {
+		mainScaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	const uint factor = mainScaler->getFactor();
+	const int bandHeight = (height + numBands - 1) / numBands;
+
+	for (uint i = 1; i < numBands; i++) {
+		const int bandY = i * bandHeight;
+		if (bandY >= height)
+			break;
+
+		Scaler *scaler = _scalers[i - 1];
+		if (scaler->getFactor() != factor)
+			scaler->setFactor(factor);
+
+		const uint8 *bandSrc = srcPtr + bandY * srcPitch;
+		uint8 *bandDst = dstPtr + bandY * factor * dstPitch;
+		const int bandRows = MIN(bandHeight, height - bandY);
+		_pool.submit([=]() {
+			scaler->scale(bandSrc, srcPitch, bandDst, dstPitch, width, bandRows, x, y + bandY);
+		});
+	}
+
+	mainScaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, bandHeight, x, y);
+
+	// Join the bands before the caller touches the destination surface
+	_pool.wait();
+}
@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHICS_SCALERPOOL_H
+#define GRAPHICS_SCALERPOOL_H
+
+#include "common/array.h"
+#include "common/threadpool.h"
+#include "graphics/scalerplugin.h"
+
+/**
+ * Scales large rects in horizontal bands on a thread pool.
+ *
+ * Every band scaled off the calling thread has its own scaler instance,
+ * since scalers keep per-instance scratch buffers. Each band reads the
+ * extraPixels() rows above and below it straight from the padded source
+ * surface, so the bands join without seams. Scalers which compare against
+ * the old source (useOldSource()) keep state spanning the whole screen and
+ * must not be used with the pool.
+ */
+class ScalerPool : Common::NonCopyable {
+public:
+	/**
+	 * @param numThreads The total number of threads taking part in scaling,
+	 *                   including the calling thread. Must be at least 2.
+	 */
+	ScalerPool(uint numThreads);
+	~ScalerPool();
+
+	/**
+	 * Create the band scalers. Must be called whenever the main scaler
+	 * is recreated.
+	 */
+	void setScaler(const ScalerPluginObject *plugin, const Graphics::PixelFormat &format);
+
+	/**
+	 * Scale a rect, splitting it up between the threads if it is large
+	 * enough. The first band is scaled on the calling thread with
+	 * mainScaler. Returns once all bands have been scaled.
+	 *
+	 * @see Scaler::scale
+	 */
+	void scale(Scaler *mainScaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	           uint32 dstPitch, int width, int height, int x, int y);
+
+	/** Return the number of threads taking part in scaling. */
+	uint getThreadCount() const { return _pool.getThreadCount() + 1; }
+
+	/** Bands smaller than this are not worth handing to another thread. */
+	static const int kMinBandHeight = 16;
+
+private:
+	void clearScalers();
+
+	Common::ThreadPool _pool;
+	Common::Array<Scaler *> _scalers;
+};
+
+#endif
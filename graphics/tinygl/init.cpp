@@ -27,11 +27,13 @@
 
 #include "common/singleton.h"
 #include "common/array.h"
+#include "common/config-manager.h"
 
 #include "graphics/tinygl/tinygl.h"
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/zblit.h"
 #include "graphics/tinygl/zdirtyrect.h"
+#include "graphics/tinygl/ztiles.h"
 
 namespace TinyGL {
 
@@ -103,6 +105,8 @@ ContextHandle *createContext(int screenW, int screenH, Graphics::PixelFormat pix
 	gl_ctx = GLContextArray::instance().createContext();
 	gl_ctx->init(screenW, screenH, pixelFormat, textureSize, enableStencilBuffer,
 				 dirtyRectsEnable, drawCallMemorySize);
+	// Drawing on several threads is opt-in
+	gl_ctx->setRenderThreads(ConfMan.getInt("tinygl_threads"));
 	return (ContextHandle *)gl_ctx;
 }
 
@@ -120,6 +124,10 @@ void destroyContext(ContextHandle *handle) {
 		GLContextArray::destroy();
 }
 
+void setRenderThreads(int numThreads) {
+	gl_get_context()->setRenderThreads(numThreads);
+}
+
 void setContext(ContextHandle *handle) {
 	GLContext *ctx = GLContextArray::instance().getContext(handle);
 	if (ctx == nullptr) {
@@ -359,6 +367,15 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	_drawCallAllocator[1].initialize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
+	_tileRasterizer = nullptr;
+}
+
+void GLContext::setRenderThreads(int numThreads) {
+	delete _tileRasterizer;
+	_tileRasterizer = nullptr;
+
+	if (numThreads > 1)
+		_tileRasterizer = new TileRasterizer(numThreads);
 }
 
 void GLContext::deinit() {
@@ -371,6 +388,7 @@ void GLContext::deinit() {
 	free_texture(default_texture);
 	endSharedState();
 	gl_free(vertex);
+	delete _tileRasterizer;
 	delete fb;
 }
 
@@ -37,6 +37,11 @@ ContextHandle *createContext(int screenW, int screenH, Graphics::PixelFormat pix
 void destroyContext();
 void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
+/**
+ * Set the number of threads the current context draws with, including the
+ * calling thread. 0 or 1 draws everything on the calling thread.
+ */
+void setRenderThreads(int numThreads);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
 void getSurfaceRef(Graphics::Surface &surface);
@@ -30,9 +30,11 @@
 #include "common/scummsys.h"
 #include "common/endian.h"
 #include "common/memory.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zspan.h"
 
 namespace TinyGL {
 
@@ -53,18 +55,49 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
 
+	_ownsBuffers = true;
+
+	// The spans are drawn with vector instructions in 32 bits formats with
+	// 8 bits per channel. The test suites draw without an OSystem.
+	_spanFuncs = nullptr;
+	if (g_system && _pbufBpp == 4 && !format.rLoss && !format.gLoss && !format.bLoss && (format.aLoss == 0 || format.aLoss == 8)) {
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			_spanFuncs = &spanFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			_spanFuncs = &spanFuncsSSE2;
+#endif
+	}
+
 	_currentTexture = nullptr;
 
 	_clippingEnabled = false;
 }
 
+FrameBuffer::FrameBuffer(const FrameBuffer *other) {
+	_textureEnv = nullptr;
+	shareBuffers(*other);
+}
+
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
+
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+void FrameBuffer::shareBuffers(const FrameBuffer &other) {
+	const GLTextureEnv *textureEnv = _textureEnv;
+	*this = other;
+	_textureEnv = textureEnv;
+	_ownsBuffers = false;
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
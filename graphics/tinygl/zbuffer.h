@@ -77,6 +77,8 @@ static const int DRAW_FLAT = 1;
 static const int DRAW_SMOOTH = 2;
 
 struct GLTextureEnv; // defined in zdirtyrect.h
+struct SpanFuncs; // defined in zspan.h
+struct SpanState;
 
 struct Buffer {
 	byte *pbuf;
@@ -107,8 +109,24 @@ struct ZBufferPoint {
 
 struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
+	/** Create a frame buffer which draws into the buffers of another one. */
+	explicit FrameBuffer(const FrameBuffer *other);
 	~FrameBuffer();
 
+	/**
+	 * Draw into the buffers of another frame buffer, taking over its state
+	 * except for the texture environment.
+	 */
+	void shareBuffers(const FrameBuffer &other);
+
+	/**
+	 * Set the functions drawing the spans of triangles with vector
+	 * instructions, or nullptr to always draw them with the generic code.
+	 */
+	void setSpanFuncs(const SpanFuncs *funcs) {
+		_spanFuncs = funcs;
+	}
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -772,6 +790,8 @@ private:
 	void fillTriangleTextureMapping(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint *p2,
 									bool kInterpZ, bool kInterpST, bool kInterpSTZ);
 
+	bool setupSpanState(SpanState &state, bool depthTest, bool depthWrite, bool alphaTest, bool blending) const;
+
 public:
 
 	void fillTriangleTextureMappingPerspectiveSmooth(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint *p2);
@@ -826,6 +846,9 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _ownsBuffers;
+
+	const SpanFuncs *_spanFuncs;
 
 	bool _enableStencil;
 	int _textureSize;
@@ -20,6 +20,7 @@
  */
 
 #include "graphics/tinygl/zdirtyrect.h"
+#include "graphics/tinygl/ztiles.h"
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/gl.h"
 
@@ -207,12 +208,20 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (auto &drawCall : _drawCallsQueue) {
-			Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+		if (canUseTileRasterizer()) {
+			Common::Array<Common::Rect> tileRects;
 			for (auto &rect : rectangles) {
-				Common::Rect dirtyRegion = rect.rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					drawCall->execute(true, &dirtyRegion);
+				tileRects.push_back(rect.rectangle);
+			}
+			_tileRasterizer->execute(this, _drawCallsQueue, tileRects);
+		} else {
+			for (auto &drawCall : _drawCallsQueue) {
+				Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+				for (auto &rect : rectangles) {
+					Common::Rect dirtyRegion = rect.rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						drawCall->execute(this, true, &dirtyRegion);
+					}
 				}
 			}
 		}
@@ -252,9 +261,19 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
-	for (const auto &drawCall : _drawCallsQueue) {
-		drawCall->execute(true);
-		delete drawCall;
+	if (canUseTileRasterizer()) {
+		Common::Array<Common::Rect> tileRects;
+		tileRects.push_back(dirtyAreas.back());
+		_tileRasterizer->execute(this, _drawCallsQueue, tileRects);
+
+		for (const auto &drawCall : _drawCallsQueue) {
+			delete drawCall;
+		}
+	} else {
+		for (const auto &drawCall : _drawCallsQueue) {
+			drawCall->execute(this, true);
+			delete drawCall;
+		}
 	}
 
 	_drawCallsQueue.clear();
@@ -264,6 +283,12 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	_drawCallAllocator[_currentAllocatorIndex].reset();
 }
 
+bool GLContext::canUseTileRasterizer() const {
+	// Selection and feedback are done in order, and the counters used for
+	// profiling are not thread-safe
+	return _tileRasterizer && render_mode == TGL_RENDER && !_profilingEnabled;
+}
+
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
@@ -306,8 +331,8 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
-	_state = captureState();
-	if (c->_enableDirtyRectangles) {
+	_state = captureState(c);
+	if (c->_enableDirtyRectangles || c->_tileRasterizer) {
 		computeDirtyRegion();
 	}
 }
@@ -345,19 +370,29 @@ void RasterizationDrawCall::computeDirtyRegion() {
 	}
 }
 
-void RasterizationDrawCall::execute(bool restoreState, const Common::Rect *clippingRectangle) const {
-	GLContext *c = gl_get_context();
-
+void RasterizationDrawCall::execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle) const {
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_state, clippingRectangle);
+	applyState(c, _state, clippingRectangle);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	if (c == gl_get_context()) {
+		c->vertex = _vertex;
+	} else {
+		// Drawing writes to the vertices, so the context of a tile, which
+		// may draw in parallel with others, draws a copy of them
+		if (c->vertex_max < _vertexCount) {
+			gl_free(c->vertex);
+			c->vertex = (GLVertex *)gl_malloc(_vertexCount * sizeof(GLVertex));
+			c->vertex_max = _vertexCount;
+			prevVertex = c->vertex;
+		}
+		memcpy(c->vertex, _vertex, sizeof(GLVertex) * _vertexCount);
+	}
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
@@ -437,13 +472,12 @@ void RasterizationDrawCall::execute(bool restoreState, const Common::Rect *clipp
 	c->vertex_cnt = prevVertexCount;
 
 	if (restoreState) {
-		applyState(backupState, nullptr);
+		applyState(c, backupState, nullptr);
 	}
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(GLContext *c) const {
 	RasterizationState state;
-	GLContext *c = gl_get_context();
 	state.enableScissor = c->scissor_test_enabled;
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
@@ -499,8 +533,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state, const Common::Rect *clippingRectangle) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state, const Common::Rect *clippingRectangle) const {
 	c->fb->setupScissor(state.enableScissor, state.scissor, clippingRectangle);
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
@@ -587,9 +620,10 @@ bool RasterizationDrawCall::operator==(const RasterizationDrawCall &other) const
 
 BlittingDrawCall::BlittingDrawCall(BlitImage *image, const BlitTransform &transform, BlittingMode blittingMode) : DrawCall(DrawCall_Blitting), _transform(transform), _mode(blittingMode), _image(image) {
 	tglIncBlitImageRef(image);
-	_blitState = captureState();
+	GLContext *c = gl_get_context();
+	_blitState = captureState(c);
 	_imageVersion = tglGetBlitImageVersion(image);
-	if (gl_get_context()->_enableDirtyRectangles) {
+	if (c->_enableDirtyRectangles || c->_tileRasterizer) {
 		computeDirtyRegion();
 	}
 }
@@ -598,12 +632,15 @@ BlittingDrawCall::~BlittingDrawCall() {
 	tglDeleteBlitImage(_image);
 }
 
-void BlittingDrawCall::execute(bool restoreState, const Common::Rect *clippingRectangle) const {
+void BlittingDrawCall::execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle) const {
+	// Blitting is done by the current context
+	assert(c == gl_get_context());
+
 	BlittingState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_blitState, clippingRectangle);
+	applyState(c, _blitState, clippingRectangle);
 
 	switch (_mode) {
 	case BlittingDrawCall::BlitMode_Regular:
@@ -619,13 +656,12 @@ void BlittingDrawCall::execute(bool restoreState, const Common::Rect *clippingRe
 		break;
 	}
 	if (restoreState) {
-		applyState(backupState, nullptr);
+		applyState(c, backupState, nullptr);
 	}
 }
 
-BlittingDrawCall::BlittingState BlittingDrawCall::captureState() const {
+BlittingDrawCall::BlittingState BlittingDrawCall::captureState(GLContext *c) const {
 	BlittingState state;
-	TinyGL::GLContext *c = gl_get_context();
 	state.enableScissor = c->scissor_test_enabled;
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
@@ -639,8 +675,7 @@ BlittingDrawCall::BlittingState BlittingDrawCall::captureState() const {
 	return state;
 }
 
-void BlittingDrawCall::applyState(const BlittingState &state, const Common::Rect *clippingRectangle) const {
-	TinyGL::GLContext *c = gl_get_context();
+void BlittingDrawCall::applyState(GLContext *c, const BlittingState &state, const Common::Rect *clippingRectangle) const {
 	c->fb->setupScissor(state.enableScissor, state.scissor, clippingRectangle);
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
@@ -706,38 +741,35 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue,
 	: _clearZBuffer(clearZBuffer), _clearColorBuffer(clearColorBuffer), _zValue(zValue),
 	  _rValue(rValue), _gValue(gValue), _bValue(bValue), _clearStencilBuffer(clearStencilBuffer),
 	  _stencilValue(stencilValue), DrawCall(DrawCall_Clear) {
-	_clearState = captureState();
 	TinyGL::GLContext *c = gl_get_context();
-	if (c->_enableDirtyRectangles) {
+	_clearState = captureState(c);
+	if (c->_enableDirtyRectangles || c->_tileRasterizer) {
 		_dirtyRegion = c->renderRect;
 	}
 }
 
-void ClearBufferDrawCall::execute(bool restoreState, const Common::Rect *clippingRectangle) const {
+void ClearBufferDrawCall::execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle) const {
 	ClearBufferState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_clearState, clippingRectangle);
+	applyState(c, _clearState, clippingRectangle);
 
-	TinyGL::GLContext *c = gl_get_context();
 	c->fb->clear(_clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue, _clearStencilBuffer, _stencilValue);
 
 	if (restoreState) {
-		applyState(backupState, nullptr);
+		applyState(c, backupState, nullptr);
 	}
 }
 
-ClearBufferDrawCall::ClearBufferState ClearBufferDrawCall::captureState() const {
+ClearBufferDrawCall::ClearBufferState ClearBufferDrawCall::captureState(GLContext *c) const {
 	ClearBufferState state;
-	TinyGL::GLContext *c = gl_get_context();
 	state.enableScissor = c->scissor_test_enabled;
 	memcpy(state.scissor, c->scissor, sizeof(state.scissor));
 	return state;
 }
 
-void ClearBufferDrawCall::applyState(const ClearBufferState &state, const Common::Rect *clippingRectangle) const {
-	TinyGL::GLContext *c = gl_get_context();
+void ClearBufferDrawCall::applyState(GLContext *c, const ClearBufferState &state, const Common::Rect *clippingRectangle) const {
 	c->fb->setupScissor(state.enableScissor, state.scissor, clippingRectangle);
 
 	c->scissor_test_enabled = state.enableScissor;
@@ -72,7 +72,12 @@ public:
 	bool operator!=(const DrawCall &other) const {
 		return !(*this == other);
 	}
-	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const = 0;
+	/**
+	 * Execute the call on a context. Rasterization and clear calls can also
+	 * execute on the context of a tile, see TileRasterizer, while blits
+	 * always execute on the current context.
+	 */
+	virtual void execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle = nullptr) const = 0;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
 protected:
@@ -86,7 +91,7 @@ public:
 	ClearBufferDrawCall(bool clearZBuffer, int zValue, bool clearColorBuffer, int rValue, int gValue, int bValue, bool clearStencilBuffer, int stencilValue);
 	virtual ~ClearBufferDrawCall() { }
 	bool operator==(const ClearBufferDrawCall &other) const;
-	void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
+	void execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -110,8 +115,8 @@ private:
 		}
 	};
 
-	ClearBufferState captureState() const;
-	void applyState(const ClearBufferState &state, const Common::Rect *clippingRectangle) const;
+	ClearBufferState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const ClearBufferState &state, const Common::Rect *clippingRectangle) const;
 
 	ClearBufferState _clearState;
 };
@@ -122,7 +127,7 @@ public:
 	RasterizationDrawCall();
 	virtual ~RasterizationDrawCall() { }
 	bool operator==(const RasterizationDrawCall &other) const;
-	void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
+	void execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -191,8 +196,8 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state, const Common::Rect *clippingRectangle) const;
+	RasterizationState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const RasterizationState &state, const Common::Rect *clippingRectangle) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
@@ -207,7 +212,7 @@ public:
 	BlittingDrawCall(BlitImage *image, const BlitTransform &transform, BlittingMode blittingMode);
 	virtual ~BlittingDrawCall();
 	bool operator==(const BlittingDrawCall &other) const;
-	void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
+	void execute(GLContext *c, bool restoreState, const Common::Rect *clippingRectangle = nullptr) const override;
 
 	BlittingMode getBlittingMode() const { return _mode; }
 
@@ -249,8 +254,8 @@ private:
 		}
 	};
 
-	BlittingState captureState() const;
-	void applyState(const BlittingState &state, const Common::Rect *clippingRectangle) const;
+	BlittingState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const BlittingState &state, const Common::Rect *clippingRectangle) const;
 
 	BlittingState _blitState;
 };
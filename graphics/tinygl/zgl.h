@@ -275,6 +275,7 @@ private:
 };
 
 struct GLContext;
+class TileRasterizer;
 
 typedef void (*gl_draw_triangle_func)(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
 
@@ -471,6 +472,7 @@ struct GLContext {
 	LinearAllocator _drawCallAllocator[2];
 	bool _debugRectsEnabled;
 	bool _profilingEnabled;
+	TileRasterizer *_tileRasterizer;
 
 	void gl_vertex_transform(GLVertex *v);
 	void gl_calc_fog_factor(GLVertex *v);
@@ -528,6 +530,8 @@ public:
 
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
+	bool canUseTileRasterizer() const;
+	void setRenderThreads(int numThreads);
 
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
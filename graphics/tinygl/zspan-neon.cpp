@@ -0,0 +1,288 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/tinygl/zspan.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace TinyGL {
+
+/** The values of four consecutive pixels of an interpolated value. */
+static FORCEINLINE uint32x4_t ramp(uint value, int delta) {
+	const uint32 values[4] = { value, value + delta, value + 2 * delta, value + 3 * delta };
+	return vld1q_u32(values);
+}
+
+/** The bits of the set lanes of a mask, from the first lane up. */
+static FORCEINLINE uint laneBits(uint32x4_t mask) {
+	static const uint32 bits[4] = { 1, 2, 4, 8 };
+	const uint32x4_t set = vandq_u32(mask, vld1q_u32(bits));
+	uint32x2_t sum = vorr_u32(vget_low_u32(set), vget_high_u32(set));
+	sum = vorr_u32(sum, vrev64_u32(sum));
+	return vget_lane_u32(sum, 0);
+}
+
+static FORCEINLINE bool anyLane(uint32x4_t mask) {
+	const uint32x2_t any = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+	return (vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0;
+}
+
+/** Compare four pairs of unsigned values as in a OP b. */
+static FORCEINLINE uint32x4_t compare(int func, uint32x4_t a, uint32x4_t b) {
+	switch (func) {
+	case TGL_LESS:
+		return vcltq_u32(a, b);
+	case TGL_EQUAL:
+		return vceqq_u32(a, b);
+	case TGL_LEQUAL:
+		return vcleq_u32(a, b);
+	case TGL_GREATER:
+		return vcgtq_u32(a, b);
+	case TGL_NOTEQUAL:
+		return vmvnq_u32(vceqq_u32(a, b));
+	case TGL_GEQUAL:
+		return vcgeq_u32(a, b);
+	case TGL_ALWAYS:
+		return vdupq_n_u32(0xFFFFFFFF);
+	default:
+		return vdupq_n_u32(0);
+	}
+}
+
+/** Round four depth values to floats and back, as writing them does. */
+static FORCEINLINE uint32x4_t roundDepth(uint32x4_t z) {
+	return vcvtq_u32_f32(vcvtq_f32_u32(z));
+}
+
+/** The 8 bits of four interpolated color values. */
+static FORCEINLINE uint32x4_t channel(uint32x4_t value) {
+	return vandq_u32(vshrq_n_u32(value, 8), vdupq_n_u32(0xFF));
+}
+
+/** Modulate four texel channels by four interpolated ones. */
+static FORCEINLINE uint32x4_t modulate(uint32x4_t color, uint32x4_t texel) {
+	color = vminq_u32(vshrq_n_u32(vaddq_u32(color, vdupq_n_u32(128)), 8), vdupq_n_u32(255));
+	const uint32x4_t r = vmulq_u32(color, texel);
+	return vshrq_n_u32(vaddq_u32(vaddq_u32(r, vshrq_n_u32(r, 8)), vdupq_n_u32(127)), 8);
+}
+
+static FORCEINLINE uint32x4_t blend(SpanBlendFactor factor, uint32x4_t c, uint32x4_t a) {
+	switch (factor) {
+	case kSpanBlendZero:
+		return vdupq_n_u32(0);
+	case kSpanBlendSrcAlpha:
+		return vshrq_n_u32(vmulq_u32(c, a), 8);
+	case kSpanBlendOneMinusSrcAlpha:
+		return vshrq_n_u32(vmulq_u32(c, vsubq_u32(vdupq_n_u32(255), a)), 8);
+	default:
+		return c;
+	}
+}
+
+static FORCEINLINE uint32x4_t pack(const SpanState &state, uint32x4_t a, uint32x4_t r, uint32x4_t g, uint32x4_t b) {
+	uint32x4_t color = vorrq_u32(vshlq_u32(r, vdupq_n_s32(state.rShift)),
+	                             vorrq_u32(vshlq_u32(g, vdupq_n_s32(state.gShift)),
+	                                       vshlq_u32(b, vdupq_n_s32(state.bShift))));
+	if (state.hasAlpha)
+		color = vorrq_u32(color, vshlq_u32(a, vdupq_n_s32(state.aShift)));
+	return color;
+}
+
+/** Draw the pixels in mask of four which passed the depth test. */
+static FORCEINLINE void writePixels(const SpanState &state, uint32 *pp, uint *pz, uint32x4_t mask,
+                                    uint32x4_t a, uint32x4_t r, uint32x4_t g, uint32x4_t b, uint32x4_t z) {
+	mask = vandq_u32(mask, compare(state.alphaFunc, a, vdupq_n_u32(state.alphaRef)));
+	if (!anyLane(mask))
+		return;
+
+	if (state.depthWrite)
+		vst1q_u32(pz, vbslq_u32(mask, roundDepth(z), vld1q_u32(pz)));
+
+	const uint32x4_t dst = vld1q_u32(pp);
+	uint32x4_t color;
+	if (!state.blending) {
+		color = pack(state, a, r, g, b);
+	} else {
+		const uint32x4_t max = vdupq_n_u32(255);
+		const uint32x4_t dstR = vandq_u32(vshlq_u32(dst, vdupq_n_s32(-state.rShift)), max);
+		const uint32x4_t dstG = vandq_u32(vshlq_u32(dst, vdupq_n_s32(-state.gShift)), max);
+		const uint32x4_t dstB = vandq_u32(vshlq_u32(dst, vdupq_n_s32(-state.bShift)), max);
+		r = vminq_u32(vaddq_u32(blend(state.srcFactor, r, a), blend(state.dstFactor, dstR, a)), max);
+		g = vminq_u32(vaddq_u32(blend(state.srcFactor, g, a), blend(state.dstFactor, dstG, a)), max);
+		b = vminq_u32(vaddq_u32(blend(state.srcFactor, b, a), blend(state.dstFactor, dstB, a)), max);
+		color = pack(state, max, r, g, b);
+	}
+	vst1q_u32(pp, vbslq_u32(mask, color, dst));
+}
+
+static void fillDepthNEON(const SpanState &state, uint *pz, int count, uint z, int dzdx) {
+	uint32x4_t zv = ramp(z, dzdx);
+	const uint32x4_t dz = vdupq_n_u32(dzdx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint32x4_t dst = vld1q_u32(pz + i);
+		vst1q_u32(pz + i, vbslq_u32(compare(state.depthFunc, dst, zv), zv, dst));
+		zv = vaddq_u32(zv, dz);
+	}
+
+	for (z += (uint)dzdx * i; i < count; i++, z += dzdx) {
+		if (spanCompare(state.depthFunc, pz[i], z))
+			pz[i] = z;
+	}
+}
+
+static void fillColorNEON(const SpanState &state, uint32 *pp, uint *pz, int count, SpanValues &values) {
+	uint32x4_t z = ramp(values.z, values.dzdx);
+	uint32x4_t r = ramp(values.r, values.drdx);
+	uint32x4_t g = ramp(values.g, values.dgdx);
+	uint32x4_t b = ramp(values.b, values.dbdx);
+	uint32x4_t a = ramp(values.a, values.dadx);
+	const uint32x4_t dz = vdupq_n_u32(values.dzdx * 4);
+	const uint32x4_t dr = vdupq_n_u32(values.drdx * 4);
+	const uint32x4_t dg = vdupq_n_u32(values.dgdx * 4);
+	const uint32x4_t db = vdupq_n_u32(values.dbdx * 4);
+	const uint32x4_t da = vdupq_n_u32(values.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint32x4_t mask = compare(state.depthFunc, vld1q_u32(pz + i), z);
+		if (anyLane(mask))
+			writePixels(state, pp + i, pz + i, mask, channel(a), channel(r), channel(g), channel(b), z);
+
+		z = vaddq_u32(z, dz);
+		r = vaddq_u32(r, dr);
+		g = vaddq_u32(g, dg);
+		b = vaddq_u32(b, db);
+		a = vaddq_u32(a, da);
+	}
+	spanAdvance(values, i);
+
+	for (; i < count; i++) {
+		if (spanCompare(state.depthFunc, pz[i], values.z)) {
+			spanWritePixel(state, pp + i, pz + i, (values.a >> 8) & 0xFF, (values.r >> 8) & 0xFF,
+			               (values.g >> 8) & 0xFF, (values.b >> 8) & 0xFF, values.z);
+		}
+		spanAdvance(values, 1);
+	}
+}
+
+static uint testDepthNEON(const SpanState &state, const uint *pz, int count, uint z, int dzdx) {
+	uint32x4_t zv = ramp(z, dzdx);
+	const uint32x4_t dz = vdupq_n_u32(dzdx * 4);
+
+	uint mask = 0;
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		mask |= laneBits(compare(state.depthFunc, vld1q_u32(pz + i), zv)) << i;
+		zv = vaddq_u32(zv, dz);
+	}
+
+	for (z += (uint)dzdx * i; i < count; i++, z += dzdx) {
+		if (spanCompare(state.depthFunc, pz[i], z))
+			mask |= 1 << i;
+	}
+	return mask;
+}
+
+static void fillTextureNEON(const SpanState &state, uint32 *pp, uint *pz, const uint32 *texels, uint mask, int count, SpanValues &values) {
+	static const uint32 laneBitValues[4] = { 1, 2, 4, 8 };
+
+	uint32x4_t z = ramp(values.z, values.dzdx);
+	uint32x4_t r = ramp(values.r, values.drdx);
+	uint32x4_t g = ramp(values.g, values.dgdx);
+	uint32x4_t b = ramp(values.b, values.dbdx);
+	uint32x4_t a = ramp(values.a, values.dadx);
+	const uint32x4_t dz = vdupq_n_u32(values.dzdx * 4);
+	const uint32x4_t dr = vdupq_n_u32(values.drdx * 4);
+	const uint32x4_t dg = vdupq_n_u32(values.dgdx * 4);
+	const uint32x4_t db = vdupq_n_u32(values.dbdx * 4);
+	const uint32x4_t da = vdupq_n_u32(values.dadx * 4);
+	const uint32x4_t bits = vld1q_u32(laneBitValues);
+	const uint32x4_t byteMask = vdupq_n_u32(0xFF);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint laneMask = (mask >> i) & 0xF;
+		if (laneMask) {
+			const uint32x4_t pass = vtstq_u32(vdupq_n_u32(laneMask), bits);
+			const uint32x4_t texel = vld1q_u32(texels + i);
+			writePixels(state, pp + i, pz + i, pass,
+			            modulate(a, vshrq_n_u32(texel, 24)),
+			            modulate(r, vandq_u32(vshrq_n_u32(texel, 16), byteMask)),
+			            modulate(g, vandq_u32(vshrq_n_u32(texel, 8), byteMask)),
+			            modulate(b, vandq_u32(texel, byteMask)), z);
+		}
+
+		z = vaddq_u32(z, dz);
+		r = vaddq_u32(r, dr);
+		g = vaddq_u32(g, dg);
+		b = vaddq_u32(b, db);
+		a = vaddq_u32(a, da);
+	}
+	spanAdvance(values, i);
+
+	for (; i < count; i++) {
+		if (mask & (1 << i)) {
+			const uint32 texel = texels[i];
+			spanWritePixel(state, pp + i, pz + i, spanModulate(values.a, texel >> 24), spanModulate(values.r, (texel >> 16) & 0xFF),
+			               spanModulate(values.g, (texel >> 8) & 0xFF), spanModulate(values.b, texel & 0xFF), values.z);
+		}
+		spanAdvance(values, 1);
+	}
+}
+
+const SpanFuncs spanFuncsNEON = {
+	fillDepthNEON,
+	fillColorNEON,
+	testDepthNEON,
+	fillTextureNEON
+};
+
+} // end of namespace TinyGL
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,291 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zspan.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace TinyGL {
+
+static FORCEINLINE __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/** The values of four consecutive pixels of an interpolated value. */
+static FORCEINLINE __m128i ramp(uint value, int delta) {
+	return _mm_setr_epi32(value, value + delta, value + 2 * delta, value + 3 * delta);
+}
+
+/** Compare four pairs of unsigned values as in a OP b. */
+static FORCEINLINE __m128i compare(int func, __m128i a, __m128i b) {
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	a = _mm_xor_si128(a, bias);
+	b = _mm_xor_si128(b, bias);
+
+	switch (func) {
+	case TGL_LESS:
+		return _mm_cmplt_epi32(a, b);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(a, b);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(a, b), _mm_set1_epi32(-1));
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(a, b);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(a, b), _mm_set1_epi32(-1));
+	case TGL_GEQUAL:
+		return _mm_xor_si128(_mm_cmplt_epi32(a, b), _mm_set1_epi32(-1));
+	case TGL_ALWAYS:
+		return _mm_set1_epi32(-1);
+	default:
+		return _mm_setzero_si128();
+	}
+}
+
+/** Round four depth values to floats and back, as writing them does. */
+static FORCEINLINE __m128i roundDepth(__m128i z) {
+	// Both halves convert exactly, so that only the sum is rounded
+	const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(z, 16));
+	const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(z, _mm_set1_epi32(0xFFFF)));
+	const __m128 f = _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo);
+
+	const __m128 big = _mm_set1_ps(2147483648.0f);
+	const __m128i isBig = _mm_castps_si128(_mm_cmpge_ps(f, big));
+	const __m128i small = _mm_cvttps_epi32(f);
+	const __m128i large = _mm_add_epi32(_mm_cvttps_epi32(_mm_sub_ps(f, big)), _mm_set1_epi32((int)0x80000000));
+	return select(isBig, large, small);
+}
+
+/** The 8 bits of four interpolated color values. */
+static FORCEINLINE __m128i channel(__m128i value) {
+	return _mm_and_si128(_mm_srli_epi32(value, 8), _mm_set1_epi32(0xFF));
+}
+
+/** Modulate four texel channels by four interpolated ones. */
+static FORCEINLINE __m128i modulate(__m128i color, __m128i texel) {
+	color = _mm_srli_epi32(_mm_add_epi32(color, _mm_set1_epi32(128)), 8);
+	color = select(_mm_cmpgt_epi32(color, _mm_set1_epi32(255)), _mm_set1_epi32(255), color);
+	// The products fit into the low 16 bits of each value
+	const __m128i r = _mm_mullo_epi16(color, texel);
+	return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(r, _mm_srli_epi32(r, 8)), _mm_set1_epi32(127)), 8);
+}
+
+static FORCEINLINE __m128i blend(SpanBlendFactor factor, __m128i c, __m128i a) {
+	switch (factor) {
+	case kSpanBlendZero:
+		return _mm_setzero_si128();
+	case kSpanBlendSrcAlpha:
+		return _mm_srli_epi32(_mm_mullo_epi16(c, a), 8);
+	case kSpanBlendOneMinusSrcAlpha:
+		return _mm_srli_epi32(_mm_mullo_epi16(c, _mm_sub_epi32(_mm_set1_epi32(255), a)), 8);
+	default:
+		return c;
+	}
+}
+
+static FORCEINLINE __m128i pack(const SpanState &state, __m128i a, __m128i r, __m128i g, __m128i b) {
+	__m128i color = _mm_or_si128(_mm_sll_epi32(r, _mm_cvtsi32_si128(state.rShift)),
+	                             _mm_or_si128(_mm_sll_epi32(g, _mm_cvtsi32_si128(state.gShift)),
+	                                          _mm_sll_epi32(b, _mm_cvtsi32_si128(state.bShift))));
+	if (state.hasAlpha)
+		color = _mm_or_si128(color, _mm_sll_epi32(a, _mm_cvtsi32_si128(state.aShift)));
+	return color;
+}
+
+/** Draw the pixels in mask of four which passed the depth test. */
+static FORCEINLINE void writePixels(const SpanState &state, uint32 *pp, uint *pz, __m128i mask,
+                                    __m128i a, __m128i r, __m128i g, __m128i b, __m128i z) {
+	mask = _mm_and_si128(mask, compare(state.alphaFunc, a, _mm_set1_epi32(state.alphaRef)));
+	if (!_mm_movemask_epi8(mask))
+		return;
+
+	if (state.depthWrite) {
+		const __m128i dst = _mm_loadu_si128((const __m128i *)pz);
+		_mm_storeu_si128((__m128i *)pz, select(mask, roundDepth(z), dst));
+	}
+
+	const __m128i dst = _mm_loadu_si128((const __m128i *)pp);
+	__m128i color;
+	if (!state.blending) {
+		color = pack(state, a, r, g, b);
+	} else {
+		const __m128i max = _mm_set1_epi32(255);
+		const __m128i dstR = _mm_and_si128(_mm_srl_epi32(dst, _mm_cvtsi32_si128(state.rShift)), max);
+		const __m128i dstG = _mm_and_si128(_mm_srl_epi32(dst, _mm_cvtsi32_si128(state.gShift)), max);
+		const __m128i dstB = _mm_and_si128(_mm_srl_epi32(dst, _mm_cvtsi32_si128(state.bShift)), max);
+		// The sums are at most 510, so the 16 bits minimum works
+		r = _mm_min_epi16(_mm_add_epi32(blend(state.srcFactor, r, a), blend(state.dstFactor, dstR, a)), max);
+		g = _mm_min_epi16(_mm_add_epi32(blend(state.srcFactor, g, a), blend(state.dstFactor, dstG, a)), max);
+		b = _mm_min_epi16(_mm_add_epi32(blend(state.srcFactor, b, a), blend(state.dstFactor, dstB, a)), max);
+		color = pack(state, max, r, g, b);
+	}
+	_mm_storeu_si128((__m128i *)pp, select(mask, color, dst));
+}
+
+static void fillDepthSSE2(const SpanState &state, uint *pz, int count, uint z, int dzdx) {
+	__m128i zv = ramp(z, dzdx);
+	const __m128i dz = _mm_set1_epi32(dzdx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(pz + i));
+		const __m128i mask = compare(state.depthFunc, dst, zv);
+		_mm_storeu_si128((__m128i *)(pz + i), select(mask, zv, dst));
+		zv = _mm_add_epi32(zv, dz);
+	}
+
+	for (z += (uint)dzdx * i; i < count; i++, z += dzdx) {
+		if (spanCompare(state.depthFunc, pz[i], z))
+			pz[i] = z;
+	}
+}
+
+static void fillColorSSE2(const SpanState &state, uint32 *pp, uint *pz, int count, SpanValues &values) {
+	__m128i z = ramp(values.z, values.dzdx);
+	__m128i r = ramp(values.r, values.drdx);
+	__m128i g = ramp(values.g, values.dgdx);
+	__m128i b = ramp(values.b, values.dbdx);
+	__m128i a = ramp(values.a, values.dadx);
+	const __m128i dz = _mm_set1_epi32(values.dzdx * 4);
+	const __m128i dr = _mm_set1_epi32(values.drdx * 4);
+	const __m128i dg = _mm_set1_epi32(values.dgdx * 4);
+	const __m128i db = _mm_set1_epi32(values.dbdx * 4);
+	const __m128i da = _mm_set1_epi32(values.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i mask = compare(state.depthFunc, _mm_loadu_si128((const __m128i *)(pz + i)), z);
+		if (_mm_movemask_epi8(mask))
+			writePixels(state, pp + i, pz + i, mask, channel(a), channel(r), channel(g), channel(b), z);
+
+		z = _mm_add_epi32(z, dz);
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+		a = _mm_add_epi32(a, da);
+	}
+	spanAdvance(values, i);
+
+	for (; i < count; i++) {
+		if (spanCompare(state.depthFunc, pz[i], values.z)) {
+			spanWritePixel(state, pp + i, pz + i, (values.a >> 8) & 0xFF, (values.r >> 8) & 0xFF,
+			               (values.g >> 8) & 0xFF, (values.b >> 8) & 0xFF, values.z);
+		}
+		spanAdvance(values, 1);
+	}
+}
+
+static uint testDepthSSE2(const SpanState &state, const uint *pz, int count, uint z, int dzdx) {
+	__m128i zv = ramp(z, dzdx);
+	const __m128i dz = _mm_set1_epi32(dzdx * 4);
+
+	uint mask = 0;
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i pass = compare(state.depthFunc, _mm_loadu_si128((const __m128i *)(pz + i)), zv);
+		mask |= _mm_movemask_ps(_mm_castsi128_ps(pass)) << i;
+		zv = _mm_add_epi32(zv, dz);
+	}
+
+	for (z += (uint)dzdx * i; i < count; i++, z += dzdx) {
+		if (spanCompare(state.depthFunc, pz[i], z))
+			mask |= 1 << i;
+	}
+	return mask;
+}
+
+static void fillTextureSSE2(const SpanState &state, uint32 *pp, uint *pz, const uint32 *texels, uint mask, int count, SpanValues &values) {
+	__m128i z = ramp(values.z, values.dzdx);
+	__m128i r = ramp(values.r, values.drdx);
+	__m128i g = ramp(values.g, values.dgdx);
+	__m128i b = ramp(values.b, values.dbdx);
+	__m128i a = ramp(values.a, values.dadx);
+	const __m128i dz = _mm_set1_epi32(values.dzdx * 4);
+	const __m128i dr = _mm_set1_epi32(values.drdx * 4);
+	const __m128i dg = _mm_set1_epi32(values.dgdx * 4);
+	const __m128i db = _mm_set1_epi32(values.dbdx * 4);
+	const __m128i da = _mm_set1_epi32(values.dadx * 4);
+	const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint laneMask = (mask >> i) & 0xF;
+		if (laneMask) {
+			const __m128i pass = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(laneMask), bits), bits);
+			const __m128i texel = _mm_loadu_si128((const __m128i *)(texels + i));
+			writePixels(state, pp + i, pz + i, pass,
+			            modulate(a, _mm_srli_epi32(texel, 24)),
+			            modulate(r, _mm_and_si128(_mm_srli_epi32(texel, 16), byteMask)),
+			            modulate(g, _mm_and_si128(_mm_srli_epi32(texel, 8), byteMask)),
+			            modulate(b, _mm_and_si128(texel, byteMask)), z);
+		}
+
+		z = _mm_add_epi32(z, dz);
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+		a = _mm_add_epi32(a, da);
+	}
+	spanAdvance(values, i);
+
+	for (; i < count; i++) {
+		if (mask & (1 << i)) {
+			const uint32 texel = texels[i];
+			spanWritePixel(state, pp + i, pz + i, spanModulate(values.a, texel >> 24), spanModulate(values.r, (texel >> 16) & 0xFF),
+			               spanModulate(values.g, (texel >> 8) & 0xFF), spanModulate(values.b, texel & 0xFF), values.z);
+		}
+		spanAdvance(values, 1);
+	}
+}
+
+const SpanFuncs spanFuncsSSE2 = {
+	fillDepthSSE2,
+	fillColorSSE2,
+	testDepthSSE2,
+	fillTextureSSE2
+};
+
+} // end of namespace TinyGL
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
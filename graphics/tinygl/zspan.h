@@ -0,0 +1,164 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "common/scummsys.h"
+#include "common/util.h"
+
+#include "graphics/tinygl/gl.h"
+
+namespace TinyGL {
+
+// Vectorized drawing of the pixels of a triangle scanline, for the common
+// states with a 32 bits frame buffer. They give exactly the same pixels as
+// the generic code in ztriangle.cpp, which draws everything else.
+
+enum SpanBlendFactor {
+	kSpanBlendZero,
+	kSpanBlendOne,
+	kSpanBlendSrcAlpha,
+	kSpanBlendOneMinusSrcAlpha
+};
+
+/** The state of the frame buffer for drawing the spans of a triangle. */
+struct SpanState {
+	int depthFunc;  ///< TGL_ALWAYS when the depth test is disabled
+	bool depthWrite;
+	int alphaFunc;  ///< TGL_ALWAYS when the alpha test is disabled
+	int alphaRef;
+	bool blending;
+	SpanBlendFactor srcFactor, dstFactor;
+	bool hasAlpha;  ///< Whether the frame buffer has 8 bits of alpha or none
+	int aShift, rShift, gShift, bShift;
+};
+
+/**
+ * The interpolated values of a span, in the fixed point formats of
+ * ZBufferPoint. The functions advance them past the pixels they draw.
+ */
+struct SpanValues {
+	uint z, r, g, b, a;
+	int dzdx, drdx, dgdx, dbdx, dadx;
+};
+
+struct SpanFuncs {
+	/** Write the depth of the pixels of count which pass the depth test, without drawing them. */
+	void (*fillDepth)(const SpanState &state, uint *pz, int count, uint z, int dzdx);
+	/** Draw count pixels in the interpolated color. */
+	void (*fillColor)(const SpanState &state, uint32 *pp, uint *pz, int count, SpanValues &values);
+	/** Return the mask of the pixels of at most eight which pass the depth test. */
+	uint (*testDepth)(const SpanState &state, const uint *pz, int count, uint z, int dzdx);
+	/**
+	 * Draw the pixels in mask of at most eight, modulating their texels given
+	 * as 0xAARRGGBB by the interpolated color.
+	 */
+	void (*fillTexture)(const SpanState &state, uint32 *pp, uint *pz, const uint32 *texels, uint mask, int count, SpanValues &values);
+};
+
+#ifdef SCUMMVM_SSE2
+extern const SpanFuncs spanFuncsSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+extern const SpanFuncs spanFuncsNEON;
+#endif
+
+// The scalar versions of the tests and of drawing one pixel, for the pixels
+// left over at the end of the spans
+
+inline bool spanCompare(int func, uint a, uint b) {
+	switch (func) {
+	case TGL_LESS:
+		return a < b;
+	case TGL_EQUAL:
+		return a == b;
+	case TGL_LEQUAL:
+		return a <= b;
+	case TGL_GREATER:
+		return a > b;
+	case TGL_NOTEQUAL:
+		return a != b;
+	case TGL_GEQUAL:
+		return a >= b;
+	case TGL_ALWAYS:
+		return true;
+	default:
+		return false;
+	}
+}
+
+inline uint spanBlend(SpanBlendFactor factor, uint c, uint a) {
+	switch (factor) {
+	case kSpanBlendZero:
+		return 0;
+	case kSpanBlendSrcAlpha:
+		return (c * a) >> 8;
+	case kSpanBlendOneMinusSrcAlpha:
+		return (c * (255 - a)) >> 8;
+	default:
+		return c;
+	}
+}
+
+/** Draw one pixel which passed the depth test, like FrameBuffer::writePixel. */
+inline void spanWritePixel(const SpanState &state, uint32 *pp, uint *pz, uint a, uint r, uint g, uint b, uint z) {
+	if (!spanCompare(state.alphaFunc, a, state.alphaRef))
+		return;
+
+	if (state.depthWrite) {
+		// The depth goes through a float on the way
+		*pz = (uint)(float)z;
+	}
+
+	if (!state.blending) {
+		*pp = ((state.hasAlpha ? a : 0) << state.aShift) | (r << state.rShift) | (g << state.gShift) | (b << state.bShift);
+		return;
+	}
+
+	const uint32 dst = *pp;
+	r = spanBlend(state.srcFactor, r, a) + spanBlend(state.dstFactor, (dst >> state.rShift) & 0xFF, a);
+	g = spanBlend(state.srcFactor, g, a) + spanBlend(state.dstFactor, (dst >> state.gShift) & 0xFF, a);
+	b = spanBlend(state.srcFactor, b, a) + spanBlend(state.dstFactor, (dst >> state.bShift) & 0xFF, a);
+	*pp = ((state.hasAlpha ? 0xFFu : 0) << state.aShift) | (MIN<uint>(r, 255) << state.rShift) |
+		(MIN<uint>(g, 255) << state.gShift) | (MIN<uint>(b, 255) << state.bShift);
+}
+
+/** Modulate a texel channel by an interpolated one, like FrameBuffer::applyModulation. */
+inline uint spanModulate(uint color, uint texel) {
+	color = (color + 128) >> 8;
+	color = color > 255 ? 255 : color;
+	const uint r = color * texel;
+	return (r + (r >> 8) + 127) >> 8;
+}
+
+inline void spanAdvance(SpanValues &values, int count) {
+	values.z += (uint)values.dzdx * count;
+	values.r += (uint)values.drdx * count;
+	values.g += (uint)values.dgdx * count;
+	values.b += (uint)values.dbdx * count;
+	values.a += (uint)values.dadx * count;
+}
+
+} // end of namespace TinyGL
+
+#endif
@@ -0,0 +1,142 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "graphics/tinygl/ztiles.h"
+#include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zdirtyrect.h"
+
+namespace TinyGL {
+
+// The height of a band. Bands are spread over the threads in turn, so that
+// the busy parts of the screen are shared between them.
+static const int kBandHeight = 16;
+
+TileRasterizer::TileRasterizer(uint numThreads) : _pool(numThreads - 1, "ScummVM TinyGL"), _pending(false) {
+	assert(numThreads > 1);
+
+	_slots.resize(numThreads);
+	for (uint i = 0; i < _slots.size(); i++) {
+		_slots[i].context = new GLContext();
+		_slots[i].fb = nullptr;
+	}
+}
+
+TileRasterizer::~TileRasterizer() {
+	for (uint i = 0; i < _slots.size(); i++) {
+		gl_free(_slots[i].context->vertex);
+		delete _slots[i].context;
+		delete _slots[i].fb;
+	}
+}
+
+void TileRasterizer::setupSlots(GLContext *c) {
+	for (uint i = 0; i < _slots.size(); i++) {
+		Slot &slot = _slots[i];
+		if (!slot.fb) {
+			slot.fb = new FrameBuffer(c->fb);
+			slot.fb->setTextureEnvironment(&slot.context->_texEnv);
+		} else {
+			// The main context may have switched to another buffer since
+			slot.fb->shareBuffers(*c->fb);
+		}
+
+		GLContext *context = slot.context;
+		context->fb = slot.fb;
+		context->renderRect = c->renderRect;
+		context->render_mode = c->render_mode;
+		context->current_cull_face = c->current_cull_face;
+		context->_profilingEnabled = false;
+	}
+
+	const int bandCount = (c->fb->getPixelBufferHeight() + kBandHeight - 1) / kBandHeight;
+	if ((int)_bands.size() != bandCount)
+		_bands.resize(bandCount);
+
+	_bounds = Common::Rect(c->fb->getPixelBufferWidth(), c->fb->getPixelBufferHeight());
+}
+
+void TileRasterizer::execute(GLContext *c, const Common::List<DrawCall *> &drawCalls, const Common::Array<Common::Rect> &rects) {
+	setupSlots(c);
+
+	for (const auto &drawCall : drawCalls) {
+		Common::Rect region = drawCall->getDirtyRegion();
+		if (region.isEmpty())
+			region = _bounds;
+
+		if (drawCall->getType() == DrawCall::DrawCall_Blitting) {
+			// Blits are done by the main context, after everything before them
+			flush(rects);
+			for (const auto &rect : rects) {
+				Common::Rect clippingRectangle = rect;
+				if (clippingRectangle.intersects(region))
+					drawCall->execute(c, true, &clippingRectangle);
+			}
+			continue;
+		}
+
+		region.clip(_bounds);
+		if (region.isEmpty())
+			continue;
+
+		const int lastBand = (region.bottom - 1) / kBandHeight;
+		for (int band = region.top / kBandHeight; band <= lastBand; band++)
+			_bands[band].push_back(drawCall);
+		_pending = true;
+	}
+
+	flush(rects);
+}
+
+void TileRasterizer::flush(const Common::Array<Common::Rect> &rects) {
+	if (!_pending)
+		return;
+
+	_pool.parallelFor(0, _slots.size(), [this, &rects](int slot) {
+		drawSlot(slot, rects);
+	});
+
+	for (uint i = 0; i < _bands.size(); i++)
+		_bands[i].resize(0);
+	_pending = false;
+}
+
+void TileRasterizer::drawSlot(uint slot, const Common::Array<Common::Rect> &rects) {
+	GLContext *context = _slots[slot].context;
+
+	for (uint band = slot; band < _bands.size(); band += _slots.size()) {
+		const Common::Rect bandRect(_bounds.left, band * kBandHeight, _bounds.right, MIN<int>((band + 1) * kBandHeight, _bounds.bottom));
+
+		for (const auto &drawCall : _bands[band]) {
+			Common::Rect region = drawCall->getDirtyRegion();
+			if (region.isEmpty())
+				region = _bounds;
+
+			for (const auto &rect : rects) {
+				Common::Rect clippingRectangle = rect.findIntersectingRect(bandRect);
+				if (!clippingRectangle.isEmpty() && clippingRectangle.intersects(region))
+					drawCall->execute(context, false, &clippingRectangle);
+			}
+		}
+	}
+}
+
+} // end of namespace TinyGL
@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GRAPHICS_TINYGL_ZTILES_H
+#define GRAPHICS_TINYGL_ZTILES_H
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/rect.h"
+#include "common/threadpool.h"
+
+namespace TinyGL {
+
+struct GLContext;
+struct FrameBuffer;
+class DrawCall;
+
+/**
+ * Executes the draw calls of a frame on several threads.
+ *
+ * The frame buffer is split up into bands of rows, and the rasterization and
+ * clear calls are sorted into the bands they cover. Every thread draws its
+ * bands with its own context, which shares the color, depth and stencil
+ * buffers of the main one but only touches the rows of its bands. Blits are
+ * executed in order on the main context in between.
+ */
+class TileRasterizer {
+public:
+	/**
+	 * @param numThreads The total number of threads taking part in drawing,
+	 *                   including the calling thread.
+	 */
+	explicit TileRasterizer(uint numThreads);
+	~TileRasterizer();
+
+	/**
+	 * Execute the draw calls for the context c, clipped to the given
+	 * disjoint rectangles. Returns once everything has been drawn.
+	 */
+	void execute(GLContext *c, const Common::List<DrawCall *> &drawCalls, const Common::Array<Common::Rect> &rects);
+
+private:
+	struct Slot {
+		GLContext *context;
+		FrameBuffer *fb;
+	};
+
+	void setupSlots(GLContext *c);
+	void flush(const Common::Array<Common::Rect> &rects);
+	void drawSlot(uint slot, const Common::Array<Common::Rect> &rects);
+
+	Common::ThreadPool _pool;
+	Common::Array<Slot> _slots;
+	Common::Array<Common::Array<const DrawCall *> > _bands;
+	Common::Rect _bounds;
+	bool _pending;
+};
+
+} // end of namespace TinyGL
+
+#endif
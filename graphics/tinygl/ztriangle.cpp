@@ -29,11 +29,49 @@
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zspan.h"
 
 namespace TinyGL {
 
 static const int NB_INTERP = 8;
 
+static bool getSpanBlendFactor(int factor, SpanBlendFactor &spanFactor) {
+	switch (factor) {
+	case TGL_ZERO:
+		spanFactor = kSpanBlendZero;
+		return true;
+	case TGL_ONE:
+		spanFactor = kSpanBlendOne;
+		return true;
+	case TGL_SRC_ALPHA:
+		spanFactor = kSpanBlendSrcAlpha;
+		return true;
+	case TGL_ONE_MINUS_SRC_ALPHA:
+		spanFactor = kSpanBlendOneMinusSrcAlpha;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FrameBuffer::setupSpanState(SpanState &state, bool depthTest, bool depthWrite, bool alphaTest, bool blending) const {
+	state.blending = blending;
+	if (blending && (!getSpanBlendFactor(_sourceBlendingFactor, state.srcFactor) ||
+	                 !getSpanBlendFactor(_destinationBlendingFactor, state.dstFactor)))
+		return false;
+
+	state.depthFunc = depthTest ? _depthFunc : TGL_ALWAYS;
+	state.depthWrite = depthWrite;
+	state.alphaFunc = alphaTest ? _alphaTestFunc : TGL_ALWAYS;
+	state.alphaRef = _alphaTestRefVal;
+	state.hasAlpha = _pbufFormat.aLoss == 0;
+	state.aShift = _pbufFormat.aShift;
+	state.rShift = _pbufFormat.rShift;
+	state.gShift = _pbufFormat.gShift;
+	state.bShift = _pbufFormat.bShift;
+	return true;
+}
+
 static bool applyStipplePattern(int x, int y, const byte *stipple) {
 
 	int stippleX = x % 32;
@@ -383,6 +421,13 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		pr1 = p0;
 		pr2 = p2;
 	}
+	// The spans of the common states are drawn by the vectorized functions
+	SpanState spanState;
+	const SpanFuncs *spanFuncs = nullptr;
+	if (_spanFuncs && kInterpZ && !kFogMode && !kStencilEnabled && !stippleEnabled && colorMode != ColorMode::CustomTexEnv &&
+	    setupSpanState(spanState, kDepthTestEnabled, kDepthWrite, kAlphaTestEnabled, kBlendingEnabled))
+		spanFuncs = _spanFuncs;
+
 	nb_lines = p1->y - p0->y;
 	y = p0->y;
 	for (part = 0; part < 2; part++) {
@@ -483,7 +528,79 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
 			int x = x1;
-			if (colorMode == ColorMode::NoInterpolation) {
+			if (kEnableScissor && (y < _clipRectangle.top || y >= _clipRectangle.bottom)) {
+				// The whole line is clipped, such as when drawing another tile
+			} else if (spanFuncs && colorMode == ColorMode::NoInterpolation) {
+				int first = x1, last = x2 >> 16;
+				if (kEnableScissor) {
+					first = MAX<int>(first, _clipRectangle.left);
+					last = MIN<int>(last, _clipRectangle.right - 1);
+				}
+				if (kDepthWrite && first <= last)
+					spanFuncs->fillDepth(spanState, pz1 + first, last - first + 1, z1 + (uint)dzdx * (first - x1), dzdx);
+			} else if (spanFuncs && !(kInterpST || kInterpSTZ)) {
+				int first = x1, last = x2 >> 16;
+				if (kEnableScissor) {
+					first = MAX<int>(first, _clipRectangle.left);
+					last = MIN<int>(last, _clipRectangle.right - 1);
+				}
+				if (first <= last) {
+					SpanValues values = { (uint)z1, (uint)r1, (uint)g1, (uint)b1, (uint)a1, dzdx, drdx, dgdx, dbdx, dadx };
+					spanAdvance(values, first - x1);
+					spanFuncs->fillColor(spanState, (uint32 *)_pbuf + pp1 + first, pz1 + first, last - first + 1, values);
+				}
+			} else if (spanFuncs) {
+				// The texels are fetched for the pixels passing the depth test,
+				// with the same perspective correction as below
+				uint32 texels[NB_INTERP];
+				SpanValues values = { (uint)z1, (uint)r1, (uint)g1, (uint)b1, (uint)a1, dzdx, drdx, dgdx, dbdx, dadx };
+				uint32 *pp = (uint32 *)_pbuf + pp1 + x1;
+				uint *pz = pz1 + x1;
+				int n = (x2 >> 16) - x1;
+				float fz = (float)z1;
+				float zinv = (float)(1.0 / fz);
+				float sz = sz1;
+				float tz = tz1;
+				while (n >= 0) {
+					const float ss = sz * zinv;
+					const float tt = tz * zinv;
+					int s = (int)ss;
+					int t = (int)tt;
+					const int dsdx = (int)((dszdx - ss * fdzdx) * zinv);
+					const int dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+					const int count = MIN(n + 1, NB_INTERP);
+					if (count == NB_INTERP) {
+						fz += fndzdx;
+						zinv = (float)(1.0 / fz);
+					}
+
+					uint mask = spanFuncs->testDepth(spanState, pz, count, values.z, dzdx);
+					if (kEnableScissor) {
+						const int left = MAX<int>(_clipRectangle.left - x, 0);
+						const int right = MIN<int>(_clipRectangle.right - x, count);
+						mask &= left < right ? ((1 << right) - 1) & ~((1 << left) - 1) : 0;
+					}
+					for (int i = 0; i < count; i++) {
+						if (mask & (1 << i)) {
+							uint8 c_a, c_r, c_g, c_b;
+							texture->getARGBAt(_wrapS, _wrapT, s, t, c_a, c_r, c_g, c_b);
+							texels[i] = ((uint32)c_a << 24) | (c_r << 16) | (c_g << 8) | c_b;
+						} else {
+							texels[i] = 0;
+						}
+						s += dsdx;
+						t += dtdx;
+					}
+					spanFuncs->fillTexture(spanState, pp, pz, texels, mask, count, values);
+
+					pp += count;
+					pz += count;
+					sz += ndszdx;
+					tz += ndtzdx;
+					n -= count;
+					x += count;
+				}
+			} else if (colorMode == ColorMode::NoInterpolation) {
 				int n;
 				uint *pz = nullptr;
 				byte *ps = nullptr;
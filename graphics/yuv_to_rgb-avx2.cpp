@@ -0,0 +1,205 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+/**
+ * Multiply sixteen chroma values in [-128, 127] by a 16.16 fixed point
+ * factor, truncating towards zero like the colour table does.
+ */
+static FORCEINLINE __m256i mulChroma(__m256i c, int factor) {
+	const __m256i mag = _mm256_abs_epi16(c);
+
+	__m256i r = _mm256_mulhi_epu16(mag, _mm256_set1_epi16((short)(factor & 0xFFFF)));
+	if (factor > 0xFFFF)
+		r = _mm256_add_epi16(r, mag);
+
+	return _mm256_sign_epi16(r, c);
+}
+
+/**
+ * Compute the chroma contributions to the red, green and blue channels of
+ * sixteen pixels from their zero extended chroma values.
+ */
+static FORCEINLINE void computeChroma(__m256i u, __m256i v, __m256i &r, __m256i &g, __m256i &b) {
+	const __m256i bias = _mm256_set1_epi16(128);
+	u = _mm256_sub_epi16(u, bias);
+	v = _mm256_sub_epi16(v, bias);
+
+	r = mulChroma(v, kYUVCrRFactor);
+	g = _mm256_add_epi16(mulChroma(v, kYUVCrGFactor), mulChroma(u, kYUVCbGFactor));
+	b = mulChroma(u, kYUVCbBFactor);
+}
+
+/**
+ * Clip a channel to the range of the clip table and scale it to [0, 255].
+ */
+static FORCEINLINE __m256i clipChannel(__m256i c, bool itu) {
+	if (!itu)
+		return _mm256_min_epi16(_mm256_max_epi16(c, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+
+	c = _mm256_sub_epi16(_mm256_min_epi16(_mm256_max_epi16(c, _mm256_set1_epi16(16)), _mm256_set1_epi16(235)), _mm256_set1_epi16(16));
+	const __m256i frac = _mm256_mulhi_epu16(_mm256_mullo_epi16(c, _mm256_set1_epi16(36)), _mm256_set1_epi16((short)kYUVITUDivMul));
+	return _mm256_add_epi16(c, _mm256_srli_epi16(frac, kYUVITUDivShift - 16));
+}
+
+struct YUVToRGBShiftsAVX2 {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	__m256i aFull;
+	bool itu;
+
+	YUVToRGBShiftsAVX2(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		aFull = _mm256_set1_epi16(0xFF >> format.aLoss);
+		itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	}
+};
+
+static FORCEINLINE __m256i packPixels32(const YUVToRGBShiftsAVX2 &shifts, __m128i r, __m128i g, __m128i b, __m128i a) {
+	const __m256i rg = _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(r), shifts.rShift), _mm256_sll_epi32(_mm256_cvtepu16_epi32(g), shifts.gShift));
+	const __m256i ba = _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(b), shifts.bShift), _mm256_sll_epi32(_mm256_cvtepu16_epi32(a), shifts.aShift));
+	return _mm256_or_si256(rg, ba);
+}
+
+/**
+ * Convert sixteen pixels from their zero extended luminance values and their
+ * chroma contributions. aSrc is nullptr for an opaque alpha.
+ */
+template<typename PixelInt>
+static FORCEINLINE void putPixels(PixelInt *dst, const YUVToRGBShiftsAVX2 &shifts, __m256i y, const byte *aSrc, __m256i crR, __m256i crbG, __m256i cbB) {
+	const __m256i r = _mm256_srl_epi16(clipChannel(_mm256_add_epi16(y, crR), shifts.itu), shifts.rLoss);
+	const __m256i g = _mm256_srl_epi16(clipChannel(_mm256_sub_epi16(y, crbG), shifts.itu), shifts.gLoss);
+	const __m256i b = _mm256_srl_epi16(clipChannel(_mm256_add_epi16(y, cbB), shifts.itu), shifts.bLoss);
+
+	__m256i a = shifts.aFull;
+	if (aSrc)
+		a = _mm256_srl_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)aSrc)), shifts.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		const __m256i rg = _mm256_or_si256(_mm256_sll_epi16(r, shifts.rShift), _mm256_sll_epi16(g, shifts.gShift));
+		const __m256i ba = _mm256_or_si256(_mm256_sll_epi16(b, shifts.bShift), _mm256_sll_epi16(a, shifts.aShift));
+		_mm256_storeu_si256((__m256i *)dst, _mm256_or_si256(rg, ba));
+	} else {
+		_mm256_storeu_si256((__m256i *)dst, packPixels32(shifts,
+			_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b), _mm256_castsi256_si128(a)));
+		_mm256_storeu_si256((__m256i *)(dst + 8), packPixels32(shifts,
+			_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1), _mm256_extracti128_si256(a, 1)));
+	}
+}
+
+/**
+ * Duplicate each of sixteen chroma contributions for the two pixels it
+ * covers, keeping the order across the 128-bit lanes.
+ */
+static FORCEINLINE void duplicateChroma(__m256i c, __m256i &c0, __m256i &c1) {
+	const __m256i lo = _mm256_unpacklo_epi16(c, c);
+	const __m256i hi = _mm256_unpackhi_epi16(c, c);
+	c0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+	c1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+}
+
+/**
+ * Convert a row of pixels, 32 pixels per iteration. The remaining pixels
+ * are left for the C implementation.
+ */
+template<typename PixelInt, bool halfChroma>
+static void convertYUVRowToRGBAVX2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const YUVToRGBShiftsAVX2 shifts(lookup);
+
+	PixelInt *dstPtr = (PixelInt *)dst;
+	int done = 0;
+
+	for (; done + 32 <= width; done += 32) {
+		__m256i crR0, crbG0, cbB0, crR1, crbG1, cbB1;
+
+		if (halfChroma) {
+			const __m256i u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(uSrc + done / 2)));
+			const __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(vSrc + done / 2)));
+
+			__m256i crR, crbG, cbB;
+			computeChroma(u, v, crR, crbG, cbB);
+
+			duplicateChroma(crR, crR0, crR1);
+			duplicateChroma(crbG, crbG0, crbG1);
+			duplicateChroma(cbB, cbB0, cbB1);
+		} else {
+			const __m128i *u = (const __m128i *)(uSrc + done);
+			const __m128i *v = (const __m128i *)(vSrc + done);
+
+			computeChroma(_mm256_cvtepu8_epi16(_mm_loadu_si128(u)), _mm256_cvtepu8_epi16(_mm_loadu_si128(v)), crR0, crbG0, cbB0);
+			computeChroma(_mm256_cvtepu8_epi16(_mm_loadu_si128(u + 1)), _mm256_cvtepu8_epi16(_mm_loadu_si128(v + 1)), crR1, crbG1, cbB1);
+		}
+
+		const __m128i *y = (const __m128i *)(ySrc + done);
+
+		putPixels<PixelInt>(dstPtr + done, shifts, _mm256_cvtepu8_epi16(_mm_loadu_si128(y)), aSrc ? aSrc + done : nullptr, crR0, crbG0, cbB0);
+		putPixels<PixelInt>(dstPtr + done + 16, shifts, _mm256_cvtepu8_epi16(_mm_loadu_si128(y + 1)), aSrc ? aSrc + done + 16 : nullptr, crR1, crbG1, cbB1);
+	}
+
+	if (done < width) {
+		const int chromaDone = halfChroma ? done / 2 : done;
+		yuvToRGBRowFuncsGeneric.getRowFunc(halfChroma, sizeof(PixelInt))((byte *)(dstPtr + done), lookup,
+			ySrc + done, uSrc + chromaDone, vSrc + chromaDone, aSrc ? aSrc + done : nullptr, width - done);
+	}
+}
+
+/**
+ * The row conversions of yuvToRGBRowFuncsGeneric using AVX2. They compute
+ * the colour and clip tables arithmetically, and produce exactly the same
+ * pixels.
+ */
+const YUVToRGBRowFuncs yuvToRGBRowFuncsAVX2 = {
+	convertYUVRowToRGBAVX2<uint16, false>,
+	convertYUVRowToRGBAVX2<uint32, false>,
+	convertYUVRowToRGBAVX2<uint16, true>,
+	convertYUVRowToRGBAVX2<uint32, true>
+};
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,224 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+/** The high halves of the unsigned products of eight values by a constant. */
+static FORCEINLINE uint16x8_t mulhi(uint16x8_t a, uint16_t b) {
+	const uint32x4_t lo = vmull_u16(vget_low_u16(a), vdup_n_u16(b));
+	const uint32x4_t hi = vmull_u16(vget_high_u16(a), vdup_n_u16(b));
+	return vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+}
+
+/**
+ * Multiply eight chroma values in [-128, 127] by a 16.16 fixed point
+ * factor, truncating towards zero like the colour table does.
+ */
+static FORCEINLINE int16x8_t mulChroma(int16x8_t c, int factor) {
+	const uint16x8_t mag = vreinterpretq_u16_s16(vabsq_s16(c));
+
+	uint16x8_t r = mulhi(mag, factor & 0xFFFF);
+	if (factor > 0xFFFF)
+		r = vaddq_u16(r, mag);
+
+	const int16x8_t s = vreinterpretq_s16_u16(r);
+	return vbslq_s16(vcltq_s16(c, vdupq_n_s16(0)), vnegq_s16(s), s);
+}
+
+/**
+ * Compute the chroma contributions to the red, green and blue channels of
+ * eight pixels from their chroma values.
+ */
+static FORCEINLINE void computeChroma(uint8x8_t u8, uint8x8_t v8, int16x8_t &r, int16x8_t &g, int16x8_t &b) {
+	const int16x8_t bias = vdupq_n_s16(128);
+	const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), bias);
+	const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), bias);
+
+	r = mulChroma(v, kYUVCrRFactor);
+	g = vaddq_s16(mulChroma(v, kYUVCrGFactor), mulChroma(u, kYUVCbGFactor));
+	b = mulChroma(u, kYUVCbBFactor);
+}
+
+/**
+ * Clip a channel to the range of the clip table and scale it to [0, 255].
+ */
+static FORCEINLINE uint16x8_t clipChannel(int16x8_t c, bool itu) {
+	if (!itu)
+		return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(c, vdupq_n_s16(0)), vdupq_n_s16(255)));
+
+	const uint16x8_t n = vreinterpretq_u16_s16(vsubq_s16(vminq_s16(vmaxq_s16(c, vdupq_n_s16(16)), vdupq_n_s16(235)), vdupq_n_s16(16)));
+	const uint16x8_t frac = vshrq_n_u16(mulhi(vmulq_n_u16(n, 36), kYUVITUDivMul), kYUVITUDivShift - 16);
+	return vaddq_u16(n, frac);
+}
+
+struct YUVToRGBShiftsNEON {
+	int16x8_t rLoss, gLoss, bLoss, aLoss;
+	int16x8_t rShift, gShift, bShift, aShift;
+	int32x4_t rShift32, gShift32, bShift32, aShift32;
+	uint16x8_t aFull;
+	bool itu;
+
+	YUVToRGBShiftsNEON(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+
+		// Negative counts shift to the right
+		rLoss = vdupq_n_s16(-format.rLoss);
+		gLoss = vdupq_n_s16(-format.gLoss);
+		bLoss = vdupq_n_s16(-format.bLoss);
+		aLoss = vdupq_n_s16(-format.aLoss);
+		rShift = vdupq_n_s16(format.rShift);
+		gShift = vdupq_n_s16(format.gShift);
+		bShift = vdupq_n_s16(format.bShift);
+		aShift = vdupq_n_s16(format.aShift);
+		rShift32 = vdupq_n_s32(format.rShift);
+		gShift32 = vdupq_n_s32(format.gShift);
+		bShift32 = vdupq_n_s32(format.bShift);
+		aShift32 = vdupq_n_s32(format.aShift);
+		aFull = vdupq_n_u16(0xFF >> format.aLoss);
+		itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	}
+};
+
+static FORCEINLINE uint32x4_t packPixels32(const YUVToRGBShiftsNEON &shifts, uint16x4_t r, uint16x4_t g, uint16x4_t b, uint16x4_t a) {
+	const uint32x4_t rg = vorrq_u32(vshlq_u32(vmovl_u16(r), shifts.rShift32), vshlq_u32(vmovl_u16(g), shifts.gShift32));
+	const uint32x4_t ba = vorrq_u32(vshlq_u32(vmovl_u16(b), shifts.bShift32), vshlq_u32(vmovl_u16(a), shifts.aShift32));
+	return vorrq_u32(rg, ba);
+}
+
+/**
+ * Convert eight pixels from their luminance values and their chroma
+ * contributions. aSrc is nullptr for an opaque alpha.
+ */
+template<typename PixelInt>
+static FORCEINLINE void putPixels(PixelInt *dst, const YUVToRGBShiftsNEON &shifts, uint8x8_t y8, const byte *aSrc, int16x8_t crR, int16x8_t crbG, int16x8_t cbB) {
+	const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(y8));
+
+	const uint16x8_t r = vshlq_u16(clipChannel(vaddq_s16(y, crR), shifts.itu), shifts.rLoss);
+	const uint16x8_t g = vshlq_u16(clipChannel(vsubq_s16(y, crbG), shifts.itu), shifts.gLoss);
+	const uint16x8_t b = vshlq_u16(clipChannel(vaddq_s16(y, cbB), shifts.itu), shifts.bLoss);
+
+	uint16x8_t a = shifts.aFull;
+	if (aSrc)
+		a = vshlq_u16(vmovl_u8(vld1_u8(aSrc)), shifts.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		const uint16x8_t rg = vorrq_u16(vshlq_u16(r, shifts.rShift), vshlq_u16(g, shifts.gShift));
+		const uint16x8_t ba = vorrq_u16(vshlq_u16(b, shifts.bShift), vshlq_u16(a, shifts.aShift));
+		vst1q_u16((uint16 *)dst, vorrq_u16(rg, ba));
+	} else {
+		vst1q_u32((uint32 *)dst, packPixels32(shifts, vget_low_u16(r), vget_low_u16(g), vget_low_u16(b), vget_low_u16(a)));
+		vst1q_u32((uint32 *)dst + 4, packPixels32(shifts, vget_high_u16(r), vget_high_u16(g), vget_high_u16(b), vget_high_u16(a)));
+	}
+}
+
+/**
+ * Convert a row of pixels, 16 pixels per iteration. The remaining pixels
+ * are left for the C implementation.
+ */
+template<typename PixelInt, bool halfChroma>
+static void convertYUVRowToRGBNEON(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const YUVToRGBShiftsNEON shifts(lookup);
+
+	PixelInt *dstPtr = (PixelInt *)dst;
+	int done = 0;
+
+	for (; done + 16 <= width; done += 16) {
+		int16x8_t crR0, crbG0, cbB0, crR1, crbG1, cbB1;
+
+		if (halfChroma) {
+			int16x8_t crR, crbG, cbB;
+			computeChroma(vld1_u8(uSrc + done / 2), vld1_u8(vSrc + done / 2), crR, crbG, cbB);
+
+			// Each chroma sample covers two pixels
+			const int16x8x2_t r = vzipq_s16(crR, crR);
+			const int16x8x2_t g = vzipq_s16(crbG, crbG);
+			const int16x8x2_t b = vzipq_s16(cbB, cbB);
+			crR0 = r.val[0];
+			crR1 = r.val[1];
+			crbG0 = g.val[0];
+			crbG1 = g.val[1];
+			cbB0 = b.val[0];
+			cbB1 = b.val[1];
+		} else {
+			const uint8x16_t u = vld1q_u8(uSrc + done);
+			const uint8x16_t v = vld1q_u8(vSrc + done);
+
+			computeChroma(vget_low_u8(u), vget_low_u8(v), crR0, crbG0, cbB0);
+			computeChroma(vget_high_u8(u), vget_high_u8(v), crR1, crbG1, cbB1);
+		}
+
+		const uint8x16_t y = vld1q_u8(ySrc + done);
+
+		putPixels<PixelInt>(dstPtr + done, shifts, vget_low_u8(y), aSrc ? aSrc + done : nullptr, crR0, crbG0, cbB0);
+		putPixels<PixelInt>(dstPtr + done + 8, shifts, vget_high_u8(y), aSrc ? aSrc + done + 8 : nullptr, crR1, crbG1, cbB1);
+	}
+
+	if (done < width) {
+		const int chromaDone = halfChroma ? done / 2 : done;
+		yuvToRGBRowFuncsGeneric.getRowFunc(halfChroma, sizeof(PixelInt))((byte *)(dstPtr + done), lookup,
+			ySrc + done, uSrc + chromaDone, vSrc + chromaDone, aSrc ? aSrc + done : nullptr, width - done);
+	}
+}
+
+/**
+ * The row conversions of yuvToRGBRowFuncsGeneric using NEON. They compute
+ * the colour and clip tables arithmetically, and produce exactly the same
+ * pixels.
+ */
+const YUVToRGBRowFuncs yuvToRGBRowFuncsNEON = {
+	convertYUVRowToRGBNEON<uint16, false>,
+	convertYUVRowToRGBNEON<uint32, false>,
+	convertYUVRowToRGBNEON<uint16, true>,
+	convertYUVRowToRGBNEON<uint32, true>
+};
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
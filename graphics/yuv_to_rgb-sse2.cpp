@@ -0,0 +1,207 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+/**
+ * Multiply eight chroma values in [-128, 127] by a 16.16 fixed point
+ * factor, truncating towards zero like the colour table does.
+ */
+static FORCEINLINE __m128i mulChroma(__m128i c, int factor) {
+	const __m128i sign = _mm_srai_epi16(c, 15);
+	const __m128i mag = _mm_sub_epi16(_mm_xor_si128(c, sign), sign);
+
+	__m128i r = _mm_mulhi_epu16(mag, _mm_set1_epi16((short)(factor & 0xFFFF)));
+	if (factor > 0xFFFF)
+		r = _mm_add_epi16(r, mag);
+
+	return _mm_sub_epi16(_mm_xor_si128(r, sign), sign);
+}
+
+/**
+ * Compute the chroma contributions to the red, green and blue channels of
+ * eight pixels from their zero extended chroma values.
+ */
+static FORCEINLINE void computeChroma(__m128i u, __m128i v, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i bias = _mm_set1_epi16(128);
+	u = _mm_sub_epi16(u, bias);
+	v = _mm_sub_epi16(v, bias);
+
+	r = mulChroma(v, kYUVCrRFactor);
+	g = _mm_add_epi16(mulChroma(v, kYUVCrGFactor), mulChroma(u, kYUVCbGFactor));
+	b = mulChroma(u, kYUVCbBFactor);
+}
+
+/**
+ * Clip a channel to the range of the clip table and scale it to [0, 255].
+ */
+static FORCEINLINE __m128i clipChannel(__m128i c, bool itu) {
+	if (!itu)
+		return _mm_min_epi16(_mm_max_epi16(c, _mm_setzero_si128()), _mm_set1_epi16(255));
+
+	c = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(c, _mm_set1_epi16(16)), _mm_set1_epi16(235)), _mm_set1_epi16(16));
+	const __m128i frac = _mm_mulhi_epu16(_mm_mullo_epi16(c, _mm_set1_epi16(36)), _mm_set1_epi16((short)kYUVITUDivMul));
+	return _mm_add_epi16(c, _mm_srli_epi16(frac, kYUVITUDivShift - 16));
+}
+
+struct YUVToRGBShiftsSSE2 {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	__m128i aFull;
+	bool itu;
+
+	YUVToRGBShiftsSSE2(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		aFull = _mm_set1_epi16(0xFF >> format.aLoss);
+		itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	}
+};
+
+/**
+ * Convert eight pixels from their zero extended luminance and alpha values
+ * and their chroma contributions. aSrc is nullptr for an opaque alpha.
+ */
+template<typename PixelInt>
+static FORCEINLINE void putPixels(PixelInt *dst, const YUVToRGBShiftsSSE2 &shifts, __m128i y, const byte *aSrc, __m128i crR, __m128i crbG, __m128i cbB) {
+	const __m128i zero = _mm_setzero_si128();
+
+	const __m128i r = _mm_srl_epi16(clipChannel(_mm_add_epi16(y, crR), shifts.itu), shifts.rLoss);
+	const __m128i g = _mm_srl_epi16(clipChannel(_mm_sub_epi16(y, crbG), shifts.itu), shifts.gLoss);
+	const __m128i b = _mm_srl_epi16(clipChannel(_mm_add_epi16(y, cbB), shifts.itu), shifts.bLoss);
+
+	__m128i a = shifts.aFull;
+	if (aSrc)
+		a = _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)aSrc), zero), shifts.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		const __m128i rg = _mm_or_si128(_mm_sll_epi16(r, shifts.rShift), _mm_sll_epi16(g, shifts.gShift));
+		const __m128i ba = _mm_or_si128(_mm_sll_epi16(b, shifts.bShift), _mm_sll_epi16(a, shifts.aShift));
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(rg, ba));
+	} else {
+		__m128i rg = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), shifts.rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), shifts.gShift));
+		__m128i ba = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(b, zero), shifts.bShift), _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), shifts.aShift));
+		_mm_storeu_si128((__m128i *)dst, _mm_or_si128(rg, ba));
+
+		rg = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), shifts.rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), shifts.gShift));
+		ba = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(b, zero), shifts.bShift), _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), shifts.aShift));
+		_mm_storeu_si128((__m128i *)(dst + 4), _mm_or_si128(rg, ba));
+	}
+}
+
+/**
+ * Convert a row of pixels, 16 pixels per iteration. The remaining pixels
+ * are left for the C implementation.
+ */
+template<typename PixelInt, bool halfChroma>
+static void convertYUVRowToRGBSSE2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const YUVToRGBShiftsSSE2 shifts(lookup);
+	const __m128i zero = _mm_setzero_si128();
+
+	PixelInt *dstPtr = (PixelInt *)dst;
+	int done = 0;
+
+	for (; done + 16 <= width; done += 16) {
+		__m128i crR0, crbG0, cbB0, crR1, crbG1, cbB1;
+
+		if (halfChroma) {
+			const __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(uSrc + done / 2)), zero);
+			const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(vSrc + done / 2)), zero);
+
+			__m128i crR, crbG, cbB;
+			computeChroma(u, v, crR, crbG, cbB);
+
+			// Each chroma sample covers two pixels
+			crR0 = _mm_unpacklo_epi16(crR, crR);
+			crR1 = _mm_unpackhi_epi16(crR, crR);
+			crbG0 = _mm_unpacklo_epi16(crbG, crbG);
+			crbG1 = _mm_unpackhi_epi16(crbG, crbG);
+			cbB0 = _mm_unpacklo_epi16(cbB, cbB);
+			cbB1 = _mm_unpackhi_epi16(cbB, cbB);
+		} else {
+			const __m128i u = _mm_loadu_si128((const __m128i *)(uSrc + done));
+			const __m128i v = _mm_loadu_si128((const __m128i *)(vSrc + done));
+
+			computeChroma(_mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero), crR0, crbG0, cbB0);
+			computeChroma(_mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero), crR1, crbG1, cbB1);
+		}
+
+		const __m128i y = _mm_loadu_si128((const __m128i *)(ySrc + done));
+
+		putPixels<PixelInt>(dstPtr + done, shifts, _mm_unpacklo_epi8(y, zero), aSrc ? aSrc + done : nullptr, crR0, crbG0, cbB0);
+		putPixels<PixelInt>(dstPtr + done + 8, shifts, _mm_unpackhi_epi8(y, zero), aSrc ? aSrc + done + 8 : nullptr, crR1, crbG1, cbB1);
+	}
+
+	if (done < width) {
+		const int chromaDone = halfChroma ? done / 2 : done;
+		yuvToRGBRowFuncsGeneric.getRowFunc(halfChroma, sizeof(PixelInt))((byte *)(dstPtr + done), lookup,
+			ySrc + done, uSrc + chromaDone, vSrc + chromaDone, aSrc ? aSrc + done : nullptr, width - done);
+	}
+}
+
+/**
+ * The row conversions of yuvToRGBRowFuncsGeneric using SSE2. They compute
+ * the colour and clip tables arithmetically, and produce exactly the same
+ * pixels.
+ */
+const YUVToRGBRowFuncs yuvToRGBRowFuncsSSE2 = {
+	convertYUVRowToRGBSSE2<uint16, false>,
+	convertYUVRowToRGBSSE2<uint32, false>,
+	convertYUVRowToRGBSSE2<uint16, true>,
+	convertYUVRowToRGBSSE2<uint32, true>
+};
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
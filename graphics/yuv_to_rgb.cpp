@@ -82,8 +82,12 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/mutex.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,22 +95,6 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
-class YUVToRGBLookup {
-public:
-	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
-
-	Graphics::PixelFormat getFormat() const { return _format; }
-	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
-	const int16 *getColorTable() const { return _colorTab; }
-	const byte *getClipTable() const { return _clipTable; }
-
-private:
-	Graphics::PixelFormat _format;
-	YUVToRGBManager::LuminanceScale _scale;
-	int16 _colorTab[4 * 256]; // 2048 bytes
-	byte _clipTable[3 * 768];
-};
-
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
 	_format = format;
 	_scale = scale;
@@ -181,29 +169,16 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 	}
 }
 
-YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
-}
-
-YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
-}
-
-const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
-		return _lookup;
-
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale);
-	return _lookup;
-}
-
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
 
-template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+#define PUT_PIXELA(s, a, d) \
+	L = &clipTable[(s)]; \
+	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
+
+template<typename PixelInt, bool halfChroma, bool hasAlpha>
+static void convertYUVRowToRGB(byte *dstPtr, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = lookup->getColorTable();
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -214,230 +189,258 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const byte r_shift = lookup->getFormat().rShift;
 	const byte g_shift = lookup->getFormat().gShift;
 	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
+	const byte a_shift = lookup->getFormat().aShift;
+	const byte a_loss = lookup->getFormat().aLoss;
+	const PixelInt a_mask = (0xFF >> a_loss) << a_shift;
 
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
-			const byte *L;
+	const int chromaWidth = halfChroma ? width >> 1 : width;
+
+	for (int w = 0; w < chromaWidth; w++) {
+		const byte *L;
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
+		int16 cr_r  = Cr_r_tab[*vSrc];
+		int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		int16 cb_b  = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
 
+		if (hasAlpha) {
+			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
+			aSrc++;
+		} else {
 			PUT_PIXEL(*ySrc, dstPtr);
+		}
+		ySrc++;
+		dstPtr += sizeof(PixelInt);
+
+		if (halfChroma) {
+			if (hasAlpha) {
+				PUT_PIXELA(*ySrc, *aSrc, dstPtr);
+				aSrc++;
+			} else {
+				PUT_PIXEL(*ySrc, dstPtr);
+			}
 			ySrc++;
 			dstPtr += sizeof(PixelInt);
 		}
-
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-		uSrc += uvPitch - yWidth;
-		vSrc += uvPitch - yWidth;
 	}
 }
 
-void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+#undef PUT_PIXEL
+#undef PUT_PIXELA
 
+template<typename PixelInt, bool halfChroma>
+static void convertYUVRowToRGB(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
 	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	if (aSrc)
+		convertYUVRowToRGB<PixelInt, halfChroma, true>(dst, lookup, ySrc, uSrc, vSrc, aSrc, width);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVRowToRGB<PixelInt, halfChroma, false>(dst, lookup, ySrc, uSrc, vSrc, aSrc, width);
 }
 
-template<typename PixelInt>
-void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfWidth = yWidth >> 1;
+const YUVToRGBRowFuncs yuvToRGBRowFuncsGeneric = {
+	convertYUVRowToRGB<uint16, false>,
+	convertYUVRowToRGB<uint32, false>,
+	convertYUVRowToRGB<uint16, true>,
+	convertYUVRowToRGB<uint32, true>
+};
 
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
+YUVToRGBManager::YUVToRGBManager() {
+	for (int i = 0; i < kLookupCacheSize; i++) {
+		_lookups[i].lookup = nullptr;
+		_lookups[i].refCount = 0;
+	}
 
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
+	_rowFuncs = &yuvToRGBRowFuncsGeneric;
+	_lookupMutex = new Common::Mutex();
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_rowFuncs = &yuvToRGBRowFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_rowFuncs = &yuvToRGBRowFuncsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		_rowFuncs = &yuvToRGBRowFuncsAVX2;
+#endif
+}
 
-	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
+YUVToRGBManager::~YUVToRGBManager() {
+	for (int i = 0; i < kLookupCacheSize; i++)
+		delete _lookups[i].lookup;
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
+	delete _lookupMutex;
+}
 
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+YUVToRGBManager &YUVToRGBManager::instance() {
+	// Videos are also converted on worker threads, which must not create
+	// the manager twice. The mutex is created on the first call, under the
+	// guard the compiler puts around initializing local statics, and kept
+	// for the whole run.
+	static Common::Mutex *instanceMutex = new Common::Mutex();
 
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch  - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
-	}
+	Common::StackLock lock(*instanceMutex);
+	if (!_singleton)
+		_singleton = new YUVToRGBManager();
+
+	return *_singleton;
 }
 
-void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
+const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
+	Common::StackLock lock(*_lookupMutex);
+
+	int i = 0;
+	while (i < kLookupCacheSize && _lookups[i].lookup && (_lookups[i].lookup->getFormat() != format || _lookups[i].lookup->getScale() != scale))
+		i++;
+
+	if (i == kLookupCacheSize || !_lookups[i].lookup) {
+		// Not cached, replace the least recently used lookup which no
+		// conversion is using. The free entries are at the end.
+		i = kLookupCacheSize - 1;
+		while (i >= 0 && _lookups[i].refCount > 0)
+			i--;
+
+		// All of them are in use, so don't cache this one. It is deleted
+		// again by releaseLookup().
+		if (i < 0)
+			return new YUVToRGBLookup(format, scale);
+
+		delete _lookups[i].lookup;
+		_lookups[i].lookup = new YUVToRGBLookup(format, scale);
+	}
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const CachedLookup entry = _lookups[i];
+	for (; i > 0; i--)
+		_lookups[i] = _lookups[i - 1];
+	_lookups[0] = entry;
+	_lookups[0].refCount++;
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	return entry.lookup;
 }
 
-template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
+void YUVToRGBManager::releaseLookup(const YUVToRGBLookup *lookup) {
+	Common::StackLock lock(*_lookupMutex);
 
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
+	for (int i = 0; i < kLookupCacheSize; i++) {
+		if (_lookups[i].lookup == lookup) {
+			assert(_lookups[i].refCount > 0);
+			_lookups[i].refCount--;
+			return;
+		}
+	}
 
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
+	delete lookup;
+}
+
+void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Sanity checks
+	assert(dst && dst->getPixels());
+	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
 
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
+	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowFuncs::RowFunc convertRow = _rowFuncs->getRowFunc(false, dst->format.bytesPerPixel);
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
+	byte *dstPtr = (byte *)dst->getPixels();
 
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXEL(*ySrc, dstPtr);
-			PUT_PIXEL(*(ySrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	for (int h = 0; h < yHeight; h++) {
+		convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, nullptr, yWidth);
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
 	}
+
+	releaseLookup(lookup);
 }
 
-void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowFuncs::RowFunc convertRow = _rowFuncs->getRowFunc(true, dst->format.bytesPerPixel);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-}
+	byte *dstPtr = (byte *)dst->getPixels();
 
-#define PUT_PIXELA(s, a, d) \
-	L = &clipTable[(s)]; \
-	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
+	for (int h = 0; h < yHeight; h++) {
+		convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, nullptr, yWidth);
 
-template<typename PixelInt>
-void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	int halfHeight = yHeight >> 1;
-	int halfWidth = yWidth >> 1;
+		dstPtr += dst->pitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
 
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
+	releaseLookup(lookup);
+}
 
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const byte a_shift = lookup->getFormat().aShift;
-	const byte a_loss = lookup->getFormat().aLoss;
+void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool) {
+	// Sanity checks
+	assert(dst && dst->getPixels());
+	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
+	assert((yWidth & 1) == 0);
+	assert((yHeight & 1) == 0);
 
-	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
-			const byte *L;
+	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowFuncs::RowFunc convertRow = _rowFuncs->getRowFunc(true, dst->format.bytesPerPixel);
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
-			++uSrc;
-			++vSrc;
+	byte *dstPtr = (byte *)dst->getPixels();
+	const int dstPitch = dst->pitch;
 
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-			PUT_PIXELA(*ySrc, *aSrc, dstPtr);
-			PUT_PIXELA(*(ySrc + yPitch), *(aSrc + yPitch), dstPtr + dstPitch);
-			ySrc++;
-			aSrc++;
-			dstPtr += sizeof(PixelInt);
-		}
+	// Each chroma row is shared by two luminance rows, which are converted
+	// together so that slices never share a chroma row
+	const auto convertRows = [=](int h) {
+		for (int i = h * 2; i < h * 2 + 2; i++)
+			convertRow(dstPtr + i * dstPitch, lookup, ySrc + i * yPitch, uSrc + h * uvPitch, vSrc + h * uvPitch, nullptr, yWidth);
+	};
 
-		dstPtr += dstPitch;
-		ySrc += (yPitch << 1) - yWidth;
-		aSrc += (yPitch << 1) - yWidth;
-		uSrc += uvPitch - halfWidth;
-		vSrc += uvPitch - halfWidth;
+	if (pool) {
+		pool->parallelFor(0, yHeight / 2, convertRows);
+	} else {
+		for (int h = 0; h < yHeight / 2; h++)
+			convertRows(h);
 	}
+
+	releaseLookup(lookup);
 }
 
-void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
+	assert(ySrc && uSrc && vSrc && aSrc);
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowFuncs::RowFunc convertRow = _rowFuncs->getRowFunc(true, dst->format.bytesPerPixel);
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+	byte *dstPtr = (byte *)dst->getPixels();
+	const int dstPitch = dst->pitch;
+
+	// Each chroma row is shared by two luminance rows, see convert420()
+	const auto convertRows = [=](int h) {
+		for (int i = h * 2; i < h * 2 + 2; i++)
+			convertRow(dstPtr + i * dstPitch, lookup, ySrc + i * yPitch, uSrc + h * uvPitch, vSrc + h * uvPitch, aSrc + i * yPitch, yWidth);
+	};
+
+	if (pool) {
+		pool->parallelFor(0, yHeight / 2, convertRows);
+	} else {
+		for (int h = 0; h < yHeight / 2; h++)
+			convertRows(h);
+	}
+
+	releaseLookup(lookup);
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -450,71 +453,7 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
 			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
 
-#define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
-	\
-	cr_r  = Cr_r_tab[v]; \
-	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
-	cb_b  = Cb_b_tab[u]; \
-	\
-	PUT_PIXEL(*ySrc, dstPtr); \
-	dstPtr += sizeof(PixelInt); \
-	\
-	ySrc++; \
-	xDiff++
-
-template<typename PixelInt>
-void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->getColorTable();
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
-	const byte *clipTable = lookup->getClipTable();
-
-	const byte r_shift = lookup->getFormat().rShift;
-	const byte g_shift = lookup->getFormat().gShift;
-	const byte b_shift = lookup->getFormat().bShift;
-	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
-
-	int quarterWidth = yWidth >> 2;
-
-	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
-			// Perform bilinear interpolation on the chroma values
-			// Based on the algorithm found here:
-			// https://web.archive.org/web/20120228182419/http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
-			int targetY = y >> 2;
-			int xDiff = 0;
-			int yDiff = y & 3;
-			int index = targetY * uvPitch + x;
-
-			// Declare some variables for the following macros
-			byte u, v;
-			int16 cr_r, crb_g, cb_b;
-			const byte *L;
-
-			READ_QUAD(uSrc, u);
-			READ_QUAD(vSrc, v);
-
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-			DO_YUV410_PIXEL();
-		}
-
-		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
-		ySrc += yPitch - yWidth;
-	}
-}
-
-#undef READ_QUAD
-#undef DO_INTERPOLATION
-#undef DO_YUV410_PIXEL
-
-void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
@@ -523,12 +462,58 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 3) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	const YUVToRGBRowFuncs::RowFunc convertRow = _rowFuncs->getRowFunc(false, dst->format.bytesPerPixel);
+
+	byte *dstPtr = (byte *)dst->getPixels();
+	const int dstPitch = dst->pitch;
+	const int bytesPerPixel = dst->format.bytesPerPixel;
+
+	// The chroma is upscaled to a full resolution row in chunks, which are
+	// then converted like YUV444. Rows only read the chroma, so they can be
+	// converted in any order.
+	const auto convertRows = [=](int y) {
+		const int kChunkWidth = 256;
+		byte uRow[kChunkWidth];
+		byte vRow[kChunkWidth];
+
+		const int yDiff = y & 3;
+
+		for (int chunk = 0; chunk < yWidth; chunk += kChunkWidth) {
+			const int chunkWidth = MIN(yWidth - chunk, kChunkWidth);
+
+			for (int x = 0; x < chunkWidth; x += 4) {
+				// Perform bilinear interpolation on the chroma values
+				// Based on the algorithm found here:
+				// https://web.archive.org/web/20120228182419/http://tech-algorithm.com/articles/bilinear-image-scaling/
+				int index = (y >> 2) * uvPitch + ((chunk + x) >> 2);
+
+				READ_QUAD(uSrc, u);
+				READ_QUAD(vSrc, v);
+
+				for (int xDiff = 0; xDiff < 4; xDiff++) {
+					byte u, v;
+					DO_INTERPOLATION(u);
+					DO_INTERPOLATION(v);
+					uRow[x + xDiff] = u;
+					vRow[x + xDiff] = v;
+				}
+			}
+
+			convertRow(dstPtr + y * dstPitch + chunk * bytesPerPixel, lookup, ySrc + y * yPitch + chunk, uRow, vRow, nullptr, chunkWidth);
+		}
+	};
 
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	if (pool) {
+		pool->parallelFor(0, yHeight, convertRows);
+	} else {
+		for (int y = 0; y < yHeight; y++)
+			convertRows(y);
+	}
+
+	releaseLookup(lookup);
 }
 
+#undef READ_QUAD
+#undef DO_INTERPOLATION
+
 } // End of namespace Graphics
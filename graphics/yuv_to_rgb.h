@@ -41,9 +41,15 @@
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+namespace Common {
+class Mutex;
+class ThreadPool;
+}
+
 namespace Graphics {
 
 class YUVToRGBLookup;
+struct YUVToRGBRowFuncs;
 
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
@@ -95,8 +101,9 @@ public:
 	 * @param yHeight the height of the y surface (must be divisible by 2)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
+	 * @param pool    if not nullptr, the rows are converted in slices on this pool
 	 */
-	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool = nullptr);
 
 	/**
 	 * Convert a YUV420 image with Alpha component to an ARGB surface
@@ -111,8 +118,9 @@ public:
 	 * @param yHeight the height of the y surface (must be divisible by 2)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
+	 * @param pool    if not nullptr, the rows are converted in slices on this pool
 	 */
-	void convert420Alpha(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	void convert420Alpha(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool = nullptr);
 
 	/**
 	 * Convert a YUV410 image to an RGB surface
@@ -132,17 +140,48 @@ public:
 	 * @param yHeight the height of the y surface (must be divisible by 4)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
+	 * @param pool    if not nullptr, the rows are converted in slices on this pool
+	 */
+	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool = nullptr);
+
+	/**
+	 * Return the manager, creating it if needed. Unlike Singleton::instance(),
+	 * this may be called from several threads at once.
 	 */
-	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	static YUVToRGBManager &instance();
 
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
 	~YUVToRGBManager();
 
+	/**
+	 * Get the lookup of a format and scale, which stays valid until it is
+	 * passed to releaseLookup().
+	 */
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
+	void releaseLookup(const YUVToRGBLookup *lookup);
+
+	/**
+	 * Videos are often converted to more than one format or scale at once,
+	 * e.g. when a game overlays two of them, so keep a few lookups around.
+	 */
+	static const int kLookupCacheSize = 4;
+
+	struct CachedLookup {
+		YUVToRGBLookup *lookup;
+		/** The conversions using the lookup, which must not evict it */
+		uint refCount;
+	};
+
+	/** The cached lookups, the most recently used first */
+	CachedLookup _lookups[kLookupCacheSize];
+
+	/** Guards the lookup cache, as videos may be converted on other threads */
+	Common::Mutex *_lookupMutex;
 
-	YUVToRGBLookup *_lookup;
+	/** The row conversion functions for the running CPU */
+	const YUVToRGBRowFuncs *_rowFuncs;
 };
  /** @} */
 } // End of namespace Graphics
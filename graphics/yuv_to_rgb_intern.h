@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+class YUVToRGBLookup {
+public:
+	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
+
+	Graphics::PixelFormat getFormat() const { return _format; }
+	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	const int16 *getColorTable() const { return _colorTab; }
+	const byte *getClipTable() const { return _clipTable; }
+
+private:
+	Graphics::PixelFormat _format;
+	YUVToRGBManager::LuminanceScale _scale;
+	int16 _colorTab[4 * 256]; // 2048 bytes
+	byte _clipTable[3 * 768];
+};
+
+/**
+ * The chroma factors of the colour table in 16.16 fixed point, for the SIMD
+ * versions which compute the table entries instead of looking them up.
+ * With these, (|c| * factor) >> 16 truncates exactly like the float
+ * conversion of the table does for every chroma value c in [-128, 127].
+ */
+enum {
+	kYUVCrRFactor = 65536 + 26302,	///< 0.419 / 0.299
+	kYUVCrGFactor = 46767,			///< 0.299 / 0.419
+	kYUVCbGFactor = 22571,			///< 0.114 / 0.331
+	kYUVCbBFactor = 65536 + 50686	///< 0.587 / 0.331
+};
+
+/**
+ * Multiplier and shift to divide (n * 36) by 219 for n in [0, 219], which
+ * stretches the ITU luminance range as n + n * 36 / 219.
+ */
+enum {
+	kYUVITUDivMul = 38305,
+	kYUVITUDivShift = 23
+};
+
+/**
+ * Functions converting one row of pixels. The 444 versions take one chroma
+ * sample per pixel, the 422 versions one per two pixels, in which case
+ * width must be even. aSrc is nullptr unless the alpha channel of the
+ * destination is taken from an alpha plane.
+ */
+struct YUVToRGBRowFuncs {
+	typedef void (*RowFunc)(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width);
+
+	RowFunc row444To16;
+	RowFunc row444To32;
+	RowFunc row422To16;
+	RowFunc row422To32;
+
+	RowFunc getRowFunc(bool halfChroma, int bytesPerPixel) const {
+		if (halfChroma)
+			return bytesPerPixel == 2 ? row422To16 : row422To32;
+		else
+			return bytesPerPixel == 2 ? row444To16 : row444To32;
+	}
+};
+
+extern const YUVToRGBRowFuncs yuvToRGBRowFuncsGeneric;
+#ifdef SCUMMVM_NEON
+extern const YUVToRGBRowFuncs yuvToRGBRowFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const YUVToRGBRowFuncs yuvToRGBRowFuncsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+extern const YUVToRGBRowFuncs yuvToRGBRowFuncsAVX2;
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -61,6 +61,7 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	_dirsScanned(0),
 	_oldGamesCount(0),
 	_dirTotal(0),
+	_detectionSession(new DetectionSession()),
 	_okButton(nullptr),
 	_dirProgressText(nullptr),
 	_gameProgressText(nullptr) {
@@ -183,6 +184,10 @@ void MassAddDialog::updateGameList() {
 	}
 }
 
+MassAddDialog::~MassAddDialog() {
+	delete _detectionSession;
+}
+
 void MassAddDialog::handleTickle() {
 	if (_scanStack.empty())
 		return;	// We have finished scanning
@@ -194,12 +199,12 @@ void MassAddDialog::handleTickle() {
 		Common::FSNode dir = _scanStack.pop();
 
 		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+		if (!_detectionSession->getChildren(dir, files)) {
 			continue;
 		}
 
 		// Run the detector on the dir
-		DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED | ADGF_ADDON), true);
+		DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED | ADGF_ADDON), true, _detectionSession);
 
 		if (detectionResults.foundUnknownGames()) {
 			Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
@@ -277,6 +282,12 @@ void MassAddDialog::handleTickle() {
 	Common::U32String buf;
 
 	if (_scanStack.empty()) {
+		// Make sure the hashes of all scanned files are kept for next time
+		ADCacheMan.saveFileCache(true);
+
+		delete _detectionSession;
+		_detectionSession = nullptr;
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
@@ -29,6 +29,8 @@
 #include "common/stack.h"
 #include "common/str.h"
 
+class DetectionSession;
+
 namespace GUI {
 
 class StaticTextWidget;
@@ -37,6 +39,7 @@ class MassAddListWidget;
 class MassAddDialog : public Dialog {
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -66,6 +69,9 @@ private:
 	int _oldGamesCount;
 	int _dirTotal;
 
+	/** Shared by the detections of all scanned directories */
+	DetectionSession *_detectionSession;
+
 	Widget *_okButton;
 	StaticTextWidget *_dirProgressText;
 	StaticTextWidget *_gameProgressText;
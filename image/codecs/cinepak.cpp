@@ -281,6 +281,7 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, Common::Seeka
 
 CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec(), _bitsPerPixel(bitsPerPixel), _ditherPalette(0) {
 	_curFrame.surface = 0;
+	_ownSurface = 0;
 	_curFrame.strips = 0;
 	_y = 0;
 	_colorMap = 0;
@@ -309,15 +310,15 @@ CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec(), _bitsPerPixel(bitsPe
 }
 
 CinepakDecoder::~CinepakDecoder() {
-	if (_curFrame.surface) {
-		_curFrame.surface->free();
-		delete _curFrame.surface;
+	if (_ownSurface) {
+		_ownSurface->free();
+		delete _ownSurface;
 	}
 
 	delete[] _curFrame.strips;
 	delete[] _clipTableBuf;
 
-	delete[] _colorMap;
+	freeColorMap();
 }
 
 const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream &stream) {
@@ -348,8 +349,9 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 	}
 
 	if (!_curFrame.surface) {
-		_curFrame.surface = new Graphics::Surface();
-		_curFrame.surface->create(_curFrame.width, _curFrame.height, _pixelFormat);
+		_ownSurface = new Graphics::Surface();
+		_ownSurface->create(_curFrame.width, _curFrame.height, _pixelFormat);
+		_curFrame.surface = _ownSurface;
 	}
 
 	_y = 0;
@@ -491,7 +493,7 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v1_codebook[codebookIndex];
 		byte *output = (byte *)(_curFrame.strips[strip].v1_dither + codebookIndex);
 
-		byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
+		const byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
 		output[0x000] = ditherEntry[0x0000];
 		output[0x001] = ditherEntry[0x4000];
 		output[0x400] = ditherEntry[0xC000];
@@ -518,7 +520,7 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v4_codebook[codebookIndex];
 		byte *output = (byte *)(_curFrame.strips[strip].v4_dither + codebookIndex);
 
-		byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
+		const byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
 		output[0x000] = ditherEntry[0x0000];
 		output[0x400] = ditherEntry[0x8000];
 		output[0x800] = ditherEntry[0x4000];
@@ -642,6 +644,15 @@ void CinepakDecoder::decodeVectors24(Common::SeekableReadStream &stream, uint16
 	}
 }
 
+bool CinepakDecoder::setOutputSurface(Graphics::Surface *surface) {
+	// The size of the frames is only known once the first one is decoded
+	if (!_ownSurface)
+		return !surface;
+
+	switchOutputSurface(_curFrame.surface, _ownSurface, _outputSurface, surface);
+	return true;
+}
+
 bool CinepakDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
 	if (_bitsPerPixel == 8)
 		return format.isCLUT8();
@@ -660,7 +671,7 @@ bool CinepakDecoder::canDither(DitherType type) const {
 void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	assert(canDither(type));
 
-	delete[] _colorMap;
+	freeColorMap();
 
 	_ditherPalette.resize(256, false);
 	_ditherPalette.set(palette, 0, 256);
@@ -670,17 +681,32 @@ void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	_ditherType = type;
 
 	if (type == kDitherTypeVFW) {
-		_colorMap = new byte[1024];
+		byte *colorMap = new byte[1024];
 
 		for (int i = 0; i < 1024; i++)
-			_colorMap[i] = findNearestRGB(s_defaultPaletteLookup[i]);
+			colorMap[i] = findNearestRGB(s_defaultPaletteLookup[i]);
+
+		_colorMap = colorMap;
 	} else {
-		// Generate QuickTime dither table
+		// Get the QuickTime dither table
 		// 4 blocks of 0x4000 bytes (RGB554 lookup)
-		_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+		_colorMap = DitherCodec::getQuickTimeDitherTable(palette, 256);
 	}
 }
 
+void CinepakDecoder::freeColorMap() {
+	if (!_colorMap)
+		return;
+
+	// The QuickTime dither tables are shared
+	if (_ditherType == kDitherTypeQT)
+		DitherCodec::releaseQuickTimeDitherTable(_colorMap);
+	else
+		delete[] _colorMap;
+
+	_colorMap = nullptr;
+}
+
 byte CinepakDecoder::findNearestRGB(int index) const {
 	byte r = s_defaultPalette[index * 3];
 	byte g = s_defaultPalette[index * 3 + 1];
@@ -76,6 +76,7 @@ public:
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
 	Graphics::PixelFormat getPixelFormat() const override { return _pixelFormat; }
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
+	bool setOutputSurface(Graphics::Surface *surface) override;
 
 	bool containsPalette() const override { return _ditherPalette != 0; }
 	const byte *getPalette() override { _dirtyPalette = false; return _ditherPalette.data(); }
@@ -85,6 +86,8 @@ public:
 
 private:
 	CinepakFrame _curFrame;
+	Graphics::Surface *_ownSurface;
+	Graphics::Surface _outputSurface;  ///< The part of the caller's surface decoded into
 	int32 _y;
 	int _bitsPerPixel;
 	Graphics::PixelFormat _pixelFormat;
@@ -92,7 +95,7 @@ private:
 
 	Graphics::Palette _ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	const byte *_colorMap;
 	DitherType _ditherType;
 
 	void initializeCodebook(uint16 strip, byte codebookType);
@@ -104,6 +107,7 @@ private:
 	void ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex);
 	void ditherCodebookVFW(uint16 strip, byte codebookType, uint16 codebookIndex);
+	void freeColorMap();
 };
 
 } // End of namespace Image
@@ -60,6 +60,28 @@ Graphics::PixelFormat Codec::getDefaultYUVFormat() {
 		return format;
 }
 
+void switchOutputSurface(Graphics::Surface *&current, Graphics::Surface *own, Graphics::Surface &external, Graphics::Surface *surface) {
+	Graphics::Surface *target = own;
+	Graphics::Surface area;
+
+	if (surface) {
+		assert(surface->w >= own->w && surface->h >= own->h && surface->format == own->format);
+		area = surface->getSubArea(Common::Rect(own->w, own->h));
+		target = &area;
+	}
+
+	// The new surface only receives the parts which change from now on
+	if (target->getPixels() != current->getPixels() || target->pitch != current->pitch)
+		target->copyRectToSurface(*current, 0, 0, Common::Rect(own->w, own->h));
+
+	if (surface) {
+		external = area;
+		current = &external;
+	} else {
+		current = own;
+	}
+}
+
 Codec *createBitmapCodec(uint32 tag, uint32 streamTag, int width, int height, int bitsPerPixel) {
 #ifdef USE_JYV1
 	// Crusader videos are special cased here because the frame type is not in the "compression"
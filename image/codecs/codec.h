@@ -123,12 +123,41 @@ public:
 	 */
 	virtual void setCodecAccuracy(CodecAccuracy accuracy) {}
 
+	/**
+	 * Decode into a surface owned by the caller instead of the codec's own
+	 * surface.
+	 *
+	 * The surface must be in the format returned by getPixelFormat() and at
+	 * least as large as the frames. The frame decoded last is copied into
+	 * it, after which decodeFrame() only writes the parts of each frame
+	 * which changed, and returns the top left part of the surface. The
+	 * surface must therefore be used by this codec only, keep its contents,
+	 * and stay valid until the codec is switched to another surface, or
+	 * back to its own surface with nullptr. The screen locked with
+	 * OSystem::lockScreen() is not suitable.
+	 *
+	 * @return true if the codec decodes into @p surface from now on
+	 */
+	virtual bool setOutputSurface(Graphics::Surface *surface) { return !surface; }
+
 	/**
 	 * Get the preferred default pixel format for use with YUV codecs
 	 */
 	static Graphics::PixelFormat getDefaultYUVFormat();
 };
 
+/**
+ * Switch the surface a decoder draws each frame into over the previous one,
+ * for implementing Codec::setOutputSurface(). The frame decoded last is
+ * copied into the new surface, unless it is already there.
+ *
+ * @param current   the surface decoded into so far, set to the new one
+ * @param own       the decoder's own surface, which is used for nullptr
+ * @param external  storage for the part of the caller's surface decoded into
+ * @param surface   the caller's surface, or nullptr
+ */
+void switchOutputSurface(Graphics::Surface *&current, Graphics::Surface *own, Graphics::Surface &external, Graphics::Surface *surface);
+
 /**
  * Create a codec given a bitmap/AVI compression tag and stream handler tag (can be 0)
  */
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "image/codecs/dither_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Image {
+
+struct QuickTimeDitherShiftsNEON {
+	// Negative counts shift to the right
+	int rShift, gShift, bShift;
+	int rDrop, gDrop, bDrop;
+	uint32 rMask, gMask, bMask;
+
+	QuickTimeDitherShiftsNEON(const Graphics::PixelFormat &format) {
+		rShift = -format.rShift;
+		gShift = -format.gShift;
+		bShift = -format.bShift;
+		rDrop = 5 - format.rBits();
+		gDrop = 5 - format.gBits();
+		bDrop = 4 - format.bBits();
+		rMask = (1 << format.rBits()) - 1;
+		gMask = (1 << format.gBits()) - 1;
+		bMask = (1 << format.bBits()) - 1;
+	}
+};
+
+/** Compute the dither colors of eight 16 bit pixels. */
+static FORCEINLINE uint16x8_t computeIndices16(const QuickTimeDitherShiftsNEON &shifts, uint16x8_t c) {
+	const uint16x8_t r = vshlq_u16(vandq_u16(vshlq_u16(c, vdupq_n_s16(shifts.rShift)), vdupq_n_u16(shifts.rMask)), vdupq_n_s16(shifts.rDrop));
+	const uint16x8_t g = vshlq_u16(vandq_u16(vshlq_u16(c, vdupq_n_s16(shifts.gShift)), vdupq_n_u16(shifts.gMask)), vdupq_n_s16(shifts.gDrop));
+	const uint16x8_t b = vshlq_u16(vandq_u16(vshlq_u16(c, vdupq_n_s16(shifts.bShift)), vdupq_n_u16(shifts.bMask)), vdupq_n_s16(shifts.bDrop));
+	return vorrq_u16(vorrq_u16(vshlq_n_u16(r, 9), vshlq_n_u16(g, 4)), b);
+}
+
+/** Compute the dither colors of four 32 bit pixels. */
+static FORCEINLINE uint32x4_t computeIndices32(const QuickTimeDitherShiftsNEON &shifts, uint32x4_t c) {
+	const uint32x4_t r = vshlq_u32(vandq_u32(vshlq_u32(c, vdupq_n_s32(shifts.rShift)), vdupq_n_u32(shifts.rMask)), vdupq_n_s32(shifts.rDrop));
+	const uint32x4_t g = vshlq_u32(vandq_u32(vshlq_u32(c, vdupq_n_s32(shifts.gShift)), vdupq_n_u32(shifts.gMask)), vdupq_n_s32(shifts.gDrop));
+	const uint32x4_t b = vshlq_u32(vandq_u32(vshlq_u32(c, vdupq_n_s32(shifts.bShift)), vdupq_n_u32(shifts.bMask)), vdupq_n_s32(shifts.bDrop));
+	return vorrq_u32(vorrq_u32(vshlq_n_u32(r, 9), vshlq_n_u32(g, 4)), b);
+}
+
+/**
+ * Compute the dither colors of a row, 8 pixels per iteration. The remaining
+ * pixels are left for the C implementation.
+ */
+static void computeQuickTimeDitherIndices16NEON(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width) {
+	const QuickTimeDitherShiftsNEON shifts(format);
+	const uint16 *srcPtr = (const uint16 *)src;
+	int done = 0;
+
+	for (; done + 8 <= width; done += 8)
+		vst1q_u16(dst + done, computeIndices16(shifts, vld1q_u16(srcPtr + done)));
+
+	if (done < width)
+		quickTimeDitherFuncsGeneric.computeIndices16(dst + done, srcPtr + done, format, width - done);
+}
+
+static void computeQuickTimeDitherIndices32NEON(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width) {
+	const QuickTimeDitherShiftsNEON shifts(format);
+	const uint32 *srcPtr = (const uint32 *)src;
+	int done = 0;
+
+	for (; done + 8 <= width; done += 8) {
+		const uint32x4_t lo = computeIndices32(shifts, vld1q_u32(srcPtr + done));
+		const uint32x4_t hi = computeIndices32(shifts, vld1q_u32(srcPtr + done + 4));
+		vst1q_u16(dst + done, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+	}
+
+	if (done < width)
+		quickTimeDitherFuncsGeneric.computeIndices32(dst + done, srcPtr + done, format, width - done);
+}
+
+/** The functions of quickTimeDitherFuncsGeneric using NEON. */
+const QuickTimeDitherFuncs quickTimeDitherFuncsNEON = {
+	computeQuickTimeDitherIndices16NEON,
+	computeQuickTimeDitherIndices32NEON
+};
+
+} // End of namespace Image
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
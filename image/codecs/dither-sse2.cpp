@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "image/codecs/dither_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Image {
+
+struct QuickTimeDitherShiftsSSE2 {
+	__m128i rShift, gShift, bShift;
+	__m128i rDrop, gDrop, bDrop;
+	uint32 rMask, gMask, bMask;
+
+	QuickTimeDitherShiftsSSE2(const Graphics::PixelFormat &format) {
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		rDrop = _mm_cvtsi32_si128(format.rBits() - 5);
+		gDrop = _mm_cvtsi32_si128(format.gBits() - 5);
+		bDrop = _mm_cvtsi32_si128(format.bBits() - 4);
+		rMask = (1 << format.rBits()) - 1;
+		gMask = (1 << format.gBits()) - 1;
+		bMask = (1 << format.bBits()) - 1;
+	}
+};
+
+/** Compute the dither colors of eight 16 bit pixels. */
+static FORCEINLINE __m128i computeIndices16(const QuickTimeDitherShiftsSSE2 &shifts, __m128i c) {
+	const __m128i r = _mm_srl_epi16(_mm_and_si128(_mm_srl_epi16(c, shifts.rShift), _mm_set1_epi16(shifts.rMask)), shifts.rDrop);
+	const __m128i g = _mm_srl_epi16(_mm_and_si128(_mm_srl_epi16(c, shifts.gShift), _mm_set1_epi16(shifts.gMask)), shifts.gDrop);
+	const __m128i b = _mm_srl_epi16(_mm_and_si128(_mm_srl_epi16(c, shifts.bShift), _mm_set1_epi16(shifts.bMask)), shifts.bDrop);
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 9), _mm_slli_epi16(g, 4)), b);
+}
+
+/** Compute the dither colors of four 32 bit pixels. */
+static FORCEINLINE __m128i computeIndices32(const QuickTimeDitherShiftsSSE2 &shifts, __m128i c) {
+	const __m128i r = _mm_srl_epi32(_mm_and_si128(_mm_srl_epi32(c, shifts.rShift), _mm_set1_epi32(shifts.rMask)), shifts.rDrop);
+	const __m128i g = _mm_srl_epi32(_mm_and_si128(_mm_srl_epi32(c, shifts.gShift), _mm_set1_epi32(shifts.gMask)), shifts.gDrop);
+	const __m128i b = _mm_srl_epi32(_mm_and_si128(_mm_srl_epi32(c, shifts.bShift), _mm_set1_epi32(shifts.bMask)), shifts.bDrop);
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 9), _mm_slli_epi32(g, 4)), b);
+}
+
+/**
+ * Compute the dither colors of a row, 8 pixels per iteration. The remaining
+ * pixels are left for the C implementation.
+ */
+static void computeQuickTimeDitherIndices16SSE2(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width) {
+	const QuickTimeDitherShiftsSSE2 shifts(format);
+	const uint16 *srcPtr = (const uint16 *)src;
+	int done = 0;
+
+	for (; done + 8 <= width; done += 8)
+		_mm_storeu_si128((__m128i *)(dst + done), computeIndices16(shifts, _mm_loadu_si128((const __m128i *)(srcPtr + done))));
+
+	if (done < width)
+		quickTimeDitherFuncsGeneric.computeIndices16(dst + done, srcPtr + done, format, width - done);
+}
+
+static void computeQuickTimeDitherIndices32SSE2(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width) {
+	const QuickTimeDitherShiftsSSE2 shifts(format);
+	const uint32 *srcPtr = (const uint32 *)src;
+	int done = 0;
+
+	// The dither colors are 14 bits, so packing them cannot saturate
+	for (; done + 8 <= width; done += 8) {
+		const __m128i lo = computeIndices32(shifts, _mm_loadu_si128((const __m128i *)(srcPtr + done)));
+		const __m128i hi = computeIndices32(shifts, _mm_loadu_si128((const __m128i *)(srcPtr + done + 4)));
+		_mm_storeu_si128((__m128i *)(dst + done), _mm_packs_epi32(lo, hi));
+	}
+
+	if (done < width)
+		quickTimeDitherFuncsGeneric.computeIndices32(dst + done, srcPtr + done, format, width - done);
+}
+
+/** The functions of quickTimeDitherFuncsGeneric using SSE2. */
+const QuickTimeDitherFuncs quickTimeDitherFuncsSSE2 = {
+	computeQuickTimeDitherIndices16SSE2,
+	computeQuickTimeDitherIndices32SSE2
+};
+
+} // End of namespace Image
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
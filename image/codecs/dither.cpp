@@ -20,8 +20,12 @@
  */
 
 #include "image/codecs/dither.h"
+#include "image/codecs/dither_intern.h"
 
 #include "common/list.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/system.h"
 
 namespace Image {
 
@@ -58,7 +62,8 @@ DitherCodec::~DitherCodec() {
 	if (_disposeAfterUse == DisposeAfterUse::YES)
 		delete _codec;
 
-	delete[] _ditherTable;
+	if (_ditherTable)
+		releaseQuickTimeDitherTable(_ditherTable);
 
 	if (_ditherFrame) {
 		_ditherFrame->free();
@@ -75,23 +80,92 @@ inline uint16 readQT_RGB(uint32 srcColor, const Graphics::PixelFormat& format, c
 	return makeQuickTimeDitherColor(r, g, b);
 }
 
-// Specialized version for 8bpp
-inline uint16 readQT_Palette(uint8 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return makeQuickTimeDitherColor(palette[srcColor * 3], palette[srcColor * 3 + 1], palette[srcColor * 3 + 2]);
+/**
+ * Dither a row from its RGB554 colors, with the four dither tables the
+ * pixels cycle through.
+ */
+template<typename IndexInt>
+void ditherQuickTimeRow(byte *dst, const IndexInt *colors, const byte *const *tables, int width) {
+	const byte *table0 = tables[0], *table1 = tables[1], *table2 = tables[2], *table3 = tables[3];
+
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		dst[x] = table0[colors[x]];
+		dst[x + 1] = table1[colors[x + 1]];
+		dst[x + 2] = table2[colors[x + 2]];
+		dst[x + 3] = table3[colors[x + 3]];
+	}
+
+	for (; x < width; x++)
+		dst[x] = tables[x & 3][colors[x]];
 }
 
-// Specialized version for RGB554
-inline uint16 readQT_RGB554(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return srcColor;
+/**
+ * Return the dither tables the pixels of a row cycle through, starting
+ * from the one of the first pixel.
+ */
+void getQuickTimeRowTables(const byte **rowTables, const byte *const *tables, int y) {
+	static const int firstTables[] = { 0, 3, 1, 2 };
+
+	for (int i = 0; i < 4; i++)
+		rowTables[i] = tables[(firstTables[y & 3] + i) & 3];
+}
+
+// Paletted frames are dithered through a map from palette entries to dither
+// colors for each of the four tables, so the palette is only looked up once
+void ditherQuickTimeFrameCLUT8(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, const byte *palette) {
+	byte maps[4][256];
+	for (int i = 0; i < 256; i++) {
+		const uint16 color = makeQuickTimeDitherColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+		for (int t = 0; t < 4; t++)
+			maps[t][i] = ditherTable[t * 0x4000 + color];
+	}
+
+	const byte *const tables[] = { maps[0], maps[1], maps[2], maps[3] };
+	const byte *rowTables[4];
+
+	for (int y = 0; y < dst.h; y++) {
+		getQuickTimeRowTables(rowTables, tables, y);
+		ditherQuickTimeRow<byte>((byte *)dst.getBasePtr(0, y), (const byte *)src.getBasePtr(0, y), rowTables, dst.w);
+	}
 }
 
-// Specialized version for RGB555 and ARGB1555
-inline uint16 readQT_RGB555(uint16 srcColor, const Graphics::PixelFormat& format, const byte *palette) {
-	return (srcColor >> 1) & 0x3FFF;
+// RGB554 frames are the dither colors already
+void ditherQuickTimeFrameRGB554(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable) {
+	const byte *const tables[] = { ditherTable, ditherTable + 0x4000, ditherTable + 0x8000, ditherTable + 0xC000 };
+	const byte *rowTables[4];
+
+	for (int y = 0; y < dst.h; y++) {
+		getQuickTimeRowTables(rowTables, tables, y);
+		ditherQuickTimeRow<uint16>((byte *)dst.getBasePtr(0, y), (const uint16 *)src.getBasePtr(0, y), rowTables, dst.w);
+	}
 }
 
-template<typename PixelInt, class Fn>
-void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, Fn fn, const byte *palette = 0) {
+// Other RGB frames are converted to dither colors in chunks first
+void ditherQuickTimeFrameRGB(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable, const QuickTimeDitherFuncs &funcs) {
+	const QuickTimeDitherFuncs::IndexFunc computeIndices = (src.format.bytesPerPixel == 2) ? funcs.computeIndices16 : funcs.computeIndices32;
+	const byte *const tables[] = { ditherTable, ditherTable + 0x4000, ditherTable + 0x8000, ditherTable + 0xC000 };
+	const byte *rowTables[4];
+
+	const int kChunkWidth = 256;
+	uint16 colors[kChunkWidth];
+
+	for (int y = 0; y < dst.h; y++) {
+		getQuickTimeRowTables(rowTables, tables, y);
+
+		for (int chunk = 0; chunk < dst.w; chunk += kChunkWidth) {
+			const int chunkWidth = MIN(dst.w - chunk, kChunkWidth);
+			computeIndices(colors, src.getBasePtr(chunk, y), src.format, chunkWidth);
+
+			// Chunks are a multiple of four pixels wide, so the tables line up
+			ditherQuickTimeRow<uint16>((byte *)dst.getBasePtr(chunk, y), colors, rowTables, chunkWidth);
+		}
+	}
+}
+
+// Fallback for formats with fewer bits per component, which expand differently
+template<typename PixelInt>
+void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst, const byte *ditherTable) {
 	static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
 
 	for (int y = 0; y < dst.h; y++) {
@@ -100,15 +174,190 @@ void ditherQuickTimeFrame(const Graphics::Surface &src, Graphics::Surface &dst,
 		uint16 colorTableOffset = colorTableOffsets[y & 3];
 
 		for (int x = 0; x < dst.w; x++) {
-			uint16 color = fn(*srcPtr++, src.format, palette);
+			uint16 color = readQT_RGB(*srcPtr++, src.format, nullptr);
 			*dstPtr++ = ditherTable[colorTableOffset + color];
 			colorTableOffset += 0x4000;
 		}
 	}
 }
 
+template<typename PixelInt>
+void computeQuickTimeDitherIndices(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width) {
+	const PixelInt *srcPtr = (const PixelInt *)src;
+	const uint rMask = (1 << format.rBits()) - 1, gMask = (1 << format.gBits()) - 1, bMask = (1 << format.bBits()) - 1;
+	const uint rDrop = format.rBits() - 5, gDrop = format.gBits() - 5, bDrop = format.bBits() - 4;
+
+	for (int x = 0; x < width; x++) {
+		const uint32 color = srcPtr[x];
+		const uint r = ((color >> format.rShift) & rMask) >> rDrop;
+		const uint g = ((color >> format.gShift) & gMask) >> gDrop;
+		const uint b = ((color >> format.bShift) & bMask) >> bDrop;
+		dst[x] = (r << 9) | (g << 4) | b;
+	}
+}
+
 } // End of anonymous namespace
 
+const QuickTimeDitherFuncs quickTimeDitherFuncsGeneric = {
+	computeQuickTimeDitherIndices<uint16>,
+	computeQuickTimeDitherIndices<uint32>
+};
+
+/**
+ * Shares the QuickTime dither tables between codecs, and keeps the ones of
+ * the last few palettes around after they are released.
+ */
+class QuickTimeDitherTableCache : public Common::Singleton<QuickTimeDitherTableCache> {
+public:
+	const byte *getTable(const byte *palette, uint colorCount);
+	void releaseTable(const byte *table);
+
+	const QuickTimeDitherFuncs &getFuncs() const { return *_funcs; }
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	QuickTimeDitherTableCache();
+	~QuickTimeDitherTableCache();
+
+	struct Entry {
+		uint32 hash;
+		uint colorCount;
+		byte palette[256 * 3];
+		byte *table;
+		uint refCount;
+	};
+
+	static uint32 hashPalette(const byte *palette, uint colorCount);
+	void removeUnusedEntries();
+
+	/** The number of released tables kept, 64 KB each */
+	static const uint kMaxUnusedTables = 4;
+
+	/** The tables, the most recently used first */
+	Common::List<Entry *> _entries;
+
+	/**
+	 * Guards the cache, as videos may be decoded on other threads. nullptr
+	 * without an OSystem.
+	 */
+	Common::Mutex *_mutex;
+
+	/** The row functions for the running CPU */
+	const QuickTimeDitherFuncs *_funcs;
+};
+
+} // End of namespace Image
+
+namespace Common {
+DECLARE_SINGLETON(Image::QuickTimeDitherTableCache);
+}
+
+namespace Image {
+
+QuickTimeDitherTableCache::QuickTimeDitherTableCache() {
+	_funcs = &quickTimeDitherFuncsGeneric;
+	_mutex = nullptr;
+
+	// The test suites dither without an OSystem
+	if (!g_system)
+		return;
+
+	_mutex = new Common::Mutex();
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_funcs = &quickTimeDitherFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_funcs = &quickTimeDitherFuncsSSE2;
+#endif
+}
+
+QuickTimeDitherTableCache::~QuickTimeDitherTableCache() {
+	for (auto &entry : _entries) {
+		delete[] entry->table;
+		delete entry;
+	}
+
+	delete _mutex;
+}
+
+uint32 QuickTimeDitherTableCache::hashPalette(const byte *palette, uint colorCount) {
+	// FNV-1a
+	uint32 hash = 2166136261u;
+	for (uint i = 0; i < colorCount * 3; i++)
+		hash = (hash ^ palette[i]) * 16777619u;
+	return hash;
+}
+
+const byte *QuickTimeDitherTableCache::getTable(const byte *palette, uint colorCount) {
+	assert(colorCount <= 256);
+	const uint32 hash = hashPalette(palette, colorCount);
+
+	if (_mutex)
+		_mutex->lock();
+
+	Entry *found = nullptr;
+	for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+		Entry *entry = *it;
+		if (entry->hash == hash && entry->colorCount == colorCount && !memcmp(entry->palette, palette, colorCount * 3)) {
+			found = entry;
+			_entries.erase(it);
+			break;
+		}
+	}
+
+	if (!found) {
+		found = new Entry();
+		found->hash = hash;
+		found->colorCount = colorCount;
+		memcpy(found->palette, palette, colorCount * 3);
+		found->table = DitherCodec::createQuickTimeDitherTable(palette, colorCount);
+		found->refCount = 0;
+	}
+
+	found->refCount++;
+	_entries.push_front(found);
+
+	if (_mutex)
+		_mutex->unlock();
+
+	return found->table;
+}
+
+void QuickTimeDitherTableCache::releaseTable(const byte *table) {
+	if (_mutex)
+		_mutex->lock();
+
+	for (auto &entry : _entries) {
+		if (entry->table == table) {
+			assert(entry->refCount > 0);
+			entry->refCount--;
+			break;
+		}
+	}
+
+	removeUnusedEntries();
+
+	if (_mutex)
+		_mutex->unlock();
+}
+
+void QuickTimeDitherTableCache::removeUnusedEntries() {
+	uint unused = 0;
+	for (auto it = _entries.begin(); it != _entries.end();) {
+		Entry *entry = *it;
+		if (entry->refCount == 0 && ++unused > kMaxUnusedTables) {
+			delete[] entry->table;
+			delete entry;
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
 const Graphics::Surface *DitherCodec::decodeFrame(Common::SeekableReadStream &stream) {
 	const Graphics::Surface *frame = _codec->decodeFrame(stream);
 	if (!frame || _forcedDitherPalette.empty())
@@ -132,17 +381,18 @@ const Graphics::Surface *DitherCodec::decodeFrame(Common::SeekableReadStream &st
 		_ditherFrame->create(frame->w, frame->h, Graphics::PixelFormat::createFormatCLUT8());
 	}
 
+	const QuickTimeDitherFuncs &funcs = QuickTimeDitherTableCache::instance().getFuncs();
+
 	if (frame->format.isCLUT8() && curPalette)
-		ditherQuickTimeFrame<byte>(*frame, *_ditherFrame, _ditherTable, readQT_Palette, curPalette);
+		ditherQuickTimeFrameCLUT8(*frame, *_ditherFrame, _ditherTable, curPalette);
 	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB554);
-	else if (frame->format == Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) ||
-	         frame->format == Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15))
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB555);
+		ditherQuickTimeFrameRGB554(*frame, *_ditherFrame, _ditherTable);
+	else if (canComputeQuickTimeDitherIndices(frame->format))
+		ditherQuickTimeFrameRGB(*frame, *_ditherFrame, _ditherTable, funcs);
 	else if (frame->format.bytesPerPixel == 2)
-		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
+		ditherQuickTimeFrame<uint16>(*frame, *_ditherFrame, _ditherTable);
 	else if (frame->format.bytesPerPixel == 4)
-		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, _ditherTable, readQT_RGB);
+		ditherQuickTimeFrame<uint32>(*frame, *_ditherFrame, _ditherTable);
 
 	return _ditherFrame;
 }
@@ -194,7 +444,7 @@ void DitherCodec::setDither(DitherType type, const byte *palette) {
 		_forcedDitherPalette.set(palette, 0, 256);
 		_dirtyPalette = true;
 
-		_ditherTable = createQuickTimeDitherTable(_forcedDitherPalette.data(), 256);
+		_ditherTable = getQuickTimeDitherTable(_forcedDitherPalette.data(), 256);
 
 		// Prefer RGB554 or RGB555 to avoid extra conversion when dithering
 		if (!_codec->setOutputPixelFormat(Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0)))
@@ -206,6 +456,14 @@ void DitherCodec::setCodecAccuracy(CodecAccuracy accuracy) {
 	return _codec->setCodecAccuracy(accuracy);
 }
 
+const byte *DitherCodec::getQuickTimeDitherTable(const byte *palette, uint colorCount) {
+	return QuickTimeDitherTableCache::instance().getTable(palette, colorCount);
+}
+
+void DitherCodec::releaseQuickTimeDitherTable(const byte *table) {
+	QuickTimeDitherTableCache::instance().releaseTable(table);
+}
+
 byte *DitherCodec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000]();
 
@@ -55,6 +55,19 @@ public:
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
 
+	/**
+	 * Get a dither table, as used by QuickTime codecs. The tables are shared,
+	 * and the ones of the last few palettes are kept after being released,
+	 * so movies with the same palette do not create it again. Release the
+	 * table with releaseQuickTimeDitherTable().
+	 */
+	static const byte *getQuickTimeDitherTable(const byte *palette, uint colorCount);
+
+	/**
+	 * Release a dither table got from getQuickTimeDitherTable().
+	 */
+	static void releaseQuickTimeDitherTable(const byte *table);
+
 private:
 	DisposeAfterUse::Flag _disposeAfterUse;
 	Codec *_codec;
@@ -62,7 +75,7 @@ private:
 
 	Graphics::Surface *_ditherFrame;
 	Graphics::Palette _forcedDitherPalette;
-	byte *_ditherTable;
+	const byte *_ditherTable;
 	bool _dirtyPalette;
 };
 
@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef IMAGE_CODECS_DITHER_INTERN_H
+#define IMAGE_CODECS_DITHER_INTERN_H
+
+#include "common/scummsys.h"
+#include "graphics/pixelformat.h"
+
+namespace Image {
+
+/**
+ * Computing the RGB554 indices into a QuickTime dither table for a row of
+ * 16 or 32 bit pixels. They only take formats with at least 5 bits of red
+ * and green and 4 bits of blue, for which the indices only depend on the
+ * top bits of the components.
+ */
+struct QuickTimeDitherFuncs {
+	typedef void (*IndexFunc)(uint16 *dst, const void *src, const Graphics::PixelFormat &format, int width);
+
+	IndexFunc computeIndices16;
+	IndexFunc computeIndices32;
+};
+
+/** Return true if the QuickTimeDitherFuncs take pixels in this format. */
+inline bool canComputeQuickTimeDitherIndices(const Graphics::PixelFormat &format) {
+	return (format.bytesPerPixel == 2 || format.bytesPerPixel == 4) &&
+		format.rBits() >= 5 && format.gBits() >= 5 && format.bBits() >= 4;
+}
+
+extern const QuickTimeDitherFuncs quickTimeDitherFuncsGeneric;
+#ifdef SCUMMVM_NEON
+extern const QuickTimeDitherFuncs quickTimeDitherFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const QuickTimeDitherFuncs quickTimeDitherFuncsSSE2;
+#endif
+
+} // End of namespace Image
+
+#endif
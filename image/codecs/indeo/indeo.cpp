@@ -28,6 +28,7 @@
 #include "image/codecs/indeo/mem.h"
 #include "graphics/yuv_to_rgb.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "common/algorithm.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -470,9 +471,25 @@ IndeoDecoderBase::IndeoDecoderBase(uint16 width, uint16 height, uint bitsPerPixe
 	_pixelFormat = getDefaultYUVFormat();
 
 	_ctx._bRefBuf = 3; // buffer 2 is used for scalability mode
+
+	_dsp = getIndeoDSPFuncs();
+
+	// The bands have to be decoded one after the other, but outputting
+	// and converting the planes can be spread over several threads, which
+	// pays off for large frames
+	_threadPool = nullptr;
+	if (width * height >= 640 * 480) {
+		_threadPool = new Common::ThreadPool(0, "ScummVM Indeo");
+		if (!_threadPool->isAsync()) {
+			delete _threadPool;
+			_threadPool = nullptr;
+		}
+	}
 }
 
 IndeoDecoderBase::~IndeoDecoderBase() {
+	delete _threadPool;
+
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -576,7 +593,7 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	// Merge the planes into the final surface
 	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU,
 		frame->_data[0], frame->_data[1], frame->_data[2], frame->_width, frame->_height,
-		frame->_width, frame->_width);
+		frame->_width, frame->_width, _threadPool);
 
 	if (_ctx._hasTransp)
 		decodeTransparency();
@@ -637,6 +654,9 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 		return -1;
 	}
 
+	// use the SIMD version of the inverse transform, if there is one
+	band->_invTransform = selectInvTransform(_dsp, band->_invTransform);
+
 	band->_rvMap = &_ctx._rvmapTabs[band->_rvmapSel];
 
 	// apply corrections to the selected rvmap table if present
@@ -916,11 +936,17 @@ void IndeoDecoderBase::outputPlane(IVIPlaneDesc *_plane, uint8 *dst, int dstPitc
 	if (!src)
 		return;
 
-	for (int y = 0; y < _plane->_height; y++) {
-		for (int x = 0; x < _plane->_width; x++)
-			dst[x] = avClipUint8(src[x] + 128);
-		src += pitch;
-		dst += dstPitch;
+	const IndeoDSPFuncs *dsp = _dsp;
+	const int width = _plane->_width;
+	const auto outputRow = [=](int y) {
+		dsp->outputRow(dst + y * dstPitch, src + y * pitch, width);
+	};
+
+	if (_threadPool) {
+		_threadPool->parallelFor(0, _plane->_height, outputRow);
+	} else {
+		for (int y = 0; y < _plane->_height; y++)
+			outputRow(y);
 	}
 }
 
@@ -996,8 +1022,8 @@ int IndeoDecoderBase::processEmptyTile(IVIBandDesc *band,
 
 	if (band->_inheritMv && needMc) { // apply motion compensation if there is at least one non-zero motion vector
 		int numBlocks = (band->_mbSize != band->_blkSize) ? 4 : 1; // number of blocks per mb
-		IviMCFunc mcNoDeltaFunc = (band->_blkSize == 8) ? IndeoDSP::ffIviMc8x8NoDelta
-			: IndeoDSP::ffIviMc4x4NoDelta;
+		IviMCFunc mcNoDeltaFunc = (band->_blkSize == 8) ? _dsp->mc8x8NoDelta
+			: _dsp->mc4x4NoDelta;
 
 		int mbn;
 		for (mbn = 0, mb = tile->_mbs; mbn < tile->_numMBs; mb++, mbn++) {
@@ -1064,13 +1090,13 @@ int IndeoDecoderBase::decodeBlocks(GetBits *_gb, IVIBandDesc *band, IVITile *til
 	IviMCAvgFunc mcAvgWithDeltaFunc, mcAvgNoDeltaFunc;
 
 	if (blkSize == 8) {
-		mcWithDeltaFunc     = IndeoDSP::ffIviMc8x8Delta;
-		mcNoDeltaFunc       = IndeoDSP::ffIviMc8x8NoDelta;
+		mcWithDeltaFunc     = _dsp->mc8x8Delta;
+		mcNoDeltaFunc       = _dsp->mc8x8NoDelta;
 		mcAvgWithDeltaFunc = IndeoDSP::ffIviMcAvg8x8Delta;
 		mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg8x8NoDelta;
 	} else {
-		mcWithDeltaFunc     = IndeoDSP::ffIviMc4x4Delta;
-		mcNoDeltaFunc       = IndeoDSP::ffIviMc4x4NoDelta;
+		mcWithDeltaFunc     = _dsp->mc4x4Delta;
+		mcNoDeltaFunc       = _dsp->mc4x4NoDelta;
 		mcAvgWithDeltaFunc = IndeoDSP::ffIviMcAvg4x4Delta;
 		mcAvgNoDeltaFunc   = IndeoDSP::ffIviMcAvg4x4NoDelta;
 	}
@@ -38,9 +38,15 @@
 #include "image/codecs/indeo/get_bits.h"
 #include "image/codecs/indeo/vlc.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Image {
 namespace Indeo {
 
+struct IndeoDSPFuncs;
+
 /**
  *  Indeo 4 frame types.
  */
@@ -524,6 +530,11 @@ protected:
 	Graphics::PixelFormat _pixelFormat;
 	Graphics::Surface *_surface;
 
+	const IndeoDSPFuncs *_dsp; ///< The kernels for the running CPU.
+
+	/** Outputs and converts large frames in slices, nullptr for small frames. */
+	Common::ThreadPool *_threadPool;
+
 	/**
 	 *  Scan patterns shared between indeo4 and indeo5
 	 */
@@ -0,0 +1,350 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Image {
+namespace Indeo {
+
+/** Load a row of a block of four or eight pixels. */
+template<int size>
+static FORCEINLINE int16x8_t loadRow(const int16 *src) {
+	if (size == 8)
+		return vld1q_s16(src);
+	else
+		return vcombine_s16(vld1_s16(src), vdup_n_s16(0));
+}
+
+template<int size>
+static FORCEINLINE void storeRow(int16 *dst, int16x8_t row) {
+	if (size == 8)
+		vst1q_s16(dst, row);
+	else
+		vst1_s16(dst, vget_low_s16(row));
+}
+
+/** (a + b + c + d) >> 2, summed in 32 bits. */
+static FORCEINLINE int16x8_t average4(int16x8_t a, int16x8_t b, int16x8_t c, int16x8_t d) {
+	int32x4_t lo = vaddl_s16(vget_low_s16(a), vget_low_s16(b));
+	int32x4_t hi = vaddl_s16(vget_high_s16(a), vget_high_s16(b));
+	lo = vaddq_s32(lo, vaddl_s16(vget_low_s16(c), vget_low_s16(d)));
+	hi = vaddq_s32(hi, vaddl_s16(vget_high_s16(c), vget_high_s16(d)));
+	return vcombine_s16(vshrn_n_s32(lo, 2), vshrn_n_s32(hi, 2));
+}
+
+template<int size, bool delta>
+static FORCEINLINE void putRow(int16 *buf, int16x8_t row) {
+	if (delta)
+		row = vaddq_s16(loadRow<size>(buf), row);
+	storeRow<size>(buf, row);
+}
+
+/**
+ * Motion compensation of a block, one row per iteration. Like the C
+ * version, the deltas wrap around.
+ */
+template<int size, bool delta>
+static void iviMcNEON(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	const int16 *wptr = refBuf + pitch;
+
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch)
+			putRow<size, delta>(buf, loadRow<size>(refBuf));
+		break;
+	case 1: // horizontal halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch)
+			putRow<size, delta>(buf, vhaddq_s16(loadRow<size>(refBuf), loadRow<size>(refBuf + 1)));
+		break;
+	case 2: // vertical halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch, wptr += pitch)
+			putRow<size, delta>(buf, vhaddq_s16(loadRow<size>(refBuf), loadRow<size>(wptr)));
+		break;
+	case 3: // vertical and horizontal halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch, wptr += pitch)
+			putRow<size, delta>(buf, average4(loadRow<size>(refBuf), loadRow<size>(refBuf + 1),
+				loadRow<size>(wptr), loadRow<size>(wptr + 1)));
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Convert a row of a plane to pixels, 16 pixels per iteration. The
+ * remaining pixels are left for the C implementation.
+ */
+static void outputRowNEON(uint8 *dst, const int16 *src, int width) {
+	const int16x8_t bias = vdupq_n_s16(128);
+	int done = 0;
+
+	for (; done + 16 <= width; done += 16) {
+		const int16x8_t lo = vqaddq_s16(vld1q_s16(src + done), bias);
+		const int16x8_t hi = vqaddq_s16(vld1q_s16(src + done + 8), bias);
+		vst1q_u8(dst + done, vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi)));
+	}
+
+	if (done < width)
+		indeoDSPFuncsGeneric.outputRow(dst + done, src + done, width - done);
+}
+
+/** Butterflies of the inverse transforms, see the macros of the C version. */
+static FORCEINLINE void haarBfly(int32x4_t s1, int32x4_t s2, int32x4_t &o1, int32x4_t &o2) {
+	o2 = vshrq_n_s32(vsubq_s32(s1, s2), 1);
+	o1 = vshrq_n_s32(vaddq_s32(s1, s2), 1);
+}
+
+static FORCEINLINE void slantBfly(int32x4_t s1, int32x4_t s2, int32x4_t &o1, int32x4_t &o2) {
+	o2 = vsubq_s32(s1, s2);
+	o1 = vaddq_s32(s1, s2);
+}
+
+static FORCEINLINE void slantReflect(int32x4_t s1, int32x4_t s2, int32x4_t &o1, int32x4_t &o2) {
+	const int32x4_t two = vdupq_n_s32(2);
+	o1 = vaddq_s32(vshrq_n_s32(vaddq_s32(vaddq_s32(s1, vshlq_n_s32(s2, 1)), two), 2), s1);
+	o2 = vsubq_s32(vshrq_n_s32(vaddq_s32(vsubq_s32(vshlq_n_s32(s1, 1), s2), two), 2), s2);
+}
+
+static FORCEINLINE void slantPart4(int32x4_t s1, int32x4_t s2, int32x4_t &o1, int32x4_t &o2) {
+	const int32x4_t four = vdupq_n_s32(4);
+	o1 = vaddq_s32(s2, vshrq_n_s32(vaddq_s32(vsubq_s32(vshlq_n_s32(s1, 2), s2), four), 3));
+	o2 = vaddq_s32(s1, vshrq_n_s32(vsubq_s32(vsubq_s32(four, s1), vshlq_n_s32(s2, 2)), 3));
+}
+
+enum {
+	kTransformHaar,
+	kTransformSlant
+};
+
+/** A one-dimensional inverse transform of eight points, in place, on each lane. */
+template<int type>
+static FORCEINLINE void inverse8(int32x4_t *v) {
+	int32x4_t t1, t2, t3, t4, t5, t6, t7, t8;
+
+	if (type == kTransformHaar) {
+		t1 = vshlq_n_s32(v[0], 1);
+		t5 = vshlq_n_s32(v[1], 1);
+		haarBfly(t1, t5, t1, t5);
+		haarBfly(t1, v[2], t1, t3);
+		haarBfly(t5, v[3], t5, t7);
+		haarBfly(t1, v[4], t1, t2);
+		haarBfly(t3, v[5], t3, t4);
+		haarBfly(t5, v[6], t5, t6);
+		haarBfly(t7, v[7], t7, t8);
+	} else {
+		slantPart4(v[1], v[3], t4, t5);
+		slantBfly(v[0], t5, t1, t5);
+		slantBfly(v[4], v[5], t2, t6);
+		slantBfly(v[7], v[6], t7, t3);
+		slantBfly(t4, v[2], t4, t8);
+		slantBfly(t1, t2, t1, t2);
+		slantReflect(t4, t3, t4, t3);
+		slantBfly(t5, t6, t5, t6);
+		slantReflect(t8, t7, t8, t7);
+		slantBfly(t1, t4, t1, t4);
+		slantBfly(t2, t3, t2, t3);
+		slantBfly(t5, t8, t5, t8);
+		slantBfly(t6, t7, t6, t7);
+	}
+
+	v[0] = t1; v[1] = t2; v[2] = t3; v[3] = t4;
+	v[4] = t5; v[5] = t6; v[6] = t7; v[7] = t8;
+}
+
+/** A one-dimensional inverse transform of four points, in place, on each lane. */
+template<int type>
+static FORCEINLINE void inverse4(int32x4_t *v) {
+	int32x4_t t0, t1, t2, t3, t4;
+
+	if (type == kTransformHaar) {
+		haarBfly(v[0], v[1], t0, t1);
+		haarBfly(t0, v[2], v[0], v[1]);
+		haarBfly(t1, v[3], v[2], v[3]);
+	} else {
+		slantBfly(v[0], v[2], t1, t2);
+		slantReflect(v[1], v[3], t4, t3);
+		slantBfly(t1, t4, v[0], v[3]);
+		slantBfly(t2, t3, v[1], v[2]);
+	}
+}
+
+/** The rounding of the second pass of the slant transforms. */
+template<int type>
+static FORCEINLINE int32x4_t compensate(int32x4_t x) {
+	if (type == kTransformHaar)
+		return x;
+	else
+		return vshrq_n_s32(vaddq_s32(x, vdupq_n_s32(1)), 1);
+}
+
+/** All lanes set for the columns without coefficients. */
+static FORCEINLINE int32x4_t emptyColumns(const uint8 *flags) {
+	const int32 set[4] = { flags[0], flags[1], flags[2], flags[3] };
+	return vreinterpretq_s32_u32(vceqq_s32(vld1q_s32(set), vdupq_n_s32(0)));
+}
+
+static FORCEINLINE void transpose4(int32x4_t &r0, int32x4_t &r1, int32x4_t &r2, int32x4_t &r3) {
+	const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+	const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+/**
+ * Transpose an 8x8 block, held as the left and right four columns of
+ * each row.
+ */
+static FORCEINLINE void transpose8(int32x4_t (&v)[2][8]) {
+	int32x4_t t[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int hb = 0; hb < 2; hb++) {
+			int32x4_t r0 = v[h][4 * hb], r1 = v[h][4 * hb + 1], r2 = v[h][4 * hb + 2], r3 = v[h][4 * hb + 3];
+			transpose4(r0, r1, r2, r3);
+			t[hb][4 * h] = r0;
+			t[hb][4 * h + 1] = r1;
+			t[hb][4 * h + 2] = r2;
+			t[hb][4 * h + 3] = r3;
+		}
+	}
+
+	memcpy(v, t, sizeof(t));
+}
+
+/**
+ * Two-dimensional inverse 8x8 transform, like IndeoDSP::ffIviInverseHaar8x8
+ * and ffIviInverseSlant8x8: the columns are transformed four at a time,
+ * then the block is transposed so the rows are as well.
+ */
+template<int type>
+static void inverse8x8NEON(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	int32x4_t v[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int r = 0; r < 8; r++)
+			v[h][r] = vld1q_s32(in + r * 8 + h * 4);
+	}
+
+	// The Haar transform scales the first four rows of the left columns
+	if (type == kTransformHaar) {
+		for (int r = 0; r < 4; r++)
+			v[0][r] = vshlq_n_s32(v[0][r], 1);
+	}
+
+	for (int h = 0; h < 2; h++) {
+		inverse8<type>(v[h]);
+
+		const int32x4_t empty = emptyColumns(flags + h * 4);
+		for (int r = 0; r < 8; r++)
+			v[h][r] = vbicq_s32(v[h][r], empty);
+	}
+
+	transpose8(v);
+	for (int h = 0; h < 2; h++) {
+		inverse8<type>(v[h]);
+		for (int c = 0; c < 8; c++)
+			v[h][c] = compensate<type>(v[h][c]);
+	}
+	transpose8(v);
+
+	// Narrow to 16 bits, wrapping around like the C version
+	for (int r = 0; r < 8; r++, out += pitch)
+		vst1q_s16(out, vcombine_s16(vmovn_s32(v[0][r]), vmovn_s32(v[1][r])));
+}
+
+/** Two-dimensional inverse 4x4 transform, see inverse8x8NEON(). */
+template<int type>
+static void inverse4x4NEON(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	int32x4_t v[4];
+
+	for (int r = 0; r < 4; r++)
+		v[r] = vld1q_s32(in + r * 4);
+
+	// The Haar transform scales the first two rows of the left columns
+	if (type == kTransformHaar) {
+		const int32x4_t left = vcombine_s32(vdup_n_s32(-1), vdup_n_s32(0));
+		for (int r = 0; r < 2; r++)
+			v[r] = vaddq_s32(v[r], vandq_s32(v[r], left));
+	}
+
+	inverse4<type>(v);
+
+	const int32x4_t empty = emptyColumns(flags);
+	for (int r = 0; r < 4; r++)
+		v[r] = vbicq_s32(v[r], empty);
+
+	transpose4(v[0], v[1], v[2], v[3]);
+	inverse4<type>(v);
+	for (int c = 0; c < 4; c++)
+		v[c] = compensate<type>(v[c]);
+	transpose4(v[0], v[1], v[2], v[3]);
+
+	for (int r = 0; r < 4; r++, out += pitch)
+		vst1_s16(out, vmovn_s32(v[r]));
+}
+
+/** The kernels of indeoDSPFuncsGeneric using NEON. */
+const IndeoDSPFuncs indeoDSPFuncsNEON = {
+	iviMcNEON<8, false>,
+	iviMcNEON<8, true>,
+	iviMcNEON<4, false>,
+	iviMcNEON<4, true>,
+	outputRowNEON,
+	inverse8x8NEON<kTransformHaar>,
+	inverse4x4NEON<kTransformHaar>,
+	inverse8x8NEON<kTransformSlant>,
+	inverse4x4NEON<kTransformSlant>
+};
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,367 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Image {
+namespace Indeo {
+
+/** Load a row of a block of four or eight pixels. */
+template<int size>
+static FORCEINLINE __m128i loadRow(const int16 *src) {
+	if (size == 8)
+		return _mm_loadu_si128((const __m128i *)src);
+	else
+		return _mm_loadl_epi64((const __m128i *)src);
+}
+
+template<int size>
+static FORCEINLINE void storeRow(int16 *dst, __m128i row) {
+	if (size == 8)
+		_mm_storeu_si128((__m128i *)dst, row);
+	else
+		_mm_storel_epi64((__m128i *)dst, row);
+}
+
+/** (a + b) >> 1 without overflowing 16 bits. */
+static FORCEINLINE __m128i average2(__m128i a, __m128i b) {
+	const __m128i odd = _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+	return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)), odd);
+}
+
+/** Sign extend the low or high four values to 32 bits. */
+static FORCEINLINE __m128i widenLo(__m128i a) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+
+static FORCEINLINE __m128i widenHi(__m128i a) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+}
+
+/** (a + b + c + d) >> 2, summed in 32 bits. */
+static FORCEINLINE __m128i average4(__m128i a, __m128i b, __m128i c, __m128i d) {
+	const __m128i lo = _mm_add_epi32(_mm_add_epi32(widenLo(a), widenLo(b)), _mm_add_epi32(widenLo(c), widenLo(d)));
+	const __m128i hi = _mm_add_epi32(_mm_add_epi32(widenHi(a), widenHi(b)), _mm_add_epi32(widenHi(c), widenHi(d)));
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+
+template<int size, bool delta>
+static FORCEINLINE void putRow(int16 *buf, __m128i row) {
+	if (delta)
+		row = _mm_add_epi16(loadRow<size>(buf), row);
+	storeRow<size>(buf, row);
+}
+
+/**
+ * Motion compensation of a block, one row per iteration. Like the C
+ * version, the deltas wrap around.
+ */
+template<int size, bool delta>
+static void iviMcSSE2(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType) {
+	const int16 *wptr = refBuf + pitch;
+
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch)
+			putRow<size, delta>(buf, loadRow<size>(refBuf));
+		break;
+	case 1: // horizontal halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch)
+			putRow<size, delta>(buf, average2(loadRow<size>(refBuf), loadRow<size>(refBuf + 1)));
+		break;
+	case 2: // vertical halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch, wptr += pitch)
+			putRow<size, delta>(buf, average2(loadRow<size>(refBuf), loadRow<size>(wptr)));
+		break;
+	case 3: // vertical and horizontal halfpel interpolation
+		for (int i = 0; i < size; i++, buf += pitch, refBuf += pitch, wptr += pitch)
+			putRow<size, delta>(buf, average4(loadRow<size>(refBuf), loadRow<size>(refBuf + 1),
+				loadRow<size>(wptr), loadRow<size>(wptr + 1)));
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Convert a row of a plane to pixels, 16 pixels per iteration. The
+ * remaining pixels are left for the C implementation.
+ */
+static void outputRowSSE2(uint8 *dst, const int16 *src, int width) {
+	const __m128i bias = _mm_set1_epi16(128);
+	int done = 0;
+
+	for (; done + 16 <= width; done += 16) {
+		const __m128i lo = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(src + done)), bias);
+		const __m128i hi = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(src + done + 8)), bias);
+		_mm_storeu_si128((__m128i *)(dst + done), _mm_packus_epi16(lo, hi));
+	}
+
+	if (done < width)
+		indeoDSPFuncsGeneric.outputRow(dst + done, src + done, width - done);
+}
+
+/** Butterflies of the inverse transforms, see the macros of the C version. */
+static FORCEINLINE void haarBfly(__m128i s1, __m128i s2, __m128i &o1, __m128i &o2) {
+	o2 = _mm_srai_epi32(_mm_sub_epi32(s1, s2), 1);
+	o1 = _mm_srai_epi32(_mm_add_epi32(s1, s2), 1);
+}
+
+static FORCEINLINE void slantBfly(__m128i s1, __m128i s2, __m128i &o1, __m128i &o2) {
+	o2 = _mm_sub_epi32(s1, s2);
+	o1 = _mm_add_epi32(s1, s2);
+}
+
+static FORCEINLINE void slantReflect(__m128i s1, __m128i s2, __m128i &o1, __m128i &o2) {
+	const __m128i two = _mm_set1_epi32(2);
+	o1 = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(s1, _mm_slli_epi32(s2, 1)), two), 2), s1);
+	o2 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s1, 1), s2), two), 2), s2);
+}
+
+static FORCEINLINE void slantPart4(__m128i s1, __m128i s2, __m128i &o1, __m128i &o2) {
+	const __m128i four = _mm_set1_epi32(4);
+	o1 = _mm_add_epi32(s2, _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s1, 2), s2), four), 3));
+	o2 = _mm_add_epi32(s1, _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(four, s1), _mm_slli_epi32(s2, 2)), 3));
+}
+
+enum {
+	kTransformHaar,
+	kTransformSlant
+};
+
+/** A one-dimensional inverse transform of eight points, in place, on each lane. */
+template<int type>
+static FORCEINLINE void inverse8(__m128i *v) {
+	__m128i t1, t2, t3, t4, t5, t6, t7, t8;
+
+	if (type == kTransformHaar) {
+		t1 = _mm_slli_epi32(v[0], 1);
+		t5 = _mm_slli_epi32(v[1], 1);
+		haarBfly(t1, t5, t1, t5);
+		haarBfly(t1, v[2], t1, t3);
+		haarBfly(t5, v[3], t5, t7);
+		haarBfly(t1, v[4], t1, t2);
+		haarBfly(t3, v[5], t3, t4);
+		haarBfly(t5, v[6], t5, t6);
+		haarBfly(t7, v[7], t7, t8);
+	} else {
+		slantPart4(v[1], v[3], t4, t5);
+		slantBfly(v[0], t5, t1, t5);
+		slantBfly(v[4], v[5], t2, t6);
+		slantBfly(v[7], v[6], t7, t3);
+		slantBfly(t4, v[2], t4, t8);
+		slantBfly(t1, t2, t1, t2);
+		slantReflect(t4, t3, t4, t3);
+		slantBfly(t5, t6, t5, t6);
+		slantReflect(t8, t7, t8, t7);
+		slantBfly(t1, t4, t1, t4);
+		slantBfly(t2, t3, t2, t3);
+		slantBfly(t5, t8, t5, t8);
+		slantBfly(t6, t7, t6, t7);
+	}
+
+	v[0] = t1; v[1] = t2; v[2] = t3; v[3] = t4;
+	v[4] = t5; v[5] = t6; v[6] = t7; v[7] = t8;
+}
+
+/** A one-dimensional inverse transform of four points, in place, on each lane. */
+template<int type>
+static FORCEINLINE void inverse4(__m128i *v) {
+	__m128i t0, t1, t2, t3, t4;
+
+	if (type == kTransformHaar) {
+		haarBfly(v[0], v[1], t0, t1);
+		haarBfly(t0, v[2], v[0], v[1]);
+		haarBfly(t1, v[3], v[2], v[3]);
+	} else {
+		slantBfly(v[0], v[2], t1, t2);
+		slantReflect(v[1], v[3], t4, t3);
+		slantBfly(t1, t4, v[0], v[3]);
+		slantBfly(t2, t3, v[1], v[2]);
+	}
+}
+
+/** The rounding of the second pass of the slant transforms. */
+template<int type>
+static FORCEINLINE __m128i compensate(__m128i x) {
+	if (type == kTransformHaar)
+		return x;
+	else
+		return _mm_srai_epi32(_mm_add_epi32(x, _mm_set1_epi32(1)), 1);
+}
+
+/** All lanes set for the columns without coefficients. */
+static FORCEINLINE __m128i emptyColumns(const uint8 *flags) {
+	const __m128i set = _mm_setr_epi32(flags[0], flags[1], flags[2], flags[3]);
+	return _mm_cmpeq_epi32(set, _mm_setzero_si128());
+}
+
+static FORCEINLINE void transpose4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Transpose an 8x8 block, held as the left and right four columns of
+ * each row.
+ */
+static FORCEINLINE void transpose8(__m128i (&v)[2][8]) {
+	__m128i t[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int hb = 0; hb < 2; hb++) {
+			__m128i r0 = v[h][4 * hb], r1 = v[h][4 * hb + 1], r2 = v[h][4 * hb + 2], r3 = v[h][4 * hb + 3];
+			transpose4(r0, r1, r2, r3);
+			t[hb][4 * h] = r0;
+			t[hb][4 * h + 1] = r1;
+			t[hb][4 * h + 2] = r2;
+			t[hb][4 * h + 3] = r3;
+		}
+	}
+
+	memcpy(v, t, sizeof(t));
+}
+
+/** Narrow to 16 bits, wrapping around like the C version. */
+static FORCEINLINE __m128i narrow(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/**
+ * Two-dimensional inverse 8x8 transform, like IndeoDSP::ffIviInverseHaar8x8
+ * and ffIviInverseSlant8x8: the columns are transformed four at a time,
+ * then the block is transposed so the rows are as well.
+ */
+template<int type>
+static void inverse8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[2][8];
+
+	for (int h = 0; h < 2; h++) {
+		for (int r = 0; r < 8; r++)
+			v[h][r] = _mm_loadu_si128((const __m128i *)(in + r * 8 + h * 4));
+	}
+
+	// The Haar transform scales the first four rows of the left columns
+	if (type == kTransformHaar) {
+		for (int r = 0; r < 4; r++)
+			v[0][r] = _mm_slli_epi32(v[0][r], 1);
+	}
+
+	for (int h = 0; h < 2; h++) {
+		inverse8<type>(v[h]);
+
+		const __m128i empty = emptyColumns(flags + h * 4);
+		for (int r = 0; r < 8; r++)
+			v[h][r] = _mm_andnot_si128(empty, v[h][r]);
+	}
+
+	transpose8(v);
+	for (int h = 0; h < 2; h++) {
+		inverse8<type>(v[h]);
+		for (int c = 0; c < 8; c++)
+			v[h][c] = compensate<type>(v[h][c]);
+	}
+	transpose8(v);
+
+	for (int r = 0; r < 8; r++, out += pitch)
+		_mm_storeu_si128((__m128i *)out, narrow(v[0][r], v[1][r]));
+}
+
+/** Two-dimensional inverse 4x4 transform, see inverse8x8SSE2(). */
+template<int type>
+static void inverse4x4SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i v[4];
+
+	for (int r = 0; r < 4; r++)
+		v[r] = _mm_loadu_si128((const __m128i *)(in + r * 4));
+
+	// The Haar transform scales the first two rows of the left columns
+	if (type == kTransformHaar) {
+		const __m128i left = _mm_setr_epi32(-1, -1, 0, 0);
+		for (int r = 0; r < 2; r++)
+			v[r] = _mm_add_epi32(v[r], _mm_and_si128(v[r], left));
+	}
+
+	inverse4<type>(v);
+
+	const __m128i empty = emptyColumns(flags);
+	for (int r = 0; r < 4; r++)
+		v[r] = _mm_andnot_si128(empty, v[r]);
+
+	transpose4(v[0], v[1], v[2], v[3]);
+	inverse4<type>(v);
+	for (int c = 0; c < 4; c++)
+		v[c] = compensate<type>(v[c]);
+	transpose4(v[0], v[1], v[2], v[3]);
+
+	for (int r = 0; r < 4; r++, out += pitch)
+		_mm_storel_epi64((__m128i *)out, narrow(v[r], v[r]));
+}
+
+/** The kernels of indeoDSPFuncsGeneric using SSE2. */
+const IndeoDSPFuncs indeoDSPFuncsSSE2 = {
+	iviMcSSE2<8, false>,
+	iviMcSSE2<8, true>,
+	iviMcSSE2<4, false>,
+	iviMcSSE2<4, true>,
+	outputRowSSE2,
+	inverse8x8SSE2<kTransformHaar>,
+	inverse4x4SSE2<kTransformHaar>,
+	inverse8x8SSE2<kTransformSlant>,
+	inverse4x4SSE2<kTransformSlant>
+};
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
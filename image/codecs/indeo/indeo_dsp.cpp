@@ -25,6 +25,7 @@
  * written, produced, and directed by Alan Smithee
  */
 
+#include "common/system.h"
 #include "image/codecs/indeo/indeo_dsp.h"
 
 namespace Image {
@@ -603,5 +604,52 @@ IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+static void outputRowGeneric(uint8 *dst, const int16 *src, int width) {
+	for (int x = 0; x < width; x++)
+		dst[x] = avClipUint8(src[x] + 128);
+}
+
+const IndeoDSPFuncs indeoDSPFuncsGeneric = {
+	IndeoDSP::ffIviMc8x8NoDelta,
+	IndeoDSP::ffIviMc8x8Delta,
+	IndeoDSP::ffIviMc4x4NoDelta,
+	IndeoDSP::ffIviMc4x4Delta,
+	outputRowGeneric,
+	IndeoDSP::ffIviInverseHaar8x8,
+	IndeoDSP::ffIviInverseHaar4x4,
+	IndeoDSP::ffIviInverseSlant8x8,
+	IndeoDSP::ffIviInverseSlant4x4
+};
+
+const IndeoDSPFuncs *getIndeoDSPFuncs() {
+	const IndeoDSPFuncs *funcs = &indeoDSPFuncsGeneric;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		funcs = &indeoDSPFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		funcs = &indeoDSPFuncsSSE2;
+#endif
+
+	return funcs;
+}
+
+InvTransformPtr *selectInvTransform(const IndeoDSPFuncs *funcs, InvTransformPtr *transform) {
+	const IndeoDSPFuncs &generic = indeoDSPFuncsGeneric;
+
+	if (transform == generic.inverseHaar8x8)
+		return funcs->inverseHaar8x8;
+	if (transform == generic.inverseHaar4x4)
+		return funcs->inverseHaar4x4;
+	if (transform == generic.inverseSlant8x8)
+		return funcs->inverseSlant8x8;
+	if (transform == generic.inverseSlant4x4)
+		return funcs->inverseSlant4x4;
+
+	return transform;
+}
+
 } // End of namespace Indeo
 } // End of namespace Image
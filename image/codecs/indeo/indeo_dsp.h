@@ -329,6 +329,45 @@ public:
 	static void ffIviMcAvg4x4NoDelta(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
 };
 
+/**
+ * The kernels of IndeoDSP the decoders spend most of their time in, for
+ * which there are SIMD versions. All versions produce exactly the same
+ * pixels.
+ */
+struct IndeoDSPFuncs {
+	/** Motion compensation of a block, see IndeoDSP::ffIviMc8x8NoDelta and friends. */
+	IviMCFunc mc8x8NoDelta;
+	IviMCFunc mc8x8Delta;
+	IviMCFunc mc4x4NoDelta;
+	IviMCFunc mc4x4Delta;
+
+	/** Convert a row of a reconstructed plane to pixels, adding 128 and clipping. */
+	void (*outputRow)(uint8 *dst, const int16 *src, int width);
+
+	/** Two-dimensional inverse transforms, see IndeoDSP::ffIviInverseHaar8x8 and friends. */
+	InvTransformPtr *inverseHaar8x8;
+	InvTransformPtr *inverseHaar4x4;
+	InvTransformPtr *inverseSlant8x8;
+	InvTransformPtr *inverseSlant4x4;
+};
+
+extern const IndeoDSPFuncs indeoDSPFuncsGeneric;
+#ifdef SCUMMVM_NEON
+extern const IndeoDSPFuncs indeoDSPFuncsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const IndeoDSPFuncs indeoDSPFuncsSSE2;
+#endif
+
+/** Return the fastest kernels the CPU supports. */
+const IndeoDSPFuncs *getIndeoDSPFuncs();
+
+/**
+ * Return the version of an inverse transform of IndeoDSP in funcs, or the
+ * transform itself if there is none.
+ */
+InvTransformPtr *selectInvTransform(const IndeoDSPFuncs *funcs, InvTransformPtr *transform);
+
 } // End of namespace Indeo
 } // End of namespace Image
 
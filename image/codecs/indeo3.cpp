@@ -31,6 +31,7 @@
 #include "common/endian.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 
 #include "graphics/yuv_to_rgb.h"
@@ -49,9 +50,22 @@ Indeo3Decoder::Indeo3Decoder(uint16 width, uint16 height, uint bitsPerPixel) : _
 
 	buildModPred();
 	allocFrames();
+
+	// The three planes can be decoded and the frame converted on separate
+	// threads, which pays off for large frames
+	_threadPool = nullptr;
+	if (width * height >= 640 * 480) {
+		_threadPool = new Common::ThreadPool(0, "ScummVM Indeo 3");
+		if (!_threadPool->isAsync()) {
+			delete _threadPool;
+			_threadPool = nullptr;
+		}
+	}
 }
 
 Indeo3Decoder::~Indeo3Decoder() {
+	delete _threadPool;
+
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -240,29 +254,42 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 		return 0;
 	}
 
-	byte *hdr_pos = inData;
-	byte *buf_pos;
-
-	// Luminance Y
-	stream.seek(offsY);
-	buf_pos = inData + offsY + 4 - hPos;
-	offs = stream.readUint32LE();
-	decodeChunk(_cur_frame->Ybuf, _ref_frame->Ybuf, fWidth, fHeight,
-			buf_pos + offs * 2, flags2, hdr_pos, buf_pos, MIN<int>(fWidth, 160));
-
-	// Chrominance U
-	stream.seek(offsU);
-	buf_pos = inData + offsU + 4 - hPos;
-	offs = stream.readUint32LE();
-	decodeChunk(_cur_frame->Vbuf, _ref_frame->Vbuf, chromaWidth, chromaHeight,
-			buf_pos + offs * 2, flags2, hdr_pos, buf_pos, MIN<int>(chromaWidth, 40));
-
-	// Chrominance V
-	stream.seek(offsV);
-	buf_pos = inData + offsV + 4 - hPos;
-	offs = stream.readUint32LE();
-	decodeChunk(_cur_frame->Ubuf, _ref_frame->Ubuf, chromaWidth, chromaHeight,
-			buf_pos + offs * 2, flags2, hdr_pos, buf_pos, MIN<int>(chromaWidth, 40));
+	const byte *hdr_pos = inData;
+
+	// The offsets of the planes' data are all read first, so that the planes
+	// can be decoded independently of each other
+	struct PlaneChunk {
+		byte *cur, *ref;
+		int width, height;
+		const byte *buf1, *buf2;
+		int minWidth160;
+	} chunks[3] = {
+		// Luminance Y
+		{ _cur_frame->Ybuf, _ref_frame->Ybuf, fWidth, (int)fHeight, nullptr, inData + offsY + 4 - hPos, MIN<int>(fWidth, 160) },
+		// Chrominance U
+		{ _cur_frame->Vbuf, _ref_frame->Vbuf, (int)chromaWidth, (int)chromaHeight, nullptr, inData + offsU + 4 - hPos, MIN<int>(chromaWidth, 40) },
+		// Chrominance V
+		{ _cur_frame->Ubuf, _ref_frame->Ubuf, (int)chromaWidth, (int)chromaHeight, nullptr, inData + offsV + 4 - hPos, MIN<int>(chromaWidth, 40) }
+	};
+	const uint32 chunkOffsets[3] = { offsY, offsU, offsV };
+
+	for (int i = 0; i < 3; i++) {
+		stream.seek(chunkOffsets[i]);
+		offs = stream.readUint32LE();
+		chunks[i].buf1 = chunks[i].buf2 + offs * 2;
+	}
+
+	const auto decodePlane = [&](int i) {
+		decodeChunk(chunks[i].cur, chunks[i].ref, chunks[i].width, chunks[i].height,
+				chunks[i].buf1, flags2, hdr_pos, chunks[i].buf2, chunks[i].minWidth160);
+	};
+
+	if (_threadPool) {
+		_threadPool->parallelFor(0, 3, decodePlane);
+	} else {
+		for (int i = 0; i < 3; i++)
+			decodePlane(i);
+	}
 
 	delete[] inData;
 
@@ -294,14 +321,14 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 	if (scaleWidth == 1 && scaleHeight == 1) {
 		// Shortcut: Don't need to scale so we can decode straight to the surface
 		YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU, srcY, tempU, tempV,
-				fWidth, fHeight, fWidth, chromaWidth + 1);
+				fWidth, fHeight, fWidth, chromaWidth + 1, _threadPool);
 	} else {
 		// Need to upscale, so decode to a temp surface first
 		Graphics::Surface tempSurface;
 		tempSurface.create(fWidth, fHeight, _surface->format);
 
 		YUVToRGBMan.convert410(&tempSurface, Graphics::YUVToRGBManager::kScaleITU, srcY, tempU, tempV,
-				fWidth, fHeight, fWidth, chromaWidth + 1);
+				fWidth, fHeight, fWidth, chromaWidth + 1, _threadPool);
 
 		// Upscale
 		for (int y = 0; y < _surface->h; y++) {
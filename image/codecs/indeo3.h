@@ -33,6 +33,10 @@
 
 #include "image/codecs/codec.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Image {
 
 /**
@@ -89,6 +93,9 @@ private:
 	byte *_ModPred;
 	byte *_corrector_type;
 
+	/** Decodes and converts large frames on several threads, nullptr for small frames. */
+	Common::ThreadPool *_threadPool;
+
 	void buildModPred();
 	void allocFrames();
 
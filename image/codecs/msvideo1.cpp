@@ -34,22 +34,23 @@ namespace Image {
   }
 
 MSVideo1Decoder::MSVideo1Decoder(uint16 width, uint16 height, byte bitsPerPixel) : Codec() {
-	_surface = new Graphics::Surface();
-	_surface->create(width, height, (bitsPerPixel == 8) ? Graphics::PixelFormat::createFormatCLUT8() :
+	_ownSurface = new Graphics::Surface();
+	_ownSurface->create(width, height, (bitsPerPixel == 8) ? Graphics::PixelFormat::createFormatCLUT8() :
 														  Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+	_surface = _ownSurface;
 
 	_bitsPerPixel = bitsPerPixel;
 }
 
 MSVideo1Decoder::~MSVideo1Decoder() {
-	_surface->free();
-	delete _surface;
+	_ownSurface->free();
+	delete _ownSurface;
 }
 
 void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
 	byte colors[8];
 	byte *pixels = (byte *)_surface->getPixels();
-	uint16 stride = _surface->w;
+	uint16 stride = _surface->pitch;
 
 	int skipBlocks = 0;
 	uint16 blocks_wide = _surface->w / 4;
@@ -129,7 +130,7 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 	/* decoding parameters */
 	uint16 colors[8];
 	uint16 *pixels = (uint16 *)_surface->getPixels();
-	int32 stride = _surface->w;
+	int32 stride = _surface->pitch / 2;
 
 	int32 skip_blocks = 0;
 	int32 blocks_wide = _surface->w / 4;
@@ -212,6 +213,15 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 	}
 }
 
+bool MSVideo1Decoder::setOutputSurface(Graphics::Surface *surface) {
+	// The pixels are addressed in units of the pixel size
+	if (surface && surface->pitch % _surface->format.bytesPerPixel != 0)
+		return false;
+
+	switchOutputSurface(_surface, _ownSurface, _outputSurface, surface);
+	return true;
+}
+
 const Graphics::Surface *MSVideo1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
 	if (_bitsPerPixel == 8)
 		decode8(stream);
@@ -38,11 +38,14 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
 	Graphics::PixelFormat getPixelFormat() const override { return _surface->format; }
+	bool setOutputSurface(Graphics::Surface *surface) override;
 
 private:
 	byte _bitsPerPixel;
 
-	Graphics::Surface *_surface;
+	Graphics::Surface *_surface;       ///< The surface decoded into
+	Graphics::Surface *_ownSurface;
+	Graphics::Surface _outputSurface;  ///< The part of the caller's surface decoded into
 
 	void decode8(Common::SeekableReadStream &stream);
 	void decode16(Common::SeekableReadStream &stream);
@@ -39,6 +39,8 @@ QTRLEDecoder::QTRLEDecoder(uint16 width, uint16 height, byte bitsPerPixel) : Cod
 	_width = width;
 	_height = height;
 	_surface = 0;
+	_ownSurface = 0;
+	_stride = 0;
 	_dirtyPalette = false;
 	_colorMap = 0;
 
@@ -50,12 +52,13 @@ QTRLEDecoder::QTRLEDecoder(uint16 width, uint16 height, byte bitsPerPixel) : Cod
 }
 
 QTRLEDecoder::~QTRLEDecoder() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
+	if (_ownSurface) {
+		_ownSurface->free();
+		delete _ownSurface;
 	}
 
-	delete[] _colorMap;
+	if (_colorMap)
+		DitherCodec::releaseQuickTimeDitherTable(_colorMap);
 }
 
 #define CHECK_STREAM_PTR(n) \
@@ -68,8 +71,8 @@ QTRLEDecoder::~QTRLEDecoder() {
 
 #define CHECK_PIXEL_PTR(n) \
 	do { \
-		if ((int32)pixelPtr + n > (int)_paddedWidth * _surface->h) { \
-			warning("QTRLE Problem: pixel ptr = %d, pixel limit = %d", pixelPtr + n, _paddedWidth * _surface->h); \
+		if ((int32)pixelPtr + n > (int)(_stride * (_surface->h - 1) + _paddedWidth)) { \
+			warning("QTRLE Problem: pixel ptr = %d, pixel limit = %d", pixelPtr + n, _stride * (_surface->h - 1) + _paddedWidth); \
 			return; \
 		} \
 	} while (0)
@@ -88,7 +91,7 @@ void QTRLEDecoder::decode1(Common::SeekableReadStream &stream, uint32 rowPtr, ui
 
 		if (skip & 0x80) {
 			linesToChange--;
-			rowPtr += _paddedWidth;
+			rowPtr += _stride;
 			pixelPtr = rowPtr + 2 * (skip & 0x7f);
 		} else
 			pixelPtr += 2 * skip;
@@ -174,7 +177,7 @@ void QTRLEDecoder::decode2_4(Common::SeekableReadStream &stream, uint32 rowPtr,
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -219,7 +222,7 @@ void QTRLEDecoder::decode8(Common::SeekableReadStream &stream, uint32 rowPtr, ui
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -257,7 +260,7 @@ void QTRLEDecoder::decode16(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -318,7 +321,7 @@ void QTRLEDecoder::dither16(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 		curColorTableOffset = (curColorTableOffset + 1) & 3;
 	}
 }
@@ -364,7 +367,7 @@ void QTRLEDecoder::decode24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -431,7 +434,7 @@ void QTRLEDecoder::dither24(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 		curColorTableOffset = (curColorTableOffset + 1) & 3;
 	}
 }
@@ -479,7 +482,7 @@ void QTRLEDecoder::decode32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 	}
 }
 
@@ -546,7 +549,7 @@ void QTRLEDecoder::dither32(Common::SeekableReadStream &stream, uint32 rowPtr, u
 			}
 		}
 
-		rowPtr += _paddedWidth;
+		rowPtr += _stride;
 		curColorTableOffset = (curColorTableOffset + 1) & 3;
 	}
 }
@@ -579,7 +582,7 @@ const Graphics::Surface *QTRLEDecoder::decodeFrame(Common::SeekableReadStream &s
 		stream.readUint16BE(); // Unknown
 	}
 
-	uint32 rowPtr = _paddedWidth * startLine;
+	uint32 rowPtr = _stride * startLine;
 
 	switch (_bitsPerPixel) {
 	case 1:
@@ -661,19 +664,41 @@ void QTRLEDecoder::setDither(DitherType type, const byte *palette) {
 	_ditherPalette.set(palette, 0, 256);
 	_dirtyPalette = true;
 
-	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	if (_colorMap)
+		DitherCodec::releaseQuickTimeDitherTable(_colorMap);
+	_colorMap = DitherCodec::getQuickTimeDitherTable(palette, 256);
 }
 
 void QTRLEDecoder::createSurface() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
+	if (_ownSurface) {
+		_ownSurface->free();
+		delete _ownSurface;
 	}
 
-	_surface = new Graphics::Surface();
-	_surface->create(_paddedWidth, _height, getPixelFormat());
-	_surface->w = _width;
+	_ownSurface = new Graphics::Surface();
+	_ownSurface->create(_paddedWidth, _height, getPixelFormat());
+	_ownSurface->w = _width;
+	_surface = _ownSurface;
+	_stride = _paddedWidth;
+}
+
+bool QTRLEDecoder::setOutputSurface(Graphics::Surface *surface) {
+	if (!surface) {
+		if (_surface)
+			switchOutputSurface(_surface, _ownSurface, _outputSurface, nullptr);
+		_stride = _paddedWidth;
+		return true;
+	}
+
+	// The surface is only created with the first frame. The rows are
+	// decoded up to the padded width, and addressed in units of the pixel
+	// size.
+	if (!_surface || surface->w < (int)_paddedWidth || surface->pitch % _surface->format.bytesPerPixel != 0)
+		return false;
+
+	switchOutputSurface(_surface, _ownSurface, _outputSurface, surface);
+	_stride = _surface->pitch / _surface->format.bytesPerPixel;
+	return true;
 }
 
 } // End of namespace Image
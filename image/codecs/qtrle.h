@@ -40,6 +40,7 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
 	Graphics::PixelFormat getPixelFormat() const override;
+	bool setOutputSurface(Graphics::Surface *surface) override;
 
 	bool containsPalette() const override { return _ditherPalette != 0; }
 	const byte *getPalette() override { _dirtyPalette = false; return _ditherPalette.data(); }
@@ -49,12 +50,15 @@ public:
 
 private:
 	byte _bitsPerPixel;
-	Graphics::Surface *_surface;
+	Graphics::Surface *_surface;       ///< The surface decoded into
+	Graphics::Surface *_ownSurface;
+	Graphics::Surface _outputSurface;  ///< The part of the caller's surface decoded into
 	uint16 _width, _height;
 	uint32 _paddedWidth;
+	uint32 _stride;                    ///< The distance between two rows of _surface in pixels
 	Graphics::Palette _ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	const byte *_colorMap;
 
 	void createSurface();
 
@@ -48,7 +48,8 @@ RPZADecoder::~RPZADecoder() {
 		delete _surface;
 	}
 
-	delete[] _colorMap;
+	if (_colorMap)
+		DitherCodec::releaseQuickTimeDitherTable(_colorMap);
 }
 
 #define ADVANCE_BLOCK() \
@@ -358,8 +359,9 @@ void RPZADecoder::setDither(DitherType type, const byte *palette) {
 	_dirtyPalette = true;
 	_format = Graphics::PixelFormat::createFormatCLUT8();
 
-	delete[] _colorMap;
-	_colorMap = DitherCodec::createQuickTimeDitherTable(palette, 256);
+	if (_colorMap)
+		DitherCodec::releaseQuickTimeDitherTable(_colorMap);
+	_colorMap = DitherCodec::getQuickTimeDitherTable(palette, 256);
 }
 
 } // End of namespace Image
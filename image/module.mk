@@ -27,6 +27,15 @@ MODULE_OBJS := \
 	codecs/rpza.o \
 	codecs/smc.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	codecs/dither-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/dither-sse2.o
+endif
+
 ifdef USE_GIF
 MODULE_OBJS += \
 	gif.o
@@ -65,6 +74,15 @@ MODULE_OBJS += \
 	codecs/indeo/indeo_dsp.o \
 	codecs/indeo/mem.o \
 	codecs/indeo/vlc.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-sse2.o
+endif
 endif
 
 ifdef USE_HNM
@@ -3,6 +3,7 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 #include "audio/rate.h"
+#include "audio/decoders/raw.h"
 
 /**
  * A stream of consecutive integers, so that every sample in the output can be
@@ -29,6 +30,29 @@ private:
 	int _pos;
 };
 
+/**
+ * A stream holding the same sample forever.
+ */
+class ConstantAudioStream : public Audio::AudioStream {
+public:
+	ConstantAudioStream(int rate, bool stereo, int16 value) : _rate(rate), _stereo(stereo), _value(value) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		for (int i = 0; i < numSamples; ++i)
+			buffer[i] = _value;
+		return numSamples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return false; }
+
+private:
+	int _rate;
+	bool _stereo;
+	int16 _value;
+};
+
 class RateTestSuite : public CxxTest::TestSuite {
 public:
 	/**
@@ -150,4 +174,72 @@ public:
 
 		delete converter;
 	}
+
+	/**
+	 * The sinc filters are normalized per phase, so once the filter window is
+	 * filled a constant input must come out unchanged, whatever the ratio.
+	 */
+	void test_sinc_unity_gain() {
+		const Audio::RateConverterQuality qualities[] = { Audio::kRateQualityBalanced, Audio::kRateQualityBest };
+		const int rates[][2] = { { 11025, 44100 }, { 22050, 48000 }, { 48000, 44100 }, { 44100, 8000 } };
+		const int frames = 700;
+
+		for (int q = 0; q < ARRAYSIZE(qualities); ++q) {
+			for (int r = 0; r < ARRAYSIZE(rates); ++r) {
+				for (int stereo = 0; stereo < 2; ++stereo) {
+					Audio::RateConverter *converter = Audio::makeRateConverter(rates[r][0], rates[r][1], stereo, true, false, qualities[q]);
+					ConstantAudioStream input(rates[r][0], stereo, 12345);
+
+					int16 out[frames * 2] = {};
+					const int written = converter->convert(input, (byte *)out, sizeof(int16), frames,
+						Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, Audio::MIX_ADD);
+					TS_ASSERT_EQUALS(written, frames);
+
+					// Skip the frames which still see the silent initial history
+					const int skip = 32 * rates[r][1] / rates[r][0] + 1;
+					for (int k = skip * 2; k < frames * 2; ++k)
+						TS_ASSERT_EQUALS(out[k], 12345);
+
+					delete converter;
+				}
+			}
+		}
+	}
+
+	/**
+	 * At the end of a finite stream, a sinc converter has to push the last
+	 * input frames through the filter delay, then stop and report how many
+	 * frames it actually wrote.
+	 */
+	void test_sinc_end_of_stream() {
+		const int inFrames = 300;
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 44100, false, true, false, Audio::kRateQualityBest);
+		byte *samples = (byte *)malloc(inFrames * 2);
+		for (int i = 0; i < inFrames; ++i)
+			WRITE_BE_INT16(samples + i * 2, 12345);
+		Audio::AudioStream *input = Audio::makeRawStream(samples, inFrames * 2, 22050, Audio::FLAG_16BITS);
+
+		int16 out[1000 * 2] = {};
+		const int written = converter->convert(*input, (byte *)out, sizeof(int16), 1000,
+			Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, Audio::MIX_ADD);
+
+		// Every input frame and each of the 32 silent frames flushing the
+		// 32 tap filter produce two output frames, minus the first one
+		TS_ASSERT_LESS_THAN_EQUALS(2 * (inFrames + 32) - 1, written);
+		TS_ASSERT_LESS_THAN_EQUALS(written, 2 * (inFrames + 32));
+		TS_ASSERT(!converter->needsDraining());
+
+		// The output is delayed by half the filter, so all of the input
+		// comes out at full level, then fades out to silence
+		for (int k = 2 * 33; k < 2 * (inFrames - 16); ++k)
+			TS_ASSERT_EQUALS(out[k * 2], 12345);
+		TS_ASSERT_LESS_THAN(ABS(out[(written - 1) * 2]), 12345 / 4);
+
+		// Nothing more comes out once the tail is flushed
+		TS_ASSERT_EQUALS(converter->convert(*input, (byte *)out, sizeof(int16), 1000,
+			Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume, Audio::MIX_ADD), 0);
+
+		delete input;
+		delete converter;
+	}
 };
@@ -0,0 +1,197 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/rate.h"
+#include "common/config-manager.h"
+#include "common/textconsole.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * An endless stream of pseudo random samples, cheap enough not to show up
+ * in the mixer benchmark.
+ */
+class NoiseAudioStream : public Audio::AudioStream {
+public:
+	NoiseAudioStream(int rate, bool stereo, uint32 seed) : _rate(rate), _stereo(stereo), _state(seed) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		for (int i = 0; i < numSamples; ++i) {
+			_state = _state * 1103515245 + 12345;
+			buffer[i] = (int16)(_state >> 16);
+		}
+		return numSamples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return false; }
+
+private:
+	int _rate;
+	bool _stereo;
+	uint32 _state;
+};
+
+class SampleMixTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if BENCHMARK_TIME
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/**
+	 * Every SIMD version must produce exactly the same output as the generic
+	 * one, including the wrapping/saturating behaviour and the rounding of
+	 * negative samples.
+	 */
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			checkFuncs(Audio::SampleMix::mixStereoSSE2, Audio::SampleMix::mixMonoSSE2);
+			checkConvolve(Audio::SampleMix::convolveSSE2);
+		}
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs(Audio::SampleMix::mixStereoNEON, Audio::SampleMix::mixMonoNEON);
+		checkConvolve(Audio::SampleMix::convolveNEON);
+#endif
+	}
+
+	/**
+	 * Measure how many output frames per second the mixer produces with a
+	 * growing number of channels, using a typical mix of stream formats, for
+	 * every resampler quality.
+	 */
+	void test_mixer_speed() {
+#if BENCHMARK_TIME
+		// The test OSystem reports the CPU features, so this picks the same
+		// functions as a real backend would
+		Audio::SampleMix::selectFuncs();
+
+#ifdef SLOW_TESTS
+		const int seconds = 60;
+#else
+		const int seconds = 1;
+#endif
+		const uint frames = 1024;
+		const int channelCounts[] = { 1, 4, 8, 16, 32 };
+		const char *const qualities[] = { "fast", "balanced", "best" };
+		int16 *buffer = new int16[frames * 2];
+
+		for (int q = 0; q < ARRAYSIZE(qualities); q++) {
+			ConfMan.set("resampler_quality", qualities[q]);
+
+			for (int c = 0; c < ARRAYSIZE(channelCounts); c++) {
+				Audio::MixerImpl mixer(44100, true, frames);
+				mixer.setReady(true);
+
+				for (int i = 0; i < channelCounts[c]; i++) {
+					// Alternate native rate stereo music, and upsampled mono effects
+					const bool stereo = (i % 2) == 0;
+					const int rate = stereo ? 44100 : 22050 + i * 100;
+					mixer.playStream(Audio::Mixer::kPlainSoundType, nullptr, new NoiseAudioStream(rate, stereo, i),
+						-1, Audio::Mixer::kMaxChannelVolume - i, 0, DisposeAfterUse::YES, false, false);
+				}
+
+				const uint32 start = g_system->getMillis();
+				const int iterations = seconds * 44100 / frames;
+				for (int i = 0; i < iterations; i++)
+					mixer.mixCallback((byte *)buffer, frames * 2 * sizeof(int16));
+				const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+				debug("Mixer with %d channels, %s resampler: %f frames per second, %d ms for %d seconds of audio (%.2f%% CPU)\n",
+					channelCounts[c], qualities[q], (double)iterations * frames * 1000 / time, time, seconds,
+					time / (seconds * 10.0));
+			}
+		}
+
+		ConfMan.removeKey("resampler_quality", Common::ConfigManager::kApplicationDomain);
+		delete[] buffer;
+#endif
+	}
+
+private:
+	void checkConvolve(Audio::SampleMix::ConvolveFunc func) {
+		const uint taps[] = { 8, 16, 24, 32 };
+		NoiseAudioStream noise(44100, false, 2);
+
+		int16 left[32], right[32], coefs[32];
+		noise.readBuffer(left, 32);
+		noise.readBuffer(right, 32);
+		noise.readBuffer(coefs, 32);
+		// Make sure the clipping is covered, too
+		left[0] = right[0] = -32768;
+		coefs[0] = 16384;
+
+		for (int t = 0; t < ARRAYSIZE(taps); t++) {
+			int16 expected[2], actual[2];
+
+			Audio::SampleMix::convolveGeneric(expected, left, right, coefs, taps[t]);
+			func(actual, left, right, coefs, taps[t]);
+			TS_ASSERT_EQUALS(actual[0], expected[0]);
+			TS_ASSERT_EQUALS(actual[1], expected[1]);
+
+			Audio::SampleMix::convolveGeneric(expected, left, nullptr, coefs, taps[t]);
+			func(actual, left, nullptr, coefs, taps[t]);
+			TS_ASSERT_EQUALS(actual[0], expected[0]);
+			TS_ASSERT_EQUALS(actual[1], expected[1]);
+		}
+	}
+
+	void checkFuncs(Audio::SampleMix::MixFunc stereoFunc, Audio::SampleMix::MixFunc monoFunc) {
+		const uint frames = 37;
+		const Audio::st_volume_t volumes[] = { 0, 1, 100, 255, 256 };
+		NoiseAudioStream noise(44100, true, 1);
+
+		int16 in[frames * 2], base[frames * 2], expected[frames * 2], actual[frames * 2];
+		noise.readBuffer(in, frames * 2);
+		noise.readBuffer(base, frames * 2);
+		// Make sure the extremes are covered
+		in[0] = -32768;
+		in[1] = 32767;
+		in[2] = -1;
+
+		for (int v = 0; v < ARRAYSIZE(volumes) * ARRAYSIZE(volumes); v++) {
+			const Audio::st_volume_t volL = volumes[v % ARRAYSIZE(volumes)];
+			const Audio::st_volume_t volR = volumes[v / ARRAYSIZE(volumes)];
+
+			for (int mode = 0; mode < 2; mode++) {
+				const Audio::MixMode mixMode = mode ? Audio::MIX_CLAMPED_ADD : Audio::MIX_ADD;
+
+				for (int reverse = 0; reverse < 2; reverse++) {
+					memcpy(expected, base, sizeof(base));
+					memcpy(actual, base, sizeof(base));
+					Audio::SampleMix::mixStereoGeneric(expected, in, frames, volL, volR, reverse, mixMode);
+					stereoFunc(actual, in, frames, volL, volR, reverse, mixMode);
+					TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+				}
+
+				memcpy(expected, base, sizeof(base));
+				memcpy(actual, base, sizeof(base));
+				Audio::SampleMix::mixMonoGeneric(expected, in, frames, volL, volR, false, mixMode);
+				monoFunc(actual, in, frames, volL, volR, false, mixMode);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+			}
+		}
+	}
+};
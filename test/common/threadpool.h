@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+#include "../system/null_osystem.h"
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_submit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool;
+		int values[11] = {};
+		for (int i = 1; i <= 10; i++)
+			pool.submit([&values, i]() { values[i] = i; });
+		pool.wait();
+
+		int sum = 0;
+		for (int i = 0; i <= 10; i++)
+			sum += values[i];
+		TS_ASSERT_EQUALS(sum, 55);
+#endif
+	}
+
+	void test_async() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool;
+		Common::Future<int> answer = pool.async([]() { return 6 * 7; });
+		TS_ASSERT(answer.isValid());
+		TS_ASSERT_EQUALS(answer.get(), 42);
+
+		int calls = 0;
+		Common::Future<void> done = pool.async([&calls]() { calls++; });
+		done.get();
+		TS_ASSERT_EQUALS(calls, 1);
+
+		Common::Future<int> empty;
+		TS_ASSERT(!empty.isValid());
+#endif
+	}
+
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool;
+		int values[100];
+		for (int i = 0; i < 100; i++)
+			values[i] = 0;
+
+		pool.parallelFor(3, 97, [&values](int i) { values[i] += i; });
+
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(values[i], (i >= 3 && i < 97) ? i : 0);
+
+		// Empty ranges must not call the function
+		pool.parallelFor(5, 5, [&values](int i) { values[i] = -1; });
+		TS_ASSERT_EQUALS(values[5], 5);
+#endif
+	}
+
+	/**
+	 * The test OSystem provides real threads where it can, so check that
+	 * the pool does not fall back to running tasks synchronously there.
+	 */
+	void test_worker_threads() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Common::ThreadPool pool(3);
+		TS_ASSERT(pool.isAsync());
+		TS_ASSERT_EQUALS(pool.getThreadCount(), 3u);
+		if (!pool.isAsync())
+			return;
+
+		// Every task waits until all of them have started, which only
+		// happens when they really run at the same time
+		Common::ConditionVariable cond;
+		int started = 0;
+		for (int i = 0; i < 3; i++) {
+			pool.submit([&cond, &started]() {
+				Common::StackLock lock(cond);
+				started++;
+				cond.notifyAll();
+				while (started < 3)
+					cond.wait();
+			});
+		}
+		pool.wait();
+		TS_ASSERT_EQUALS(started, 3);
+#endif
+	}
+
+	void test_worker_futures() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Common::ThreadPool pool(4);
+		TS_ASSERT(pool.isAsync());
+
+		// Tasks waiting for other tasks must not deadlock the pool
+		Common::Array<Common::Future<int> > futures;
+		for (int i = 0; i < 32; i++) {
+			futures.push_back(pool.async([&pool, i]() {
+				Common::Future<int> inner = pool.async([i]() { return i * i; });
+				return inner.get() + 1;
+			}));
+		}
+		for (int i = 0; i < 32; i++)
+			TS_ASSERT_EQUALS(futures[i].get(), i * i + 1);
+#endif
+	}
+
+	void test_worker_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Common::ThreadPool pool(4);
+		TS_ASSERT(pool.isAsync());
+
+		Common::Mutex mutex;
+		const int count = 10000;
+		int64 sum = 0;
+		Common::Array<int> calls(count, 0);
+		pool.parallelFor(0, count, [&](int i) {
+			calls[i]++;
+			Common::StackLock lock(mutex);
+			sum += i;
+		});
+
+		TS_ASSERT_EQUALS(sum, (int64)count * (count - 1) / 2);
+		for (int i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(calls[i], 1);
+#endif
+	}
+};
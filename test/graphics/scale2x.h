@@ -0,0 +1,69 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/scummsys.h"
+#include "graphics/scaler/scale2x.h"
+
+class Scale2xTestSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Every SIMD version must produce exactly the same rows as the C
+	 * version, for all three pixel sizes and for widths which leave a tail
+	 * of pixels after the last full vector.
+	 */
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			checkFuncs<scale2x_uint8>(scale2x_8_sse2, scale2x_8_def);
+			checkFuncs<scale2x_uint16>(scale2x_16_sse2, scale2x_16_def);
+			checkFuncs<scale2x_uint32>(scale2x_32_sse2, scale2x_32_def);
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			checkFuncs<scale2x_uint8>(scale2x_8_avx2, scale2x_8_def);
+			checkFuncs<scale2x_uint16>(scale2x_16_avx2, scale2x_16_def);
+			checkFuncs<scale2x_uint32>(scale2x_32_avx2, scale2x_32_def);
+		}
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs<scale2x_uint8>(scale2x_8_neon, scale2x_8_def);
+		checkFuncs<scale2x_uint16>(scale2x_16_neon, scale2x_16_def);
+		checkFuncs<scale2x_uint32>(scale2x_32_neon, scale2x_32_def);
+#endif
+	}
+
+private:
+	template<typename Pixel>
+	void checkFuncs(void (*func)(Pixel *, Pixel *, const Pixel *, const Pixel *, const Pixel *, unsigned),
+	                void (*reference)(Pixel *, Pixel *, const Pixel *, const Pixel *, const Pixel *, unsigned)) {
+		// The row functions read one pixel either side of the middle row
+		const unsigned maxWidth = 131;
+		Pixel src[3][maxWidth + 2];
+		Pixel dst[2][maxWidth * 2], expected[2][maxWidth * 2];
+		uint32 seed = 1;
+
+		for (unsigned width = 1; width <= maxWidth; width += (width < 40) ? 1 : 7) {
+			for (int pass = 0; pass < 8; ++pass) {
+				// Few distinct values, so that neighbours are often equal
+				for (int row = 0; row < 3; ++row) {
+					for (unsigned x = 0; x < width + 2; ++x) {
+						seed = seed * 1103515245 + 12345;
+						src[row][x] = (Pixel)(((seed >> 16) % 3) * 0x01010101);
+					}
+				}
+
+				memset(dst, 0xCD, sizeof(dst));
+				memset(expected, 0xCD, sizeof(expected));
+				func(dst[0], dst[1], src[0] + 1, src[1] + 1, src[2] + 1, width);
+				reference(expected[0], expected[1], src[0] + 1, src[1] + 1, src[2] + 1, width);
+
+				TS_ASSERT_SAME_DATA(dst, expected, sizeof(dst));
+			}
+		}
+	}
+};
@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scalerpool.h"
+#include "graphics/scaler/scalebit.h"
+#include "../system/null_osystem.h"
+
+/** Creates AdvMame scalers without going through the plugin manager. */
+class ScalerPoolTestPlugin : public ScalerPluginObject {
+public:
+	Scaler *createInstance(const Graphics::PixelFormat &format) const override { return new AdvMameScaler(format); }
+	uint extraPixels() const override { return 4; }
+	bool canDrawCursor() const override { return true; }
+	const char *getName() const override { return "advmame"; }
+	const char *getPrettyName() const override { return "AdvMame"; }
+};
+
+class ScalerPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/**
+	 * Scaling in bands must give exactly the same picture as scaling the
+	 * whole rect on one thread, also where the bands meet.
+	 */
+	void test_bands_match_single_thread() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		ScalerPoolTestPlugin plugin;
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			ScalerPool pool(4);
+			pool.setScaler(&plugin, formats[f]);
+#ifdef POSIX
+			TS_ASSERT_EQUALS(pool.getThreadCount(), 4u);
+#endif
+			Scaler *mainScaler = plugin.createInstance(formats[f]);
+
+			for (uint factor = 2; factor <= 4; factor++) {
+				mainScaler->setFactor(factor);
+				// Heights giving bands of unequal size, and too few rows for a band
+				checkScale(pool, mainScaler, formats[f], 75, 101);
+				checkScale(pool, mainScaler, formats[f], 32, 64);
+				checkScale(pool, mainScaler, formats[f], 17, ScalerPool::kMinBandHeight + 1);
+			}
+
+			delete mainScaler;
+		}
+#endif
+	}
+
+private:
+	void checkScale(ScalerPool &pool, Scaler *mainScaler, const Graphics::PixelFormat &format, int width, int height) {
+		const int padding = 4;
+		const int bpp = format.bytesPerPixel;
+		const uint factor = mainScaler->getFactor();
+
+		const uint32 srcPitch = (width + padding * 2) * bpp;
+		byte *src = new byte[srcPitch * (height + padding * 2)];
+		uint32 seed = width * 31 + height;
+		for (uint32 i = 0; i < srcPitch * (height + padding * 2); i++) {
+			// Few distinct values, so that neighbours are often equal
+			seed = seed * 1103515245 + 12345;
+			src[i] = ((seed >> 16) % 3) * 0x55;
+		}
+
+		const uint32 dstPitch = width * factor * bpp;
+		const uint32 dstSize = dstPitch * height * factor;
+		byte *expected = new byte[dstSize];
+		byte *actual = new byte[dstSize];
+		memset(expected, 0xCD, dstSize);
+		memset(actual, 0xCD, dstSize);
+
+		const byte *srcPtr = src + padding * srcPitch + padding * bpp;
+		mainScaler->scale(srcPtr, srcPitch, expected, dstPitch, width, height, 0, 0);
+		pool.scale(mainScaler, srcPtr, srcPitch, actual, dstPitch, width, height, 0, 0);
+		TS_ASSERT_SAME_DATA(expected, actual, dstSize);
+
+		delete[] src;
+		delete[] expected;
+		delete[] actual;
+	}
+};
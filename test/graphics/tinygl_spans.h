@@ -0,0 +1,201 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#ifdef USE_TINYGL
+
+#include "common/array.h"
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zspan.h"
+
+// draws the same scenes with the vectorized spans and with the generic
+// code, which must give exactly the same pixels and depths
+
+class TinyGLSpansTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 96;
+	static const int kHeight = 72;
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	float nextCoord() {
+		// also reaches outside of the screen, to have triangles clipped
+		return (int)(nextRandom() % 240 - 120) / 100.0f;
+	}
+
+	void drawTriangles(int count, bool textured) {
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < count * 3; i++) {
+			tglColor4ub(nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff);
+			if (textured)
+				tglTexCoord2f((nextRandom() % 300) / 100.0f - 1.0f, (nextRandom() % 300) / 100.0f - 1.0f);
+			tglVertex3f(nextCoord(), nextCoord(), -1.5f - (nextRandom() % 200) / 100.0f);
+		}
+		tglEnd();
+	}
+
+	void uploadTexture(TGLuint texture, TGLint filter) {
+		byte pixels[16 * 16 * 4];
+		for (int i = 0; i < ARRAYSIZE(pixels); i++)
+			pixels[i] = nextRandom() & 0xff;
+
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, filter);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, filter);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_S, TGL_REPEAT);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_T, TGL_REPEAT);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 16, 16, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, pixels);
+	}
+
+	void drawScene() {
+		static const TGLenum depthFuncs[] = {
+			TGL_LESS, TGL_EQUAL, TGL_LEQUAL, TGL_GREATER, TGL_NOTEQUAL, TGL_GEQUAL, TGL_ALWAYS, TGL_NEVER
+		};
+		static const TGLenum blendFactors[] = {
+			TGL_ZERO, TGL_ONE, TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA, TGL_DST_COLOR
+		};
+
+		_seed = 1;
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglFrustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 4.0f);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClearDepth(1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		// depth only
+		tglEnable(TGL_DEPTH_TEST);
+		tglColorMask(TGL_FALSE, TGL_FALSE, TGL_FALSE, TGL_FALSE);
+		drawTriangles(10, false);
+		tglColorMask(TGL_TRUE, TGL_TRUE, TGL_TRUE, TGL_TRUE);
+
+		for (int i = 0; i < ARRAYSIZE(depthFuncs); i++) {
+			tglDepthFunc(depthFuncs[i]);
+			tglDepthMask(i % 2 ? TGL_FALSE : TGL_TRUE);
+			tglShadeModel(i % 3 ? TGL_SMOOTH : TGL_FLAT);
+			drawTriangles(6, false);
+		}
+		tglDepthFunc(TGL_LESS);
+		tglDepthMask(TGL_TRUE);
+		tglShadeModel(TGL_SMOOTH);
+
+		tglEnable(TGL_BLEND);
+		for (int i = 0; i < ARRAYSIZE(blendFactors); i++) {
+			for (int j = 0; j < ARRAYSIZE(blendFactors); j++) {
+				tglBlendFunc(blendFactors[i], blendFactors[j]);
+				drawTriangles(1, false);
+			}
+		}
+		tglDisable(TGL_BLEND);
+
+		tglEnable(TGL_ALPHA_TEST);
+		for (int i = 0; i < ARRAYSIZE(depthFuncs); i++) {
+			tglAlphaFunc(depthFuncs[i], (nextRandom() & 0xff) / 255.0f);
+			drawTriangles(3, false);
+		}
+		tglDisable(TGL_ALPHA_TEST);
+
+		TGLuint textures[2];
+		tglGenTextures(2, textures);
+		uploadTexture(textures[0], TGL_NEAREST);
+		uploadTexture(textures[1], TGL_LINEAR);
+		tglEnable(TGL_TEXTURE_2D);
+		for (int i = 0; i < 2; i++) {
+			tglBindTexture(TGL_TEXTURE_2D, textures[i]);
+			tglShadeModel(TGL_SMOOTH);
+			drawTriangles(8, true);
+			tglShadeModel(TGL_FLAT);
+			drawTriangles(4, true);
+			tglShadeModel(TGL_SMOOTH);
+
+			tglEnable(TGL_BLEND);
+			tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+			tglEnable(TGL_ALPHA_TEST);
+			tglAlphaFunc(TGL_GREATER, 0.3f);
+			drawTriangles(4, true);
+			tglDisable(TGL_ALPHA_TEST);
+			tglDisable(TGL_BLEND);
+
+			tglDisable(TGL_DEPTH_TEST);
+			drawTriangles(2, true);
+			tglEnable(TGL_DEPTH_TEST);
+		}
+
+		// scissored parts of the spans are skipped
+		tglEnable(TGL_SCISSOR_TEST);
+		tglScissor(13, 7, 51, 43);
+		drawTriangles(4, true);
+		tglDisable(TGL_TEXTURE_2D);
+		drawTriangles(4, false);
+		tglColorMask(TGL_FALSE, TGL_FALSE, TGL_FALSE, TGL_FALSE);
+		tglDepthFunc(TGL_ALWAYS);
+		drawTriangles(4, false);
+		tglColorMask(TGL_TRUE, TGL_TRUE, TGL_TRUE, TGL_TRUE);
+		tglDepthFunc(TGL_LESS);
+		tglDisable(TGL_SCISSOR_TEST);
+
+		tglDeleteTextures(2, textures);
+	}
+
+	void renderScene(const Graphics::PixelFormat &format, const TinyGL::SpanFuncs *funcs, Common::Array<uint32> &pixels, Common::Array<uint> &depths) {
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 16, false, false);
+		TinyGL::setContext(context);
+		TinyGL::gl_get_context()->fb->setSpanFuncs(funcs);
+
+		drawScene();
+		TinyGL::presentBuffer();
+
+		TinyGL::FrameBuffer *fb = TinyGL::gl_get_context()->fb;
+		const uint32 *pbuf = (const uint32 *)fb->getPixelBuffer();
+		pixels = Common::Array<uint32>(pbuf, kWidth * kHeight);
+		depths = Common::Array<uint>(fb->getZBuffer(), kWidth * kHeight);
+
+		TinyGL::destroyContext(context);
+	}
+
+	void checkFuncs(const TinyGL::SpanFuncs &funcs) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat::createFormatARGB32(),
+			Graphics::PixelFormat::createFormatRGBA32(),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); i++) {
+			Common::Array<uint32> expectedPixels, actualPixels;
+			Common::Array<uint> expectedDepths, actualDepths;
+			renderScene(formats[i], nullptr, expectedPixels, expectedDepths);
+			renderScene(formats[i], &funcs, actualPixels, actualDepths);
+
+			for (int y = 0; y < kHeight; y++) {
+				TS_ASSERT_SAME_DATA(&expectedPixels[y * kWidth], &actualPixels[y * kWidth], kWidth * 4);
+				TS_ASSERT_SAME_DATA(&expectedDepths[y * kWidth], &actualDepths[y * kWidth], kWidth * 4);
+			}
+		}
+	}
+
+public:
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkFuncs(TinyGL::spanFuncsSSE2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs(TinyGL::spanFuncsNEON);
+#endif
+	}
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/tinygl.h"
+#include "../system/null_osystem.h"
+
+// draws the same scene on one and on several threads, which must give
+// exactly the same pixels
+
+class TinyGLTilesTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 96;
+	static const int kHeight = 72;
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	float nextCoord() {
+		// also reaches outside of the screen, to have triangles clipped
+		return (int)(nextRandom() % 240 - 120) / 100.0f;
+	}
+
+	void drawScene() {
+		_seed = 1;
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClearDepth(1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < 40 * 3; i++) {
+			tglColor3ub(nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff);
+			tglVertex3f(nextCoord(), nextCoord(), nextCoord());
+		}
+		tglEnd();
+
+		// a blit in between has to be drawn over the triangles before it
+		// and below the ones after it
+		Graphics::Surface image;
+		image.create(20, 50, Graphics::PixelFormat::createFormatARGB32());
+		for (int y = 0; y < image.h; y++) {
+			for (int x = 0; x < image.w; x++)
+				image.setPixel(x, y, image.format.ARGBToColor(255, x * 12, y * 5, 128));
+		}
+		TinyGL::BlitImage *blitImage = tglGenBlitImage();
+		tglUploadBlitImage(blitImage, image, 0, false);
+		tglBlit(blitImage, 30, 10);
+		tglDeleteBlitImage(blitImage);
+		image.free();
+
+		tglDisable(TGL_DEPTH_TEST);
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglBegin(TGL_TRIANGLE_STRIP);
+		for (int i = 0; i < 12; i++) {
+			tglColor4ub(nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff);
+			tglVertex2f(nextCoord(), nextCoord());
+		}
+		tglEnd();
+		tglDisable(TGL_BLEND);
+
+		tglShadeModel(TGL_FLAT);
+		tglBegin(TGL_LINES);
+		for (int i = 0; i < 20 * 2; i++) {
+			tglColor3ub(nextRandom() & 0xff, nextRandom() & 0xff, nextRandom() & 0xff);
+			tglVertex2f(nextCoord(), nextCoord());
+		}
+		tglEnd();
+
+		// only the middle band of the screen is cleared
+		tglEnable(TGL_SCISSOR_TEST);
+		tglScissor(10, 20, 50, 30);
+		tglClearColor(1.0f, 1.0f, 0.0f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT);
+		tglDisable(TGL_SCISSOR_TEST);
+
+		tglBegin(TGL_QUADS);
+		tglColor3ub(200, 40, 90);
+		tglVertex2f(-0.5f, -0.9f);
+		tglVertex2f(0.9f, -0.9f);
+		tglVertex2f(0.9f, 0.1f);
+		tglVertex2f(-0.5f, 0.1f);
+		tglEnd();
+	}
+
+	Graphics::Surface *renderScene(int numThreads, bool dirtyRects) {
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, Graphics::PixelFormat::createFormatARGB32(), 16, false, dirtyRects);
+		TinyGL::setContext(context);
+		TinyGL::setRenderThreads(numThreads);
+
+		drawScene();
+		TinyGL::presentBuffer();
+		Graphics::Surface *surface = TinyGL::copyFromFrameBuffer(Graphics::PixelFormat::createFormatARGB32());
+
+		TinyGL::destroyContext(context);
+		return surface;
+	}
+
+	void checkScene(bool dirtyRects) {
+		Graphics::Surface *expected = renderScene(1, dirtyRects);
+		Graphics::Surface *actual = renderScene(4, dirtyRects);
+
+		TS_ASSERT_EQUALS(expected->w, actual->w);
+		TS_ASSERT_EQUALS(expected->h, actual->h);
+		for (int y = 0; y < expected->h; y++) {
+			TS_ASSERT_SAME_DATA(expected->getBasePtr(0, y), actual->getBasePtr(0, y), expected->w * 4);
+		}
+
+		expected->free();
+		delete expected;
+		actual->free();
+		delete actual;
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void testSameAsSingleThread() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkScene(false);
+#endif
+	}
+
+	void testSameAsSingleThreadWithDirtyRects() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkScene(true);
+#endif
+	}
+};
+
+#endif
@@ -0,0 +1,301 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/textconsole.h"
+#include "common/threadpool.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+static const Graphics::PixelFormat yuvTestFormats[] = {
+	Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+	Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+	Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+	Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+	Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0),
+	Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0)
+};
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The manager keeps a mutex of the OSystem
+		Graphics::YUVToRGBManager::destroy();
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/**
+	 * Every SIMD version must produce exactly the same pixels as the lookup
+	 * tables, for every luminance and chroma value.
+	 */
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkFuncs(Graphics::yuvToRGBRowFuncsSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkFuncs(Graphics::yuvToRGBRowFuncsAVX2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs(Graphics::yuvToRGBRowFuncsNEON);
+#endif
+	}
+
+	/**
+	 * Switching between more formats than the manager caches must not mix
+	 * up the lookups.
+	 */
+	void test_lookup_cache() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const int width = 64, height = 4;
+		byte y[width * height], u[width * height / 4], v[width * height / 4];
+		fillNoise(y, sizeof(y), 1);
+		fillNoise(u, sizeof(u), 2);
+		fillNoise(v, sizeof(v), 3);
+
+		Graphics::Surface expected[ARRAYSIZE(yuvTestFormats)], actual;
+		for (int f = 0; f < ARRAYSIZE(yuvTestFormats); f++) {
+			expected[f].create(width, height, yuvTestFormats[f]);
+			YUVToRGBMan.convert420(&expected[f], Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		}
+
+		for (int i = 0; i < 3 * ARRAYSIZE(yuvTestFormats); i++) {
+			// Revisit the formats out of order, with both scales
+			const int f = (i * 5) % ARRAYSIZE(yuvTestFormats);
+			actual.create(width, height, yuvTestFormats[f]);
+			YUVToRGBMan.convert420(&actual, Graphics::YUVToRGBManager::kScaleFull, y, u, v, width, height, width, width / 2);
+			YUVToRGBMan.convert420(&actual, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+			TS_ASSERT_SAME_DATA(expected[f].getPixels(), actual.getPixels(), width * height * yuvTestFormats[f].bytesPerPixel);
+			actual.free();
+		}
+
+		for (int f = 0; f < ARRAYSIZE(yuvTestFormats); f++)
+			expected[f].free();
+#endif
+	}
+
+	/**
+	 * Threads converting to more formats at once than the manager caches
+	 * must not evict the lookups the others are still converting with.
+	 */
+	void test_lookup_cache_threads() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		const int width = 64, height = 32;
+		byte y[width * height], u[width * height / 4], v[width * height / 4];
+		fillNoise(y, sizeof(y), 1);
+		fillNoise(u, sizeof(u), 2);
+		fillNoise(v, sizeof(v), 3);
+
+		Graphics::Surface expected[ARRAYSIZE(yuvTestFormats)];
+		for (int f = 0; f < ARRAYSIZE(yuvTestFormats); f++) {
+			expected[f].create(width, height, yuvTestFormats[f]);
+			YUVToRGBMan.convert420(&expected[f], Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		}
+
+		const int kConversions = 600;
+		bool matches[kConversions];
+		Graphics::YUVToRGBManager::destroy();
+
+		Common::ThreadPool pool(ARRAYSIZE(yuvTestFormats));
+		pool.parallelFor(0, kConversions, [&](int i) {
+			const int f = i % ARRAYSIZE(yuvTestFormats);
+			Graphics::Surface actual;
+			actual.create(width, height, yuvTestFormats[f]);
+			YUVToRGBMan.convert420(&actual, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+			matches[i] = memcmp(expected[f].getPixels(), actual.getPixels(), width * height * yuvTestFormats[f].bytesPerPixel) == 0;
+			actual.free();
+		});
+
+		for (int i = 0; i < kConversions; i++)
+			TS_ASSERT(matches[i]);
+
+		for (int f = 0; f < ARRAYSIZE(yuvTestFormats); f++)
+			expected[f].free();
+#endif
+	}
+
+	/**
+	 * Converting in slices on a thread pool must produce the same image as
+	 * converting it in one go, for YUV420 and YUV410.
+	 */
+	void test_convert420_pool() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		const int width = 96, height = 70;
+		byte y[width * height], u[width * height / 4], v[width * height / 4], a[width * height];
+		fillNoise(y, sizeof(y), 4);
+		fillNoise(u, sizeof(u), 5);
+		fillNoise(v, sizeof(v), 6);
+		fillNoise(a, sizeof(a), 7);
+
+		Common::ThreadPool pool(2);
+		Graphics::Surface expected, actual;
+		expected.create(width, height, yuvTestFormats[3]);
+		actual.create(width, height, yuvTestFormats[3]);
+
+		YUVToRGBMan.convert420(&expected, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		YUVToRGBMan.convert420(&actual, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2, &pool);
+		TS_ASSERT_SAME_DATA(expected.getPixels(), actual.getPixels(), width * height * 4);
+
+		YUVToRGBMan.convert420Alpha(&expected, Graphics::YUVToRGBManager::kScaleITU, y, u, v, a, width, height, width, width / 2);
+		YUVToRGBMan.convert420Alpha(&actual, Graphics::YUVToRGBManager::kScaleITU, y, u, v, a, width, height, width, width / 2, &pool);
+		TS_ASSERT_SAME_DATA(expected.getPixels(), actual.getPixels(), width * height * 4);
+
+		// YUV410 with the extra chroma row and column it reads
+		const int height410 = 68, uvPitch410 = width / 4 + 1;
+		YUVToRGBMan.convert410(&expected, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height410, width, uvPitch410);
+		YUVToRGBMan.convert410(&actual, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height410, width, uvPitch410, &pool);
+		TS_ASSERT_SAME_DATA(expected.getPixels(), actual.getPixels(), width * height410 * 4);
+
+		expected.free();
+		actual.free();
+#endif
+	}
+
+	void test_benchmark_yuv420() {
+#if BENCHMARK_TIME
+		const int width = 640, height = 480;
+#ifdef SLOW_TESTS
+		const int frames = 1000;
+#else
+		const int frames = 20;
+#endif
+		byte *y = new byte[width * height];
+		byte *u = new byte[width * height / 4];
+		byte *v = new byte[width * height / 4];
+		fillNoise(y, width * height, 1);
+		fillNoise(u, width * height / 4, 2);
+		fillNoise(v, width * height / 4, 3);
+
+		benchmark("generic", Graphics::yuvToRGBRowFuncsGeneric, y, u, v, width, height, frames);
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			benchmark("SSE2", Graphics::yuvToRGBRowFuncsSSE2, y, u, v, width, height, frames);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			benchmark("AVX2", Graphics::yuvToRGBRowFuncsAVX2, y, u, v, width, height, frames);
+#endif
+#ifdef SCUMMVM_NEON
+		benchmark("NEON", Graphics::yuvToRGBRowFuncsNEON, y, u, v, width, height, frames);
+#endif
+
+		delete[] y;
+		delete[] u;
+		delete[] v;
+#endif
+	}
+
+private:
+	static void fillNoise(byte *buf, int size, uint32 seed) {
+		for (int i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 16;
+		}
+	}
+
+	void checkRow(Graphics::YUVToRGBRowFuncs::RowFunc expectedFunc, Graphics::YUVToRGBRowFuncs::RowFunc actualFunc,
+			const Graphics::YUVToRGBLookup &lookup, const byte *y, const byte *u, const byte *v, const byte *a, int width) {
+		const int size = width * lookup.getFormat().bytesPerPixel;
+		byte *expected = new byte[size];
+		byte *actual = new byte[size];
+
+		expectedFunc(expected, &lookup, y, u, v, a, width);
+		actualFunc(actual, &lookup, y, u, v, a, width);
+		TS_ASSERT_SAME_DATA(expected, actual, size);
+
+		delete[] expected;
+		delete[] actual;
+	}
+
+	void checkFuncs(const Graphics::YUVToRGBRowFuncs &funcs) {
+		// Every chroma pair once, and an odd tail for the C fallback
+		const int width = 256 * 256 + 13;
+		byte *y = new byte[width];
+		byte *u = new byte[width];
+		byte *v = new byte[width];
+		byte *a = new byte[width];
+
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		for (int pass = 0; pass < 2; pass++) {
+			fillNoise(y, width, 1 + pass);
+			fillNoise(a, width, 3 + pass);
+			for (int i = 0; i < width; i++) {
+				u[i] = i;
+				v[i] = i >> 8;
+			}
+			// Swap the roles the second time, so all luminances meet all chromas
+			if (pass == 1) {
+				byte *tmp = y;
+				y = u;
+				u = tmp;
+			}
+
+			for (int s = 0; s < ARRAYSIZE(scales); s++) {
+				for (int f = 0; f < ARRAYSIZE(yuvTestFormats); f++) {
+					const Graphics::YUVToRGBLookup lookup(yuvTestFormats[f], scales[s]);
+
+					for (int half = 0; half < 2; half++) {
+						const Graphics::YUVToRGBRowFuncs::RowFunc expectedFunc = Graphics::yuvToRGBRowFuncsGeneric.getRowFunc(half, yuvTestFormats[f].bytesPerPixel);
+						const Graphics::YUVToRGBRowFuncs::RowFunc actualFunc = funcs.getRowFunc(half, yuvTestFormats[f].bytesPerPixel);
+						const int rowWidth = half ? width - 1 : width;
+
+						checkRow(expectedFunc, actualFunc, lookup, y, u, v, nullptr, rowWidth);
+						checkRow(expectedFunc, actualFunc, lookup, y, u, v, a, rowWidth);
+					}
+				}
+			}
+		}
+
+		delete[] y;
+		delete[] u;
+		delete[] v;
+		delete[] a;
+	}
+
+	void benchmark(const char *name, const Graphics::YUVToRGBRowFuncs &funcs, const byte *y, const byte *u, const byte *v, int width, int height, int frames) {
+		const Graphics::PixelFormat formats[] = { yuvTestFormats[0], yuvTestFormats[2] };
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			const Graphics::YUVToRGBLookup lookup(formats[f], Graphics::YUVToRGBManager::kScaleITU);
+			const Graphics::YUVToRGBRowFuncs::RowFunc convertRow = funcs.getRowFunc(true, formats[f].bytesPerPixel);
+			const int pitch = width * formats[f].bytesPerPixel;
+			byte *dst = new byte[pitch * height];
+
+			const uint32 start = g_system->getMillis();
+			for (int i = 0; i < frames; i++) {
+				for (int h = 0; h < height; h++)
+					convertRow(dst + h * pitch, &lookup, y + h * width, u + (h / 2) * (width / 2), v + (h / 2) * (width / 2), nullptr, width);
+			}
+			const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			debug("YUV420 to %d bpp, %s: %d frames of %dx%d in %d ms (%.1f frames per second)\n",
+				formats[f].bytesPerPixel * 8, name, frames, width, height, time, frames * 1000.0 / time);
+
+			delete[] dst;
+		}
+	}
+};
@@ -0,0 +1,175 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "image/codecs/dither.h"
+#include "image/codecs/dither_intern.h"
+
+/** Returns the same frame every time, in any format. */
+class DitherTestCodec : public Image::Codec {
+public:
+	DitherTestCodec(const Graphics::Surface &frame, const byte *palette) : _frame(frame), _palette(palette) {}
+
+	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override { return &_frame; }
+	Graphics::PixelFormat getPixelFormat() const override { return _frame.format; }
+	bool containsPalette() const override { return _palette != nullptr; }
+	const byte *getPalette() override { return _palette; }
+
+private:
+	const Graphics::Surface &_frame;
+	const byte *_palette;
+};
+
+static const Graphics::PixelFormat ditherTestFormats[] = {
+	Graphics::PixelFormat(2, 5, 5, 4, 0, 9, 4, 0, 0),
+	Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+	Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+	Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+	Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+	Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+	Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+};
+
+class DitherTestSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Getting the dither table of the same palette again, also after it was
+	 * released, must return the same table without creating it again.
+	 */
+	void test_table_cache() {
+		byte palette1[256 * 3], palette2[256 * 3];
+		fillNoise(palette1, sizeof(palette1), 1);
+		fillNoise(palette2, sizeof(palette2), 2);
+
+		const byte *table1 = Image::DitherCodec::getQuickTimeDitherTable(palette1, 256);
+		const byte *table2 = Image::DitherCodec::getQuickTimeDitherTable(palette2, 256);
+		TS_ASSERT_DIFFERS(table1, table2);
+		TS_ASSERT_EQUALS(Image::DitherCodec::getQuickTimeDitherTable(palette1, 256), table1);
+
+		byte *expected = Image::DitherCodec::createQuickTimeDitherTable(palette1, 256);
+		TS_ASSERT_SAME_DATA(expected, table1, 0x10000);
+		delete[] expected;
+
+		Image::DitherCodec::releaseQuickTimeDitherTable(table1);
+		Image::DitherCodec::releaseQuickTimeDitherTable(table1);
+		Image::DitherCodec::releaseQuickTimeDitherTable(table2);
+		TS_ASSERT_EQUALS(Image::DitherCodec::getQuickTimeDitherTable(palette1, 256), table1);
+		Image::DitherCodec::releaseQuickTimeDitherTable(table1);
+	}
+
+	/**
+	 * Dithering must pick the same entries as looking up every pixel in
+	 * the dither table one by one, for every frame format.
+	 */
+	void test_dither_frame() {
+		byte ditherPalette[256 * 3], framePalette[256 * 3];
+		fillNoise(ditherPalette, sizeof(ditherPalette), 3);
+		fillNoise(framePalette, sizeof(framePalette), 4);
+
+		byte *table = Image::DitherCodec::createQuickTimeDitherTable(ditherPalette, 256);
+
+		// Wider than a chunk, and not a multiple of four
+		const int width = 263, height = 6;
+		byte pixels[width * height * 4];
+		fillNoise(pixels, sizeof(pixels), 5);
+
+		for (int f = -1; f < ARRAYSIZE(ditherTestFormats); f++) {
+			const Graphics::PixelFormat format = (f < 0) ? Graphics::PixelFormat::createFormatCLUT8() : ditherTestFormats[f];
+
+			Graphics::Surface frame;
+			frame.init(width, height, width * format.bytesPerPixel, pixels, format);
+
+			// RGB554 leaves the top two bits unused
+			if (f == 0) {
+				for (int i = 0; i < width * height; i++)
+					((uint16 *)pixels)[i] &= 0x3FFF;
+			}
+
+			DitherTestCodec *codec = new DitherTestCodec(frame, format.isCLUT8() ? framePalette : nullptr);
+			Image::DitherCodec dither(codec);
+			dither.setDither(Image::Codec::kDitherTypeQT, ditherPalette);
+
+			Common::MemoryReadStream stream(pixels, 0);
+			const Graphics::Surface *actual = dither.decodeFrame(stream);
+			TS_ASSERT(actual);
+			if (!actual)
+				continue;
+
+			static const uint16 colorTableOffsets[] = { 0x0000, 0xC000, 0x4000, 0x8000 };
+			for (int y = 0; y < height; y++) {
+				uint16 colorTableOffset = colorTableOffsets[y & 3];
+				for (int x = 0; x < width; x++) {
+					const uint16 color = getDitherColor(frame, x, y, framePalette);
+					TS_ASSERT_EQUALS(*(const byte *)actual->getBasePtr(x, y), table[colorTableOffset + color]);
+					colorTableOffset += 0x4000;
+				}
+			}
+		}
+
+		delete[] table;
+	}
+
+	/**
+	 * Every SIMD version must compute exactly the same dither colors as the
+	 * C version.
+	 */
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkFuncs(Image::quickTimeDitherFuncsSSE2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs(Image::quickTimeDitherFuncsNEON);
+#endif
+	}
+
+private:
+	static void fillNoise(byte *buf, int size, uint32 seed) {
+		for (int i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			buf[i] = seed >> 16;
+		}
+	}
+
+	static uint16 getDitherColor(const Graphics::Surface &frame, int x, int y, const byte *palette) {
+		byte r, g, b;
+		if (frame.format.isCLUT8()) {
+			const byte index = *(const byte *)frame.getBasePtr(x, y);
+			r = palette[index * 3];
+			g = palette[index * 3 + 1];
+			b = palette[index * 3 + 2];
+		} else if (frame.format.bytesPerPixel == 2) {
+			frame.format.colorToRGB(*(const uint16 *)frame.getBasePtr(x, y), r, g, b);
+		} else {
+			frame.format.colorToRGB(*(const uint32 *)frame.getBasePtr(x, y), r, g, b);
+		}
+		return ((r & 0xF8) << 6) | ((g & 0xF8) << 1) | (b >> 4);
+	}
+
+	void checkFuncs(const Image::QuickTimeDitherFuncs &funcs) {
+		const int width = 77;
+		byte pixels[width * 4];
+		fillNoise(pixels, sizeof(pixels), 6);
+
+		for (int f = 0; f < ARRAYSIZE(ditherTestFormats); f++) {
+			const Graphics::PixelFormat &format = ditherTestFormats[f];
+			if (!Image::canComputeQuickTimeDitherIndices(format))
+				continue;
+
+			const Image::QuickTimeDitherFuncs::IndexFunc expectedFunc = (format.bytesPerPixel == 2) ?
+				Image::quickTimeDitherFuncsGeneric.computeIndices16 : Image::quickTimeDitherFuncsGeneric.computeIndices32;
+			const Image::QuickTimeDitherFuncs::IndexFunc actualFunc = (format.bytesPerPixel == 2) ?
+				funcs.computeIndices16 : funcs.computeIndices32;
+
+			uint16 expected[width], actual[width];
+			expectedFunc(expected, pixels, format, width);
+			actualFunc(actual, pixels, format, width);
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+		}
+	}
+};
@@ -0,0 +1,104 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#ifdef USE_INDEO45
+#include "image/codecs/indeo/indeo_dsp.h"
+#endif
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Every SIMD version must produce exactly the same pixels as the C
+	 * version, including the wrapped around and clipped ones.
+	 */
+	void test_simd_matches_generic() {
+#ifdef USE_INDEO45
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkFuncs(Image::Indeo::indeoDSPFuncsSSE2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkFuncs(Image::Indeo::indeoDSPFuncsNEON);
+#endif
+#endif
+	}
+
+private:
+	uint32 _seed;
+
+	int nextRandom(int range) {
+		_seed = _seed * 1103515245 + 12345;
+		return (int)((_seed >> 8) % (uint32)(2 * range + 1)) - range;
+	}
+
+	void fillPlane(int16 *plane, int size, int range) {
+		for (int i = 0; i < size; i++)
+			plane[i] = nextRandom(range);
+	}
+
+#ifdef USE_INDEO45
+	void checkFuncs(const Image::Indeo::IndeoDSPFuncs &funcs) {
+		const Image::Indeo::IndeoDSPFuncs &generic = Image::Indeo::indeoDSPFuncsGeneric;
+		const int pitch = 21;
+
+		_seed = 1;
+
+		for (int round = 0; round < 400; round++) {
+			// Every other round uses the full range, which overflows the sums
+			const int range = (round & 1) ? 32767 : 300;
+
+			int16 ref[pitch * 10];
+			fillPlane(ref, ARRAYSIZE(ref), range);
+
+			int16 expected[pitch * 8], actual[pitch * 8];
+			fillPlane(expected, ARRAYSIZE(expected), range);
+
+			const Image::Indeo::IviMCFunc genericFuncs[] = { generic.mc8x8NoDelta, generic.mc8x8Delta, generic.mc4x4NoDelta, generic.mc4x4Delta };
+			const Image::Indeo::IviMCFunc actualFuncs[] = { funcs.mc8x8NoDelta, funcs.mc8x8Delta, funcs.mc4x4NoDelta, funcs.mc4x4Delta };
+
+			for (int f = 0; f < ARRAYSIZE(genericFuncs); f++) {
+				for (int mcType = 0; mcType < 5; mcType++) {
+					memcpy(actual, expected, sizeof(expected));
+					genericFuncs[f](expected, ref + 1, pitch, mcType);
+					actualFuncs[f](actual, ref + 1, pitch, mcType);
+					TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+				}
+			}
+
+			// Rows of every length up to two SIMD iterations and a tail
+			const int width = round % 40;
+			uint8 expectedRow[40], actualRow[40];
+			memset(expectedRow, 0xEE, sizeof(expectedRow));
+			memset(actualRow, 0xEE, sizeof(actualRow));
+			generic.outputRow(expectedRow, ref, width);
+			funcs.outputRow(actualRow, ref, width);
+			TS_ASSERT_SAME_DATA(expectedRow, actualRow, sizeof(expectedRow));
+
+			// Columns flagged as empty, rows of zeroes and results
+			// wrapping around to 16 bits
+			int32 coeffs[64];
+			uint8 flags[8];
+			const int coeffRange = (round & 1) ? 1 << 20 : 300;
+			for (int i = 0; i < ARRAYSIZE(coeffs); i++)
+				coeffs[i] = (i & 8) && (round & 2) ? 0 : nextRandom(coeffRange);
+			for (int i = 0; i < ARRAYSIZE(flags); i++)
+				flags[i] = nextRandom(1) != 0;
+
+			Image::Indeo::InvTransformPtr *const genericTransforms[] = { generic.inverseHaar8x8, generic.inverseHaar4x4, generic.inverseSlant8x8, generic.inverseSlant4x4 };
+			Image::Indeo::InvTransformPtr *const actualTransforms[] = { funcs.inverseHaar8x8, funcs.inverseHaar4x4, funcs.inverseSlant8x8, funcs.inverseSlant4x4 };
+
+			for (int f = 0; f < ARRAYSIZE(genericTransforms); f++) {
+				fillPlane(expected, ARRAYSIZE(expected), range);
+				memcpy(actual, expected, sizeof(expected));
+				genericTransforms[f](coeffs, expected, pitch, flags);
+				actualTransforms[f](coeffs, actual, pitch, flags);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+			}
+		}
+	}
+#endif
+};
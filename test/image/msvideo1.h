@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "image/codecs/msvideo1.h"
+#include "graphics/surface.h"
+
+class MSVideo1DecoderTestSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Decoding into a surface of the caller must produce the same frames as
+	 * decoding into the codec's own one, including the blocks kept from the
+	 * previous frame, and leave the rest of the surface alone.
+	 */
+	void test_output_surface() {
+		// An 8x8 frame of four blocks in one colour each
+		static const byte frame1[] = { 0x10, 0x80, 0x20, 0x80, 0x30, 0x80, 0x40, 0x80 };
+		// A two colour block, then three skipped ones
+		static const byte frame2[] = { 0x5A, 0x5A, 0x50, 0x60, 0x03, 0x84 };
+		// One skipped block, a one colour block, then two skipped ones
+		static const byte frame3[] = { 0x01, 0x84, 0x70, 0x80, 0x02, 0x84 };
+
+		Image::MSVideo1Decoder expected(8, 8, 8), actual(8, 8, 8);
+		Graphics::Surface screen;
+		screen.create(16, 12, Graphics::PixelFormat::createFormatCLUT8());
+		memset(screen.getPixels(), 0xEE, screen.pitch * screen.h);
+
+		// Both decode the first frame into their own surfaces
+		decode(expected, frame1, sizeof(frame1));
+		decode(actual, frame1, sizeof(frame1));
+
+		TS_ASSERT(actual.setOutputSurface(&screen));
+		const Graphics::Surface *expectedFrame = decode(expected, frame2, sizeof(frame2));
+		const Graphics::Surface *actualFrame = decode(actual, frame2, sizeof(frame2));
+		TS_ASSERT_EQUALS(actualFrame->getPixels(), screen.getPixels());
+		checkSame(expectedFrame, actualFrame);
+
+		for (int y = 0; y < screen.h; y++)
+			for (int x = 0; x < screen.w; x++)
+				if (x >= 8 || y >= 8)
+					TS_ASSERT_EQUALS(*(const byte *)screen.getBasePtr(x, y), 0xEE);
+
+		TS_ASSERT(actual.setOutputSurface(nullptr));
+		expectedFrame = decode(expected, frame3, sizeof(frame3));
+		actualFrame = decode(actual, frame3, sizeof(frame3));
+		TS_ASSERT_DIFFERS(actualFrame->getPixels(), screen.getPixels());
+		checkSame(expectedFrame, actualFrame);
+
+		screen.free();
+	}
+
+private:
+	static const Graphics::Surface *decode(Image::MSVideo1Decoder &decoder, const byte *data, uint32 size) {
+		Common::MemoryReadStream stream(data, size);
+		return decoder.decodeFrame(stream);
+	}
+
+	static void checkSame(const Graphics::Surface *expected, const Graphics::Surface *actual) {
+		TS_ASSERT(expected && actual);
+		if (!expected || !actual)
+			return;
+
+		TS_ASSERT_EQUALS(expected->w, actual->w);
+		TS_ASSERT_EQUALS(expected->h, actual->h);
+		for (int y = 0; y < expected->h; y++)
+			TS_ASSERT_SAME_DATA(expected->getBasePtr(0, y), actual->getBasePtr(0, y), expected->w);
+	}
+};
@@ -10,7 +10,8 @@ TESTS        := $(srcdir)/test/common/*.h \
 	$(srcdir)/test/common/formats/*.h \
 	$(srcdir)/test/audio/*.h \
 	$(srcdir)/test/math/*.h \
-	$(srcdir)/test/image/*.h
+	$(srcdir)/test/image/*.h \
+	$(srcdir)/test/graphics/yuv_to_rgb.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -37,6 +38,20 @@ ifdef USE_TINYGL
 TESTS += $(srcdir)/test/graphics/tinygl*.h
 endif
 
+ifdef USE_SCALERS
+TESTS += $(srcdir)/test/graphics/scale2x.h \
+	$(srcdir)/test/graphics/scalerpool.h
+endif
+
+ifdef USE_BINK
+TESTS += $(srcdir)/test/video/bink_dsp.h
+endif
+
+TESTS += $(srcdir)/test/video/decode_ahead.h \
+	$(srcdir)/test/video/decode_into.h \
+	$(srcdir)/test/video/frame_cache.h
+TEST_LIBS += video/libvideo.a
+
 # libcommon needs libformats and libformats needs libcommon: so libcommon is put twice
 TEST_LIBS +=	audio/libaudio.a math/libmath.a common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
@@ -64,6 +79,11 @@ TEST_LDFLAGS := $(LDFLAGS) $(LIBS)
 TEST_CXXFLAGS  := $(filter-out -Wglobal-constructors,$(CXXFLAGS))
 TEST_CXXFLAGS += -Wno-self-assign-overloaded
 
+ifdef POSIX
+# The test OSystem creates its threads with pthreads
+TEST_LDFLAGS += -lpthread
+endif
+
 ifdef WIN32
 TEST_LDFLAGS := $(filter-out -mwindows,$(TEST_LDFLAGS))
 endif
@@ -91,10 +111,20 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/bin/cxxtestgen $(TEST_FLAGS) -o $@ $+
 
+# Headless benchmark of the video decoders, see test/video_benchmark.cpp
+# The libraries after TEST_LIBS resolve what the video decoders pull in late
+VIDEO_BENCHMARK_LIBS := video/libvideo.a $(TEST_LIBS) image/libimage.a graphics/libgraphics.a audio/libaudio.a \
+	common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a
+
+video-benchmark: test/video_benchmark
+test/video_benchmark: $(srcdir)/test/video_benchmark.cpp $(VIDEO_BENCHMARK_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $< $(VIDEO_BENCHMARK_LIBS) $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/system/null_osystem.o
+	-$(RM) test/runner.cpp test/runner test/video_benchmark test/engine-data/encoding.dat test/system/null_osystem.o
 	-rmdir test/engine-data
+	-$(RM_REC) test/frame-cache
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 	$(MKDIR) test/engine-data
@@ -102,4 +132,4 @@ test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 
 copy-dat: test/engine-data/encoding.dat
 
-.PHONY: test clean-test copy-dat
+.PHONY: test video-benchmark clean-test copy-dat
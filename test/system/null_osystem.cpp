@@ -8,6 +8,10 @@
 #undef USE_CLOUD
 #endif
 #include "../backends/saves/savefile.cpp"
+#ifdef POSIX
+#include "../backends/mutex/pthread/pthread-mutex.cpp"
+#include "../backends/thread/pthread/pthread-thread.cpp"
+#endif
 
 //#define DISPLAY_ERROR_MESSAGES
 
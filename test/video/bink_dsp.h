@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "video/bink_dsp.h"
+
+class BinkDSPTestSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Every SIMD version must produce exactly the same pixels as the C
+	 * version, including the wrapped around ones.
+	 */
+	void test_simd_matches_generic() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkDSP(Video::binkDSPSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkDSP(Video::binkDSPAVX2);
+#endif
+#ifdef SCUMMVM_NEON
+		checkDSP(Video::binkDSPNEON);
+#endif
+	}
+
+private:
+	uint32 _seed;
+
+	int nextRandom(int range) {
+		_seed = _seed * 1103515245 + 12345;
+		return (int)((_seed >> 8) % (uint32)(2 * range + 1)) - range;
+	}
+
+	/**
+	 * Fill a block with coefficients in the range Bink produces. Most
+	 * blocks only have a few, and some none but the DC coefficient, which
+	 * the C version takes a shortcut for.
+	 */
+	void fillCoefficients(int32 *block, int round) {
+		const int density = round % 4;
+		for (int i = 0; i < 64; i++) {
+			if (i == 0 || (density && nextRandom(density * 4) == 0) || density == 3)
+				block[i] = nextRandom(2048) * 16;
+			else
+				block[i] = 0;
+		}
+	}
+
+	void fillPixels(byte *pixels, int size) {
+		for (int i = 0; i < size; i++)
+			pixels[i] = nextRandom(128) + 128;
+	}
+
+	void checkDSP(const Video::BinkDSP &dsp) {
+		const Video::BinkDSP &generic = Video::binkDSPGeneric;
+		const int pitch = 13;
+
+		_seed = 1;
+
+		for (int round = 0; round < 1000; round++) {
+			int32 coefficients[64], expectedBlock[64], actualBlock[64];
+			fillCoefficients(coefficients, round);
+
+			memcpy(expectedBlock, coefficients, sizeof(coefficients));
+			memcpy(actualBlock, coefficients, sizeof(coefficients));
+			generic.idct(expectedBlock);
+			dsp.idct(actualBlock);
+			TS_ASSERT_SAME_DATA(expectedBlock, actualBlock, sizeof(expectedBlock));
+
+			byte expected[pitch * 8], actual[pitch * 8];
+			fillPixels(expected, sizeof(expected));
+			memcpy(actual, expected, sizeof(expected));
+
+			memcpy(expectedBlock, coefficients, sizeof(coefficients));
+			memcpy(actualBlock, coefficients, sizeof(coefficients));
+			generic.idctPut(expected, pitch, expectedBlock);
+			dsp.idctPut(actual, pitch, actualBlock);
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+
+			memcpy(expectedBlock, coefficients, sizeof(coefficients));
+			memcpy(actualBlock, coefficients, sizeof(coefficients));
+			generic.idctAdd(expected, pitch, expectedBlock);
+			dsp.idctAdd(actual, pitch, actualBlock);
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+
+			int16 residue[64];
+			for (int i = 0; i < 64; i++)
+				residue[i] = nextRandom(512);
+			generic.addResidue(expected, pitch, residue);
+			dsp.addResidue(actual, pitch, residue);
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+		}
+	}
+};
@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+#include "../system/null_osystem.h"
+
+/**
+ * A seekable palette video, whose frames are filled with their own number.
+ * Every fourth frame keeps the palette of the frame before, which then has
+ * to outlive the buffer the worker decoded it into. After seeking the
+ * palette is always dirty.
+ */
+class DecodeAheadTestDecoder : public Video::VideoDecoder {
+public:
+	static const int kFrameCount = 40;
+
+	DecodeAheadTestDecoder() { addTrack(new TestTrack()); }
+
+	bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+	static bool hasOwnPalette(int frame) { return (frame % 4) != 3; }
+
+	static void getFramePalette(int frame, byte *palette) {
+		for (int i = 0; i < 3 * 256; i++)
+			palette[i] = (byte)(i + frame * 7);
+	}
+
+protected:
+	bool supportsDecodeAhead() const override { return true; }
+
+private:
+	class TestTrack : public FixedRateVideoTrack {
+	public:
+		TestTrack() : _curFrame(-1), _dirtyPalette(false) {
+			_surface.create(16, 8, Graphics::PixelFormat::createFormatCLUT8());
+		}
+		~TestTrack() { _surface.free(); }
+
+		bool endOfTrack() const override { return _curFrame >= kFrameCount - 1; }
+		bool isSeekable() const override { return true; }
+
+		bool seek(const Audio::Timestamp &time) override {
+			_curFrame = getFrameAtTime(time) - 1;
+			_dirtyPalette = true;
+			return true;
+		}
+
+		uint16 getWidth() const override { return _surface.w; }
+		uint16 getHeight() const override { return _surface.h; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return kFrameCount; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			_surface.fillRect(Common::Rect(_surface.w, _surface.h), _curFrame);
+
+			if (_dirtyPalette || hasOwnPalette(_curFrame)) {
+				getFramePalette(_curFrame, _palette);
+				_dirtyPalette = true;
+			}
+
+			return &_surface;
+		}
+
+		const byte *getPalette() const override {
+			_dirtyPalette = false;
+			return _palette;
+		}
+
+		bool hasDirtyPalette() const override { return _dirtyPalette; }
+
+	protected:
+		Common::Rational getFrameRate() const override { return 30; }
+
+	private:
+		Graphics::Surface _surface;
+		int _curFrame;
+		mutable bool _dirtyPalette;
+		byte _palette[3 * 256];
+	};
+};
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/**
+	 * The palette of the frame shown last must stay valid while the worker
+	 * decodes the following frames, which have palettes of their own.
+	 */
+	void test_palette() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		DecodeAheadTestDecoder decoder;
+		decoder.setDecodeAhead(2);
+		decoder.start();
+
+		byte expected[3 * 256];
+		for (int frame = 0; frame < DecodeAheadTestDecoder::kFrameCount; frame++) {
+			checkFrame(decoder.decodeNextFrame(), frame);
+
+			// Frames without a palette of their own keep the previous one
+			TS_ASSERT_EQUALS(decoder.hasDirtyPalette(), DecodeAheadTestDecoder::hasOwnPalette(frame));
+			if (decoder.hasDirtyPalette())
+				memcpy(expected, decoder.getPalette(), sizeof(expected));
+
+			// Give the worker the time to reuse the frames of the queue
+			g_system->delayMillis(2);
+			TS_ASSERT_SAME_DATA(decoder.getPalette(), expected, sizeof(expected));
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT(!decoder.decodeNextFrame());
+#endif
+	}
+
+	/** Seeking drops the frames decoded ahead, and decoding goes on from there. */
+	void test_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		DecodeAheadTestDecoder decoder;
+		decoder.setDecodeAhead(4);
+		decoder.start();
+
+		for (int frame = 0; frame < 3; frame++)
+			checkFrame(decoder.decodeNextFrame(), frame);
+
+		static const int seekFrames[] = { 11, 5, 30, 0 };
+		for (int i = 0; i < ARRAYSIZE(seekFrames); i++) {
+			TS_ASSERT(decoder.seekToFrame(seekFrames[i]));
+
+			for (int frame = seekFrames[i]; frame < seekFrames[i] + 6; frame++) {
+				checkFrame(decoder.decodeNextFrame(), frame);
+				TS_ASSERT_EQUALS(decoder.getCurFrame(), frame);
+
+				const bool ownPalette = frame == seekFrames[i] || DecodeAheadTestDecoder::hasOwnPalette(frame);
+				TS_ASSERT_EQUALS(decoder.hasDirtyPalette(), ownPalette);
+
+				byte expected[3 * 256];
+				DecodeAheadTestDecoder::getFramePalette(ownPalette ? frame : frame - 1, expected);
+				TS_ASSERT_SAME_DATA(decoder.getPalette(), expected, sizeof(expected));
+			}
+		}
+#endif
+	}
+
+private:
+	static void checkFrame(const Graphics::Surface *surface, int frame) {
+		TS_ASSERT(surface);
+		if (!surface)
+			return;
+
+		TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(0, 0), frame);
+		TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(surface->w - 1, surface->h - 1), frame);
+	}
+};
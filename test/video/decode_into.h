@@ -0,0 +1,190 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "image/codecs/codec.h"
+#include "video/video_decoder.h"
+#include "../system/null_osystem.h"
+
+/**
+ * A palette video which, like the codecs decoding differences, only draws
+ * one new pixel over the previous frame each time: frame n sets the n-th
+ * pixel to n + 1.
+ */
+class DecodeIntoTestDecoder : public Video::VideoDecoder {
+public:
+	static const int kWidth = 16;
+	static const int kHeight = 8;
+	static const int kFrameCount = kWidth * kHeight;
+
+	DecodeIntoTestDecoder() {
+		_track = new TestTrack();
+		addTrack(_track);
+	}
+
+	bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+	bool isDecodingInto(const Graphics::Surface &surface) const { return _track->isDecodingInto(surface); }
+
+	static byte getPixel(int frame, int x, int y) {
+		const int n = y * kWidth + x;
+		return (n <= frame) ? n + 1 : 0;
+	}
+
+	static void getColor(byte index, byte &r, byte &g, byte &b) {
+		r = index;
+		g = 255 - index;
+		b = index * 3;
+	}
+
+private:
+	class TestTrack : public FixedRateVideoTrack {
+	public:
+		TestTrack() : _curFrame(-1), _dirtyPalette(true) {
+			_ownSurface.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+			_ownSurface.fillRect(Common::Rect(kWidth, kHeight), 0);
+			_surface = &_ownSurface;
+
+			for (int i = 0; i < 256; i++)
+				getColor(i, _palette[i * 3], _palette[i * 3 + 1], _palette[i * 3 + 2]);
+		}
+		~TestTrack() { _ownSurface.free(); }
+
+		bool isDecodingInto(const Graphics::Surface &surface) const { return _surface->getPixels() == surface.getPixels(); }
+
+		bool endOfTrack() const override { return _curFrame >= kFrameCount - 1; }
+		uint16 getWidth() const override { return kWidth; }
+		uint16 getHeight() const override { return kHeight; }
+		Graphics::PixelFormat getPixelFormat() const override { return _ownSurface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return kFrameCount; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			_surface->setPixel(_curFrame % kWidth, _curFrame / kWidth, _curFrame + 1);
+			return _surface;
+		}
+
+		bool setOutputSurface(Graphics::Surface *surface) override {
+			Image::switchOutputSurface(_surface, &_ownSurface, _outputSurface, surface);
+			return true;
+		}
+
+		const byte *getPalette() const override {
+			_dirtyPalette = false;
+			return _palette;
+		}
+
+		bool hasDirtyPalette() const override { return _dirtyPalette; }
+
+	protected:
+		Common::Rational getFrameRate() const override { return 30; }
+
+	private:
+		Graphics::Surface _ownSurface;
+		Graphics::Surface _outputSurface;
+		Graphics::Surface *_surface;
+		int _curFrame;
+		mutable bool _dirtyPalette;
+		byte _palette[3 * 256];
+	};
+
+	TestTrack *_track;
+};
+
+class DecodeIntoTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/**
+	 * Surfaces in the format of the video are decoded into directly, and
+	 * keep the previous frame when switching between them and the track's
+	 * own surface.
+	 */
+	void test_direct() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		DecodeIntoTestDecoder decoder;
+		decoder.start();
+
+		// Larger than the frames, which go to the top-left corner
+		Graphics::Surface dst[2];
+		for (int i = 0; i < 2; i++) {
+			dst[i].create(DecodeIntoTestDecoder::kWidth + 5, DecodeIntoTestDecoder::kHeight + 3, Graphics::PixelFormat::createFormatCLUT8());
+			dst[i].fillRect(Common::Rect(dst[i].w, dst[i].h), 0xEE);
+		}
+
+		for (int frame = 0; frame < DecodeIntoTestDecoder::kFrameCount; frame++) {
+			// Switch the target every now and then
+			if ((frame % 10) == 9) {
+				checkFrame(decoder.decodeNextFrame(), frame);
+				continue;
+			}
+
+			Graphics::Surface &target = dst[(frame / 20) % 2];
+			TS_ASSERT(decoder.decodeNextFrameInto(target));
+			TS_ASSERT(decoder.isDecodingInto(target));
+			checkFrame(&target, frame);
+
+			for (int y = 0; y < target.h; y++)
+				for (int x = 0; x < target.w; x++)
+					if (x >= DecodeIntoTestDecoder::kWidth || y >= DecodeIntoTestDecoder::kHeight)
+						TS_ASSERT_EQUALS(*(const byte *)target.getBasePtr(x, y), 0xEE);
+		}
+
+		TS_ASSERT(!decoder.decodeNextFrameInto(dst[0]));
+
+		dst[0].free();
+		dst[1].free();
+#endif
+	}
+
+	/** Surfaces in another format receive a converted copy of each frame. */
+	void test_convert() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		DecodeIntoTestDecoder decoder;
+		decoder.start();
+
+		Graphics::Surface dst;
+		dst.create(DecodeIntoTestDecoder::kWidth, DecodeIntoTestDecoder::kHeight, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+		for (int frame = 0; frame < DecodeIntoTestDecoder::kFrameCount; frame += 7) {
+			while (decoder.getCurFrame() < frame - 1)
+				decoder.decodeNextFrame();
+
+			TS_ASSERT(decoder.decodeNextFrameInto(dst));
+			TS_ASSERT(!decoder.isDecodingInto(dst));
+
+			for (int y = 0; y < dst.h; y++) {
+				for (int x = 0; x < dst.w; x++) {
+					byte r, g, b;
+					DecodeIntoTestDecoder::getColor(DecodeIntoTestDecoder::getPixel(frame, x, y), r, g, b);
+					TS_ASSERT_EQUALS(dst.getPixel(x, y), dst.format.RGBToColor(r, g, b));
+				}
+			}
+		}
+
+		dst.free();
+#endif
+	}
+
+private:
+	static void checkFrame(const Graphics::Surface *surface, int frame) {
+		TS_ASSERT(surface);
+		if (!surface)
+			return;
+
+		for (int y = 0; y < DecodeIntoTestDecoder::kHeight; y++)
+			for (int x = 0; x < DecodeIntoTestDecoder::kWidth; x++)
+				TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(x, y), DecodeIntoTestDecoder::getPixel(frame, x, y));
+	}
+};
@@ -0,0 +1,168 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "video/frame_cache.h"
+#include "../system/null_osystem.h"
+
+/**
+ * Fills each frame with the first byte of its packet, except for a pixel
+ * in the middle row set to the third byte, and counts them.
+ */
+class FrameCacheTestCodec : public Image::Codec {
+public:
+	FrameCacheTestCodec(int *decoded) : _decoded(decoded) {
+		_surface.create(64, 64, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+	~FrameCacheTestCodec() override { _surface.free(); }
+
+	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override {
+		(*_decoded)++;
+		const byte value = stream.readByte();
+		stream.readByte();
+		const byte marker = stream.readByte();
+		memset(_surface.getPixels(), value, _surface.pitch * _surface.h);
+		memset(_surface.getBasePtr(marker % _surface.w, _surface.h / 2), marker, _surface.format.bytesPerPixel);
+		return &_surface;
+	}
+
+	Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+
+private:
+	Graphics::Surface _surface;
+	int *_decoded;
+};
+
+class FrameCacheTestSuite : public CxxTest::TestSuite {
+public:
+	static const uint kFrameCount = 40;
+
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Common::install_null_g_system();
+		ConfMan.setPath("videocachepath", "test/frame-cache", Common::ConfigManager::kApplicationDomain);
+		ConfMan.setInt("video_frame_cache_size", 2, Common::ConfigManager::kApplicationDomain);
+		Video::FrameCacheManager::instance().configure();
+		Video::FrameCacheManager::instance().clear();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Video::FrameCacheManager::instance().clear();
+		Video::FrameCacheManager::destroy();
+		ConfMan.removeKey("videocachepath", Common::ConfigManager::kApplicationDomain);
+		ConfMan.removeKey("video_frame_cache_size", Common::ConfigManager::kApplicationDomain);
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	/** Frames written during the first playback are read back in the next. */
+	void test_round_trip() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		TS_ASSERT_EQUALS(play("a", 1), (int)kFrameCount);
+		TS_ASSERT_EQUALS(play("a", 1), 0);
+
+		// Also when the video loops
+		TS_ASSERT_EQUALS(play("a", 1, 2 * kFrameCount), 0);
+#endif
+	}
+
+	/**
+	 * The cache file is only used up to the first frame decoded from other
+	 * data, and replaced when the first frame already differs.
+	 */
+	void test_invalidation() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		TS_ASSERT_EQUALS(play("a", 1), (int)kFrameCount);
+
+		TS_ASSERT_EQUALS(play("a", 1, kFrameCount, 30), 10);
+		TS_ASSERT_EQUALS(play("a", 1), 0);
+
+		TS_ASSERT_EQUALS(play("a", 2), (int)kFrameCount);
+		TS_ASSERT_EQUALS(play("a", 2), 0);
+		TS_ASSERT_EQUALS(play("a", 1), (int)kFrameCount);
+#endif
+	}
+
+	/** Frames which hardly change take up little space. */
+	void test_unchanged_rows() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		TS_ASSERT_EQUALS(play("s", 1, kFrameCount, kFrameCount, 0), (int)kFrameCount);
+		TS_ASSERT_EQUALS(play("s", 1, kFrameCount, kFrameCount, 0), 0);
+
+		int64 size = 0, modificationTime = 0;
+		TS_ASSERT(Common::FSNode(Common::Path("test/frame-cache/test-s.vfc")).getFileInfo(size, modificationTime));
+		TS_ASSERT_LESS_THAN(size, 2 * 64 * 64 * 4);
+#endif
+	}
+
+	/**
+	 * Files of 650 KiB each, with a budget of 2 MiB: the least recently
+	 * used one is dropped for the fourth.
+	 */
+	void test_eviction() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		TS_ASSERT_EQUALS(play("a", 1), (int)kFrameCount);
+		TS_ASSERT_EQUALS(play("b", 2), (int)kFrameCount);
+		TS_ASSERT_EQUALS(play("c", 3), (int)kFrameCount);
+
+		TS_ASSERT_EQUALS(play("a", 1), 0);
+		TS_ASSERT_EQUALS(play("d", 4), (int)kFrameCount);
+		TS_ASSERT(!Common::FSNode(Common::Path("test/frame-cache/test-b.vfc")).exists());
+
+		TS_ASSERT_EQUALS(play("a", 1), 0);
+		TS_ASSERT_EQUALS(play("c", 3), 0);
+		TS_ASSERT_EQUALS(play("d", 4), 0);
+		TS_ASSERT_EQUALS(play("b", 2), (int)kFrameCount);
+
+		// A file larger than the whole budget is not even written, and
+		// does not push out the others
+		ConfMan.setInt("video_frame_cache_size", 0, Common::ConfigManager::kApplicationDomain);
+		TS_ASSERT_EQUALS(play("e", 5), (int)kFrameCount);
+		TS_ASSERT(!Common::FSNode(Common::Path("test/frame-cache/test-e.vfc")).exists());
+
+		ConfMan.setInt("video_frame_cache_size", 2, Common::ConfigManager::kApplicationDomain);
+		TS_ASSERT_EQUALS(play("d", 4), 0);
+		TS_ASSERT_EQUALS(play("b", 2), 0);
+#endif
+	}
+
+private:
+	/**
+	 * Play a video through the frame cache, checking every frame.
+	 *
+	 * @param seed        the first frame, the others follow from it
+	 * @param frames      the frames to play, after the last one the video
+	 *                    starts over
+	 * @param changeFrame the first frame with other data than before
+	 * @param step        the difference between a frame and the next
+	 * @return the number of frames the codec decoded
+	 */
+	static int play(const char *name, byte seed, uint frames = kFrameCount, uint changeFrame = kFrameCount, byte step = 3) {
+		// Like the decoders when loading a video
+		Video::FrameCacheManager::instance().configure();
+
+		int decoded = 0;
+		Video::FrameCacheCodec codec(new FrameCacheTestCodec(&decoded), Common::String::format("test-%s.vfc", name), kFrameCount);
+
+		for (uint i = 0; i < frames; i++) {
+			const uint frame = i % kFrameCount;
+			byte packet[3] = { (byte)(seed + frame * step), (byte)(frame >= changeFrame ? 1 : 0), (byte)frame };
+			Common::MemoryReadStream stream(packet, sizeof(packet));
+
+			const Graphics::Surface *surface = codec.decodeFrame(stream);
+			TS_ASSERT(surface);
+			if (!surface)
+				return -1;
+
+			TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(0, 0), packet[0]);
+			TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(surface->w - 1, surface->h - 1), packet[0]);
+			TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(packet[2] % surface->w, surface->h / 2), packet[2]);
+		}
+
+		return decoded;
+	}
+};
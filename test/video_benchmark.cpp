@@ -0,0 +1,286 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Headless video decoding benchmark, built by "make video-benchmark".
+ *
+ * Decodes a video file with the given decoder on the null OSystem, and
+ * reports the time spent decoding each frame, the time spent converting
+ * it to the screen format like VideoDecoder::decodeNextFrameInto() does,
+ * and the peak memory use of the process.
+ *
+ * YUV based decoders convert to the screen format while decoding, so that
+ * time is part of the decoding time. For comparison, the benchmark also
+ * converts 4:2:0 frames of the same size to the screen format itself.
+ */
+
+// The benchmark prints its report and reads the clock itself
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+
+#if defined(POSIX)
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/system.h"
+#include "graphics/blit.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "video/avi_decoder.h"
+#include "video/dxa_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/mpegps_decoder.h"
+#include "video/psx_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#ifdef USE_BINK
+#include "video/bink_decoder.h"
+#endif
+
+#include "test/system/null_osystem.h"
+
+struct BenchmarkDecoderType {
+	const char *name;
+	const char *description;
+	Video::VideoDecoder *(*create)();
+};
+
+static const BenchmarkDecoderType benchmarkDecoderTypes[] = {
+	{ "avi", "AVI (Cinepak, Indeo 3/4/5, MS Video 1, ...)", []() -> Video::VideoDecoder * { return new Video::AVIDecoder(); } },
+#ifdef USE_BINK
+	{ "bink", "Bink", []() -> Video::VideoDecoder * { return new Video::BinkDecoder(); } },
+#endif
+	{ "dxa", "DXA", []() -> Video::VideoDecoder * { return new Video::DXADecoder(); } },
+	{ "flic", "FLIC", []() -> Video::VideoDecoder * { return new Video::FlicDecoder(); } },
+	{ "mpegps", "MPEG program stream", []() -> Video::VideoDecoder * { return new Video::MPEGPSDecoder(); } },
+	{ "psx", "PlayStation STR", []() -> Video::VideoDecoder * { return new Video::PSXStreamDecoder(Video::PSXStreamDecoder::kCD2x); } },
+	{ "qt", "QuickTime (Cinepak, QT RLE, SVQ1, ...)", []() -> Video::VideoDecoder * { return new Video::QuickTimeDecoder(); } },
+	{ "smk", "Smacker", []() -> Video::VideoDecoder * { return new Video::SmackerDecoder(); } }
+};
+
+/** A monotonic clock in microseconds. */
+static uint64 getMicros() {
+#if defined(POSIX)
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return (uint64)g_system->getMillis() * 1000;
+#endif
+}
+
+/** The peak resident memory of the process in KiB, 0 if unknown. */
+static uint32 getPeakMemory() {
+#if defined(POSIX)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(MACOSX)
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return 0;
+#endif
+}
+
+static void printTimes(const char *name, Common::Array<uint32> &times) {
+	if (times.empty()) {
+		printf("%-12s none\n", name);
+		return;
+	}
+
+	uint64 total = 0;
+	for (uint i = 0; i < times.size(); i++)
+		total += times[i];
+
+	Common::sort(times.begin(), times.end());
+	const uint32 p95 = times[(times.size() * 95 - 1) / 100];
+
+	printf("%-12s mean %8.3f ms, p95 %8.3f ms, max %8.3f ms, total %9.1f ms\n", name,
+		total / 1000.0 / times.size(), p95 / 1000.0, times.back() / 1000.0, total / 1000.0);
+}
+
+/** Convert a frame to the screen format, like VideoDecoder::decodeNextFrameInto() does. */
+static bool convertFrame(Graphics::Surface &dst, const Graphics::Surface &frame, const byte *palette) {
+	const uint w = MIN(frame.w, dst.w);
+	const uint h = MIN(frame.h, dst.h);
+
+	if (frame.format == dst.format) {
+		dst.copyRectToSurface(frame, 0, 0, Common::Rect(w, h));
+	} else if (frame.format.isCLUT8()) {
+		uint32 map[256];
+		Graphics::convertPaletteToMap(map, palette, 256, dst.format);
+		Graphics::crossBlitMap((byte *)dst.getPixels(), (const byte *)frame.getPixels(), dst.pitch, frame.pitch, w, h, dst.format.bytesPerPixel, map);
+	} else {
+		return Graphics::crossBlit((byte *)dst.getPixels(), (const byte *)frame.getPixels(), dst.pitch, frame.pitch, w, h, dst.format, frame.format);
+	}
+
+	return true;
+}
+
+static int runBenchmark(const BenchmarkDecoderType &type, const char *fileName, const Graphics::PixelFormat &screenFormat, int maxFrames) {
+	const uint32 startMemory = getPeakMemory();
+
+	Common::FSNode node(Common::Path::fromCommandLine(fileName));
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream) {
+		printf("Cannot open '%s'\n", fileName);
+		return 1;
+	}
+
+	Video::VideoDecoder *decoder = type.create();
+	if (!decoder->loadStream(stream)) {
+		printf("'%s' is not a valid %s video\n", fileName, type.description);
+		delete decoder;
+		return 1;
+	}
+
+	// Like the engines, let YUV based decoders convert to the screen format
+	// themselves
+	decoder->setOutputPixelFormat(screenFormat);
+
+	Graphics::Surface screen;
+	screen.create(decoder->getWidth(), decoder->getHeight(), screenFormat);
+
+	Common::Array<uint32> decodeTimes, convertTimes, yuvTimes;
+	Graphics::PixelFormat frameFormat;
+	bool converted = true;
+
+	// Paletted frames are black until the video sets a palette
+	byte palette[256 * 3];
+	memset(palette, 0, sizeof(palette));
+
+	while (!decoder->endOfVideo() && (maxFrames < 0 || (int)decodeTimes.size() < maxFrames)) {
+		const uint64 decodeStart = getMicros();
+		const Graphics::Surface *frame = decoder->decodeNextFrame();
+		const uint64 decodeEnd = getMicros();
+
+		if (!frame)
+			break;
+
+		decodeTimes.push_back(decodeEnd - decodeStart);
+		frameFormat = frame->format;
+
+		if (decoder->hasDirtyPalette())
+			memcpy(palette, decoder->getPalette(), sizeof(palette));
+
+		if (frame->format != screenFormat) {
+			const uint64 convertStart = getMicros();
+			converted = convertFrame(screen, *frame, palette) && converted;
+			convertTimes.push_back(getMicros() - convertStart);
+		}
+	}
+
+	// As many frames as were decoded, with planes of mid grey
+	const int yuvWidth = screen.w & ~1, yuvHeight = screen.h & ~1;
+	if (yuvWidth > 0 && yuvHeight > 0) {
+		byte *yuv = new byte[yuvWidth * yuvHeight * 3 / 2];
+		memset(yuv, 128, yuvWidth * yuvHeight * 3 / 2);
+		const byte *uPlane = yuv + yuvWidth * yuvHeight;
+		const byte *vPlane = uPlane + yuvWidth * yuvHeight / 4;
+
+		for (uint i = 0; i < decodeTimes.size(); i++) {
+			const uint64 yuvStart = getMicros();
+			YUVToRGBMan.convert420(&screen, Graphics::YUVToRGBManager::kScaleITU, yuv, uPlane, vPlane, yuvWidth, yuvHeight, yuvWidth, yuvWidth / 2);
+			yuvTimes.push_back(getMicros() - yuvStart);
+		}
+
+		delete[] yuv;
+	}
+
+	printf("File:       %s\n", fileName);
+	printf("Decoder:    %s, %dx%d, %u of %u frames\n", type.description, decoder->getWidth(), decoder->getHeight(),
+		decodeTimes.size(), decoder->getFrameCount());
+	printf("Format:     %s frames, %s screen%s\n", frameFormat.toString().c_str(), screenFormat.toString().c_str(),
+		converted ? "" : " (cannot convert)");
+	printTimes("Decoding:", decodeTimes);
+	printTimes("Converting:", convertTimes);
+	printTimes("YUV to RGB:", yuvTimes);
+
+	screen.free();
+	delete decoder;
+
+	const uint32 peakMemory = getPeakMemory();
+	if (peakMemory)
+		printf("Memory:     %u KiB peak, %u KiB peak before loading\n", peakMemory, startMemory);
+	else
+		printf("Memory:     unknown\n");
+
+	return decodeTimes.empty() ? 1 : 0;
+}
+
+static void printUsage(const char *program) {
+	printf("Usage: %s [--frames <count>] [--bpp 16|32] <decoder> <file>\n\n", program);
+	printf("Decoders:\n");
+	for (int i = 0; i < ARRAYSIZE(benchmarkDecoderTypes); i++)
+		printf("  %-8s %s\n", benchmarkDecoderTypes[i].name, benchmarkDecoderTypes[i].description);
+}
+
+int main(int argc, char *argv[]) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+	int maxFrames = -1;
+	Graphics::PixelFormat screenFormat = Graphics::PixelFormat::createFormatRGBA32();
+
+	int arg = 1;
+	for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+		if (!strcmp(argv[arg], "--frames")) {
+			maxFrames = atoi(argv[arg + 1]);
+		} else if (!strcmp(argv[arg], "--bpp") && atoi(argv[arg + 1]) == 16) {
+			screenFormat = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		} else if (strcmp(argv[arg], "--bpp") || atoi(argv[arg + 1]) != 32) {
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	if (argc - arg != 2) {
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	const BenchmarkDecoderType *type = nullptr;
+	for (int i = 0; i < ARRAYSIZE(benchmarkDecoderTypes); i++)
+		if (!scumm_stricmp(argv[arg], benchmarkDecoderTypes[i].name))
+			type = &benchmarkDecoderTypes[i];
+
+	if (!type) {
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	Common::install_null_g_system();
+	const int result = runBenchmark(*type, argv[arg + 1], screenFormat, maxFrames);
+	Common::uninstall_null_g_system();
+
+	return result;
+#else
+	printf("%s needs the null OSystem, which is not available on this platform\n", argv[0]);
+	return 2;
+#endif
+}
@@ -27,6 +27,7 @@
 #include "audio/mixer.h"
 
 #include "video/avi_decoder.h"
+#include "video/frame_cache.h"
 
 // Audio Codecs
 #include "audio/decoders/wave_types.h"
@@ -498,6 +499,9 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 			_audioTracks.push_back(status);
 		} else if (_videoTracks.empty()) {
 			_videoTracks.push_back(status);
+
+			if (getFrameCache())
+				static_cast<AVIVideoTrack *>(*it)->setFrameCache(*_fileStream, index);
 		} else {
 			// Secondary video track. For now we assume it will always be a
 			// transparency information track
@@ -722,58 +726,41 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		frame = videoTrack->getFrameAtTime(time);
 	}
 
-	// Reset any palette, if necessary
-	videoTrack->useInitialPalette();
-
-	int lastKeyFrame = -1;
-	int frameIndex = -1;
-	uint curFrame = 0;
-
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
-
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
+	const IndexEntries::StreamEntries *videoEntries = _indexEntries.getStream(videoIndex);
+	if (!videoEntries || frame >= videoEntries->frames.size()) // This shouldn't happen.
+		return false;
 
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
+	const uint32 frameIndex = videoEntries->frames[frame];
 
-		uint16 streamType = getStreamType(index.id);
+	// Find the last keyframe up to the target frame
+	uint low = 0, high = videoEntries->keyFrames.size();
+	while (low < high) {
+		uint mid = (low + high) / 2;
+		if (videoEntries->keyFrames[mid] <= frame)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	const uint keyFrame = videoEntries->keyFrames[low - 1];
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+	// Reset any palette, if necessary
+	videoTrack->useInitialPalette();
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+	// We need to handle any palette change before the target frame since
+	// there's no flag to tell if this is a "key" palette.
+	for (uint32 i = 0; i < videoEntries->paletteChanges.size() && videoEntries->paletteChanges[i] < frameIndex; i++) {
+		const OldIndex &index = _indexEntries[videoEntries->paletteChanges[i]];
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
+		// Decode the palette
+		_fileStream->seek(index.offset + 8);
+		Common::SeekableReadStream *chunk = 0;
 
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
-			curFrame++;
-		}
+		videoTrack->loadPaletteFromChunk(chunk);
 	}
 
-	if (frameIndex < 0) // This shouldn't happen.
-		return false;
-
 	// Update all the audio tracks
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AVIAudioTrack *audioTrack = (AVIAudioTrack *)_audioTracks[i].track;
@@ -784,51 +771,30 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		const IndexEntries::StreamEntries *audioEntries = _indexEntries.getStream(_audioTracks[i].index);
+		if (audioEntries && frame < audioEntries->chunks.size()) {
+			const uint32 j = audioEntries->chunks[frame];
 			const OldIndex &index = _indexEntries[j];
 
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
 		audioTrack->skipAudio(time, videoTrack->getFrameTime(frame));
 	}
 
-	// Decode from keyFrame to curFrame - 1
-	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
-
-		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
-			continue;
+	// Decode from keyFrame to frame - 1
+	for (uint i = keyFrame; i < frame; i++) {
+		const OldIndex &index = _indexEntries[videoEntries->frames[i]];
 
-		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+		_fileStream->seek(index.offset + 8);
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -931,6 +897,10 @@ void AVIDecoder::readOldIndex(uint32 size) {
 		_indexEntries.push_back(indexEntry);
 		debugC(7, kDebugLevelGVideo, "Index %d: Tag '%s', Offset = %d, Size = %d (Flags = %d)", i, tag2str(indexEntry.id), indexEntry.offset, indexEntry.size, indexEntry.flags);
 	}
+
+	// Look up the chunks of each stream once, so seeking doesn't need to
+	// go through the whole index
+	_indexEntries.buildStreams();
 }
 
 void AVIDecoder::checkTruemotion1() {
@@ -1019,6 +989,13 @@ bool AVIDecoder::AVIVideoTrack::setOutputPixelFormat(const Graphics::PixelFormat
 	return false;
 }
 
+bool AVIDecoder::AVIVideoTrack::setOutputSurface(Graphics::Surface *surface) {
+	if (_videoCodec)
+		return _videoCodec->setOutputSurface(surface);
+
+	return !surface;
+}
+
 void AVIDecoder::AVIVideoTrack::loadPaletteFromChunkRaw(Common::SeekableReadStream *chunk, int firstEntry, int numEntries) {
 	assert(chunk);
 	assert(firstEntry >= 0);
@@ -1085,9 +1062,23 @@ Image::Codec *AVIDecoder::AVIVideoTrack::createCodec() {
 	if (codec != nullptr)
 		codec->setCodecAccuracy(_accuracy);
 
+	if (codec != nullptr && !_frameCacheName.empty())
+		codec = new FrameCacheCodec(codec, _frameCacheName, _frameCount);
+
 	return codec;
 }
 
+void AVIDecoder::AVIVideoTrack::setFrameCache(Common::SeekableReadStream &stream, uint index) {
+	if (_accuracy != Image::CodecAccuracy::Default || !FrameCacheCodec::isWorthCaching(_bmInfo.compression, _bmInfo.width, _bmInfo.height))
+		return;
+
+	_frameCacheName = FrameCacheCodec::getFileName(stream, index);
+	FrameCacheManager::instance().configure();
+
+	delete _videoCodec;
+	_videoCodec = createCodec();
+}
+
 void AVIDecoder::AVIVideoTrack::forceTrackEnd() {
 	_curFrame = _frameCount - 1;
 }
@@ -1247,15 +1238,52 @@ AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+	const StreamEntries *stream = getStream(index);
+	if (!stream || frameNumber >= stream->chunks.size())
+		return nullptr;
+
+	return &(*this)[stream->chunks[frameNumber]];
+}
+
+const AVIDecoder::IndexEntries::StreamEntries *AVIDecoder::IndexEntries::getStream(uint index) const {
+	if (index >= _streams.size())
+		return nullptr;
+
+	return &_streams[index];
+}
+
+void AVIDecoder::IndexEntries::buildStreams() {
+	_streams.clear();
+
+	for (uint32 idx = 0; idx < size(); idx++) {
+		const OldIndex &entry = (*this)[idx];
+
+		// We don't care about RECs
+		if (entry.id == ID_REC)
+			continue;
+
+		uint index = AVIDecoder::getStreamIndex(entry.id);
+		if (index >= _streams.size())
+			_streams.resize(index + 1);
+
+		StreamEntries &stream = _streams[index];
+		stream.chunks.push_back(idx);
+
+		if ((entry.id & 0xFFFF) == kStreamTypePaletteChange) {
+			stream.paletteChanges.push_back(idx);
+		} else {
+			// The first frame has to be a keyframe
+			if ((entry.flags & AVIIF_INDEX) || stream.frames.empty())
+				stream.keyFrames.push_back(stream.frames.size());
+
+			stream.frames.push_back(idx);
 		}
 	}
+}
 
-	return nullptr;
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
 }
 
 } // End of namespace Video
@@ -103,6 +103,7 @@ protected:
 	void readNextPacket() override;
 	bool seekIntern(const Audio::Timestamp &time) override;
 	bool supportsAudioTrackSwitching() const override { return true; }
+	bool supportsDecodeAhead() const override { return !_transparencyTrack.track; }
 	AudioTrack *getAudioTrack(int index) override;
 
 	/**
@@ -214,6 +215,7 @@ protected:
 		uint16 getBitCount() const { return _bmInfo.bitCount; }
 		Graphics::PixelFormat getPixelFormat() const override;
 		bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
+		bool setOutputSurface(Graphics::Surface *surface) override;
 		void setCodecAccuracy(Image::CodecAccuracy accuracy) override;
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
@@ -230,6 +232,13 @@ protected:
 		void setDither(const byte *palette) override;
 		bool isValid() const { return _videoCodec != nullptr; }
 
+		/**
+		 * Keep the decoded frames in a cache file, if the codec is slow.
+		 *
+		 * @see FrameCacheCodec
+		 */
+		void setFrameCache(Common::SeekableReadStream &stream, uint index);
+
 		bool isTruemotion1() const;
 		void forceDimensions(uint16 width, uint16 height);
 
@@ -280,6 +289,7 @@ protected:
 		Image::Codec *_videoCodec;
 		const Graphics::Surface *_lastFrame;
 		Image::CodecAccuracy _accuracy;
+		Common::String _frameCacheName;
 
 		Image::Codec *createCodec();
 	};
@@ -320,7 +330,26 @@ protected:
 
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
+		/** The positions in the index of the entries of one stream. */
+		struct StreamEntries {
+			Common::Array<uint32> chunks;         ///< All chunks of the stream
+			Common::Array<uint32> frames;         ///< The chunks which aren't palette changes
+			Common::Array<uint32> keyFrames;      ///< The numbers of the frames which are key frames
+			Common::Array<uint32> paletteChanges; ///< The palette change chunks
+		};
+
 		OldIndex *find(uint index, uint frameNumber);
+
+		/** Get the entries of a stream, or nullptr if it has none. */
+		const StreamEntries *getStream(uint index) const;
+
+		/** Rebuild the entries of the streams, after adding to the index. */
+		void buildStreams();
+
+		void clear();
+
+	private:
+		Common::Array<StreamEntries> _streams;
 	};
 
 	AVIHeader _header;
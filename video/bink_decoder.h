@@ -47,6 +47,7 @@ namespace Common {
 class SeekableReadStream;
 template <class BITSTREAM>
 class Huffman;
+class ThreadPool;
 }
 
 namespace Math {
@@ -60,6 +61,8 @@ struct Surface;
 
 namespace Video {
 
+struct BinkDSP;
+
 /**
  * Decoder for Bink videos.
  *
@@ -79,6 +82,7 @@ public:
 protected:
 	void readNextPacket() override;
 	bool supportsAudioTrackSwitching() const override { return true; }
+	bool supportsDecodeAhead() const override { return true; }
 	AudioTrack *getAudioTrack(int index) override;
 	bool seekIntern(const Audio::Timestamp &time) override;
 	uint32 findKeyFrame(uint32 frame) const;
@@ -281,6 +285,11 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		const BinkDSP *_dsp; ///< The pixel kernels for the running CPU.
+
+		/** Converts large frames to RGB in slices, nullptr for small frames. */
+		Common::ThreadPool *_threadPool;
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -336,11 +345,6 @@ private:
 		void readDCS         (VideoFrame &video, Bundle &bundle);
 		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
-
-		// Bink video IDCT
-		void IDCT(int32 *block);
-		void IDCTPut(DecodeContext &ctx, int32 *block);
-		void IDCTAdd(DecodeContext &ctx, int32 *block);
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -0,0 +1,183 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "video/bink_dsp.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Video {
+
+/** (c * x) >> 11 of eight values, truncated to 32 bits like the C version. */
+static FORCEINLINE __m256i mulShift(__m256i x, int c) {
+	return _mm256_srai_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(c)), 11);
+}
+
+/**
+ * One pass of the IDCT over all eight columns or rows at once. v[i] holds
+ * the i-th coefficient of each of them. The row pass also rounds the
+ * results down to pixels.
+ */
+template<bool rowPass>
+static FORCEINLINE void transform(__m256i *v) {
+	const __m256i a0 = _mm256_add_epi32(v[0], v[4]);
+	const __m256i a1 = _mm256_sub_epi32(v[0], v[4]);
+	const __m256i a2 = _mm256_add_epi32(v[2], v[6]);
+	const __m256i a3 = mulShift(_mm256_sub_epi32(v[2], v[6]), 2896);
+	const __m256i a4 = _mm256_add_epi32(v[5], v[3]);
+	const __m256i a5 = _mm256_sub_epi32(v[5], v[3]);
+	const __m256i a6 = _mm256_add_epi32(v[1], v[7]);
+	const __m256i a7 = _mm256_sub_epi32(v[1], v[7]);
+	const __m256i b0 = _mm256_add_epi32(a4, a6);
+	const __m256i b1 = mulShift(_mm256_add_epi32(a5, a7), 3784);
+	const __m256i b2 = _mm256_add_epi32(_mm256_sub_epi32(mulShift(a5, -5352), b0), b1);
+	const __m256i b3 = _mm256_sub_epi32(mulShift(_mm256_sub_epi32(a6, a4), 2896), b2);
+	const __m256i b4 = _mm256_sub_epi32(_mm256_add_epi32(mulShift(a7, 2217), b3), b1);
+
+	const __m256i c0 = _mm256_add_epi32(a0, a2);
+	const __m256i c1 = _mm256_sub_epi32(_mm256_add_epi32(a1, a3), a2);
+	const __m256i c2 = _mm256_add_epi32(_mm256_sub_epi32(a1, a3), a2);
+	const __m256i c3 = _mm256_sub_epi32(a0, a2);
+
+	v[0] = _mm256_add_epi32(c0, b0);
+	v[1] = _mm256_add_epi32(c1, b2);
+	v[2] = _mm256_add_epi32(c2, b3);
+	v[3] = _mm256_sub_epi32(c3, b4);
+	v[4] = _mm256_add_epi32(c3, b4);
+	v[5] = _mm256_sub_epi32(c2, b3);
+	v[6] = _mm256_sub_epi32(c1, b2);
+	v[7] = _mm256_sub_epi32(c0, b0);
+
+	if (rowPass) {
+		const __m256i round = _mm256_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm256_srai_epi32(_mm256_add_epi32(v[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose8(__m256i *v) {
+	const __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+	const __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+	const __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+	const __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+	const __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]);
+	const __m256i t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+	const __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]);
+	const __m256i t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+
+	const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+	v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+	v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+	v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+	v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+	v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+	v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+	v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+	v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/** Inverse DCT of a block into its eight rows v[]. */
+static FORCEINLINE void transformBlock(const int32 *block, __m256i *v) {
+	for (int i = 0; i < 8; i++)
+		v[i] = _mm256_loadu_si256((const __m256i *)(block + i * 8));
+
+	// Unlike the C version, columns without AC coefficients take no
+	// shortcut, the full transform produces the same values for them
+	transform<false>(v);
+	transpose8(v);
+	transform<true>(v);
+	transpose8(v);
+}
+
+/** The low bytes of the eight values of a row. */
+static FORCEINLINE __m128i packRow(__m256i row) {
+	row = _mm256_and_si256(row, _mm256_set1_epi32(0xFF));
+	const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(row), _mm256_extracti128_si256(row, 1));
+	return _mm_packus_epi16(words, words);
+}
+
+static void IDCTAVX2(int32 *block) {
+	__m256i v[8];
+	transformBlock(block, v);
+
+	for (int i = 0; i < 8; i++)
+		_mm256_storeu_si256((__m256i *)(block + i * 8), v[i]);
+}
+
+static void IDCTPutAVX2(byte *dest, int pitch, int32 *block) {
+	__m256i v[8];
+	transformBlock(block, v);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		_mm_storel_epi64((__m128i *)dest, packRow(v[i]));
+}
+
+static void IDCTAddAVX2(byte *dest, int pitch, int32 *block) {
+	__m256i v[8];
+	transformBlock(block, v);
+
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, packRow(v[i])));
+	}
+}
+
+static void addResidueAVX2(byte *dest, int pitch, const int16 *block) {
+	const __m128i mask = _mm_set1_epi16(0xFF);
+
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const __m128i residue = _mm_and_si128(_mm_loadu_si128((const __m128i *)block), mask);
+		const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, _mm_packus_epi16(residue, residue)));
+	}
+}
+
+/** The kernels of binkDSPGeneric using AVX2. */
+const BinkDSP binkDSPAVX2 = {
+	IDCTAVX2,
+	IDCTPutAVX2,
+	IDCTAddAVX2,
+	addResidueAVX2
+};
+
+} // End of namespace Video
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
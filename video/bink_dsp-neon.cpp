@@ -0,0 +1,192 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "video/bink_dsp.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Video {
+
+/** (c * x) >> 11 of four values, truncated to 32 bits like the C version. */
+static FORCEINLINE int32x4_t mulShift(int32x4_t x, int32_t c) {
+	return vshrq_n_s32(vmulq_n_s32(x, c), 11);
+}
+
+/**
+ * One pass of the IDCT over four columns or rows at once. v[i] holds the
+ * i-th coefficient of each of them. The row pass also rounds the results
+ * down to pixels.
+ */
+template<bool rowPass>
+static FORCEINLINE void transform(int32x4_t *v) {
+	const int32x4_t a0 = vaddq_s32(v[0], v[4]);
+	const int32x4_t a1 = vsubq_s32(v[0], v[4]);
+	const int32x4_t a2 = vaddq_s32(v[2], v[6]);
+	const int32x4_t a3 = mulShift(vsubq_s32(v[2], v[6]), 2896);
+	const int32x4_t a4 = vaddq_s32(v[5], v[3]);
+	const int32x4_t a5 = vsubq_s32(v[5], v[3]);
+	const int32x4_t a6 = vaddq_s32(v[1], v[7]);
+	const int32x4_t a7 = vsubq_s32(v[1], v[7]);
+	const int32x4_t b0 = vaddq_s32(a4, a6);
+	const int32x4_t b1 = mulShift(vaddq_s32(a5, a7), 3784);
+	const int32x4_t b2 = vaddq_s32(vsubq_s32(mulShift(a5, -5352), b0), b1);
+	const int32x4_t b3 = vsubq_s32(mulShift(vsubq_s32(a6, a4), 2896), b2);
+	const int32x4_t b4 = vsubq_s32(vaddq_s32(mulShift(a7, 2217), b3), b1);
+
+	const int32x4_t c0 = vaddq_s32(a0, a2);
+	const int32x4_t c1 = vsubq_s32(vaddq_s32(a1, a3), a2);
+	const int32x4_t c2 = vaddq_s32(vsubq_s32(a1, a3), a2);
+	const int32x4_t c3 = vsubq_s32(a0, a2);
+
+	v[0] = vaddq_s32(c0, b0);
+	v[1] = vaddq_s32(c1, b2);
+	v[2] = vaddq_s32(c2, b3);
+	v[3] = vsubq_s32(c3, b4);
+	v[4] = vaddq_s32(c3, b4);
+	v[5] = vsubq_s32(c2, b3);
+	v[6] = vsubq_s32(c1, b2);
+	v[7] = vsubq_s32(c0, b0);
+
+	if (rowPass) {
+		const int32x4_t round = vdupq_n_s32(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = vshrq_n_s32(vaddq_s32(v[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose4(int32x4_t &a, int32x4_t &b, int32x4_t &c, int32x4_t &d) {
+	const int32x4x2_t ab = vtrnq_s32(a, b);
+	const int32x4x2_t cd = vtrnq_s32(c, d);
+	a = vcombine_s32(vget_low_s32(ab.val[0]), vget_low_s32(cd.val[0]));
+	b = vcombine_s32(vget_low_s32(ab.val[1]), vget_low_s32(cd.val[1]));
+	c = vcombine_s32(vget_high_s32(ab.val[0]), vget_high_s32(cd.val[0]));
+	d = vcombine_s32(vget_high_s32(ab.val[1]), vget_high_s32(cd.val[1]));
+}
+
+/**
+ * Transpose the 8x8 block held as left halves lo[] and right halves hi[]
+ * of its rows.
+ */
+static FORCEINLINE void transpose8(int32x4_t *lo, int32x4_t *hi) {
+	transpose4(lo[0], lo[1], lo[2], lo[3]);
+	transpose4(lo[4], lo[5], lo[6], lo[7]);
+	transpose4(hi[0], hi[1], hi[2], hi[3]);
+	transpose4(hi[4], hi[5], hi[6], hi[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const int32x4_t t = lo[i + 4];
+		lo[i + 4] = hi[i];
+		hi[i] = t;
+	}
+}
+
+/** Inverse DCT of a block into left halves lo[] and right halves hi[] of the rows. */
+static FORCEINLINE void transformBlock(const int32 *block, int32x4_t *lo, int32x4_t *hi) {
+	for (int i = 0; i < 8; i++) {
+		lo[i] = vld1q_s32(block + i * 8);
+		hi[i] = vld1q_s32(block + i * 8 + 4);
+	}
+
+	// Unlike the C version, columns without AC coefficients take no
+	// shortcut, the full transform produces the same values for them
+	transform<false>(lo);
+	transform<false>(hi);
+	transpose8(lo, hi);
+	transform<true>(lo);
+	transform<true>(hi);
+	transpose8(lo, hi);
+}
+
+/** The low bytes of the eight values of a row. */
+static FORCEINLINE uint8x8_t packRow(int32x4_t lo, int32x4_t hi) {
+	const int16x8_t words = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+	return vmovn_u16(vreinterpretq_u16_s16(words));
+}
+
+static void IDCTNEON(int32 *block) {
+	int32x4_t lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++) {
+		vst1q_s32(block + i * 8, lo[i]);
+		vst1q_s32(block + i * 8 + 4, hi[i]);
+	}
+}
+
+static void IDCTPutNEON(byte *dest, int pitch, int32 *block) {
+	int32x4_t lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, packRow(lo[i], hi[i]));
+}
+
+static void IDCTAddNEON(byte *dest, int pitch, int32 *block) {
+	int32x4_t lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), packRow(lo[i], hi[i])));
+}
+
+static void addResidueNEON(byte *dest, int pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const uint8x8_t residue = vmovn_u16(vreinterpretq_u16_s16(vld1q_s16(block)));
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), residue));
+	}
+}
+
+/** The kernels of binkDSPGeneric using NEON. */
+const BinkDSP binkDSPNEON = {
+	IDCTNEON,
+	IDCTPutNEON,
+	IDCTAddNEON,
+	addResidueNEON
+};
+
+} // End of namespace Video
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,200 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "video/bink_dsp.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Video {
+
+/** (c * x) >> 11 of four values, truncated to 32 bits like the C version. */
+static FORCEINLINE __m128i mulShift(__m128i x, int c) {
+	const __m128i factor = _mm_set1_epi32(c);
+	const __m128i even = _mm_mul_epu32(x, factor);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), factor);
+	const __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	return _mm_srai_epi32(product, 11);
+}
+
+/**
+ * One pass of the IDCT over four columns or rows at once. v[i] holds the
+ * i-th coefficient of each of them. The row pass also rounds the results
+ * down to pixels.
+ */
+template<bool rowPass>
+static FORCEINLINE void transform(__m128i *v) {
+	const __m128i a0 = _mm_add_epi32(v[0], v[4]);
+	const __m128i a1 = _mm_sub_epi32(v[0], v[4]);
+	const __m128i a2 = _mm_add_epi32(v[2], v[6]);
+	const __m128i a3 = mulShift(_mm_sub_epi32(v[2], v[6]), 2896);
+	const __m128i a4 = _mm_add_epi32(v[5], v[3]);
+	const __m128i a5 = _mm_sub_epi32(v[5], v[3]);
+	const __m128i a6 = _mm_add_epi32(v[1], v[7]);
+	const __m128i a7 = _mm_sub_epi32(v[1], v[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = mulShift(_mm_add_epi32(a5, a7), 3784);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(mulShift(a5, -5352), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(mulShift(_mm_sub_epi32(a6, a4), 2896), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(mulShift(a7, 2217), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	v[0] = _mm_add_epi32(c0, b0);
+	v[1] = _mm_add_epi32(c1, b2);
+	v[2] = _mm_add_epi32(c2, b3);
+	v[3] = _mm_sub_epi32(c3, b4);
+	v[4] = _mm_add_epi32(c3, b4);
+	v[5] = _mm_sub_epi32(c2, b3);
+	v[6] = _mm_sub_epi32(c1, b2);
+	v[7] = _mm_sub_epi32(c0, b0);
+
+	if (rowPass) {
+		const __m128i round = _mm_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			v[i] = _mm_srai_epi32(_mm_add_epi32(v[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose4(__m128i &a, __m128i &b, __m128i &c, __m128i &d) {
+	const __m128i t0 = _mm_unpacklo_epi32(a, b);
+	const __m128i t1 = _mm_unpacklo_epi32(c, d);
+	const __m128i t2 = _mm_unpackhi_epi32(a, b);
+	const __m128i t3 = _mm_unpackhi_epi32(c, d);
+	a = _mm_unpacklo_epi64(t0, t1);
+	b = _mm_unpackhi_epi64(t0, t1);
+	c = _mm_unpacklo_epi64(t2, t3);
+	d = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Transpose the 8x8 block held as left halves lo[] and right halves hi[]
+ * of its rows.
+ */
+static FORCEINLINE void transpose8(__m128i *lo, __m128i *hi) {
+	transpose4(lo[0], lo[1], lo[2], lo[3]);
+	transpose4(lo[4], lo[5], lo[6], lo[7]);
+	transpose4(hi[0], hi[1], hi[2], hi[3]);
+	transpose4(hi[4], hi[5], hi[6], hi[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = lo[i + 4];
+		lo[i + 4] = hi[i];
+		hi[i] = t;
+	}
+}
+
+/** Inverse DCT of a block into left halves lo[] and right halves hi[] of the rows. */
+static FORCEINLINE void transformBlock(const int32 *block, __m128i *lo, __m128i *hi) {
+	for (int i = 0; i < 8; i++) {
+		lo[i] = _mm_loadu_si128((const __m128i *)(block + i * 8));
+		hi[i] = _mm_loadu_si128((const __m128i *)(block + i * 8 + 4));
+	}
+
+	// Unlike the C version, columns without AC coefficients take no
+	// shortcut, the full transform produces the same values for them
+	transform<false>(lo);
+	transform<false>(hi);
+	transpose8(lo, hi);
+	transform<true>(lo);
+	transform<true>(hi);
+	transpose8(lo, hi);
+}
+
+/** The low bytes of the eight values of a row. */
+static FORCEINLINE __m128i packRow(__m128i lo, __m128i hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	const __m128i words = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+	return _mm_packus_epi16(words, words);
+}
+
+static void IDCTSSE2(int32 *block) {
+	__m128i lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++) {
+		_mm_storeu_si128((__m128i *)(block + i * 8), lo[i]);
+		_mm_storeu_si128((__m128i *)(block + i * 8 + 4), hi[i]);
+	}
+}
+
+static void IDCTPutSSE2(byte *dest, int pitch, int32 *block) {
+	__m128i lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		_mm_storel_epi64((__m128i *)dest, packRow(lo[i], hi[i]));
+}
+
+static void IDCTAddSSE2(byte *dest, int pitch, int32 *block) {
+	__m128i lo[8], hi[8];
+	transformBlock(block, lo, hi);
+
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, packRow(lo[i], hi[i])));
+	}
+}
+
+static void addResidueSSE2(byte *dest, int pitch, const int16 *block) {
+	const __m128i mask = _mm_set1_epi16(0xFF);
+
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const __m128i residue = _mm_and_si128(_mm_loadu_si128((const __m128i *)block), mask);
+		const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+		_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, _mm_packus_epi16(residue, residue)));
+	}
+}
+
+/** The kernels of binkDSPGeneric using SSE2. */
+const BinkDSP binkDSPSSE2 = {
+	IDCTSSE2,
+	IDCTPutSSE2,
+	IDCTAddSSE2,
+	addResidueSSE2
+};
+
+} // End of namespace Video
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
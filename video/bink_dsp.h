@@ -0,0 +1,64 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * The pixel kernels of the Bink video decoder, working on 8x8 blocks of a
+ * plane. All versions produce exactly the same pixels. Like the reference
+ * decoder, the results are not clipped but wrap around.
+ */
+struct BinkDSP {
+	/** Inverse DCT of a block of coefficients, in place. */
+	void (*idct)(int32 *block);
+
+	/** Inverse DCT of a block of coefficients, stored as pixels. The coefficients are clobbered. */
+	void (*idctPut)(byte *dest, int pitch, int32 *block);
+
+	/** Inverse DCT of a block of coefficients, added to the pixels. The coefficients are clobbered. */
+	void (*idctAdd)(byte *dest, int pitch, int32 *block);
+
+	/** Add a block of residues to the pixels. */
+	void (*addResidue)(byte *dest, int pitch, const int16 *block);
+};
+
+extern const BinkDSP binkDSPGeneric;
+#ifdef SCUMMVM_NEON
+extern const BinkDSP binkDSPNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+extern const BinkDSP binkDSPSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+extern const BinkDSP binkDSPAVX2;
+#endif
+
+/** Return the fastest kernels the CPU supports. */
+const BinkDSP *getBinkDSP();
+
+} // End of namespace Video
+
+#endif
@@ -107,6 +107,7 @@ DXADecoder::DXAVideoTrack::DXAVideoTrack(Common::SeekableReadStream *stream) : _
 
 	_surface = new Graphics::Surface();
 	_surface->format = Graphics::PixelFormat::createFormatCLUT8();
+	_useOutputSurface = false;
 
 	debugC(2, kDebugLevelGVideo, "flags 0x0%x framesCount %d width %d height %d rate %d", flags, getFrameCount(), getWidth(), getHeight(), getFrameRate().toInt());
 
@@ -522,36 +523,62 @@ const Graphics::Surface *DXADecoder::DXAVideoTrack::decodeNextFrame() {
 		}
 	}
 
+	// The frame buffers keep the reference for the next frame, so a
+	// surface of the caller only takes the place of the scaled buffer
+	byte *dst = _scaledBuffer;
+	uint dstPitch = _width;
+	if (_useOutputSurface) {
+		dst = (byte *)_outputSurface.getPixels();
+		dstPitch = _outputSurface.pitch;
+	}
+
 	switch (_scaleMode) {
 	case S_INTERLACED:
 		for (int cy = 0; cy < _curHeight; cy++) {
-			memcpy(&_scaledBuffer[2 * cy * _width], &_frameBuffer1[cy * _width], _width);
-			memset(&_scaledBuffer[((2 * cy) + 1) * _width], 0, _width);
+			memcpy(&dst[2 * cy * dstPitch], &_frameBuffer1[cy * _width], _width);
+			memset(&dst[((2 * cy) + 1) * dstPitch], 0, _width);
 		}
-		_surface->setPixels(_scaledBuffer);
 		break;
 	case S_DOUBLE:
 		for (int cy = 0; cy < _curHeight; cy++) {
-			memcpy(&_scaledBuffer[2 * cy * _width], &_frameBuffer1[cy * _width], _width);
-			memcpy(&_scaledBuffer[((2 * cy) + 1) * _width], &_frameBuffer1[cy * _width], _width);
+			memcpy(&dst[2 * cy * dstPitch], &_frameBuffer1[cy * _width], _width);
+			memcpy(&dst[((2 * cy) + 1) * dstPitch], &_frameBuffer1[cy * _width], _width);
 		}
-		_surface->setPixels(_scaledBuffer);
 		break;
 	case S_NONE:
-		_surface->setPixels(_frameBuffer1);
+		if (_useOutputSurface) {
+			for (int cy = 0; cy < _curHeight; cy++)
+				memcpy(&dst[cy * dstPitch], &_frameBuffer1[cy * _width], _width);
+		} else {
+			dst = _frameBuffer1;
+		}
 		break;
 	default:
 		break;
 	}
 
+	_curFrame++;
+
+	if (_useOutputSurface)
+		return &_outputSurface;
+
 	// Copy in the relevant info to the Surface
+	_surface->setPixels(dst);
 	_surface->w = getWidth();
 	_surface->h = getHeight();
 	_surface->pitch = getWidth();
 
-	_curFrame++;
-
 	return _surface;
 }
 
+bool DXADecoder::DXAVideoTrack::setOutputSurface(Graphics::Surface *surface) {
+	_useOutputSurface = surface != nullptr;
+	if (surface) {
+		assert(surface->w >= getWidth() && surface->h >= getHeight() && surface->format == getPixelFormat());
+		_outputSurface = surface->getSubArea(Common::Rect(getWidth(), getHeight()));
+	}
+
+	return true;
+}
+
 } // End of namespace Video
@@ -25,6 +25,7 @@
 #include "common/rational.h"
 #include "graphics/palette.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 #include "video/video_decoder.h"
 
 namespace Common {
@@ -66,6 +67,7 @@ private:
 		uint16 getWidth() const override { return _width; }
 		uint16 getHeight() const override { return _height; }
 		Graphics::PixelFormat getPixelFormat() const override;
+		bool setOutputSurface(Graphics::Surface *surface) override;
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
 		const Graphics::Surface *decodeNextFrame() override;
@@ -90,6 +92,8 @@ private:
 
 		Common::SeekableReadStream *_fileStream;
 		Graphics::Surface *_surface;
+		Graphics::Surface _outputSurface;
+		bool _useOutputSurface;
 
 		byte *_frameBuffer1;
 		byte *_frameBuffer2;
@@ -0,0 +1,581 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/mutex.h"
+#include "common/stream.h"
+
+#include "video/frame_cache.h"
+
+namespace Common {
+DECLARE_SINGLETON(Video::FrameCacheManager);
+}
+
+namespace Video {
+
+// The index lists the files in the cache, the least recently used first,
+// with a line of "<name> <size>" for each
+static const char *const kFrameCacheIndexName = "index";
+
+static const int kFrameCacheDefaultBudget = 1024;
+
+FrameCacheManager::FrameCacheManager() {
+	_mutex = new Common::Mutex();
+	_budget = 0;
+}
+
+FrameCacheManager::~FrameCacheManager() {
+	delete _mutex;
+}
+
+void FrameCacheManager::configure() {
+	int budget = kFrameCacheDefaultBudget;
+	if (ConfMan.hasKey("video_frame_cache_size"))
+		budget = MAX(ConfMan.getInt("video_frame_cache_size"), 0);
+
+	const Common::Path path = ConfMan.getPath("videocachepath");
+
+	Common::StackLock lock(*_mutex);
+	_configPath = path;
+	_budget = (uint64)budget * 1024 * 1024;
+}
+
+bool FrameCacheManager::isAvailable() {
+	Common::StackLock lock(*_mutex);
+	return loadIndex();
+}
+
+Common::SeekableReadStream *FrameCacheManager::openForReading(const Common::String &name) {
+	Common::StackLock lock(*_mutex);
+	if (!loadIndex())
+		return nullptr;
+
+	const int index = findEntry(name);
+	if (index < 0)
+		return nullptr;
+
+	Common::SeekableReadStream *stream = _dir.getChild(name).createReadStream();
+	if (!stream) {
+		_entries.remove_at(index);
+		saveIndex();
+		return nullptr;
+	}
+
+	const Entry entry = _entries[index];
+	_entries.remove_at(index);
+	_entries.push_back(entry);
+	saveIndex();
+
+	return stream;
+}
+
+bool FrameCacheManager::fitsBudget(uint64 size) {
+	Common::StackLock lock(*_mutex);
+	return size <= _budget;
+}
+
+Common::SeekableWriteStream *FrameCacheManager::openForWriting(const Common::String &name) {
+	Common::StackLock lock(*_mutex);
+	if (!loadIndex())
+		return nullptr;
+
+	// An older version of the file is no longer valid
+	const int index = findEntry(name);
+	if (index >= 0) {
+		_entries.remove_at(index);
+		saveIndex();
+	}
+
+	return _dir.getChild(name).createWriteStream(false);
+}
+
+bool FrameCacheManager::addFile(const Common::String &name, uint64 size) {
+	Common::StackLock lock(*_mutex);
+	if (!loadIndex())
+		return false;
+
+	const int index = findEntry(name);
+	if (index >= 0)
+		_entries.remove_at(index);
+
+	bool added = size <= _budget;
+
+	if (added) {
+		Entry entry;
+		entry.name = name;
+		entry.size = size;
+		_entries.push_back(entry);
+	} else {
+		deleteFile(name);
+	}
+
+	uint64 totalSize = 0;
+	for (uint i = 0; i < _entries.size(); i++)
+		totalSize += _entries[i].size;
+
+	while (totalSize > _budget) {
+		debugC(1, kDebugLevelGVideo, "Dropping %s from the frame cache", _entries[0].name.c_str());
+		totalSize -= _entries[0].size;
+		deleteFile(_entries[0].name);
+		_entries.remove_at(0);
+	}
+
+	saveIndex();
+	return added;
+}
+
+void FrameCacheManager::removeFile(const Common::String &name) {
+	Common::StackLock lock(*_mutex);
+	if (!loadIndex())
+		return;
+
+	const int index = findEntry(name);
+	if (index >= 0) {
+		_entries.remove_at(index);
+		saveIndex();
+	}
+
+	deleteFile(name);
+}
+
+void FrameCacheManager::clear() {
+	Common::StackLock lock(*_mutex);
+	if (!loadIndex())
+		return;
+
+	for (uint i = 0; i < _entries.size(); i++)
+		deleteFile(_entries[i].name);
+
+	_entries.clear();
+	saveIndex();
+}
+
+bool FrameCacheManager::loadIndex() {
+	if (_configPath.empty())
+		return false;
+
+	if (_configPath == _dirPath)
+		return true;
+
+	_dirPath.clear();
+	_entries.clear();
+	_dir = Common::FSNode(_configPath);
+
+	if (!_dir.exists() && !_dir.createDirectory())
+		return false;
+	if (!_dir.isDirectory())
+		return false;
+
+	_dirPath = _configPath;
+
+	Common::SeekableReadStream *stream = _dir.getChild(kFrameCacheIndexName).createReadStream();
+	if (!stream)
+		return true;
+
+	while (!stream->eos() && !stream->err()) {
+		const Common::String line = stream->readLine();
+		const size_t separator = line.findLastOf(' ');
+		if (separator == Common::String::npos)
+			continue;
+
+		Entry entry;
+		entry.name = line.substr(0, separator);
+		entry.size = line.substr(separator + 1).asUint64();
+		_entries.push_back(entry);
+	}
+
+	delete stream;
+	return true;
+}
+
+void FrameCacheManager::saveIndex() {
+	Common::SeekableWriteStream *stream = _dir.getChild(kFrameCacheIndexName).createWriteStream();
+	if (!stream)
+		return;
+
+	for (uint i = 0; i < _entries.size(); i++)
+		stream->writeString(Common::String::format("%s %llu\n", _entries[i].name.c_str(), (unsigned long long)_entries[i].size));
+
+	stream->finalize();
+	delete stream;
+}
+
+int FrameCacheManager::findEntry(const Common::String &name) const {
+	for (uint i = 0; i < _entries.size(); i++)
+		if (_entries[i].name == name)
+			return i;
+
+	return -1;
+}
+
+void FrameCacheManager::deleteFile(const Common::String &name) {
+	Common::FSNode node = _dir.getChild(name);
+	if (!node.exists() || node.removeFile())
+		return;
+
+	// At least free the space the file took up
+	Common::SeekableWriteStream *stream = node.createWriteStream(false);
+	if (stream) {
+		stream->finalize();
+		delete stream;
+	}
+}
+
+// The file starts with a header:
+//   'VFRC', version, frame count, width, height, pixel format
+// followed by an entry for every frame:
+//   checksum of the frame data, and for every row:
+//   the first pixel which differs from the previous frame, the number of
+//   pixels up to the last one which differs, those pixels
+// and ends with 'VFRC' again. The first frame is stored in full.
+// A file which was not written to the end is recognized by the missing tag.
+
+static const uint32 kFrameCacheTag = MKTAG('V', 'F', 'R', 'C');
+static const uint32 kFrameCacheVersion = 2;
+static const uint32 kFrameCacheHeaderSize = 4 + 4 + 4 + 2 + 2 + 9;
+
+// The part of the video file the name of the cache file is computed from
+static const uint32 kFrameCacheKeySize = 1024 * 1024;
+
+FrameCacheCodec::FrameCacheCodec(Image::Codec *codec, const Common::String &fileName, uint frameCount) :
+		_codec(codec), _fileName(fileName), _frameCount(frameCount), _state(kStateNew), _curFrame(0), _firstChecksum(0),
+		_inFile(nullptr), _outFile(nullptr), _packetBuffer(nullptr), _packetBufferSize(0) {
+	assert(_codec);
+
+	if (!FrameCacheManager::instance().isAvailable())
+		_state = kStateDecoding;
+}
+
+FrameCacheCodec::~FrameCacheCodec() {
+	stopReading();
+	stopWriting(false);
+
+	_surface.free();
+	free(_packetBuffer);
+	delete _codec;
+}
+
+bool FrameCacheCodec::isWorthCaching(uint32 tag, int width, int height) {
+	switch (tag) {
+	case MKTAG('I', 'V', '3', '2'):
+	case MKTAG('i', 'v', '3', '2'):
+	case MKTAG('I', 'V', '4', '1'):
+	case MKTAG('I', 'V', '4', '2'):
+	case MKTAG('I', 'V', '5', '0'):
+	case MKTAG('S', 'V', 'Q', '1'):
+	case MKTAG('M', 'P', '4', '3'):
+	case MKTAG('m', 'p', '4', '3'):
+	case MKTAG('D', 'I', 'V', '3'):
+	case MKTAG('d', 'i', 'v', '3'):
+		return true;
+	case MKTAG('c', 'v', 'i', 'd'):
+		// Small Cinepak videos decode about as fast as they are read
+		return width * height >= 320 * 240;
+	default:
+		return false;
+	}
+}
+
+Common::String FrameCacheCodec::getFileName(Common::SeekableReadStream &stream, uint track) {
+	const int64 pos = stream.pos();
+	stream.seek(0);
+	const Common::String md5 = Common::computeStreamMD5AsString(stream, kFrameCacheKeySize);
+	stream.seek(pos);
+
+	return Common::String::format("video-%s-%u-%u.vfc", md5.c_str(), (uint)stream.size(), track);
+}
+
+bool FrameCacheCodec::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	// The cache file is only valid for the format it was written in, which
+	// is checked when opening it
+	if (_state != kStateNew && _state != kStateDecoding)
+		return format == getPixelFormat();
+
+	return _codec->setOutputPixelFormat(format);
+}
+
+void FrameCacheCodec::setDither(DitherType type, const byte *palette) {
+	// The dithered frames would depend on the palette
+	stopReading();
+	stopWriting(false);
+	_state = kStateDecoding;
+
+	_codec->setDither(type, palette);
+}
+
+void FrameCacheCodec::setCodecAccuracy(Image::CodecAccuracy accuracy) {
+	// Frames from a more or less accurate decoder would not be the same
+	if (accuracy != Image::CodecAccuracy::Default) {
+		stopReading();
+		stopWriting(false);
+		_state = kStateDecoding;
+	}
+
+	_codec->setCodecAccuracy(accuracy);
+}
+
+const Graphics::Surface *FrameCacheCodec::decodeFrame(Common::SeekableReadStream &stream) {
+	if (_state == kStateDecoding)
+		return _codec->decodeFrame(stream);
+
+	const uint32 checksum = computeChecksum(stream);
+
+	if (_state == kStateNew) {
+		_firstChecksum = checksum;
+		if (startReading())
+			_state = kStateReading;
+	} else if (_state == kStateReading && _curFrame != 0 && checksum == _firstChecksum) {
+		// The video started over, such as when looping
+		stopReading();
+		_state = startReading() ? kStateReading : kStateDecoding;
+	}
+
+	if (_state == kStateReading) {
+		if (readFrame(checksum)) {
+			_curFrame++;
+			return &_surface;
+		}
+
+		stopReading();
+
+		if (_curFrame == 0) {
+			// The file is from another video, so write it again
+			debugC(1, kDebugLevelGVideo, "%s is not for this video", _fileName.c_str());
+			FrameCacheManager::instance().removeFile(_fileName);
+			_state = kStateNew;
+		} else {
+			// The codec has not decoded the frames before this one, so they
+			// may look wrong until the next key frame
+			debugC(1, kDebugLevelGVideo, "Frame %u of %s differs, decoding from here", _curFrame, _fileName.c_str());
+			_state = kStateDecoding;
+		}
+	}
+
+	const Graphics::Surface *frame = _codec->decodeFrame(stream);
+
+	if (_state == kStateNew) {
+		if (frame && !_codec->containsPalette())
+			startWriting(*frame);
+		else
+			_state = kStateDecoding;
+	}
+
+	if (_state == kStateWriting)
+		writeFrame(checksum, frame);
+
+	_curFrame++;
+	return frame;
+}
+
+bool FrameCacheCodec::startReading() {
+	Common::SeekableReadStream *file = FrameCacheManager::instance().openForReading(_fileName);
+	if (!file)
+		return false;
+
+	bool valid = file->readUint32BE() == kFrameCacheTag && file->readUint32BE() == kFrameCacheVersion &&
+		file->readUint32BE() == _frameCount;
+
+	const uint16 width = file->readUint16BE();
+	const uint16 height = file->readUint16BE();
+
+	Graphics::PixelFormat format;
+	format.bytesPerPixel = file->readByte();
+	format.rLoss = file->readByte();
+	format.gLoss = file->readByte();
+	format.bLoss = file->readByte();
+	format.aLoss = file->readByte();
+	format.rShift = file->readByte();
+	format.gShift = file->readByte();
+	format.bShift = file->readByte();
+	format.aShift = file->readByte();
+
+	valid = valid && !file->err() && format == _codec->getPixelFormat() && width && height &&
+		file->size() >= kFrameCacheHeaderSize + 4;
+
+	// A file which was not written to the end misses the tag at the end
+	if (valid) {
+		file->seek(-4, SEEK_END);
+		valid = file->readUint32BE() == kFrameCacheTag && file->seek(kFrameCacheHeaderSize);
+	}
+
+	if (!valid) {
+		delete file;
+		return false;
+	}
+
+	if (!_surface.getPixels() || _surface.w != width || _surface.h != height || _surface.format != format) {
+		_surface.free();
+		_surface.create(width, height, format);
+	}
+
+	_inFile = file;
+	_curFrame = 0;
+	return true;
+}
+
+void FrameCacheCodec::startWriting(const Graphics::Surface &frame) {
+	// Don't spend the time writing a file which would be dropped right away,
+	// even if all rows of all frames differ
+	const uint64 frameSize = 4 + (uint64)frame.h * (4 + frame.w * frame.format.bytesPerPixel);
+	const uint64 fileSize = kFrameCacheHeaderSize + frameSize * _frameCount + 4;
+	if (!FrameCacheManager::instance().fitsBudget(fileSize)) {
+		debugC(1, kDebugLevelGVideo, "%s would not fit in the frame cache", _fileName.c_str());
+		_state = kStateDecoding;
+		return;
+	}
+
+	_outFile = FrameCacheManager::instance().openForWriting(_fileName);
+	if (!_outFile) {
+		_state = kStateDecoding;
+		return;
+	}
+
+	_outFile->writeUint32BE(kFrameCacheTag);
+	_outFile->writeUint32BE(kFrameCacheVersion);
+	_outFile->writeUint32BE(_frameCount);
+	_outFile->writeUint16BE(frame.w);
+	_outFile->writeUint16BE(frame.h);
+	_outFile->writeByte(frame.format.bytesPerPixel);
+	_outFile->writeByte(frame.format.rLoss);
+	_outFile->writeByte(frame.format.gLoss);
+	_outFile->writeByte(frame.format.bLoss);
+	_outFile->writeByte(frame.format.aLoss);
+	_outFile->writeByte(frame.format.rShift);
+	_outFile->writeByte(frame.format.gShift);
+	_outFile->writeByte(frame.format.bShift);
+	_outFile->writeByte(frame.format.aShift);
+
+	// Keep the frames to compare the following ones with
+	if (!_surface.getPixels() || _surface.w != frame.w || _surface.h != frame.h || _surface.format != frame.format) {
+		_surface.free();
+		_surface.create(frame.w, frame.h, frame.format);
+	}
+
+	_state = kStateWriting;
+}
+
+bool FrameCacheCodec::readFrame(uint32 checksum) {
+	if (_curFrame >= _frameCount || _inFile->readUint32BE() != checksum)
+		return false;
+
+	// The rows of the previous frame are still in the surface
+	const uint bpp = _surface.format.bytesPerPixel;
+	for (int y = 0; y < _surface.h; y++) {
+		const uint16 first = _inFile->readUint16BE();
+		const uint16 count = _inFile->readUint16BE();
+		if (first + count > _surface.w || (_curFrame == 0 && count != _surface.w))
+			return false;
+
+		_inFile->read(_surface.getBasePtr(first, y), count * bpp);
+	}
+
+	return !_inFile->err() && !_inFile->eos();
+}
+
+void FrameCacheCodec::writeFrame(uint32 checksum, const Graphics::Surface *frame) {
+	// Only a file with all frames of the video in the same format is any use
+	if (!frame || frame->w != _surface.w || frame->h != _surface.h || frame->format != _surface.format ||
+			_codec->containsPalette() || _curFrame >= _frameCount) {
+		stopWriting(false);
+		return;
+	}
+
+	_outFile->writeUint32BE(checksum);
+
+	// Only write the part of each row which differs from the previous frame
+	const uint bpp = _surface.format.bytesPerPixel;
+	const uint rowSize = _surface.w * bpp;
+	for (int y = 0; y < _surface.h; y++) {
+		const byte *src = (const byte *)frame->getBasePtr(0, y);
+		byte *prev = (byte *)_surface.getBasePtr(0, y);
+
+		uint first = 0, end = rowSize;
+		if (_curFrame != 0) {
+			while (first < end && src[first] == prev[first])
+				first++;
+			while (end > first && src[end - 1] == prev[end - 1])
+				end--;
+
+			first = first / bpp * bpp;
+			end = (end + bpp - 1) / bpp * bpp;
+		}
+
+		_outFile->writeUint16BE(first / bpp);
+		_outFile->writeUint16BE((end - first) / bpp);
+		_outFile->write(src + first, end - first);
+		memcpy(prev + first, src + first, end - first);
+	}
+
+	if (_outFile->err())
+		stopWriting(false);
+	else if (_curFrame + 1 == _frameCount)
+		stopWriting(true);
+}
+
+void FrameCacheCodec::stopReading() {
+	delete _inFile;
+	_inFile = nullptr;
+}
+
+void FrameCacheCodec::stopWriting(bool keep) {
+	if (!_outFile)
+		return;
+
+	if (keep)
+		_outFile->writeUint32BE(kFrameCacheTag);
+
+	const uint64 size = _outFile->pos();
+	if (keep) {
+		_outFile->finalize();
+		keep = !_outFile->err();
+	}
+
+	delete _outFile;
+	_outFile = nullptr;
+
+	if (!keep)
+		FrameCacheManager::instance().removeFile(_fileName);
+	else if (FrameCacheManager::instance().addFile(_fileName, size))
+		debugC(1, kDebugLevelGVideo, "Wrote %u frames to %s", _frameCount, _fileName.c_str());
+
+	_state = kStateDecoding;
+}
+
+uint32 FrameCacheCodec::computeChecksum(Common::SeekableReadStream &stream) {
+	const int64 pos = stream.pos();
+	const uint32 size = stream.size() - pos;
+
+	if (size > _packetBufferSize) {
+		free(_packetBuffer);
+		_packetBuffer = (byte *)malloc(size);
+		_packetBufferSize = size;
+	}
+
+	stream.read(_packetBuffer, size);
+	stream.seek(pos);
+
+	return _crc.crcFast(_packetBuffer, size);
+}
+
+} // End of namespace Video
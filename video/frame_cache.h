@@ -0,0 +1,202 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_FRAME_CACHE_H
+#define VIDEO_FRAME_CACHE_H
+
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/fs.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "image/codecs/codec.h"
+
+namespace Common {
+class Mutex;
+}
+
+namespace Video {
+
+/**
+ * The directory of the frame cache files, from the videocachepath config
+ * key. Once the files take up more than video_frame_cache_size MiB, 1024 by
+ * default, the ones used least recently are dropped.
+ *
+ * The order of use is kept in an index file in the directory. Dropped files
+ * are deleted, or truncated on backends which cannot delete files. The
+ * files may be used by several threads at once, but the manager must be
+ * created and configured on the thread loading the videos.
+ */
+class FrameCacheManager : public Common::Singleton<FrameCacheManager> {
+public:
+	/**
+	 * Read the directory and the budget of the cache from the configuration
+	 * manager, which is not thread safe. Call this when loading a video.
+	 */
+	void configure();
+
+	/** Is there a directory to cache frames in? */
+	bool isAvailable();
+
+	/**
+	 * Open a cache file, making it the most recently used one.
+	 *
+	 * @return nullptr if the file is not in the cache
+	 */
+	Common::SeekableReadStream *openForReading(const Common::String &name);
+
+	/** Can a file of this size be kept in the cache at all? */
+	bool fitsBudget(uint64 size);
+
+	/**
+	 * Create a cache file, which is only kept once it is passed to
+	 * addFile() when complete.
+	 */
+	Common::SeekableWriteStream *openForWriting(const Common::String &name);
+
+	/**
+	 * Add a file written with openForWriting() to the cache as the most
+	 * recently used one, and drop the least recently used files over the
+	 * budget.
+	 *
+	 * @return false if the file alone is over the budget, and was dropped
+	 */
+	bool addFile(const Common::String &name, uint64 size);
+
+	/** Drop a file from the cache. */
+	void removeFile(const Common::String &name);
+
+	/** Drop all files from the cache. */
+	void clear();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	FrameCacheManager();
+	~FrameCacheManager();
+
+	struct Entry {
+		Common::String name;
+		uint64 size;
+	};
+
+	/** Load the index of the configured directory, if it is not loaded. */
+	bool loadIndex();
+	void saveIndex();
+	int findEntry(const Common::String &name) const;
+	void deleteFile(const Common::String &name);
+
+	Common::Mutex *_mutex;
+
+	/** The directory and the budget in bytes from the configuration */
+	Common::Path _configPath;
+	uint64 _budget;
+
+	/** The configured directory whose index is loaded */
+	Common::Path _dirPath;
+	Common::FSNode _dir;
+
+	/** The files in the cache, the least recently used first */
+	Common::Array<Entry> _entries;
+};
+
+/**
+ * A codec keeping the frames decoded by another codec in a file of the
+ * FrameCacheManager, to read them from there instead of decoding them again
+ * when the same video is played.
+ *
+ * The file holds the frames of one playback from the first frame to the
+ * last, along with a checksum of the data each one was decoded from. Only
+ * the part of each row which differs from the previous frame is stored. It is
+ * only used up to the first frame whose data differs, such as after
+ * seeking, and from then on the frames are decoded as usual. Codecs
+ * with palettes of their own, or dithering, are never cached.
+ */
+class FrameCacheCodec : public Image::Codec {
+public:
+	/**
+	 * @param codec       The codec to cache the frames of, which is deleted
+	 *                    along with this one
+	 * @param fileName    The name of the cache file
+	 * @param frameCount  The number of frames of the video
+	 */
+	FrameCacheCodec(Image::Codec *codec, const Common::String &fileName, uint frameCount);
+	~FrameCacheCodec() override;
+
+	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
+
+	Graphics::PixelFormat getPixelFormat() const override { return _codec->getPixelFormat(); }
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
+	bool containsPalette() const override { return _codec->containsPalette(); }
+	const byte *getPalette() override { return _codec->getPalette(); }
+	bool hasDirtyPalette() const override { return _codec->hasDirtyPalette(); }
+	bool canDither(DitherType type) const override { return _codec->canDither(type); }
+	void setDither(DitherType type, const byte *palette) override;
+	void setCodecAccuracy(Image::CodecAccuracy accuracy) override;
+
+	/**
+	 * Can the frames of a codec be worth caching? This is true for codecs
+	 * which take much longer to decode a frame than to read it.
+	 *
+	 * @param tag  The FourCC of the codec, as used by AVI and QuickTime
+	 */
+	static bool isWorthCaching(uint32 tag, int width, int height);
+
+	/**
+	 * Get the name of the cache file of a video track, from the first MiB
+	 * and the size of the video file.
+	 */
+	static Common::String getFileName(Common::SeekableReadStream &stream, uint track);
+
+private:
+	enum State {
+		kStateNew,       ///< Nothing decoded yet
+		kStateReading,   ///< Reading the frames from the file
+		kStateWriting,   ///< Decoding the frames and writing them to the file
+		kStateDecoding   ///< Decoding the frames
+	};
+
+	bool startReading();
+	void startWriting(const Graphics::Surface &frame);
+	bool readFrame(uint32 checksum);
+	void writeFrame(uint32 checksum, const Graphics::Surface *frame);
+	void stopReading();
+	void stopWriting(bool keep);
+	uint32 computeChecksum(Common::SeekableReadStream &stream);
+
+	Image::Codec *_codec;
+	Common::String _fileName;
+	uint _frameCount;
+
+	State _state;
+	uint _curFrame;
+	uint32 _firstChecksum;
+	Common::SeekableReadStream *_inFile;
+	Common::SeekableWriteStream *_outFile;
+	Graphics::Surface _surface;
+
+	Common::CRC32 _crc;
+	byte *_packetBuffer;
+	uint32 _packetBufferSize;
+};
+
+} // End of namespace Video
+
+#endif
@@ -8,6 +8,7 @@ MODULE_OBJS := \
 	coktel_decoder.o \
 	dxa_decoder.o \
 	flic_decoder.o \
+	frame_cache.o \
 	mpegps_decoder.o \
 	mve_decoder.o \
 	paco_decoder.o \
@@ -20,7 +21,21 @@ MODULE_OBJS := \
 
 ifdef USE_BINK
 MODULE_OBJS += \
-	bink_decoder.o
+	bink_decoder.o \
+	bink_dsp.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	bink_dsp-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_dsp-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	bink_dsp-avx2.o
+endif
 endif
 
 ifdef USE_HNM
@@ -23,6 +23,7 @@
 #include "audio/decoders/raw.h"
 #include "audio/decoders/ac3.h"
 #include "audio/decoders/mp3.h"
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/endian.h"
 #include "common/stream.h"
@@ -55,6 +56,7 @@ enum {
 MPEGPSDecoder::MPEGPSDecoder(double decibel) {
 	_decibel = decibel;
 	_demuxer = new MPEGPSDemuxer();
+	_loaded = false;
 }
 
 MPEGPSDecoder::~MPEGPSDecoder() {
@@ -75,6 +77,8 @@ bool MPEGPSDecoder::loadStream(Common::SeekableReadStream *stream) {
 		return false;
 	}
 
+	addPrebufferedTracks();
+	_loaded = true;
 	return true;
 }
 
@@ -86,6 +90,7 @@ void MPEGPSDecoder::close() {
 	VideoDecoder::close();
 	_demuxer->close();
 	_streamMap.clear();
+	_loaded = false;
 }
 
 MPEGPSDecoder::MPEGStream *MPEGPSDecoder::getStream(uint32 startCode, Common::SeekableReadStream *packet) {
@@ -94,6 +99,11 @@ MPEGPSDecoder::MPEGStream *MPEGPSDecoder::getStream(uint32 startCode, Common::Se
 	if (_streamMap.contains(startCode)) {
 		// We already found the stream
 		stream = _streamMap[startCode];
+	} else if (_loaded && getDecodeAhead() != 0) {
+		// The tracks may be in use by the thread decoding ahead, so only the
+		// streams found while prebuffering get one
+		warning("Ignoring MPEG-PS stream 0x%04X found while decoding ahead", startCode);
+		_streamMap[startCode] = 0;
 	} else {
 		// We haven't seen this before
 
@@ -217,6 +227,17 @@ bool MPEGPSDecoder::addFirstVideoTrack() {
 	return true;
 }
 
+void MPEGPSDecoder::addPrebufferedTracks() {
+	Common::Array<int32> startCodes;
+	Common::Array<Common::SeekableReadStream *> packets;
+	_demuxer->getFirstAudioPackets(startCodes, packets);
+
+	for (uint i = 0; i < packets.size(); i++) {
+		getStream(startCodes[i], packets[i]);
+		packets[i]->seek(0);
+	}
+}
+
 MPEGPSDecoder::PrivateStreamType MPEGPSDecoder::detectPrivateStreamType(Common::SeekableReadStream *packet) {
 	uint32 dvdCode = packet->readUint32LE();
 	if (packet->eos())
@@ -289,7 +310,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::loadStream(Common::SeekableReadStream *stream
 	_stream = stream;
 
 	int queuedPackets = 0;
-	while (queueNextPacket() && queuedPackets < _prebufferedPackets) {
+	while (_queuedBytes < kMaxQueuedBytes && queueNextPacket() && queuedPackets < _prebufferedPackets) {
 		queuedPackets++;
 	}
 
@@ -304,12 +325,12 @@ void MPEGPSDecoder::MPEGPSDemuxer::close() {
 	_firstVideoPacketPts = 0xFFFFFFFF;
 
 	while (!_audioQueue.empty()) {
-		Packet packet = _audioQueue.pop();
+		Packet packet = popPacket(_audioQueue);
 		delete packet._stream;
 	}
 
 	while (!_videoQueue.empty()) {
-		Packet packet = _videoQueue.pop();
+		Packet packet = popPacket(_videoQueue);
 		delete packet._stream;
 	}
 }
@@ -324,8 +345,20 @@ Common::SeekableReadStream *MPEGPSDecoder::MPEGPSDemuxer::getFirstVideoPacket(in
 	return packet._stream;
 }
 
+void MPEGPSDecoder::MPEGPSDemuxer::getFirstAudioPackets(Common::Array<int32> &startCodes, Common::Array<Common::SeekableReadStream *> &packets) const {
+	for (Common::List<Packet>::const_iterator it = _audioQueue.begin(); it != _audioQueue.end(); it++) {
+		if (Common::find(startCodes.begin(), startCodes.end(), it->_startCode) == startCodes.end()) {
+			startCodes.push_back(it->_startCode);
+			packets.push_back(it->_stream);
+		}
+	}
+}
+
 Common::SeekableReadStream *MPEGPSDecoder::MPEGPSDemuxer::getNextPacket(uint32 currentTime, int32 &startCode, uint32 &pts, uint32 &dts) {
-	queueNextPacket();
+	// Apply back-pressure once enough is queued. Held audio packets are
+	// delivered when the video queue runs dry, so this cannot stall.
+	if (_queuedBytes < kMaxQueuedBytes || _videoQueue.empty())
+		queueNextPacket();
 
 	// The idea here is to prioritize the delivery of audio packets,
 	// because when the decoder wants a frame it will keep asking until it
@@ -358,7 +391,7 @@ Common::SeekableReadStream *MPEGPSDecoder::MPEGPSDemuxer::getNextPacket(uint32 c
 		}
 
 		if (usePacket) {
-			_audioQueue.pop();
+			popPacket(_audioQueue);
 			startCode = packet._startCode;
 			pts = packet._pts;
 			dts = packet._dts;
@@ -367,7 +400,7 @@ Common::SeekableReadStream *MPEGPSDecoder::MPEGPSDemuxer::getNextPacket(uint32 c
 	}
 
 	if (!_videoQueue.empty()) {
-		Packet packet = _videoQueue.pop();
+		Packet packet = popPacket(_videoQueue);
 		startCode = packet._startCode;
 
 		if (packet._pts != 0xFFFFFFFF && packet._pts >= _firstVideoPacketPts) {
@@ -396,7 +429,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 
 		int32 startCode = 0x1E0;
 		uint32 pts = 0xFFFFFFFF, dts = 0xFFFFFFFF;
-		_videoQueue.push(Packet(stream, startCode, pts, dts));
+		pushPacket(_videoQueue, Packet(stream, startCode, pts, dts));
 		return true;
 	}
 
@@ -414,7 +447,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 
 		if (startCode == kStartCodePrivateStream1 || (startCode >= 0x1C0 && startCode <= 0x1DF)) {
 			// Audio packet
-			_audioQueue.push(Packet(stream, startCode, pts, dts));
+			pushPacket(_audioQueue, Packet(stream, startCode, pts, dts));
 			if (_firstAudioPacketPts == 0xFFFFFFFF)
 				_firstAudioPacketPts = pts;
 			return true;
@@ -422,7 +455,7 @@ bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 
 		if (startCode >= 0x1E0 && startCode <= 0x1EF) {
 			// Video packet
-			_videoQueue.push(Packet(stream, startCode, pts, dts));
+			pushPacket(_videoQueue, Packet(stream, startCode, pts, dts));
 			if (_firstVideoPacketPts == 0xFFFFFFFF)
 				_firstVideoPacketPts = pts;
 			return true;
@@ -432,6 +465,18 @@ bool MPEGPSDecoder::MPEGPSDemuxer::queueNextPacket() {
 	}
 }
 
+void MPEGPSDecoder::MPEGPSDemuxer::pushPacket(Common::List<Packet> &queue, const Packet &packet) {
+	queue.push_back(packet);
+	_queuedBytes += packet._stream->size();
+}
+
+MPEGPSDecoder::MPEGPSDemuxer::Packet MPEGPSDecoder::MPEGPSDemuxer::popPacket(Common::List<Packet> &queue) {
+	Packet packet = queue.front();
+	queue.pop_front();
+	_queuedBytes -= packet._stream->size();
+	return packet;
+}
+
 int MPEGPSDecoder::MPEGPSDemuxer::readNextPacketHeader(int32 &startCode, uint32 &pts, uint32 &dts) {
 	for (;;) {
 		uint32 size;
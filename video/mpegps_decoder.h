@@ -22,8 +22,9 @@
 #ifndef VIDEO_MPEGPS_DECODER_H
 #define VIDEO_MPEGPS_DECODER_H
 
+#include "common/array.h"
 #include "common/hashmap.h"
-#include "common/queue.h"
+#include "common/list.h"
 #include "graphics/surface.h"
 #include "video/video_decoder.h"
 
@@ -47,6 +48,11 @@ namespace Video {
 
 /**
  * Decoder for MPEG Program Stream videos.
+ *
+ * Frames are only decoded ahead on a separate thread if the caller opts in
+ * with setDecodeAhead(), e.g. with kDecodeAheadFrames, or with the
+ * video_decode_ahead config key.
+ *
  * Video decoder used in engines:
  *  - mtropolis
  *  - qdengine
@@ -57,6 +63,9 @@ public:
 	MPEGPSDecoder(double decibel = 0.0);
 	virtual ~MPEGPSDecoder();
 
+	/** About a group of pictures, a good number of frames to decode ahead */
+	static const uint kDecodeAheadFrames = 12;
+
 	bool loadStream(Common::SeekableReadStream *stream) override;
 	void close() override;
 
@@ -67,6 +76,7 @@ public:
 protected:
 	void readNextPacket() override;
 	bool useAudioSync() const override { return false; }
+	bool supportsDecodeAhead() const override { return true; }
 
 private:
 	class MPEGPSDemuxer {
@@ -78,6 +88,7 @@ private:
 		void close();
 
 		Common::SeekableReadStream *getFirstVideoPacket(int32 &startCode, uint32 &pts, uint32 &dts);
+		void getFirstAudioPackets(Common::Array<int32> &startCodes, Common::Array<Common::SeekableReadStream *> &packets) const;
 		Common::SeekableReadStream *getNextPacket(uint32 currentTime, int32 &startCode, uint32 &pts, uint32 &dts);
 
 		void setPrebufferedPackets(int packets) { _prebufferedPackets = packets; }
@@ -93,6 +104,8 @@ private:
 			uint32 _dts;
 		};
 		bool queueNextPacket();
+		void pushPacket(Common::List<Packet> &queue, const Packet &packet);
+		Packet popPacket(Common::List<Packet> &queue);
 		bool fillQueues();
 		int readNextPacketHeader(int32 &startCode, uint32 &pts, uint32 &dts);
 		int findNextStartCode(uint32 &size);
@@ -100,8 +113,8 @@ private:
 		void parseProgramStreamMap(int length);
 
 		Common::SeekableReadStream *_stream;
-		Common::Queue<Packet> _videoQueue;
-		Common::Queue<Packet> _audioQueue;
+		Common::List<Packet> _videoQueue;
+		Common::List<Packet> _audioQueue;
 		// If we come across a non-packetized elementary stream
 		bool _isESStream;
 
@@ -109,6 +122,14 @@ private:
 		uint32 _firstVideoPacketPts = 0xFFFFFFFF;
 
 		int _prebufferedPackets = 150;
+
+		// Packets are only read ahead until this much is queued, so memory
+		// use does not depend on the length of the stream
+		static const uint32 kMaxQueuedBytes = 2 * 1024 * 1024;
+
+		// The size of the packets in both queues. No more packets are read
+		// ahead past kMaxQueuedBytes, unless the video queue is empty.
+		uint32 _queuedBytes = 0;
 	};
 
 	// Base class for handling MPEG streams
@@ -240,10 +261,14 @@ private:
 	PrivateStreamType detectPrivateStreamType(Common::SeekableReadStream *packet);
 
 	bool addFirstVideoTrack();
+	void addPrebufferedTracks();
 	MPEGStream *getStream(uint32 startCode, Common::SeekableReadStream *packet);
 
 	MPEGPSDemuxer *_demuxer;
 
+	// Set once the tracks of the streams found while prebuffering exist
+	bool _loaded;
+
 	// A map from stream types to stream handlers
 	typedef Common::HashMap<int, MPEGStream *> StreamMap;
 	StreamMap _streamMap;
@@ -27,6 +27,7 @@
 // Seek function by Gael Chardon gael.dev@4now.net
 //
 
+#include "video/frame_cache.h"
 #include "video/qt_decoder.h"
 #include "video/qt_data.h"
 
@@ -244,6 +245,16 @@ void QuickTimeDecoder::init() {
 			for (uint32 j = 0; j < tracks[i]->sampleDescs.size(); j++)
 				((VideoSampleDesc *)tracks[i]->sampleDescs[j])->initCodec();
 
+			// Only cache tracks with a single codec, whose frames are decoded in order
+			if (getFrameCache() && tracks[i]->sampleDescs.size() == 1) {
+				VideoSampleDesc *desc = (VideoSampleDesc *)tracks[i]->sampleDescs[0];
+
+				if (desc->_videoCodec && FrameCacheCodec::isWorthCaching(desc->getCodecTag(), tracks[i]->width, tracks[i]->height)) {
+					FrameCacheManager::instance().configure();
+					desc->_videoCodec = new FrameCacheCodec(desc->_videoCodec, FrameCacheCodec::getFileName(*_fd, i), tracks[i]->frameCount);
+				}
+			}
+
 			addTrack(new VideoTrackHandler(this, tracks[i]));
 
 			tracks[i]->targetTrack = getNumTracks() - 1;
@@ -331,8 +342,11 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 		checkEditListBounds();
 	}
 
+	buildSampleTable();
+
 	_curEdit = 0;
 	_curFrame = -1;
+	_lastDecodedFrame = -1;
 	_delayedFrameToBufferTo = -1;
 	enterNewEditListEntry(true, true); // might set _curFrame
 
@@ -464,7 +478,15 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		int32 destinationFrame = _curFrame + 1;
 
 		assert(destinationFrame < (int32)_parent->frameCount);
-		_curFrame = findKeyFrame(destinationFrame) - 1;
+		const int32 keyFrame = findKeyFrame(destinationFrame);
+
+		// Continue from the frame decoded last when seeking forward within
+		// the same key frame interval, instead of decoding from its start
+		if (_lastDecodedFrame >= keyFrame && _lastDecodedFrame < destinationFrame && _parent->sampleDescs.size() == 1)
+			_curFrame = _lastDecodedFrame;
+		else
+			_curFrame = keyFrame - 1;
+
 		while (_curFrame < destinationFrame - 1)
 			bufferNextFrame();
 	}
@@ -501,6 +523,24 @@ bool QuickTimeDecoder::VideoTrackHandler::setOutputPixelFormat(const Graphics::P
 	return success;
 }
 
+bool QuickTimeDecoder::VideoTrackHandler::setOutputSurface(Graphics::Surface *surface) {
+	// Scaled frames are copied anyway, and codecs of different sample
+	// descriptions can't share the previous frame
+	if (surface && (_parent->sampleDescs.size() != 1 || _parent->scaleFactorX != 1 || _parent->scaleFactorY != 1))
+		return false;
+
+	bool success = true;
+
+	for (uint i = 0; i < _parent->sampleDescs.size(); i++) {
+		VideoSampleDesc *desc = (VideoSampleDesc *)_parent->sampleDescs[i];
+
+		if (desc->_videoCodec)
+			success = desc->_videoCodec->setOutputSurface(surface) && success;
+	}
+
+	return success;
+}
+
 int QuickTimeDecoder::VideoTrackHandler::getFrameCount() const {
 	return _parent->frameCount;
 }
@@ -699,49 +739,52 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 	return Common::Rational(_parent->height) / _parent->scaleFactorY;
 }
 
-Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
+void QuickTimeDecoder::VideoTrackHandler::buildSampleTable() {
+	// Track down which chunk holds each sample, and where the sample is
+	// located in the chunk, so that frames can be looked up directly.
 	uint32 sampleToChunkIndex = 0;
 
 	for (uint32 i = 0; i < _parent->chunkCount; i++) {
 		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
 			sampleToChunkIndex++;
 
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
+		if (sampleToChunkIndex == 0)
+			continue;
 
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
+		const SampleToChunkEntry &entry = _parent->sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = _parent->chunkOffsets[i];
 
-	if (actualChunk < 0)
-		error("Could not find data for frame %d", _curFrame);
+		for (uint32 j = 0; j < entry.count; j++) {
+			SampleEntry sample;
+			sample.offset = offset;
+			sample.descId = entry.id;
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+			if (_parent->sampleSize != 0) {
+				sample.size = _parent->sampleSize;
+			} else if (_samples.size() < _parent->sampleCount) {
+				sample.size = _parent->sampleSizes[_samples.size()];
+			} else {
+				return;
+			}
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
+			_samples.push_back(sample);
+			offset += sample.size;
+		}
 	}
+}
 
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
+Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
+	if (_curFrame < 0 || (uint32)_curFrame >= _samples.size())
+		error("Could not find data for frame %d", _curFrame);
 
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
+	const SampleEntry &sample = _samples[_curFrame];
+	descId = sample.descId;
 
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, sample.offset, sample.size);
+
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(sample.offset);
+	return stream->readStream(sample.size);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
@@ -760,9 +803,18 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+	// The key frames are sorted, find the number of those up to the frame
+	uint32 low = 0, high = _parent->keyframeCount;
+	while (low < high) {
+		uint32 mid = (low + high) / 2;
+		if (_parent->keyframes[mid] <= frame)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	if (low > 0)
+		return _parent->keyframes[low - 1];
 
 	// If none found, we'll assume the requested frame is a key frame
 	return frame;
@@ -882,6 +934,13 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 	const Graphics::Surface *frame = entry->_videoCodec->decodeFrame(*frameData);
 	delete frameData;
 
+	// Only a frame decoded right after the previous one, or from a key
+	// frame, can be continued from when seeking
+	if (frame && (_lastDecodedFrame == _curFrame - 1 || findKeyFrame(_curFrame) == (uint32)_curFrame))
+		_lastDecodedFrame = _curFrame;
+	else
+		_lastDecodedFrame = -1;
+
 	// The codec palette takes priority over the container one
 	if (entry->_videoCodec->containsPalette()) {
 		_dirtyPalette = entry->_videoCodec->hasDirtyPalette();
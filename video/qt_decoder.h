@@ -340,6 +340,7 @@ private:
 		uint16 getHeight() const override;
 		Graphics::PixelFormat getPixelFormat() const override;
 		bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
+		bool setOutputSurface(Graphics::Surface *surface) override;
 		int getCurFrame() const override { return _curFrame; }
 		void setCurFrame(int32 curFrame) { _curFrame = curFrame; }
 		int getFrameCount() const override;
@@ -371,6 +372,19 @@ private:
 		mutable bool _dirtyPalette;
 		bool _reversed;
 
+		// The frame the codec state belongs to, if it was decoded in order
+		// from a key frame, or -1
+		int32 _lastDecodedFrame;
+
+		// Where the data of each sample is, built once from the chunk tables
+		struct SampleEntry {
+			uint32 offset;
+			uint32 size;
+			uint32 descId;
+		};
+		Common::Array<SampleEntry> _samples;
+
+		void buildSampleTable();
 		Common::SeekableReadStream *getNextFramePacket(uint32 &descId);
 		uint32 getCurFrameDuration();            // media time
 		uint32 findKeyFrame(uint32 frame) const;
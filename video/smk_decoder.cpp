@@ -44,6 +44,8 @@
 #include "audio/mixer.h"
 #include "audio/decoders/raw.h"
 
+#include "image/codecs/codec.h"
+
 namespace Video {
 
 enum SmkBlockTypes {
@@ -417,6 +419,17 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	for (i = 0; i < frameCount; ++i)
 		_frameTypes[i] = _fileStream->readByte();
 
+	uint32 offset = 0;
+	for (i = 0; i < frameCount; ++i) {
+		_frameOffsets.push_back(offset);
+		offset += _frameSizes[i] & ~3;
+
+		if (_frameSizes[i] & 1)
+			_keyFrames.push_back(i);
+		if (_frameTypes[i] & 1)
+			_paletteFrames.push_back(i);
+	}
+
 	byte *huffmanTrees = (byte *) malloc(_header.treesSize);
 	_fileStream->read(huffmanTrees, _header.treesSize);
 
@@ -439,6 +452,10 @@ void SmackerDecoder::close() {
 
 	delete[] _frameSizes;
 	_frameSizes = 0;
+
+	_frameOffsets.clear();
+	_keyFrames.clear();
+	_paletteFrames.clear();
 }
 
 bool SmackerDecoder::rewind() {
@@ -464,33 +481,59 @@ const Graphics::Surface *SmackerDecoder::forceSeekToFrame(uint frame) {
 	if (seekFrame >= getFrameCount())
 		return nullptr;
 
-	if (!rewind())
-		return nullptr;
+	// Start from the last key frame instead, if it is closer
+	uint low = 0, high = _keyFrames.size();
+	while (low < high) {
+		uint mid = (low + high) / 2;
+		if (_keyFrames[mid] <= frame)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	if (low > 0 && _keyFrames[low - 1] > seekFrame)
+		seekFrame = _keyFrames[low - 1];
+
+	// The tracks are at the frame decoded last from here on, and the
+	// frames up to the requested one are decoded on this thread
+	blockDecodeAhead(true);
 
-	stopAudio();
 	SmackerVideoTrack *videoTrack = (SmackerVideoTrack *)getTrack(0);
-	uint32 startPos = _fileStream->pos();
-	uint32 offset = 0;
-	for (uint32 i = 0; i < seekFrame; i++) {
-		videoTrack->increaseCurFrame();
+	const int curFrame = videoTrack->getCurFrame();
+
+	if (curFrame >= (int)seekFrame - 1 && curFrame < (int)frame) {
+		// Already there, just continue decoding
+		stopAudio();
+	} else {
+		if (!rewind()) {
+			blockDecodeAhead(false);
+			return nullptr;
+		}
+
+		stopAudio();
+
 		// Frames with palette data contain palette entries which use
 		// the previous palette as their base. Therefore, we need to
 		// parse all palette entries up to the requested frame
-		if (_frameTypes[videoTrack->getCurFrame()] & 1) {
-			_fileStream->seek(startPos + offset, SEEK_SET);
+		for (uint32 i = 0; i < _paletteFrames.size() && _paletteFrames[i] < seekFrame; i++) {
+			_fileStream->seek(_firstFrameStart + _frameOffsets[_paletteFrames[i]], SEEK_SET);
 			videoTrack->unpackPalette(_fileStream);
 		}
-		offset += _frameSizes[i] & ~3;
-	}
 
-	if (!_fileStream->seek(startPos + offset, SEEK_SET))
-		return nullptr;
+		videoTrack->setCurFrame(seekFrame - 1);
+
+		if (!_fileStream->seek(_firstFrameStart + _frameOffsets[seekFrame], SEEK_SET)) {
+			blockDecodeAhead(false);
+			return nullptr;
+		}
+	}
 
 	const Graphics::Surface *surface = nullptr;
 	while (getCurFrame() < (int)frame) {
 		surface = decodeNextFrame();
 	}
 
+	blockDecodeAhead(false);
+
 	_lastTimeChange = videoTrack->getFrameTime(frame);
 	if (isPlaying()) {
 		_startTime = g_system->getMillis() - (_lastTimeChange.msecs() / getRate()).toInt();
@@ -601,8 +644,9 @@ VideoDecoder::AudioTrack *SmackerDecoder::getAudioTrack(int index) {
 }
 
 SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, uint32 flags, uint32 version) : _palette(256) {
-	_surface = new Graphics::Surface();
-	_surface->create(width, height * ((flags & 6) ? 2 : 1), Graphics::PixelFormat::createFormatCLUT8());
+	_ownSurface = new Graphics::Surface();
+	_ownSurface->create(width, height * ((flags & 6) ? 2 : 1), Graphics::PixelFormat::createFormatCLUT8());
+	_surface = _ownSurface;
 	_dirtyBlocks.set_size(width * height / 16);
 	_frameCount = frameCount;
 	_frameRate = frameRate;
@@ -614,8 +658,8 @@ SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height
 }
 
 SmackerDecoder::SmackerVideoTrack::~SmackerVideoTrack() {
-	_surface->free();
-	delete _surface;
+	_ownSurface->free();
+	delete _ownSurface;
 
 	delete _MMapTree;
 	delete _MClrTree;
@@ -624,15 +668,20 @@ SmackerDecoder::SmackerVideoTrack::~SmackerVideoTrack() {
 }
 
 uint16 SmackerDecoder::SmackerVideoTrack::getWidth() const {
-	return _surface->w;
+	return _ownSurface->w;
 }
 
 uint16 SmackerDecoder::SmackerVideoTrack::getHeight() const {
-	return _surface->h;
+	return _ownSurface->h;
 }
 
 Graphics::PixelFormat SmackerDecoder::SmackerVideoTrack::getPixelFormat() const {
-	return _surface->format;
+	return _ownSurface->format;
+}
+
+bool SmackerDecoder::SmackerVideoTrack::setOutputSurface(Graphics::Surface *surface) {
+	Image::switchOutputSurface(_surface, _ownSurface, _outputSurface, surface);
+	return true;
 }
 
 void SmackerDecoder::SmackerVideoTrack::readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize) {
@@ -654,7 +703,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 
 	uint bw = getWidth() / 4;
 	uint bh = getHeight() / doubleY / 4;
-	uint stride = getWidth();
+	uint stride = _surface->pitch;
 	uint block = 0, blocks = bw*bh;
 
 	byte *out;
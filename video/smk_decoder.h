@@ -91,6 +91,7 @@ public:
 protected:
 	void readNextPacket() override;
 	bool supportsAudioTrackSwitching() const override { return true; }
+	bool supportsDecodeAhead() const override { return true; }
 	AudioTrack *getAudioTrack(int index) override;
 
 	virtual void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize);
@@ -108,6 +109,7 @@ protected:
 		uint16 getWidth() const override;
 		uint16 getHeight() const override;
 		Graphics::PixelFormat getPixelFormat() const override;
+		bool setOutputSurface(Graphics::Surface *surface) override;
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
 		const Graphics::Surface *decodeNextFrame() override { return _surface; }
@@ -116,6 +118,7 @@ protected:
 
 		void readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize);
 		void increaseCurFrame() { _curFrame++; }
+		void setCurFrame(int frame) { _curFrame = frame; }
 		void decodeFrame(SmackerBitStream &bs);
 		void unpackPalette(Common::SeekableReadStream *stream);
 
@@ -127,6 +130,9 @@ protected:
 		Graphics::Surface *_surface;
 
 	private:
+		Graphics::Surface *_ownSurface;
+		Graphics::Surface _outputSurface;
+
 		Common::Rational _frameRate;
 		uint32 _flags, _version;
 
@@ -222,6 +228,12 @@ protected:
 
 private:
 	uint32 _firstFrameStart;
+
+	// The offsets of the frames from the first one, and the frames which
+	// are key frames or contain palette records, for seeking
+	Common::Array<uint32> _frameOffsets;
+	Common::Array<uint32> _keyFrames;
+	Common::Array<uint32> _paletteFrames;
 };
 
 } // End of namespace Video
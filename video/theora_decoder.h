@@ -79,6 +79,7 @@ public:
 
 protected:
 	void readNextPacket() override;
+	bool supportsDecodeAhead() const override { return true; }
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
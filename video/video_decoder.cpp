@@ -24,12 +24,271 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/config-manager.h"
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/queue.h"
 #include "common/system.h"
+#include "common/textconsole.h"
+#include "common/thread.h"
+
+#include "graphics/blit.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * Frames decoded ahead by a worker thread, for a single video track.
+ *
+ * While the worker runs, it owns the decoder's tracks: it calls
+ * readNextPacket() and the track's decodeNextFrame(), and copies each frame
+ * along with the track state after decoding it. The calling thread only
+ * reads these copies, and pauses the worker before touching the tracks.
+ *
+ * There is one frame more than can be decoded ahead, for the frame being
+ * displayed.
+ *
+ * The warnings and errors of the worker are handed over to the calling
+ * thread, which outputs them the next time it uses the queue.
+ */
+class VideoDecoder::DecodeAheadQueue : public Common::LogRedirect {
+public:
+	struct Frame {
+		Frame() : hasSurface(false), curFrame(-1), curFrameDelay(0), nextFrameStartTime(0), endOfTrack(false), dirtyPalette(false) {}
+		~Frame() { surface.free(); }
+
+		Graphics::Surface surface;
+		bool hasSurface;
+
+		// The state of the track after decoding this frame
+		int curFrame;
+		int curFrameDelay;
+		uint32 nextFrameStartTime;
+		bool endOfTrack;
+
+		bool dirtyPalette;
+		byte palette[3 * 256];
+	};
+
+	DecodeAheadQueue(VideoDecoder *decoder, VideoTrack *track, uint frames);
+	~DecodeAheadQueue();
+
+	VideoTrack *getTrack() const { return _track; }
+
+	/** The frame displayed last, or the state of the track before the first one. */
+	const Frame &getShown() const { return *_shown; }
+
+	/**
+	 * Start the worker if it is not running yet.
+	 *
+	 * @return false if the backend cannot create a thread
+	 */
+	bool start();
+
+	/** Wait for the worker to return, keeping the frames decoded so far. */
+	void pause();
+
+	/**
+	 * Make the next decoded frame the shown one, waiting for the worker to
+	 * decode it if needed.
+	 *
+	 * @return false if the track has ended, or the worker is paused and no
+	 *         frame was decoded
+	 */
+	bool next();
+
+	void redirectWarning(const char *msg) override;
+	void redirectError(const char *msg) override;
+
+private:
+	static void workerProc(void *param);
+	void decodeFrame(Frame &frame);
+	void readState(Frame &frame) const;
+
+	/** Output the warnings and the error of the worker on this thread. */
+	void outputLog();
+
+	VideoDecoder *_decoder;
+	VideoTrack *_track;
+
+	Common::ConditionVariable _cond;
+	Common::ThreadInternal *_thread;
+	bool _running;
+	bool _quit;
+	bool _ended;
+
+	Common::Array<Common::String> _warnings;
+	Common::String _error;
+	bool _failed;
+
+	Common::Array<Frame *> _free;
+	Common::Queue<Frame *> _ready;
+	Frame *_shown;
+};
+
+VideoDecoder::DecodeAheadQueue::DecodeAheadQueue(VideoDecoder *decoder, VideoTrack *track, uint frames) :
+		_decoder(decoder), _track(track), _thread(nullptr), _running(false), _quit(false), _ended(false), _failed(false) {
+	for (uint i = 0; i < frames; i++)
+		_free.push_back(new Frame());
+
+	_shown = new Frame();
+	readState(*_shown);
+	_ended = _shown->endOfTrack;
+}
+
+VideoDecoder::DecodeAheadQueue::~DecodeAheadQueue() {
+	pause();
+
+	for (uint i = 0; i < _free.size(); i++)
+		delete _free[i];
+
+	while (!_ready.empty())
+		delete _ready.pop();
+
+	delete _shown;
+}
+
+bool VideoDecoder::DecodeAheadQueue::start() {
+	if (_thread || _ended)
+		return true;
+
+	_running = true;
+	_thread = g_system->createThread(workerProc, this, "ScummVM video");
+	if (!_thread)
+		_running = false;
+
+	return _thread != nullptr;
+}
+
+void VideoDecoder::DecodeAheadQueue::pause() {
+	if (!_thread)
+		return;
+
+	_cond.lock();
+	_quit = true;
+	_cond.notifyAll();
+
+	// A worker which ran into an error never returns
+	while (_running && !_failed)
+		_cond.wait();
+	_cond.unlock();
+
+	outputLog();
+
+	_thread->join();
+	delete _thread;
+	_thread = nullptr;
+	_quit = false;
+}
+
+bool VideoDecoder::DecodeAheadQueue::next() {
+	bool shown = false;
+
+	_cond.lock();
+	while (_ready.empty() && !_ended && _thread && !_failed)
+		_cond.wait();
+
+	if (!_ready.empty()) {
+		_free.push_back(_shown);
+		_shown = _ready.pop();
+		_cond.notifyAll();
+		shown = true;
+	}
+	_cond.unlock();
+
+	outputLog();
+	return shown;
+}
+
+void VideoDecoder::DecodeAheadQueue::redirectWarning(const char *msg) {
+	Common::StackLock lock(_cond);
+	_warnings.push_back(msg);
+}
+
+void VideoDecoder::DecodeAheadQueue::redirectError(const char *msg) {
+	Common::StackLock lock(_cond);
+	_error = msg;
+	_failed = true;
+	_cond.notifyAll();
+
+	// The calling thread ends the process with this error
+	for (;;)
+		_cond.wait();
+}
+
+void VideoDecoder::DecodeAheadQueue::outputLog() {
+	Common::Array<Common::String> warnings;
+	Common::String errorMsg;
+
+	_cond.lock();
+	warnings.swap(_warnings);
+	if (_failed)
+		errorMsg = _error;
+	_cond.unlock();
+
+	for (uint i = 0; i < warnings.size(); i++)
+		warning("%s", warnings[i].c_str());
+
+	if (!errorMsg.empty())
+		error("%s", errorMsg.c_str());
+}
+
+void VideoDecoder::DecodeAheadQueue::workerProc(void *param) {
+	DecodeAheadQueue *queue = (DecodeAheadQueue *)param;
+	Common::setThreadLogRedirect(queue);
+
+	Common::StackLock lock(queue->_cond);
+	while (!queue->_quit) {
+		if (queue->_ended || queue->_free.empty()) {
+			queue->_cond.wait();
+			continue;
+		}
+
+		Frame *frame = queue->_free.back();
+		queue->_free.pop_back();
+
+		queue->_cond.unlock();
+		queue->decodeFrame(*frame);
+		queue->_cond.lock();
+
+		queue->_ended = frame->endOfTrack;
+		queue->_ready.push(frame);
+		queue->_cond.notifyAll();
+	}
+
+	queue->_running = false;
+	queue->_cond.notifyAll();
+	Common::setThreadLogRedirect(nullptr);
+}
+
+void VideoDecoder::DecodeAheadQueue::decodeFrame(Frame &frame) {
+	_decoder->readNextPacket();
+
+	const Graphics::Surface *surface = _track->decodeNextFrame();
+	frame.hasSurface = surface != nullptr;
+
+	if (surface) {
+		// Keep the buffer of the frame unless the video changes size
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format)
+			frame.surface.create(surface->w, surface->h, surface->format);
+
+		frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.dirtyPalette = _track->hasDirtyPalette();
+	if (frame.dirtyPalette)
+		memcpy(frame.palette, _track->getPalette(), sizeof(frame.palette));
+
+	readState(frame);
+}
+
+void VideoDecoder::DecodeAheadQueue::readState(Frame &frame) const {
+	frame.curFrame = _track->getCurFrame();
+	frame.curFrameDelay = _track->getCurFrameDelay();
+	frame.nextFrameStartTime = _track->getNextFrameStartTime();
+	frame.endOfTrack = _track->endOfTrack();
+}
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -48,9 +307,29 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_decodeAhead = nullptr;
+	_decodeAheadFrames = 0;
+	_decodeAheadBlocked = false;
+	_frameCache = false;
+	_outputRedirected = false;
+	_decodingInto = false;
+
+	if (ConfMan.hasKey("video_decode_ahead"))
+		setDecodeAhead(MAX(ConfMan.getInt("video_decode_ahead"), 0));
+	if (ConfMan.hasKey("video_frame_cache"))
+		_frameCache = ConfMan.getBool("video_frame_cache");
+}
+
+VideoDecoder::~VideoDecoder() {
+	delete _decodeAhead;
 }
 
 void VideoDecoder::close() {
+	stopDecodeAhead();
+
+	// The tracks are deleted anyway, without touching the caller's surface
+	_outputRedirected = false;
+
 	if (isPlaying())
 		stop();
 
@@ -134,6 +413,7 @@ void VideoDecoder::pauseVideo(bool pause) {
 	}
 
 	if (_pauseLevel == 1 && pause) {
+		pauseDecodeAhead();
 		_pauseStartTime = g_system->getMillis(); // Store the starting time from pausing to keep it for later
 
 		for (auto &track : _tracks)
@@ -212,6 +492,33 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (!_decodingInto)
+		resetOutputSurface();
+
+	startDecodeAhead();
+
+	if (_decodeAhead) {
+		if (!_decodeAhead->next()) {
+			// All frames have been displayed, but a subclass may still
+			// need to buffer the remaining audio.
+			_decodeAhead->pause();
+			readNextPacket();
+			return 0;
+		}
+
+		const DecodeAheadQueue::Frame &frame = _decodeAhead->getShown();
+
+		if (frame.dirtyPalette) {
+			memcpy(_decodeAheadPalette, frame.palette, sizeof(_decodeAheadPalette));
+			_palette = _decodeAheadPalette;
+			_dirtyPalette = true;
+		}
+
+		findNextVideoTrack();
+
+		return frame.hasSurface ? &frame.surface : 0;
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -232,11 +539,72 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+bool VideoDecoder::decodeNextFrameInto(Graphics::Surface &dst) {
+	startDecodeAhead();
+
+	// Decode straight into dst if there is a single video track in the
+	// same format, which isn't decoded ahead into frames of its own
+	bool direct = false;
+	if (!_decodeAhead && _nextVideoTrack && _nextVideoTrack->getPixelFormat() == dst.format &&
+			dst.w >= _nextVideoTrack->getWidth() && dst.h >= _nextVideoTrack->getHeight()) {
+		direct = true;
+		for (const auto &track : _tracks)
+			if (track->getTrackType() == Track::kTrackTypeVideo && track != _nextVideoTrack)
+				direct = false;
+	}
+
+	if (direct && _nextVideoTrack->setOutputSurface(&dst))
+		_outputRedirected = true;
+	else
+		resetOutputSurface();
+
+	_decodingInto = true;
+	const Graphics::Surface *frame = decodeNextFrame();
+	_decodingInto = false;
+
+	if (!frame)
+		return false;
+
+	if (frame->getPixels() == dst.getPixels())
+		return true;
+
+	const uint w = MIN(frame->w, dst.w);
+	const uint h = MIN(frame->h, dst.h);
+
+	if (frame->format == dst.format) {
+		dst.copyRectToSurface(*frame, 0, 0, Common::Rect(w, h));
+	} else if (frame->format.isCLUT8() && _palette) {
+		uint32 map[256];
+		Graphics::convertPaletteToMap(map, _palette, 256, dst.format);
+		Graphics::crossBlitMap((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, w, h, dst.format.bytesPerPixel, map);
+	} else if (!Graphics::crossBlit((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, w, h, dst.format, frame->format)) {
+		warning("VideoDecoder::decodeNextFrameInto(): Cannot convert from %s to %s", frame->format.toString().c_str(), dst.format.toString().c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void VideoDecoder::resetOutputSurface() {
+	if (!_outputRedirected)
+		return;
+
+	for (auto &track : _tracks)
+		if (track->getTrackType() == Track::kTrackTypeVideo)
+			((VideoTrack *)track)->setOutputSurface(nullptr);
+
+	_outputRedirected = false;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The frames decoded ahead are in the wrong direction now
+	if (reverse && _decodeAhead && !resyncDecodeAhead())
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -261,7 +629,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (const auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)track)->getCurFrame() + 1;
+			frame += getTrackCurFrame((VideoTrack *)track) + 1;
 
 	return frame;
 }
@@ -271,7 +639,7 @@ int VideoDecoder::getCurFrameDelay() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrameDelay() + 1;
+			frame += getTrackCurFrameDelay((VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -313,7 +681,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getTrackNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -332,8 +700,8 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (const auto &track : _tracks) {
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getTrackNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = getTrackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -356,6 +724,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	stopDecodeAhead();
+	resetOutputSurface();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -390,12 +761,21 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	stopDecodeAhead();
+	resetOutputSurface();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
 
-	// Do the actual seeking
-	if (!seekIntern(time))
+	// Do the actual seeking. Frames decoded to get there must not start
+	// decoding ahead.
+	const bool blocked = _decodeAheadBlocked;
+	_decodeAheadBlocked = true;
+	bool result = seekIntern(time);
+	_decodeAheadBlocked = blocked;
+
+	if (!result)
 		return false;
 
 	// Seek any external track too
@@ -586,6 +966,8 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 }
 
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
+	pauseDecodeAhead();
+
 	_videoCodecAccuracy = accuracy;
 
 	for (Track *track : _tracks) {
@@ -817,6 +1199,8 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::Path &baseNa
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	pauseDecodeAhead();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -893,6 +1277,8 @@ bool VideoDecoder::setAudioTrack(int index) {
 	if (_mainAudioTrack == audioTrack)
 		return true;
 
+	pauseDecodeAhead();
+
 	_mainAudioTrack->setMute(true);
 	audioTrack->setMute(false);
 	_mainAudioTrack = audioTrack;
@@ -959,7 +1345,7 @@ void VideoDecoder::setEndFrame(uint frame) {
 
 void VideoDecoder::resetStartTime() {
 	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(getTrackCurFrame(_nextVideoTrack));
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -982,7 +1368,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (const auto &track : _tracks)
-		if (track->getTrackType() == Track::kTrackTypeVideo && !track->endOfTrack())
+		if (track->getTrackType() == Track::kTrackTypeVideo && !getTrackEnded(track))
 			return false;
 
 	return true;
@@ -993,9 +1379,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (auto &track : _tracks) {
-		if (track->getTrackType() == Track::kTrackTypeVideo && !track->endOfTrack()) {
+		if (track->getTrackType() == Track::kTrackTypeVideo && !getTrackEnded(track)) {
 			VideoTrack *videoTrack = (VideoTrack *)track;
-			uint32 time = videoTrack->getNextFrameStartTime();
+			uint32 time = getTrackNextFrameStartTime(videoTrack);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -1008,6 +1394,8 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 }
 
 void VideoDecoder::startAudio() {
+	pauseDecodeAhead();
+
 	if (_endTimeSet) {
 		// HACK: Timestamp's subtraction asserts out when subtracting two times
 		// with different rates.
@@ -1021,6 +1409,8 @@ void VideoDecoder::startAudio() {
 }
 
 void VideoDecoder::stopAudio() {
+	pauseDecodeAhead();
+
 	for (auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeAudio)
 			((AudioTrack *)track)->stop();
@@ -1034,6 +1424,8 @@ void VideoDecoder::setAudioRate(Common::Rational rate) {
 }
 
 void VideoDecoder::startAudioLimit(const Audio::Timestamp &limit) {
+	pauseDecodeAhead();
+
 	for (auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeAudio)
 			((AudioTrack *)track)->start(limit);
@@ -1049,8 +1441,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *videoTrack = (const VideoTrack *)track;
 
-		bool videoEndTimeReached = _endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = videoTrack->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getTrackNextFrameStartTime(videoTrack) >= (uint)_endTime.msecs();
+		bool endReached = getTrackEnded(videoTrack) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -1067,6 +1459,13 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	resetOutputSurface();
+
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		stopDecodeAhead();
+	else
+		pauseDecodeAhead();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -1083,4 +1482,109 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	// More frames only cost memory once the worker keeps up
+	_decodeAheadFrames = MIN<uint>(frames, 16);
+}
+
+void VideoDecoder::startDecodeAhead() {
+	if (_decodeAhead) {
+		// Resume a paused worker. Should that fail, the frames decoded so far
+		// are dropped and decoding continues on this thread.
+		if (!_decodeAhead->start() && !resyncDecodeAhead())
+			warning("VideoDecoder: Could not return to the frame displayed");
+		return;
+	}
+
+	if (_decodeAheadFrames == 0 || _decodeAheadBlocked || !supportsDecodeAhead())
+		return;
+
+	if (!_nextVideoTrack || _nextVideoTrack->isReversed() || _nextVideoTrack->endOfTrack())
+		return;
+
+	// Only a single video track can be decoded ahead
+	for (const auto &track : _tracks)
+		if (track->getTrackType() == Track::kTrackTypeVideo && track != _nextVideoTrack)
+			return;
+
+	// The worker decodes into frames of its own
+	resetOutputSurface();
+
+	_decodeAhead = new DecodeAheadQueue(this, _nextVideoTrack, _decodeAheadFrames);
+
+	if (!_decodeAhead->start()) {
+		// No thread support, don't try again for every frame
+		delete _decodeAhead;
+		_decodeAhead = nullptr;
+		_decodeAheadFrames = 0;
+	}
+}
+
+void VideoDecoder::pauseDecodeAhead() {
+	if (_decodeAhead)
+		_decodeAhead->pause();
+}
+
+void VideoDecoder::blockDecodeAhead(bool block) {
+	if (block)
+		stopDecodeAhead();
+
+	_decodeAheadBlocked = block;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (!_decodeAhead)
+		return;
+
+	// _palette may point to _decodeAheadPalette, which stays valid
+	delete _decodeAhead;
+	_decodeAhead = nullptr;
+}
+
+bool VideoDecoder::resyncDecodeAhead() {
+	VideoTrack *videoTrack = _decodeAhead->getTrack();
+	const int curFrame = _decodeAhead->getShown().curFrame;
+
+	stopDecodeAhead();
+
+	if (!videoTrack->isSeekable())
+		return false;
+
+	const bool blocked = _decodeAheadBlocked;
+	_decodeAheadBlocked = true;
+	bool result = seekIntern(videoTrack->getFrameTime(curFrame + 1));
+	_decodeAheadBlocked = blocked;
+
+	findNextVideoTrack();
+	return result;
+}
+
+int VideoDecoder::getTrackCurFrame(const VideoTrack *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getShown().curFrame;
+
+	return track->getCurFrame();
+}
+
+int VideoDecoder::getTrackCurFrameDelay(const VideoTrack *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getShown().curFrameDelay;
+
+	return track->getCurFrameDelay();
+}
+
+uint32 VideoDecoder::getTrackNextFrameStartTime(const VideoTrack *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getShown().nextFrameStartTime;
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::getTrackEnded(const Track *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getShown().endOfTrack;
+
+	return track->endOfTrack();
+}
+
 } // End of namespace Video
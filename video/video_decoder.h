@@ -53,7 +53,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -371,6 +371,29 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame straight into a surface owned by the caller, for
+	 * instance the back buffer the engine composes its screen in.
+	 *
+	 * The frame is placed at the top-left corner of dst; use
+	 * Graphics::Surface::getSubArea() to place it elsewhere. Tracks which
+	 * support it decode into dst directly when it has their pixel format,
+	 * otherwise the frame is copied and converted to the format of dst,
+	 * using the current palette for paletted videos.
+	 *
+	 * Codecs decoding the differences to the previous frame keep using dst
+	 * as their reference. Hence dst must be used by this video only, keep
+	 * the frame unchanged, and stay valid until the next call to this,
+	 * decodeNextFrame(), seek(), rewind() or close(). This rules out the
+	 * surface returned by OSystem::lockScreen(), which is only valid until
+	 * unlockScreen().
+	 *
+	 * @param dst The surface to decode into
+	 * @return true if a new frame was decoded into dst, false if there was
+	 *         none, in which case the last frame should be kept on screen
+	 */
+	bool decodeNextFrameInto(Graphics::Surface &dst);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -430,6 +453,51 @@ public:
 	 */
 	virtual void setVideoCodecAccuracy(Image::CodecAccuracy accuracy);
 
+	/**
+	 * Decode up to the given number of frames ahead on a separate thread.
+	 *
+	 * decodeNextFrame() then returns frames which have already been decoded
+	 * while the previous ones were displayed. This only has an effect for
+	 * video formats supporting it, for videos with a single video track
+	 * played forward, and on backends with thread support. Otherwise frames
+	 * are decoded when requested, as with the default of 0.
+	 *
+	 * The default is taken from the video_decode_ahead config key. A change
+	 * takes effect when the next video is loaded, or after seeking.
+	 *
+	 * @param frames The maximum number of frames decoded ahead
+	 */
+	void setDecodeAhead(uint frames);
+
+	/**
+	 * Get the maximum number of frames decoded ahead.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	uint getDecodeAhead() const { return _decodeAheadFrames; }
+
+	/**
+	 * Keep the frames of codecs which are slow to decode in a file in the
+	 * directory of the videocachepath config key, and read them from there
+	 * when the video is played again.
+	 *
+	 * This only has an effect for video formats supporting it, for frames
+	 * decoded with the default accuracy and without dithering, and if there
+	 * is a cache directory. The
+	 * default is taken from the video_frame_cache config key. A change takes
+	 * effect when the next video is loaded.
+	 *
+	 * @param enable Whether frames are cached
+	 */
+	void setFrameCache(bool enable) { _frameCache = enable; }
+
+	/**
+	 * Are frames of slow codecs cached?
+	 *
+	 * @see setFrameCache()
+	 */
+	bool getFrameCache() const { return _frameCache; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -620,6 +688,21 @@ protected:
 		 */
 		virtual bool setOutputPixelFormat(const Graphics::PixelFormat &format) { return format == getPixelFormat(); }
 
+		/**
+		 * Decode the following frames into the given surface of the caller,
+		 * which has the pixel format of the track and is at least the size
+		 * of its frames, and return a part of it from decodeNextFrame().
+		 * Nothing else may write into the surface while the track uses it.
+		 *
+		 * The last frame decoded must be copied into a new surface first, if
+		 * later frames depend on it. nullptr switches back to the surface of
+		 * the track, which then gets the last frame from the previous one.
+		 *
+		 * @see VideoDecoder::decodeNextFrameInto()
+		 * @return true if the track switched to the surface
+		 */
+		virtual bool setOutputSurface(Graphics::Surface *surface) { return !surface; }
+
 		/**
 		 * Set the image codec accuracy
 		 */
@@ -997,6 +1080,42 @@ protected:
 	 */
 	virtual bool supportsAudioTrackSwitching() const { return false; }
 
+	/**
+	 * Can frames of this video format be decoded ahead on another thread?
+	 *
+	 * Returning true implies that readNextPacket() followed by the video
+	 * track's decodeNextFrame() produces the next frame without any help
+	 * from the calling thread, that the subclass does not access its tracks
+	 * outside of the functions of this class while playing, and that its
+	 * destructor calls close().
+	 *
+	 * @see setDecodeAhead()
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
+	/**
+	 * Stop decoding ahead and drop the frames decoded so far.
+	 *
+	 * The tracks are left at the last decoded frame, so this must be
+	 * followed by a seek or rewind of the tracks. seek(), rewind() and
+	 * close() do this on their own.
+	 */
+	void stopDecodeAhead();
+
+	/**
+	 * Stop decoding ahead and don't start again until unblocked, for
+	 * subclasses decoding frames on their own, e.g. to seek to a frame.
+	 * seek() and rewind() keep it blocked.
+	 */
+	void blockDecodeAhead(bool block);
+
+	/**
+	 * Switch all video tracks back to decoding into their own surfaces.
+	 *
+	 * @see decodeNextFrameInto()
+	 */
+	void resetOutputSurface();
+
 	/**
 	 * Get the audio track for the given index.
 	 *
@@ -1053,6 +1172,31 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Frames decoded ahead on another thread
+	class DecodeAheadQueue;
+	DecodeAheadQueue *_decodeAhead;
+	uint _decodeAheadFrames;
+	bool _decodeAheadBlocked;
+
+	// Palette of the frame shown last when decoding ahead, as the worker
+	// reuses the frames of the queue for the frames after it
+	byte _decodeAheadPalette[3 * 256];
+
+	// Frames of slow codecs kept in the videocachepath directory
+	bool _frameCache;
+
+	// Video tracks decoding into a surface passed to decodeNextFrameInto()
+	bool _outputRedirected;
+	bool _decodingInto;
+
+	void startDecodeAhead();
+	void pauseDecodeAhead();
+	bool resyncDecodeAhead();
+	int getTrackCurFrame(const VideoTrack *track) const;
+	int getTrackCurFrameDelay(const VideoTrack *track) const;
+	uint32 getTrackNextFrameStartTime(const VideoTrack *track) const;
+	bool getTrackEnded(const Track *track) const;
 };
 
 } // End of namespace Video